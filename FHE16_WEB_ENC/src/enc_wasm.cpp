@@ -13,18 +13,20 @@
 // CMake(예시)에서 반드시 export 하세요:
 // -sMODULARIZE=1 -sEXPORT_NAME=createFHE16 -sFORCE_FILESYSTEM=1
 // -sEXPORTED_RUNTIME_METHODS=FS,ccall,cwrap,UTF8ToString,stringToUTF8,lengthBytesUTF8
-// -sEXPORTED_FUNCTIONS=['_malloc','_free','_FHE16_init_params','_FHE16_set_pk','_FHE16_load_pk_from_fs','_FHE16_ENC_WASM','_FHE16_ENC_BIN','_FHE16_free']
+// -sEXPORTED_FUNCTIONS=['_malloc','_free','_FHE16_init_params','_FHE16_set_pk','_FHE16_load_pk_from_fs','_FHE16_ENC_WASM','_FHE16_ENC_BIN','_FHE16_ENC_BATCH','_FHE16_free']
+// - 배치 버전: FHE16_ENC_BATCH(msgs, n, out) → 호출자 버퍼에 n 개 연속 기록
 //
 
 #include <algorithm>
+#include <climits>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <cmath>
-#include <random>
 #include <string>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 #ifdef __EMSCRIPTEN__
@@ -39,6 +41,11 @@
   #endif
 #endif
 
+#include "fhe16_enc_pool.hpp"
+#include "fhe16_pk_compact.hpp"
+#include "fhe16_pk_kernel.hpp"
+#include "fhe16_rng.hpp"
+
 // ===== 파라미터/PK 저장 영역 =====
 struct FHE16PARAM {
     int _PK_row = 0;
@@ -50,142 +57,222 @@ struct FHE16PARAM {
 static FHE16PARAM g_P;
 
 static std::vector<int32_t> g_PK; // row-major, length = PK_row * PK_col
-
-// ===== 유틸 =====
-static std::mt19937_64 make_strong_engine() {
-    std::random_device rd;
-    std::vector<uint32_t> seeds(16);
-    for (auto &s : seeds) s = rd();
-    std::seed_seq seq(seeds.begin(), seeds.end());
-    return std::mt19937_64(seq);
+static FHE16_PKPacked g_PK_packed;  // 커널용 배치 (g_PK 와 파라미터가 맞을 때만 유효)
+
+static void refresh_pk_packed() {
+    if (g_P._PK_row > 0 && g_P._PK_col > 0 &&
+        g_PK.size() == (size_t)g_P._PK_row * (size_t)g_P._PK_col) {
+        FHE16_PK_pack(g_PK.data(), g_P._PK_row, g_P._PK_col, &g_PK_packed);
+    } else {
+        FHE16_PK_pack(nullptr, 0, 0, &g_PK_packed);
+    }
 }
-static inline int iround(double x) {
-    return (int)llround(x);
+
+static const FHE16_PKPacked* pk_packed_for(int rows, int cols) {
+    if (g_PK_packed.fast && g_PK_packed.rows == rows && g_PK_packed.cols == cols) return &g_PK_packed;
+    return nullptr;
 }
 
 // ===== 내부 암호화 코어 (원 알고리즘에 최대한 맞춤) =====
-// 반환: 길이 PK_col 의 int32 벡터
-static std::vector<int32_t> FHE16_ENC_core(int msg, int bit) {
+static inline int32_t reduce_coeff(int64_t x, int PK_Q, int BL_Q) {
+    int32_t v = (int32_t)(x % PK_Q);
+    v += (v >> 31) & PK_Q;              // 음수 보정
+    if (v > BL_Q) v -= BL_Q;            // Reduce to BK_Q
+    return v;
+}
+
+// ===== 스레드 =====
+// pthread 빌드(-pthread)/네이티브는 열 구간을 나눠 병렬, 그 외는 1개
+static int g_threads = 0;   // 0 = 자동
+
+static int enc_threads() {
+#if FHE16_POOL_HAS_THREAD
+    if (g_threads > 0) return g_threads;
+    const int hw = (int)std::thread::hardware_concurrency();
+    return std::max(1, std::min(hw, 8));
+#else
+    return 1;
+#endif
+}
+
+// CT_LARGE[bit][col] = sum_row SK[bit][row] * PK[row][col]
+// 스레드마다 64열 단위 구간을 맡고, 각 구간의 PK 타일은 모든 비트에 재사용
+static void pk_matmul_parallel(const int32_t* sk, int nbit, int64_t* C, int nthreads) {
     const int PK_row = g_P._PK_row;
+    const int PK_col = g_P._PK_col;
+    const FHE16_PKPacked* P = pk_packed_for(PK_row, PK_col);
+
+    const int tiles = (PK_col + 63) / 64;
+    const int nt    = std::max(1, std::min(nthreads, tiles));
+    auto run = [&](int t) {
+        const int c0 = std::min(tiles * t / nt * 64, PK_col);
+        const int c1 = std::min(tiles * (t + 1) / nt * 64, PK_col);
+        FHE16_PK_matmul(P, g_PK.data(), PK_row, PK_col, sk, nbit, C, PK_col, c0, c1);
+    };
+    if (nt == 1) { run(0); return; }
+#if FHE16_POOL_HAS_THREAD
+    std::vector<std::thread> th;
+    for (int t = 1; t < nt; ++t) th.emplace_back(run, t);
+    run(0);
+    for (auto& x : th) x.join();
+#endif
+}
+
+// CT_LARGE(+E) → 0 의 암호문. b 계수만 BL_Q 보정 없이 [0, PK_Q) 로 남김
+static void FHE16_ENC_zero_finalize(const int64_t* CT_LARGE, const int32_t* tmp_E, int bit, int32_t* out) {
     const int PK_col = g_P._PK_col;
     const int PK_Q   = g_P._PK_Q;
     const int BL_Q   = (int)g_P._Q_TOT;
 
-    std::vector<int32_t> CT(1040*bit, 0);
-    std::vector<int64_t> CT_LARGE(1040*bit, 0);
-    std::vector<int> tmp_E(PK_col*bit, 0), tmp_SK(PK_row*bit, 0);
+    for (int bit_idx = 0; bit_idx < bit; bit_idx++) {
+        const int64_t* acc = CT_LARGE + (size_t)bit_idx * PK_col;
+        const int32_t* E   = tmp_E + (size_t)bit_idx * PK_col;
+        int32_t*       dst = out + (size_t)bit_idx * PK_col;
 
-    auto eng = make_strong_engine();
-    std::normal_distribution<double> dis_E_DG(0.0, g_P._sigma_bs);
+        for (int col = 0; col < PK_col - 1; col++) dst[col] = reduce_coeff(acc[col] + E[col], PK_Q, BL_Q);
 
-    // 비밀/노이즈
-    for (int jj = 0; jj < PK_row*bit; ++jj) tmp_SK[jj] = iround(dis_E_DG(eng));
-    for (int jj = 0; jj < PK_col*bit; ++jj) tmp_E[jj]  = iround(dis_E_DG(eng));
+        int32_t vb = (int32_t)((acc[PK_col-1] + E[PK_col-1]) % PK_Q);
+        vb += (vb >> 31) & PK_Q;
+        dst[PK_col-1] = vb;
+    }
+}
 
+// 0 의 암호문 bit 개 : out[bit_idx * PK_col + col]
+// b 계수(col = PK_col-1) 는 메시지를 나중에 더할 수 있도록 BL_Q 보정 전의 [0, PK_Q) 값
+static bool FHE16_ENC_zero_core(int bit, int32_t* out, int nthreads = 1) {
+    const int PK_row = g_P._PK_row;
+    const int PK_col = g_P._PK_col;
 
     // PK 필요
-    if ((int)g_PK.size() < PK_row * PK_col) {
-        // PK 없음 → 0 벡터 반환
-        return CT;
-    }
-    const int32_t* PK = g_PK.data();
-	/*
-    // CT_LARGE += PK(row, col) * sk[row]
-    for (int bit_idx =0; jj < bit; bit_idx++) {
-		for (int jjj = 0; jjj < 1025; jjj++) {
-			CT_LARGE[col] = 0;
-		}
-
-		for (int row = 0; row < PK_row; ++row) {
-			const int tmp_sk_val = tmp_SK[row + bit_idx*PK_row];
-			const int row_base   = row * PK_col;
-			for (int col = 0; col < PK_col; ++col) {
-				CT_LARGE[col] += (int64_t)PK[row_base + col] * (int64_t)tmp_sk_val;
-			}
-		}
-
-		// 잡음 더하기
-		for (int col = 0; col < PK_col; ++col) {
-			CT_LARGE[col] += (int64_t)tmp_E[col];
-		}
-
-    // 메시지 주입
-    if (PK_col > 0) {
-        CT_LARGE[PK_col - 1] += (int64_t)msg * (((int64_t)BL_Q) >> bit);
-    }
+    if (PK_row <= 0 || PK_col <= 0 || (int)g_PK.size() < PK_row * PK_col) return false;
 
-    // 모듈러 및 보정
-    for (int col = 0; col < PK_col; ++col) {
-        int64_t t = CT_LARGE[col] % PK_Q;
-        int32_t v = (int32_t)t;
-        v += (v >> 31) & PK_Q;   // 음수 보정
-        CT[col] = v;
-    }
-    // Reduce to BL_Q
-    for (int col = 0; col < PK_col; ++col) {
-        if (CT[col] > BL_Q) CT[col] -= BL_Q;
-    }
-	*/
-	
-	int tmp_msg = msg;
-	int CT_length = 1040;
+    // 비밀/노이즈 : 스레드 컨텍스트 스트림에서 블록 단위로 (시딩은 최초 1회, 실패하면 암호화 실패)
+    FHE16_RNG* rng = FHE16_RNG_thread();
+    if (!rng) return false;
 
-    for (int bit_idx = 0; bit_idx < bit; bit_idx++) {
-        int bit_idx_prod_CT_length  = bit_idx * CT_length;
-        int bit_idx_prod_PK_row     = bit_idx * PK_row;
-        for (int row = 0; row < PK_row; row++) {
-            int tmp_sk_val = tmp_SK[bit_idx_prod_PK_row + row];
-            int row_prod_PK_col =   row*PK_col;
-            for (int col = 0; col < PK_col; col++) {
-                CT_LARGE[bit_idx_prod_CT_length + col] +=  (int64_t) (  (  (int64_t)PK[row_prod_PK_col + col]) * ((int64_t)tmp_sk_val));
-            }
-        }
-		
-		int bit_idx_prod_PK_col     = bit_idx*PK_col;
-        for (int col = 0; col < PK_col; col++) {
-            CT_LARGE[bit_idx_prod_CT_length + col]          += (int64_t)tmp_E[bit_idx_prod_PK_col + col];
-        }
+    std::vector<int32_t> tmp_E(PK_col*bit, 0), tmp_SK(PK_row*bit, 0);
+    FHE16_RNG_gauss_vec(rng, tmp_SK.data(), tmp_SK.size(), g_P._sigma_bs);
+    FHE16_RNG_gauss_vec(rng, tmp_E.data(),  tmp_E.size(),  g_P._sigma_bs);
 
-		CT_LARGE[bit_idx_prod_CT_length + PK_col-1] += ((int64_t)(tmp_msg & 1)) * (((int64_t)BL_Q) >> 2);
-        // HAHA ... 
-        for (int col = 0; col < PK_col; col++) {
-            CT[16 + bit_idx_prod_CT_length + col] = (int32_t) (CT_LARGE[ bit_idx_prod_CT_length + col] % PK_Q);
-            CT[16 + bit_idx_prod_CT_length + col] += (CT[16 + bit_idx_prod_CT_length + col] >> 31) & PK_Q;
-        }
-		
-		tmp_msg >>= 1;
+    std::vector<int64_t> CT_LARGE((size_t)PK_col*bit, 0);
+    pk_matmul_parallel(tmp_SK.data(), bit, CT_LARGE.data(), nthreads);
 
-        // Reduce to BK_Q
-        for (int col = 0; col < PK_col; col++) {
-            if (CT[16 + bit_idx_prod_CT_length + col] > BL_Q) {
-                CT[16 + bit_idx_prod_CT_length + col] -= BL_Q;
-            }
-        }
+    FHE16_ENC_zero_finalize(CT_LARGE.data(), tmp_E.data(), bit, out);
+    return true;
+}
+
+// 0 의 암호문에 메시지를 넣어 CT 배치로 기록 (비트 i 는 16 + i*1040 부터 PK_col 개)
+static void FHE16_ENC_inject(int msg, int bit, const int32_t* zero, std::vector<int32_t>& CT) {
+    const int PK_col = g_P._PK_col;
+    const int PK_Q   = g_P._PK_Q;
+    const int BL_Q   = (int)g_P._Q_TOT;
+    const int CT_length = 1040;
+
+	int tmp_msg = msg;
+    for (int bit_idx = 0; bit_idx < bit; bit_idx++) {
+        const int32_t* src = zero + (size_t)bit_idx * PK_col;
+        int32_t*       dst = CT.data() + 16 + bit_idx * CT_length;
+        std::memcpy(dst, src, (size_t)(PK_col - 1) * sizeof(int32_t));
+        dst[PK_col-1] = reduce_coeff((int64_t)src[PK_col-1] + ((int64_t)(tmp_msg & 1)) * (((int64_t)BL_Q) >> 2),
+                                     PK_Q, BL_Q);
+		tmp_msg >>= 1;
 	}
-	return CT; // 길이 = PK_col
 }
 
-// ===== 1056개(16 + 1040) 구성 =====
-static void build_ct1056(const std::vector<int32_t>& ct_raw, int bit_fixed,
-                         std::vector<int32_t>& out1056) {
-    const int META_N = 16;
-    const int DATA_N = 1040*32;
+// ===== 오프라인/온라인 : 0 암호문 풀 =====
+static FHE16_EncPool g_pool;
+
+static bool pool_producer(int nbits, int32_t* out) { return FHE16_ENC_zero_core(nbits, out); }
+
+// 반환: 길이 1040*bit + 16 의 int32 벡터, 실패하면 빈 벡터
+// 앞의 16 오프셋만큼 여유를 둬서 마지막 비트가 벡터 밖으로 나가지 않게 함
+// 풀에서 꺼내 메시지만 주입. 부족하면 바로 암호화
+static std::vector<int32_t> FHE16_ENC_core_pooled(int msg, int bit) {
+    std::vector<int32_t> CT(1040*bit + 16, 0);
+    std::vector<int32_t> zero((size_t)std::max(g_P._PK_col, 0) * bit);
+    if (!g_pool.take(bit, zero.data()) && !FHE16_ENC_zero_core(bit, zero.data(), enc_threads())) return {};
+    FHE16_ENC_inject(msg, bit, zero.data(), CT);
+    return CT;
+}
+
+// PK/파라미터를 바꾸는 동안 백그라운드 생산을 멈추고, 기존 항목은 폐기
+struct PoolPause {
+    bool was_running;
+    int64_t target, low;
+    PoolPause() {
+        FHE16_EncPoolStats st;
+        g_pool.stats(&st);
+        target = st.target_bits; low = st.low_bits;
+        was_running = g_pool.running();
+        g_pool.stop();
+    }
+    ~PoolPause() {
+        g_pool.configure(g_P._PK_col, pool_producer);
+        if (was_running) g_pool.start((int)target, (int)low);
+    }
+};
 
-    // 데이터부 1040으로 패딩하거나 자르기
-    std::vector<int32_t> data(DATA_N, 0);
-    const int copyN = std::min<int>(DATA_N, (int)ct_raw.size());
-    if (copyN > 0) std::memcpy(data.data(), ct_raw.data(), copyN * sizeof(int32_t));
+// ===== 압축 PK(.fpk) 스트리밍 로딩 =====
+// 행이 도착하는 대로 디코딩하고, 미리 뽑아 둔 SK 로 0 암호문을 행 구간별로 누적한다.
+// 다운로드가 끝나면 남은 구간만 계산해서 바로 풀에 넣으므로 첫 암호화가 즉시 가능.
+static FHE16_PKStreamDecoder g_pk_stream;
+
+struct PKStreamPrefetch {
+    int nbits    = 0;
+    int rows_acc = 0;                  // 누적에 반영된 행 수
+    std::vector<int32_t> sk;           // [nbits][PK_row]
+    std::vector<int32_t> e;            // [nbits][PK_col]
+    std::vector<int64_t> acc;          // [nbits][PK_col]
+};
+static PKStreamPrefetch g_pk_prefetch;
+
+static const int PK_STREAM_ROW_CHUNK = 128;
+
+// rows_acc .. upto 행 구간을 누적
+static void pk_prefetch_accumulate(int upto) {
+    PKStreamPrefetch& pf = g_pk_prefetch;
+    const FHE16_PKCompactHeader& h = g_pk_stream.header();
+    const int rows = (int)h.rows, cols = (int)h.cols;
+    const int nr = upto - pf.rows_acc;
+    if (pf.nbits <= 0 || nr <= 0) return;
+
+    std::vector<int32_t> sk_chunk((size_t)pf.nbits * nr);
+    for (int b = 0; b < pf.nbits; ++b)
+        std::memcpy(sk_chunk.data() + (size_t)b * nr, pf.sk.data() + (size_t)b * rows + pf.rows_acc,
+                    (size_t)nr * sizeof(int32_t));
+
+    const int32_t* pk_chunk = g_pk_stream.pk() + (size_t)pf.rows_acc * cols;
+    FHE16_PKPacked packed;
+    FHE16_PK_pack(pk_chunk, nr, cols, &packed);
+
+    std::vector<int64_t> part((size_t)pf.nbits * cols);
+    FHE16_PK_matmul(&packed, pk_chunk, nr, cols, sk_chunk.data(), pf.nbits, part.data(), cols, 0, cols);
+    for (size_t i = 0; i < part.size(); ++i) pf.acc[i] += part[i];
+    pf.rows_acc = upto;
+}
 
-    out1056.resize(META_N + DATA_N);
+// ===== 1056개(16 + 1040) 구성 =====
+static const int CT_META_N = 16;
+static const int CT_DATA_N = 1040*32;
 
+// dst 에 CT_META_N + CT_DATA_N 개 기록 (데이터부는 패딩하거나 자르기)
+static void build_ct1056_into(const std::vector<int32_t>& ct_raw, int bit_fixed, int32_t* dst) {
     // 메타 채우기
-    out1056[0] = bit_fixed;   // 예: 32
-    out1056[1] = DATA_N;      // 1040
-    out1056[2] = 6;        // 요구값
-    for (int i = 3; i < META_N; ++i) out1056[i] = 0;
+    dst[0] = bit_fixed;   // 예: 32
+    dst[1] = CT_DATA_N;   // 1040
+    dst[2] = 6;        // 요구값
+    for (int i = 3; i < CT_META_N; ++i) dst[i] = 0;
 
     // 데이터부 붙이기
-    std::memcpy(out1056.data() + META_N, data.data(), DATA_N * sizeof(int32_t));
+    const int copyN = std::min<int>(CT_DATA_N, (int)ct_raw.size());
+    if (copyN > 0) std::memcpy(dst + CT_META_N, ct_raw.data(), copyN * sizeof(int32_t));
+    if (copyN < CT_DATA_N) std::memset(dst + CT_META_N + copyN, 0, (CT_DATA_N - copyN) * sizeof(int32_t));
+}
+
+static void build_ct1056(const std::vector<int32_t>& ct_raw, int bit_fixed,
+                         std::vector<int32_t>& out1056) {
+    out1056.resize(CT_META_N + CT_DATA_N);
+    build_ct1056_into(ct_raw, bit_fixed, out1056.data());
 }
 
 // 문자열 CSV 직렬화 (size 프리픽스 없음)
@@ -204,18 +291,22 @@ extern "C" {
 // 파라미터 설정
 EMSCRIPTEN_KEEPALIVE
 void FHE16_init_params(int pk_row, int pk_col, int pk_Q, double Q_TOT, double sigma) {
+    PoolPause pause;
     g_P._PK_row   = pk_row;
     g_P._PK_col   = pk_col;
     g_P._PK_Q     = pk_Q;
     g_P._Q_TOT    = Q_TOT;
     g_P._sigma_bs = sigma;
+    refresh_pk_packed();
 }
 
 // JS 힙 포인터로 PK 직접 설정 (length = int32 개수)
 EMSCRIPTEN_KEEPALIVE
 void FHE16_set_pk(const int32_t* pk_ptr, int length) {
-    if (!pk_ptr || length <= 0) { g_PK.clear(); g_PK.shrink_to_fit(); return; }
+    PoolPause pause;
+    if (!pk_ptr || length <= 0) { g_PK.clear(); g_PK.shrink_to_fit(); refresh_pk_packed(); return; }
     g_PK.assign(pk_ptr, pk_ptr + length);
+    refresh_pk_packed();
 }
 
 // 패키징/프리로드된 파일에서 PK 로딩 (path 예: "/pk.bin")
@@ -234,6 +325,8 @@ int FHE16_load_pk_from_fs(const char* path) {
     }
     size_t n = (size_t)fsz / sizeof(int32_t);
 
+    PoolPause pause;
+
     // 파라미터가 설정된 경우, 기대 크기 검사
     if (g_P._PK_row > 0 && g_P._PK_col > 0) {
         const size_t expect = (size_t)g_P._PK_row * (size_t)g_P._PK_col;
@@ -245,8 +338,9 @@ int FHE16_load_pk_from_fs(const char* path) {
     g_PK.resize(n);
     size_t rd = std::fread(g_PK.data(), sizeof(int32_t), n, fp);
     std::fclose(fp);
-    if (rd != n) { g_PK.clear(); g_PK.shrink_to_fit(); return 0; }
+    if (rd != n) { g_PK.clear(); g_PK.shrink_to_fit(); refresh_pk_packed(); return 0; }
 
+    refresh_pk_packed();
     return 1;
 }
 
@@ -254,7 +348,8 @@ int FHE16_load_pk_from_fs(const char* path) {
 EMSCRIPTEN_KEEPALIVE
 char* FHE16_ENC_WASM(int32_t msg, int bit) {
     
-	auto ct_raw = FHE16_ENC_core(msg, 32);
+	auto ct_raw = FHE16_ENC_core_pooled(msg, 32);
+    if (ct_raw.empty()) return nullptr;
     std::vector<int32_t> ct1056;
     build_ct1056(ct_raw, bit, ct1056);
 
@@ -272,7 +367,8 @@ EMSCRIPTEN_KEEPALIVE
 int FHE16_ENC_BIN(int32_t msg, int bit, uint32_t* out_ptr, int32_t* out_nbytes) {
     if (!out_ptr || !out_nbytes) return 0;
 
-    auto ct_raw = FHE16_ENC_core(msg, bit);
+    auto ct_raw = FHE16_ENC_core_pooled(msg, bit);
+    if (ct_raw.empty()) return 0;
     std::vector<int32_t> ct1056;
     build_ct1056(ct_raw, bit, ct1056);
 
@@ -286,6 +382,184 @@ int FHE16_ENC_BIN(int32_t msg, int bit, uint32_t* out_ptr, int32_t* out_nbytes)
     return (int)ct1056.size(); // 1056
 }
 
+// 배치 버전: msgs[n] 을 각각 32비트로 암호화해 out 에 연속 기록
+// out 은 호출자 버퍼 (n * (16 + 1040*32) 개 int32). 반환: 기록한 int32 개수, 실패 시 0
+// 풀에 있는 만큼 먼저 쓰고, 나머지 값들은 한 번의 PK 행렬곱(스레드 분할)으로 생산
+EMSCRIPTEN_KEEPALIVE
+int FHE16_ENC_BATCH(const int32_t* msgs, int n, int32_t* out) {
+    const int BIT    = 32;
+    const int CHUNK  = 8;     // 한 번에 생산하는 값 개수 (CT_LARGE 메모리 제한)
+    const int PK_col = g_P._PK_col;
+    if (!msgs || !out || n <= 0 || PK_col <= 0) return 0;
+
+    const size_t per_val = (size_t)BIT * PK_col;
+    const size_t per_ct  = CT_META_N + CT_DATA_N;
+    std::vector<int32_t> zero(per_val * CHUNK);
+    std::vector<int32_t> CT(1040*BIT + 16, 0);
+
+    for (int v0 = 0; v0 < n; v0 += CHUNK) {
+        const int nv = std::min(CHUNK, n - v0);
+        int ready = 0;
+        while (ready < nv && g_pool.take(BIT, zero.data() + ready * per_val)) ++ready;
+        if (ready < nv &&
+            !FHE16_ENC_zero_core((nv - ready) * BIT, zero.data() + ready * per_val, enc_threads())) {
+            return 0;
+        }
+        for (int i = 0; i < nv; ++i) {
+            FHE16_ENC_inject(msgs[v0 + i], BIT, zero.data() + i * per_val, CT);
+            build_ct1056_into(CT, BIT, out + (size_t)(v0 + i) * per_ct);
+        }
+    }
+    return (int)(n * per_ct);
+}
+
+// 암호화 스레드 수 (0 이하 = 자동). 스레드 없는 빌드에서는 무시
+EMSCRIPTEN_KEEPALIVE
+void FHE16_set_threads(int n) { g_threads = n > 0 ? n : 0; }
+
+// ===== 압축 PK(.fpk) =====
+// 스트리밍 시작. prefetch_bits 개(32 단위)의 0 암호문을 다운로드와 겹쳐서 미리 계산
+// (FHE16_init_params 이후에만 prefetch, 파라미터가 .fpk 헤더와 다르면 push 에서 실패)
+// total_bytes : 받을 .fpk 전체 길이 (매니페스트 bytes / 파일 크기, 0 이하 = 모름).
+// 헤더가 파라미터 세트나 이 길이와 맞지 않으면 PK 버퍼를 잡기 전에 push 가 실패한다.
+EMSCRIPTEN_KEEPALIVE
+int FHE16_PK_stream_begin(int prefetch_bits, int total_bytes) {
+    g_pk_stream.reset();
+    g_pk_stream.expect(g_P._PK_row > 0 ? (uint32_t)g_P._PK_row : 0,
+                       g_P._PK_col > 0 ? (uint32_t)g_P._PK_col : 0,
+                       g_P._PK_Q   > 0 ? (uint32_t)g_P._PK_Q   : 0,
+                       total_bytes > 0 ? (uint64_t)total_bytes : 0);
+    g_pk_prefetch = PKStreamPrefetch();
+    g_pk_prefetch.nbits = (g_P._PK_row > 0 && g_P._PK_col > 0) ? std::max(prefetch_bits, 0) : 0;
+    return 1;
+}
+
+// 받은 바이트 투입. 반환: 복원된 행 수, 오류 시 -1
+EMSCRIPTEN_KEEPALIVE
+int FHE16_PK_stream_push(const uint8_t* data, int len) {
+    if (!data || len < 0) return -1;
+    const bool had_header = g_pk_stream.header_ready();
+    const int rows = g_pk_stream.push(data, (size_t)len);
+    if (rows < 0) return -1;
+
+    const FHE16_PKCompactHeader& h = g_pk_stream.header();
+    PKStreamPrefetch& pf = g_pk_prefetch;
+    if (!had_header && g_pk_stream.header_ready()) {
+        // 파라미터가 설정돼 있으면 헤더와 일치해야 함
+        if (g_P._PK_row > 0 && ((int)h.rows != g_P._PK_row || (int)h.cols != g_P._PK_col ||
+                                (int)h.Q != g_P._PK_Q)) {
+            g_pk_stream.reset();
+            return -1;
+        }
+        if (pf.nbits > 0) {
+            // 시딩 실패 : 예측 가능한 SK 로 풀을 채우지 않도록 스트림을 실패시킨다
+            FHE16_RNG* rng = FHE16_RNG_thread();
+            if (!rng) {
+                g_pk_stream.reset();
+                return -1;
+            }
+            pf.sk.assign((size_t)pf.nbits * h.rows, 0);
+            pf.e.assign((size_t)pf.nbits * h.cols, 0);
+            pf.acc.assign((size_t)pf.nbits * h.cols, 0);
+            FHE16_RNG_gauss_vec(rng, pf.sk.data(), pf.sk.size(), g_P._sigma_bs);
+            FHE16_RNG_gauss_vec(rng, pf.e.data(),  pf.e.size(),  g_P._sigma_bs);
+        }
+    }
+    if (pf.nbits > 0 && rows - pf.rows_acc >= PK_STREAM_ROW_CHUNK) pk_prefetch_accumulate(rows);
+    return rows;
+}
+
+// 스트림 종료 : 해시 검증 후 PK 설치, 미리 계산한 0 암호문을 풀에 투입. 성공 1, 실패 0
+EMSCRIPTEN_KEEPALIVE
+int FHE16_PK_stream_end() {
+    if (!g_pk_stream.finish()) return 0;
+    const FHE16_PKCompactHeader& h = g_pk_stream.header();
+    PKStreamPrefetch& pf = g_pk_prefetch;
+    if (pf.nbits > 0) pk_prefetch_accumulate((int)h.rows);
+
+    {
+        PoolPause pause;
+        if (g_P._PK_row <= 0) {
+            g_P._PK_row = (int)h.rows;
+            g_P._PK_col = (int)h.cols;
+            g_P._PK_Q   = (int)h.Q;
+        }
+        g_PK.swap(g_pk_stream.pk_mut());
+        refresh_pk_packed();
+    }
+
+    if (pf.nbits > 0) {
+        std::vector<int32_t> zero((size_t)pf.nbits * h.cols);
+        FHE16_ENC_zero_finalize(pf.acc.data(), pf.e.data(), pf.nbits, zero.data());
+        g_pool.push(pf.nbits, zero.data());
+    }
+    g_pk_prefetch = PKStreamPrefetch();
+    g_pk_stream.reset();
+    return 1;
+}
+
+// 헤더의 내용 해시(32B, IndexedDB 캐시 키). 헤더를 아직 못 받았으면 0
+EMSCRIPTEN_KEEPALIVE
+int FHE16_PK_stream_hash(uint8_t* out32) {
+    if (!out32 || !g_pk_stream.header_ready()) return 0;
+    std::memcpy(out32, g_pk_stream.header().hash, 32);
+    return 1;
+}
+
+// 패키징/프리로드된 .fpk 파일에서 PK 로딩 (path 예: "/pk.fpk")
+EMSCRIPTEN_KEEPALIVE
+int FHE16_load_pk_compact_from_fs(const char* path) {
+    if (!path) return 0;
+    FILE* fp = std::fopen(path, "rb");
+    if (!fp) return 0;
+
+    std::fseek(fp, 0, SEEK_END);
+    const long fsz = std::ftell(fp);
+    std::fseek(fp, 0, SEEK_SET);
+    if (fsz <= 0 || fsz > INT_MAX) { std::fclose(fp); return 0; }
+
+    FHE16_PK_stream_begin(0, (int)fsz);
+    std::vector<uint8_t> buf(1 << 16);
+    size_t rd;
+    int ok = 1;
+    while ((rd = std::fread(buf.data(), 1, buf.size(), fp)) > 0) {
+        if (FHE16_PK_stream_push(buf.data(), (int)rd) < 0) { ok = 0; break; }
+    }
+    std::fclose(fp);
+    return ok ? FHE16_PK_stream_end() : 0;
+}
+
+// ===== 0 암호문 풀 =====
+// 풀 용량/refill 시작점 설정 (단위: 비트 암호문). 백그라운드 스레드가 돌면 1,
+// 스레드 없는 빌드면 0 → JS 가 유휴 시간/워커에서 FHE16_POOL_refill 호출
+EMSCRIPTEN_KEEPALIVE
+int FHE16_POOL_start(int target_bits, int low_bits) {
+    return g_pool.start(target_bits, low_bits) ? 1 : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+void FHE16_POOL_stop() { g_pool.stop(); }
+
+// 동기 refill, 생산한 비트 수 반환
+EMSCRIPTEN_KEEPALIVE
+int FHE16_POOL_refill(int max_bits) { return g_pool.refill(max_bits); }
+
+// out[8] = depth, target, low, produced, hits, misses, refill_batches, last_batch_us
+EMSCRIPTEN_KEEPALIVE
+void FHE16_POOL_stats(double* out) {
+    if (!out) return;
+    FHE16_EncPoolStats st;
+    g_pool.stats(&st);
+    out[0] = (double)st.depth_bits;
+    out[1] = (double)st.target_bits;
+    out[2] = (double)st.low_bits;
+    out[3] = (double)st.produced_bits;
+    out[4] = (double)st.hits;
+    out[5] = (double)st.misses;
+    out[6] = (double)st.refill_batches;
+    out[7] = (double)st.last_batch_us;
+}
+
 // free
 EMSCRIPTEN_KEEPALIVE
 void FHE16_free(void* p) { std::free(p); }
@@ -0,0 +1,175 @@
+// fhe16_enc_pool.cpp — 영(0) 암호문 풀 구현 (fhe16_enc_pool.hpp 참고)
+
+#include "fhe16_enc_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+void FHE16_EncPool::configure(int cols, FHE16_ZeroProducer producer) {
+    std::lock_guard<std::mutex> lk(mu_);
+    cols_     = cols;
+    producer_ = producer;
+    ++gen_;
+    head_ = count_ = 0;
+    ring_.assign((size_t)cap_bits_ * (size_t)std::max(cols_, 0), 0);
+}
+
+bool FHE16_EncPool::start(int target_bits, int low_bits) {
+    stop();
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        target_ = std::max(target_bits, BATCH_BITS);
+        low_    = std::min<int64_t>(std::max(low_bits, 0), target_ - BATCH_BITS);
+        // 목표치 + 배치 하나만큼 여유
+        const int64_t cap = target_ + BATCH_BITS;
+        if (cap != cap_bits_) {
+            cap_bits_ = cap;
+            head_ = count_ = 0;
+            ring_.assign((size_t)cap_bits_ * (size_t)std::max(cols_, 0), 0);
+        }
+        stopping_ = false;
+    }
+#if FHE16_POOL_HAS_THREAD
+    worker_ = std::thread(&FHE16_EncPool::worker_loop, this);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void FHE16_EncPool::stop() {
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) worker_.join();
+}
+
+void FHE16_EncPool::clear() {
+    std::lock_guard<std::mutex> lk(mu_);
+    ++gen_;
+    head_ = count_ = 0;
+    cv_.notify_all();
+}
+
+// 배치 하나를 락 밖에서 생산해서 넣는다. 세대가 바뀌었으면 버림
+bool FHE16_EncPool::produce_batch(uint64_t gen) {
+    FHE16_ZeroProducer producer;
+    int cols;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        producer = producer_;
+        cols     = cols_;
+    }
+    if (!producer || cols <= 0) return false;
+
+    std::vector<int32_t> tmp((size_t)BATCH_BITS * cols);
+    const auto t0 = std::chrono::steady_clock::now();
+    if (!producer(BATCH_BITS, tmp.data())) return false;
+    const auto t1 = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lk(mu_);
+    if (gen != gen_ || cols != cols_) return false;
+    if (count_ + BATCH_BITS > cap_bits_) return false;
+
+    for (int b = 0; b < BATCH_BITS; ++b) {
+        const int64_t slot = (head_ + count_) % cap_bits_;
+        std::memcpy(ring_.data() + (size_t)slot * cols, tmp.data() + (size_t)b * cols,
+                    (size_t)cols * sizeof(int32_t));
+        ++count_;
+    }
+    st_.produced_bits  += BATCH_BITS;
+    st_.refill_batches += 1;
+    st_.last_batch_us   = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+    return true;
+}
+
+int FHE16_EncPool::refill(int max_bits) {
+    int produced = 0;
+    while (produced < max_bits) {
+        uint64_t gen;
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            if (cap_bits_ == 0 || count_ + BATCH_BITS > std::max<int64_t>(target_, BATCH_BITS)) break;
+            gen = gen_;
+        }
+        if (!produce_batch(gen)) break;
+        produced += BATCH_BITS;
+    }
+    return produced;
+}
+
+void FHE16_EncPool::worker_loop() {
+    for (;;) {
+        uint64_t gen;
+        {
+            std::unique_lock<std::mutex> lk(mu_);
+            cv_.wait(lk, [&] { return stopping_ || count_ <= low_; });
+            if (stopping_) return;
+            gen = gen_;
+        }
+        // low 아래로 내려갔으면 target 까지 채움
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> lk(mu_);
+                if (stopping_ || gen != gen_ || count_ + BATCH_BITS > target_) break;
+            }
+            if (!produce_batch(gen)) {
+                // PK 미설정 등 : clear()/stop() 이 올 때까지 대기
+                std::unique_lock<std::mutex> lk(mu_);
+                cv_.wait(lk, [&] { return stopping_ || gen != gen_; });
+                break;
+            }
+        }
+    }
+}
+
+int FHE16_EncPool::push(int nbits, const int32_t* src) {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (nbits <= 0 || cols_ <= 0) return 0;
+    if (cap_bits_ == 0) {
+        target_   = std::max(nbits, BATCH_BITS);
+        low_      = 0;
+        cap_bits_ = target_ + BATCH_BITS;
+        head_ = count_ = 0;
+        ring_.assign((size_t)cap_bits_ * cols_, 0);
+    }
+    const int n = (int)std::min<int64_t>(nbits, cap_bits_ - count_);
+    for (int b = 0; b < n; ++b) {
+        const int64_t slot = (head_ + count_) % cap_bits_;
+        std::memcpy(ring_.data() + (size_t)slot * cols_, src + (size_t)b * cols_,
+                    (size_t)cols_ * sizeof(int32_t));
+        ++count_;
+    }
+    st_.produced_bits += n;
+    return n;
+}
+
+bool FHE16_EncPool::take(int nbits, int32_t* out) {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (cap_bits_ == 0) return false;   // 풀 미사용
+    if (nbits <= 0 || count_ < nbits || cols_ <= 0) {
+        st_.misses += 1;
+        cv_.notify_all();
+        return false;
+    }
+    for (int b = 0; b < nbits; ++b) {
+        std::memcpy(out + (size_t)b * cols_, ring_.data() + (size_t)head_ * cols_,
+                    (size_t)cols_ * sizeof(int32_t));
+        head_ = (head_ + 1) % cap_bits_;
+        --count_;
+    }
+    st_.hits += 1;
+    if (count_ <= low_) cv_.notify_all();
+    return true;
+}
+
+void FHE16_EncPool::stats(FHE16_EncPoolStats* st) {
+    std::lock_guard<std::mutex> lk(mu_);
+    *st = st_;
+    st->depth_bits  = count_;
+    st->target_bits = target_;
+    st->low_bits    = low_;
+}
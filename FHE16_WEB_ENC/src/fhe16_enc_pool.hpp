@@ -0,0 +1,88 @@
+// fhe16_enc_pool.hpp — 영(0) 암호문 풀 (오프라인/온라인 분리 암호화)
+//
+// 오프라인: PK 로 만든 "0 의 암호문"(비트 단위, PK_col 워드)을 미리 채워 둔다.
+//           네이티브/pthread 빌드는 백그라운드 스레드, 그 외(wasm 단일 스레드)는
+//           JS 가 유휴 시간/전용 워커에서 refill() 을 호출.
+// 온라인  : 풀에서 bit 개를 꺼내 b 계수에 msg * (BL_Q >> 2) 만 더하면 끝.
+//
+// 항목의 b 계수(마지막 열)는 최종 BL_Q 보정 전의 [0, PK_Q) 값으로 저장한다.
+// (온라인 단계에서 메시지를 더한 뒤 원래 코어와 같은 보정을 적용)
+//
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+  #define FHE16_POOL_HAS_THREAD 1
+#else
+  #define FHE16_POOL_HAS_THREAD 0
+#endif
+
+// 생산자: nbits 개의 0 암호문을 out[nbits * cols] 에 기록. PK 가 없으면 false
+typedef bool (*FHE16_ZeroProducer)(int nbits, int32_t* out);
+
+struct FHE16_EncPoolStats {
+    int64_t depth_bits;        // 현재 보유량
+    int64_t target_bits;       // 목표 보유량
+    int64_t low_bits;          // 이 아래로 내려가면 refill 시작
+    int64_t produced_bits;     // 누적 생산량
+    int64_t hits;              // 풀에서 바로 처리된 요청
+    int64_t misses;            // 부족해서 직접 암호화한 요청
+    int64_t refill_batches;    // 누적 생산 배치 수
+    int64_t last_batch_us;     // 마지막 배치 생산 시간 (us)
+};
+
+class FHE16_EncPool {
+public:
+    static constexpr int BATCH_BITS = 32;   // 생산 단위 (PK 커널 재사용 폭)
+
+    ~FHE16_EncPool() { stop(); }
+
+    // 열 개수/생산자 지정. 기존 항목은 버림
+    void configure(int cols, FHE16_ZeroProducer producer);
+
+    // 백그라운드 refill 시작. 스레드를 쓸 수 없는 빌드면 false (수동 refill)
+    bool start(int target_bits, int low_bits);
+    void stop();
+    bool running() const { return worker_.joinable(); }
+
+    // PK/파라미터 변경 시 호출 : 보유 항목 폐기 (진행 중인 배치도 버려짐)
+    void clear();
+
+    // 동기 refill. 최대 max_bits 만큼 (목표치까지) 생산, 생산한 비트 수 반환
+    int refill(int max_bits);
+
+    // 밖에서 만든 0 암호문 nbits 개를 넣는다 (풀 미사용이면 그만큼 용량 확보). 넣은 비트 수 반환
+    int push(int nbits, const int32_t* src);
+
+    // nbits 개를 꺼내 out[nbits * cols] 에 복사. 부족하면 false (miss 집계)
+    bool take(int nbits, int32_t* out);
+
+    void stats(FHE16_EncPoolStats* st);
+
+private:
+    bool produce_batch(uint64_t gen);
+    void worker_loop();
+
+    std::mutex              mu_;
+    std::condition_variable cv_;
+    std::thread             worker_;
+    bool                    stopping_ = false;
+
+    FHE16_ZeroProducer producer_ = nullptr;
+    int      cols_   = 0;
+    uint64_t gen_    = 0;              // clear() 마다 증가
+
+    std::vector<int32_t> ring_;        // [capacity_bits][cols]
+    int64_t  cap_bits_  = 0;
+    int64_t  head_      = 0;           // 가장 오래된 항목
+    int64_t  count_     = 0;
+    int64_t  target_    = 0;
+    int64_t  low_       = 0;
+
+    FHE16_EncPoolStats st_ = {};
+};
@@ -0,0 +1,217 @@
+// fhe16_pk_compact.cpp — 압축 PK 포맷 구현 (fhe16_pk_compact.hpp 참고)
+
+#include "fhe16_pk_compact.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "fhe16_rng.hpp"
+
+static inline void put_u32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); p[2] = (uint8_t)(v >> 16); p[3] = (uint8_t)(v >> 24);
+}
+static inline uint32_t get_u32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static size_t packed_row_bytes(const FHE16_PKCompactHeader& h) {
+    return ((size_t)(h.cols - h.uniform_cols) * h.bits + 7) / 8;
+}
+
+static void write_header(const FHE16_PKCompactHeader& h, uint8_t* out, bool with_hash) {
+    std::memset(out, 0, FHE16_FPK_HEADER_BYTES);
+    std::memcpy(out, "FPK1", 4);
+    put_u32(out + 4,  FHE16_FPK_VERSION);
+    put_u32(out + 8,  h.rows);
+    put_u32(out + 12, h.cols);
+    put_u32(out + 16, h.Q);
+    put_u32(out + 20, h.bits);
+    put_u32(out + 24, h.uniform_cols);
+    std::memcpy(out + 32, h.seed, 32);
+    if (with_hash) std::memcpy(out + 64, h.hash, 32);
+}
+
+uint64_t FHE16_PK_compact_bytes(const FHE16_PKCompactHeader& h) {
+    return FHE16_FPK_HEADER_BYTES + (uint64_t)h.rows * packed_row_bytes(h);
+}
+
+int FHE16_PK_bits_for_Q(uint32_t Q) {
+    int bits = 1;
+    while (bits < 32 && ((uint64_t)1 << bits) < (uint64_t)Q) ++bits;
+    return bits;
+}
+
+void FHE16_PK_expand_uniform_row(const uint8_t seed[32], int row, int n, uint32_t Q, int32_t* out) {
+    FHE16_RNG rng;
+    FHE16_RNG_seed(&rng, seed, (uint64_t)row);
+    FHE16_RNG_uniform_Q_vec(&rng, out, (size_t)n, Q);
+}
+
+// ===== 인코더 =====
+bool FHE16_PK_compact_encode(const int32_t* pk, int rows, int cols, uint32_t Q,
+                             int uniform_cols, const uint8_t* seed,
+                             std::vector<uint8_t>& out, FHE16_PKCompactHeader* hdr_out) {
+    if (!pk || rows <= 0 || cols <= 0 || Q < 2) return false;
+    if (uniform_cols < 0 || uniform_cols > cols || (uniform_cols > 0 && !seed)) return false;
+
+    FHE16_PKCompactHeader h;
+    h.rows = rows; h.cols = cols; h.Q = Q;
+    h.bits = FHE16_PK_bits_for_Q(Q);
+    h.uniform_cols = uniform_cols;
+    if (seed) std::memcpy(h.seed, seed, 32);
+
+    const size_t rb = packed_row_bytes(h);
+    out.assign(FHE16_FPK_HEADER_BYTES + rb * rows, 0);
+
+    std::vector<int32_t> a(uniform_cols);
+    for (int r = 0; r < rows; ++r) {
+        const int32_t* row = pk + (size_t)r * cols;
+        for (int c = 0; c < cols; ++c)
+            if (row[c] < 0 || (uint32_t)row[c] >= Q) return false;
+
+        if (uniform_cols > 0) {
+            FHE16_PK_expand_uniform_row(h.seed, r, uniform_cols, Q, a.data());
+            if (std::memcmp(a.data(), row, (size_t)uniform_cols * sizeof(int32_t)) != 0) return false;
+        }
+
+        uint8_t* dst = out.data() + FHE16_FPK_HEADER_BYTES + rb * r;
+        uint64_t acc = 0; int nacc = 0; size_t k = 0;
+        for (int c = uniform_cols; c < cols; ++c) {
+            acc |= (uint64_t)(uint32_t)row[c] << nacc;
+            nacc += h.bits;
+            while (nacc >= 8) { dst[k++] = (uint8_t)acc; acc >>= 8; nacc -= 8; }
+        }
+        if (nacc > 0) dst[k++] = (uint8_t)acc;
+    }
+
+    write_header(h, out.data(), false);
+    FHE16_SHA256 sha;
+    FHE16_SHA256_init(&sha);
+    FHE16_SHA256_update(&sha, out.data(), out.size());
+    FHE16_SHA256_final(&sha, h.hash);
+    std::memcpy(out.data() + 64, h.hash, 32);
+
+    if (hdr_out) *hdr_out = h;
+    return true;
+}
+
+// ===== 스트리밍 디코더 =====
+void FHE16_PKStreamDecoder::reset() {
+    hdr_ = FHE16_PKCompactHeader();
+    want_ = FHE16_PKCompactHeader();
+    want_bytes_ = 0;
+    FHE16_SHA256_init(&sha_);
+    pending_.clear();
+    pk_.clear(); pk_.shrink_to_fit();
+    row_bytes_ = 0;
+    rows_done_ = 0;
+    have_header_ = false;
+    failed_ = false;
+}
+
+void FHE16_PKStreamDecoder::expect(uint32_t rows, uint32_t cols, uint32_t Q, uint64_t total_bytes) {
+    want_.rows = rows;
+    want_.cols = cols;
+    want_.Q    = Q;
+    want_bytes_ = total_bytes;
+}
+
+bool FHE16_PKStreamDecoder::parse_header(const uint8_t* p) {
+    if (std::memcmp(p, "FPK1", 4) != 0 || get_u32(p + 4) != FHE16_FPK_VERSION) return false;
+    hdr_.rows         = get_u32(p + 8);
+    hdr_.cols         = get_u32(p + 12);
+    hdr_.Q            = get_u32(p + 16);
+    hdr_.bits         = get_u32(p + 20);
+    hdr_.uniform_cols = get_u32(p + 24);
+    std::memcpy(hdr_.seed, p + 32, 32);
+    std::memcpy(hdr_.hash, p + 64, 32);
+
+    if (get_u32(p + 28) != 0) return false;
+    if (hdr_.rows == 0 || hdr_.cols == 0 || hdr_.Q < 2 || hdr_.Q > (uint32_t)INT32_MAX) return false;
+    if ((uint64_t)hdr_.rows * hdr_.cols > FHE16_FPK_MAX_WORDS) return false;
+    if (hdr_.bits != (uint32_t)FHE16_PK_bits_for_Q(hdr_.Q) || hdr_.uniform_cols > hdr_.cols) return false;
+
+    // 파라미터 세트 / 받을 길이와 맞는지 (PK 버퍼 할당 전)
+    if (want_.rows && hdr_.rows != want_.rows) return false;
+    if (want_.cols && hdr_.cols != want_.cols) return false;
+    if (want_.Q && hdr_.Q != want_.Q) return false;
+    if (want_bytes_ && FHE16_PK_compact_bytes(hdr_) != want_bytes_) return false;
+
+    uint8_t zeroed[FHE16_FPK_HEADER_BYTES];
+    std::memcpy(zeroed, p, FHE16_FPK_HEADER_BYTES);
+    std::memset(zeroed + 64, 0, 32);
+    FHE16_SHA256_update(&sha_, zeroed, sizeof(zeroed));
+
+    row_bytes_ = packed_row_bytes(hdr_);
+    pk_.assign((size_t)hdr_.rows * hdr_.cols, 0);
+    return true;
+}
+
+bool FHE16_PKStreamDecoder::decode_row(const uint8_t* src, int row) {
+    int32_t* dst = pk_.data() + (size_t)row * hdr_.cols;
+    const int U = (int)hdr_.uniform_cols;
+    if (U > 0) FHE16_PK_expand_uniform_row(hdr_.seed, row, U, hdr_.Q, dst);
+
+    const uint64_t mask = ((uint64_t)1 << hdr_.bits) - 1;
+    uint64_t acc = 0; int nacc = 0; size_t k = 0;
+    for (int c = U; c < (int)hdr_.cols; ++c) {
+        while (nacc < (int)hdr_.bits) { acc |= (uint64_t)src[k++] << nacc; nacc += 8; }
+        const uint64_t v = acc & mask;
+        if (v >= hdr_.Q) return false;   // bits 비트에는 [Q, 2^bits) 도 들어간다   // bits 비트에는 [Q, 2^bits) 도 들어간다
+        dst[c] = (int32_t)v;
+        acc >>= hdr_.bits;
+        nacc -= hdr_.bits;
+    }
+    return true;
+}
+
+int FHE16_PKStreamDecoder::push(const uint8_t* data, size_t len) {
+    if (failed_) return -1;
+
+    if (!have_header_) {
+        const size_t need = FHE16_FPK_HEADER_BYTES - pending_.size();
+        const size_t take = std::min(need, len);
+        pending_.insert(pending_.end(), data, data + take);
+        data += take; len -= take;
+        if (pending_.size() < FHE16_FPK_HEADER_BYTES) return 0;
+        if (!parse_header(pending_.data())) { failed_ = true; return -1; }
+        have_header_ = true;
+        pending_.clear();
+        // 전부 시드 모드면 payload 없이 바로 복원
+        if (row_bytes_ == 0) while (rows_done_ < (int)hdr_.rows) decode_row(nullptr, rows_done_++);
+    }
+
+    if (len == 0) return rows_done_;
+    FHE16_SHA256_update(&sha_, data, len);
+
+    // 앞 조각 + 새 데이터로 행 완성
+    if (!pending_.empty()) {
+        const size_t take = std::min(row_bytes_ - pending_.size(), len);
+        pending_.insert(pending_.end(), data, data + take);
+        data += take; len -= take;
+        if (pending_.size() == row_bytes_ && rows_done_ < (int)hdr_.rows) {
+            if (!decode_row(pending_.data(), rows_done_)) { failed_ = true; return -1; }
+            ++rows_done_;
+            pending_.clear();
+        }
+    }
+    while (len >= row_bytes_ && rows_done_ < (int)hdr_.rows) {
+        if (!decode_row(data, rows_done_)) { failed_ = true; return -1; }
+        ++rows_done_;
+        data += row_bytes_; len -= row_bytes_;
+    }
+    if (rows_done_ == (int)hdr_.rows) {
+        if (len > 0) { failed_ = true; return -1; }   // 뒤에 남는 데이터
+    } else if (len > 0) {
+        pending_.insert(pending_.end(), data, data + len);
+    }
+    return rows_done_;
+}
+
+bool FHE16_PKStreamDecoder::finish() {
+    if (failed_ || !have_header_ || rows_done_ != (int)hdr_.rows || !pending_.empty()) return false;
+    uint8_t h[32];
+    FHE16_SHA256_final(&sha_, h);
+    if (std::memcmp(h, hdr_.hash, 32) != 0) { failed_ = true; return false; }
+    return true;
+}
@@ -0,0 +1,95 @@
+// fhe16_pk_compact.hpp — 압축 PK 포맷 (.fpk) 과 스트리밍 디코더
+//
+// pk.bin (PK_row * PK_col 개 int32) 대신 브라우저로 보내는 압축 포맷.
+//  - 각 행의 앞 uniform_cols 개는 시드에서 재생성 (ChaCha20, 행 번호 = stream id)
+//  - 나머지는 ceil(log2 Q) 비트로 bit-pack (LSB 먼저, 행마다 바이트 정렬)
+//  - 헤더의 hash = SHA-256(해시 칸을 0 으로 채운 헤더 || payload) → IndexedDB 캐시 키
+//
+// 레이아웃 (little endian)
+//   0  "FPK1"            4  u32 version(=1)
+//   8  u32 rows          12 u32 cols
+//   16 u32 Q             20 u32 bits
+//   24 u32 uniform_cols  28 u32 reserved(=0)
+//   32 u8 seed[32]       64 u8 hash[32]
+//   96 payload : rows x ceil((cols - uniform_cols) * bits / 8) 바이트
+//
+// 시드 모드는 키 생성 쪽이 FHE16_PK_expand_uniform_row 로 A 부분을 만들었을 때만 쓸 수 있다.
+// 기존 pk.bin 은 uniform_cols = 0 (전체 bit-pack) 으로 변환.
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "fhe16_sha256.hpp"
+
+#define FHE16_FPK_HEADER_BYTES 96
+#define FHE16_FPK_VERSION      1
+#define FHE16_FPK_MAX_WORDS    (1u << 24)   // rows * cols 상한 (64 MiB, 배포 PK 1024 x 1025 의 16 배)
+
+struct FHE16_PKCompactHeader {
+    uint32_t rows         = 0;
+    uint32_t cols         = 0;
+    uint32_t Q            = 0;
+    uint32_t bits         = 0;
+    uint32_t uniform_cols = 0;
+    uint8_t  seed[32]     = {};
+    uint8_t  hash[32]     = {};
+};
+
+// [0, Q) 를 담는 최소 비트 수
+int FHE16_PK_bits_for_Q(uint32_t Q);
+
+// 헤더 + payload 전체 바이트 수
+uint64_t FHE16_PK_compact_bytes(const FHE16_PKCompactHeader& h);
+
+// 시드 모드의 한 행 A 부분 (n 개, [0, Q) 균등)
+void FHE16_PK_expand_uniform_row(const uint8_t seed[32], int row, int n, uint32_t Q, int32_t* out);
+
+// PK → .fpk. seed 가 nullptr 이면 uniform_cols 는 0 이어야 함.
+// 시드 모드에서 A 부분이 시드 확장과 다르거나 값이 [0, Q) 밖이면 false
+bool FHE16_PK_compact_encode(const int32_t* pk, int rows, int cols, uint32_t Q,
+                             int uniform_cols, const uint8_t* seed,
+                             std::vector<uint8_t>& out, FHE16_PKCompactHeader* hdr_out);
+
+// 스트리밍 디코더 : 받은 만큼 push, 행 단위로 즉시 복원
+class FHE16_PKStreamDecoder {
+public:
+    void reset();
+
+    // 헤더 검사 기준 (reset 뒤, 첫 push 전에). 0 인 값은 검사하지 않음.
+    // 헤더의 rows / cols / Q 가 파라미터 세트와, 헤더로 계산한 전체 길이가 total_bytes 와 다르면
+    // PK 버퍼를 잡기 전에 실패한다.
+    void expect(uint32_t rows, uint32_t cols, uint32_t Q, uint64_t total_bytes);
+
+    // 반환: 지금까지 복원된 행 수, 포맷 오류 (계수 >= Q 포함) 시 -1
+    int push(const uint8_t* data, size_t len);
+
+    bool header_ready() const { return have_header_; }
+    const FHE16_PKCompactHeader& header() const { return hdr_; }
+    int rows_done() const { return rows_done_; }
+    bool failed() const { return failed_; }
+
+    // 복원된 PK (row-major, rows_done() 행까지 유효)
+    const int32_t* pk() const { return pk_.data(); }
+    std::vector<int32_t>& pk_mut() { return pk_; }
+
+    // 모든 행을 받았고 해시가 헤더와 같으면 true
+    bool finish();
+
+private:
+    bool parse_header(const uint8_t* h);
+    bool decode_row(const uint8_t* src, int row);
+
+    FHE16_PKCompactHeader hdr_;
+    FHE16_PKCompactHeader want_;       // expect() 기준 (rows / cols / Q)
+    uint64_t want_bytes_ = 0;
+    FHE16_SHA256 sha_;
+    std::vector<uint8_t> pending_;     // 헤더/행 조각
+    std::vector<int32_t> pk_;
+    size_t row_bytes_   = 0;
+    int    rows_done_   = 0;
+    bool   have_header_ = false;
+    bool   failed_      = false;
+};
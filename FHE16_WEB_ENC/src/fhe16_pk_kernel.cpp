@@ -0,0 +1,230 @@
+// fhe16_pk_kernel.cpp — PK 암호화 행렬곱 커널 구현 (fhe16_pk_kernel.hpp 참고)
+
+#include "fhe16_pk_kernel.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__AVX2__) || defined(__AVX512BW__)
+  #include <immintrin.h>
+#elif defined(__SSE2__)
+  #include <emmintrin.h>
+#elif defined(__wasm_simd128__)
+  #include <wasm_simd128.h>
+#endif
+
+#define FHE16_PK_SPLIT     14     // PK = hi << 14 | lo
+#define FHE16_PK_RC_PAIRS  128    // 256행마다 int32 누적값을 int64 로 내보냄
+#define FHE16_PK_MB        4      // 마이크로커널 한 번에 처리하는 비트 수
+#define FHE16_PK_COL_ALIGN 64
+#define FHE16_PK_SK_MAX    511    // 256 * (2^14-1) * 511 < 2^31
+
+// ===== 벡터 추상화 : madd = 인접 int16 쌍의 곱을 더해 int32 로 =====
+struct PKVecScalar {
+    typedef int32_t T;
+    enum { L = 1 };
+    static inline T zero()                         { return 0; }
+    static inline T load(const int32_t* p)         { return *p; }
+    static inline void store(int32_t* p, T v)      { *p = v; }
+    static inline T splat(int32_t v)               { return v; }
+    static inline T add(T a, T b)                  { return a + b; }
+    static inline T madd(T a, T b) {
+        return (int32_t)(int16_t)(a & 0xFFFF) * (int32_t)(int16_t)(b & 0xFFFF)
+             + (a >> 16) * (b >> 16);
+    }
+};
+
+#if defined(__AVX512BW__)
+struct PKVecAVX512 {
+    typedef __m512i T;
+    enum { L = 16 };
+    static inline T zero()                         { return _mm512_setzero_si512(); }
+    static inline T load(const int32_t* p)         { return _mm512_loadu_si512((const void*)p); }
+    static inline void store(int32_t* p, T v)      { _mm512_storeu_si512((void*)p, v); }
+    static inline T splat(int32_t v)               { return _mm512_set1_epi32(v); }
+    static inline T add(T a, T b)                  { return _mm512_add_epi32(a, b); }
+    static inline T madd(T a, T b)                 { return _mm512_madd_epi16(a, b); }
+};
+typedef PKVecAVX512 PKVecBest;
+#elif defined(__AVX2__)
+struct PKVecAVX2 {
+    typedef __m256i T;
+    enum { L = 8 };
+    static inline T zero()                         { return _mm256_setzero_si256(); }
+    static inline T load(const int32_t* p)         { return _mm256_loadu_si256((const __m256i*)p); }
+    static inline void store(int32_t* p, T v)      { _mm256_storeu_si256((__m256i*)p, v); }
+    static inline T splat(int32_t v)               { return _mm256_set1_epi32(v); }
+    static inline T add(T a, T b)                  { return _mm256_add_epi32(a, b); }
+    static inline T madd(T a, T b)                 { return _mm256_madd_epi16(a, b); }
+};
+typedef PKVecAVX2 PKVecBest;
+#elif defined(__SSE2__)
+struct PKVecSSE2 {
+    typedef __m128i T;
+    enum { L = 4 };
+    static inline T zero()                         { return _mm_setzero_si128(); }
+    static inline T load(const int32_t* p)         { return _mm_loadu_si128((const __m128i*)p); }
+    static inline void store(int32_t* p, T v)      { _mm_storeu_si128((__m128i*)p, v); }
+    static inline T splat(int32_t v)               { return _mm_set1_epi32(v); }
+    static inline T add(T a, T b)                  { return _mm_add_epi32(a, b); }
+    static inline T madd(T a, T b)                 { return _mm_madd_epi16(a, b); }
+};
+typedef PKVecSSE2 PKVecBest;
+#elif defined(__wasm_simd128__)
+struct PKVecWasm128 {
+    typedef v128_t T;
+    enum { L = 4 };
+    static inline T zero()                         { return wasm_i32x4_splat(0); }
+    static inline T load(const int32_t* p)         { return wasm_v128_load(p); }
+    static inline void store(int32_t* p, T v)      { wasm_v128_store(p, v); }
+    static inline T splat(int32_t v)               { return wasm_i32x4_splat(v); }
+    static inline T add(T a, T b)                  { return wasm_i32x4_add(a, b); }
+    static inline T madd(T a, T b)                 { return wasm_i32x4_dot_i16x8(a, b); }
+};
+typedef PKVecWasm128 PKVecBest;
+#else
+typedef PKVecScalar PKVecBest;
+#endif
+
+static inline int32_t pack_i16_pair(int32_t a, int32_t b) {
+    return (int32_t)((uint32_t)(uint16_t)(int16_t)a | ((uint32_t)(uint16_t)(int16_t)b << 16));
+}
+
+// ===== PK 변환 =====
+void FHE16_PK_pack(const int32_t* pk, int rows, int cols, FHE16_PKPacked* out) {
+    out->rows = rows;
+    out->cols = cols;
+    out->fast = false;
+    out->lo.clear(); out->lo.shrink_to_fit();
+    out->hi.clear(); out->hi.shrink_to_fit();
+    if (!pk || rows <= 0 || cols <= 0) return;
+
+    const int32_t LIMIT = (int32_t)1 << (2 * FHE16_PK_SPLIT);
+    for (size_t i = 0; i < (size_t)rows * (size_t)cols; ++i)
+        if (pk[i] < 0 || pk[i] >= LIMIT) return;   // 참조 경로만 사용
+
+    out->pairs    = (rows + 1) / 2;
+    out->cols_pad = (cols + FHE16_PK_COL_ALIGN - 1) / FHE16_PK_COL_ALIGN * FHE16_PK_COL_ALIGN;
+    out->lo.assign((size_t)out->pairs * out->cols_pad, 0);
+    out->hi.assign((size_t)out->pairs * out->cols_pad, 0);
+
+    const int32_t MASK = (1 << FHE16_PK_SPLIT) - 1;
+    for (int p = 0; p < out->pairs; ++p) {
+        const int32_t* r0 = pk + (size_t)(2 * p) * cols;
+        const int32_t* r1 = (2 * p + 1 < rows) ? r0 + cols : nullptr;
+        int32_t* dlo = out->lo.data() + (size_t)p * out->cols_pad;
+        int32_t* dhi = out->hi.data() + (size_t)p * out->cols_pad;
+        for (int c = 0; c < cols; ++c) {
+            const int32_t a = r0[c];
+            const int32_t b = r1 ? r1[c] : 0;
+            dlo[c] = pack_i16_pair(a & MASK, b & MASK);
+            dhi[c] = pack_i16_pair(a >> FHE16_PK_SPLIT, b >> FHE16_PK_SPLIT);
+        }
+    }
+    out->fast = true;
+}
+
+// ===== 마이크로커널 : MB 비트 x L 열, np 행쌍 =====
+template <class V>
+static inline void pk_micro(const int32_t* lo, const int32_t* hi, int ld, int np,
+                            const int32_t* skp, int ldsk,
+                            int32_t* olo, int32_t* ohi) {
+    typedef typename V::T T;
+    T alo[FHE16_PK_MB], ahi[FHE16_PK_MB];
+    for (int b = 0; b < FHE16_PK_MB; ++b) { alo[b] = V::zero(); ahi[b] = V::zero(); }
+
+    for (int p = 0; p < np; ++p) {
+        const T l = V::load(lo + (size_t)p * ld);
+        const T h = V::load(hi + (size_t)p * ld);
+        for (int b = 0; b < FHE16_PK_MB; ++b) {
+            const T s = V::splat(skp[(size_t)b * ldsk + p]);
+            alo[b] = V::add(alo[b], V::madd(l, s));
+            ahi[b] = V::add(ahi[b], V::madd(h, s));
+        }
+    }
+    for (int b = 0; b < FHE16_PK_MB; ++b) {
+        V::store(olo + b * V::L, alo[b]);
+        V::store(ohi + b * V::L, ahi[b]);
+    }
+}
+
+template <class V>
+static void pk_matmul_fast(const FHE16_PKPacked* P, const int32_t* sk, int nbit,
+                           int64_t* C, int ldc, int c_begin, int c_end) {
+    const int rows  = P->rows;
+    const int pairs = P->pairs;
+    const int nb    = (nbit + FHE16_PK_MB - 1) / FHE16_PK_MB * FHE16_PK_MB;
+
+    // SK 를 int16 쌍으로 (남는 비트/행은 0)
+    std::vector<int32_t> skp((size_t)nb * pairs, 0);
+    for (int b = 0; b < nbit; ++b) {
+        const int32_t* s = sk + (size_t)b * rows;
+        for (int p = 0; p < pairs; ++p) {
+            const int32_t s1 = (2 * p + 1 < rows) ? s[2 * p + 1] : 0;
+            skp[(size_t)b * pairs + p] = pack_i16_pair(s[2 * p], s1);
+        }
+    }
+
+    alignas(64) int32_t tlo[FHE16_PK_MB * V::L];
+    alignas(64) int32_t thi[FHE16_PK_MB * V::L];
+    const int ct_begin = c_begin / V::L * V::L;
+
+    for (int p0 = 0; p0 < pairs; p0 += FHE16_PK_RC_PAIRS) {
+        const int np = std::min(FHE16_PK_RC_PAIRS, pairs - p0);
+        const int32_t* lo = P->lo.data() + (size_t)p0 * P->cols_pad;
+        const int32_t* hi = P->hi.data() + (size_t)p0 * P->cols_pad;
+
+        for (int ct = ct_begin; ct < c_end; ct += V::L) {
+            // 이 PK 타일(np 행쌍 x L 열)은 모든 비트 묶음에서 L1 재사용
+            for (int b0 = 0; b0 < nb; b0 += FHE16_PK_MB) {
+                pk_micro<V>(lo + ct, hi + ct, P->cols_pad, np,
+                            skp.data() + (size_t)b0 * pairs + p0, pairs, tlo, thi);
+
+                const int bmax = std::min(FHE16_PK_MB, nbit - b0);
+                for (int b = 0; b < bmax; ++b) {
+                    int64_t* crow = C + (size_t)(b0 + b) * ldc;
+                    for (int l = 0; l < V::L; ++l) {
+                        const int c = ct + l;
+                        if (c < c_begin || c >= c_end) continue;
+                        crow[c] += (int64_t)tlo[b * V::L + l]
+                                 + ((int64_t)thi[b * V::L + l] << FHE16_PK_SPLIT);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// 참조 경로 : 행 단위로 PK 한 줄을 모든 비트에 재사용
+static void pk_matmul_ref(const int32_t* pk, int rows, int cols, const int32_t* sk, int nbit,
+                          int64_t* C, int ldc, int c_begin, int c_end) {
+    for (int r = 0; r < rows; ++r) {
+        const int32_t* prow = pk + (size_t)r * cols;
+        for (int b = 0; b < nbit; ++b) {
+            const int64_t s = sk[(size_t)b * rows + r];
+            int64_t* crow = C + (size_t)b * ldc;
+            for (int c = c_begin; c < c_end; ++c) crow[c] += (int64_t)prow[c] * s;
+        }
+    }
+}
+
+void FHE16_PK_matmul(const FHE16_PKPacked* P, const int32_t* pk, int rows, int cols,
+                     const int32_t* sk, int nbit,
+                     int64_t* C, int ldc, int c_begin, int c_end) {
+    c_begin = std::max(c_begin, 0);
+    c_end   = std::min(c_end, cols);
+    if (nbit <= 0 || c_begin >= c_end) return;
+
+    for (int b = 0; b < nbit; ++b)
+        std::memset(C + (size_t)b * ldc + c_begin, 0, (size_t)(c_end - c_begin) * sizeof(int64_t));
+
+    bool fast = P && P->fast && P->rows == rows && P->cols == cols;
+    if (fast) {
+        for (size_t i = 0; i < (size_t)nbit * rows; ++i)
+            if (std::abs(sk[i]) > FHE16_PK_SK_MAX) { fast = false; break; }
+    }
+
+    if (fast) pk_matmul_fast<PKVecBest>(P, sk, nbit, C, ldc, c_begin, c_end);
+    else      pk_matmul_ref(pk, rows, cols, sk, nbit, C, ldc, c_begin, c_end);
+}
@@ -0,0 +1,42 @@
+// fhe16_pk_kernel.hpp — PK 암호화 행렬곱 커널
+//
+//   C[bit][col] = sum_row SK[bit][row] * PK[row][col]      (int64 누적)
+//
+// 비트마다 PK 전체를 한 번씩 훑던 방식 대신 (bit x PK_row)·(PK_row x PK_col)
+// 하나의 행렬곱으로 계산한다. PK 타일(행 묶음 x SIMD 폭)을 L1 에 올려 두고
+// 모든 비트(32개)에 재사용한다.
+//
+// 빠른 경로 (0 <= PK < 2^28, |SK| <= 511):
+//   PK = hi * 2^14 + lo  (lo, hi < 2^14) 로 쪼개고, 인접 두 행을 int16 쌍으로 묶어
+//   madd(int16 x int16 -> int32 쌍합) 으로 누적. 256행마다 int64 로 내보냄.
+//     AVX-512BW : _mm512_madd_epi16
+//     AVX2      : _mm256_madd_epi16
+//     SSE2      : _mm_madd_epi16
+//     wasm SIMD : wasm_i32x4_dot_i16x8
+//     그 외     : 스칼라 동일 연산
+// 그 밖의 경우 int64 참조 경로(행 단위, 비트 내부 루프)로 계산.
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct FHE16_PKPacked {
+    int rows     = 0;
+    int cols     = 0;
+    int pairs    = 0;                 // ceil(rows / 2)
+    int cols_pad = 0;                 // 64 의 배수
+    bool fast    = false;             // 빠른 경로 사용 가능 여부
+    std::vector<int32_t> lo;          // [pairs][cols_pad], (lo(2p,c) | lo(2p+1,c) << 16)
+    std::vector<int32_t> hi;          // [pairs][cols_pad], (hi(2p,c) | hi(2p+1,c) << 16)
+};
+
+// PK(row-major) 를 커널용 배치로 변환. 범위를 벗어나면 fast = false
+void FHE16_PK_pack(const int32_t* pk, int rows, int cols, FHE16_PKPacked* out);
+
+// C[b*ldc + c] = sum_r sk[b*rows + r] * pk[r*cols + c],  b < nbit,  c in [c_begin, c_end)
+// pk 는 원본(row-major), P 는 FHE16_PK_pack 결과 (없으면 nullptr → 참조 경로)
+void FHE16_PK_matmul(const FHE16_PKPacked* P, const int32_t* pk, int rows, int cols,
+                     const int32_t* sk, int nbit,
+                     int64_t* C, int ldc, int c_begin, int c_end);
@@ -0,0 +1,244 @@
+// fhe16_rng.cpp — ChaCha20 난수 스트림 구현 (fhe16_rng.hpp 참고)
+
+#include "fhe16_rng.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+#if defined(__linux__) || defined(__EMSCRIPTEN__) || defined(__APPLE__)
+  #include <unistd.h>
+  #include <sys/random.h>
+  #define FHE16_HAVE_GETENTROPY 1
+#endif
+
+#if defined(__AVX2__)
+  #include <immintrin.h>
+#elif defined(__wasm_simd128__)
+  #include <wasm_simd128.h>
+#endif
+
+// ===== 벡터 추상화 (L 개 블록을 레인별로 병렬 처리) =====
+struct VecScalar {
+    typedef uint32_t T;
+    enum { L = 1 };
+    static inline T splat(uint32_t v)            { return v; }
+    static inline T load(const uint32_t* p)      { return *p; }
+    static inline void store(uint32_t* p, T v)   { *p = v; }
+    static inline T add(T a, T b)                { return a + b; }
+    static inline T xor_(T a, T b)               { return a ^ b; }
+    template <int R> static inline T rotl(T x)   { return (x << R) | (x >> (32 - R)); }
+};
+
+#if defined(__AVX2__)
+struct VecAVX2 {
+    typedef __m256i T;
+    enum { L = 8 };
+    static inline T splat(uint32_t v)            { return _mm256_set1_epi32((int)v); }
+    static inline T load(const uint32_t* p)      { return _mm256_loadu_si256((const __m256i*)p); }
+    static inline void store(uint32_t* p, T v)   { _mm256_storeu_si256((__m256i*)p, v); }
+    static inline T add(T a, T b)                { return _mm256_add_epi32(a, b); }
+    static inline T xor_(T a, T b)               { return _mm256_xor_si256(a, b); }
+    template <int R> static inline T rotl(T x) {
+        return _mm256_or_si256(_mm256_slli_epi32(x, R), _mm256_srli_epi32(x, 32 - R));
+    }
+};
+typedef VecAVX2 VecBest;
+#elif defined(__wasm_simd128__)
+struct VecWasm128 {
+    typedef v128_t T;
+    enum { L = 4 };
+    static inline T splat(uint32_t v)            { return wasm_i32x4_splat((int32_t)v); }
+    static inline T load(const uint32_t* p)      { return wasm_v128_load(p); }
+    static inline void store(uint32_t* p, T v)   { wasm_v128_store(p, v); }
+    static inline T add(T a, T b)                { return wasm_i32x4_add(a, b); }
+    static inline T xor_(T a, T b)               { return wasm_v128_xor(a, b); }
+    template <int R> static inline T rotl(T x) {
+        return wasm_v128_or(wasm_i32x4_shl(x, R), wasm_u32x4_shr(x, 32 - R));
+    }
+};
+typedef VecWasm128 VecBest;
+#else
+typedef VecScalar VecBest;
+#endif
+
+#define FHE16_CHACHA_QR(V, a, b, c, d)                                   \
+    a = V::add(a, b); d = V::template rotl<16>(V::xor_(d, a));           \
+    c = V::add(c, d); b = V::template rotl<12>(V::xor_(b, c));           \
+    a = V::add(a, b); d = V::template rotl<8>(V::xor_(d, a));            \
+    c = V::add(c, d); b = V::template rotl<7>(V::xor_(b, c));
+
+// 블록 ctr .. ctr+L-1 을 생성, out 에 블록 순서대로 16워드씩 기록
+template <class V>
+static inline void chacha20_blocks(const FHE16_RNG* rng, uint64_t ctr, uint32_t* out) {
+    typedef typename V::T T;
+    static const uint32_t SIGMA[4] = { 0x61707865u, 0x3320646eu, 0x79622d32u, 0x6b206574u };
+
+    uint32_t lo[V::L], hi[V::L];
+    for (int l = 0; l < V::L; ++l) {
+        lo[l] = (uint32_t)(ctr + (uint64_t)l);
+        hi[l] = (uint32_t)((ctr + (uint64_t)l) >> 32);
+    }
+
+    T s[16], x[16];
+    for (int i = 0; i < 4; ++i) s[i]     = V::splat(SIGMA[i]);
+    for (int i = 0; i < 8; ++i) s[4 + i] = V::splat(rng->key[i]);
+    s[12] = V::load(lo);
+    s[13] = V::load(hi);
+    s[14] = V::splat(rng->nonce[0]);
+    s[15] = V::splat(rng->nonce[1]);
+    for (int i = 0; i < 16; ++i) x[i] = s[i];
+
+    for (int r = 0; r < 10; ++r) {
+        FHE16_CHACHA_QR(V, x[0], x[4], x[8],  x[12]);
+        FHE16_CHACHA_QR(V, x[1], x[5], x[9],  x[13]);
+        FHE16_CHACHA_QR(V, x[2], x[6], x[10], x[14]);
+        FHE16_CHACHA_QR(V, x[3], x[7], x[11], x[15]);
+        FHE16_CHACHA_QR(V, x[0], x[5], x[10], x[15]);
+        FHE16_CHACHA_QR(V, x[1], x[6], x[11], x[12]);
+        FHE16_CHACHA_QR(V, x[2], x[7], x[8],  x[13]);
+        FHE16_CHACHA_QR(V, x[3], x[4], x[9],  x[14]);
+    }
+
+    if (V::L == 1) {
+        for (int i = 0; i < 16; ++i) V::store(out + i, V::add(x[i], s[i]));
+        return;
+    }
+    // 레인 → 블록 순서로 전치 (경로와 무관하게 같은 스트림이 나오도록)
+    alignas(64) uint32_t tmp[16 * V::L];
+    for (int i = 0; i < 16; ++i) V::store(tmp + i * V::L, V::add(x[i], s[i]));
+    for (int l = 0; l < V::L; ++l)
+        for (int i = 0; i < 16; ++i)
+            out[l * 16 + i] = tmp[i * V::L + l];
+}
+
+// FHE16_RNG_BUF_BLOCKS 개 블록을 out 에 생성
+static void generate_buf_blocks(FHE16_RNG* rng, uint32_t* out) {
+    for (int b = 0; b < FHE16_RNG_BUF_BLOCKS; b += VecBest::L)
+        chacha20_blocks<VecBest>(rng, rng->counter + (uint64_t)b, out + b * FHE16_RNG_BLOCK_WORDS);
+    rng->counter += FHE16_RNG_BUF_BLOCKS;
+}
+
+static inline uint32_t load_le32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// ===== 시딩 =====
+void FHE16_RNG_seed(FHE16_RNG* rng, const uint8_t seed[32], uint64_t stream_id) {
+    for (int i = 0; i < 8; ++i) rng->key[i] = load_le32(seed + 4 * i);
+    rng->nonce[0] = (uint32_t)stream_id;
+    rng->nonce[1] = (uint32_t)(stream_id >> 32);
+    rng->counter  = 0;
+    rng->pos      = FHE16_RNG_BUF_WORDS;
+    rng->seeded   = 1;
+}
+
+static int os_entropy(uint8_t* p, size_t n) {
+#ifdef FHE16_HAVE_GETENTROPY
+    if (getentropy(p, n) == 0) return 1;   // n <= 256
+#endif
+    // fallback: random_device (emscripten 에서는 crypto.getRandomValues)
+    try {
+        std::random_device rd;
+        for (size_t i = 0; i < n; i += 4) {
+            const uint32_t v = rd();
+            std::memcpy(p + i, &v, std::min<size_t>(4, n - i));
+        }
+        return 1;
+    } catch (...) {
+        return 0;
+    }
+}
+
+int FHE16_RNG_seed_os(FHE16_RNG* rng) {
+    uint8_t seed[40];
+    if (!os_entropy(seed, sizeof(seed))) { rng->seeded = 0; return 0; }
+    uint64_t stream_id;
+    std::memcpy(&stream_id, seed + 32, sizeof(stream_id));
+    FHE16_RNG_seed(rng, seed, stream_id);
+    std::memset(seed, 0, sizeof(seed));
+    return 1;
+}
+
+// 시딩에 실패하면 nullptr (키 0 스트림을 쓰면 SK/노이즈가 누구나 재현 가능해진다). 다음 호출에서 다시 시도
+FHE16_RNG* FHE16_RNG_thread() {
+    static thread_local FHE16_RNG t_rng = {};
+    if (!t_rng.seeded && !FHE16_RNG_seed_os(&t_rng)) return nullptr;
+    return &t_rng;
+}
+
+// ===== 원시 워드 =====
+void FHE16_RNG_u32(FHE16_RNG* rng, uint32_t* out, size_t n) {
+    while (n > 0) {
+        if (rng->pos == FHE16_RNG_BUF_WORDS) {
+            // 큰 요청은 버퍼를 거치지 않고 바로 생성
+            if (n >= FHE16_RNG_BUF_WORDS) {
+                generate_buf_blocks(rng, out);
+                out += FHE16_RNG_BUF_WORDS;
+                n   -= FHE16_RNG_BUF_WORDS;
+                continue;
+            }
+            generate_buf_blocks(rng, rng->buf);
+            rng->pos = 0;
+        }
+        const size_t take = std::min(n, (size_t)FHE16_RNG_BUF_WORDS - rng->pos);
+        std::memcpy(out, rng->buf + rng->pos, take * sizeof(uint32_t));
+        rng->pos += take;
+        out      += take;
+        n        -= take;
+    }
+}
+
+// ===== uniform mod Q =====
+// x*Q 의 하위 32bit 가 (2^32 mod Q) 미만이면 거부 → 상위 32bit 가 [0,Q) 균등
+uint32_t FHE16_RNG_uniform_Q(FHE16_RNG* rng, uint32_t Q) {
+    if (Q <= 1) return 0;
+    const uint32_t thr = (uint32_t)(0u - Q) % Q;
+    for (;;) {
+        uint32_t x;
+        FHE16_RNG_u32(rng, &x, 1);
+        const uint64_t m = (uint64_t)x * (uint64_t)Q;
+        if ((uint32_t)m >= thr) return (uint32_t)(m >> 32);
+    }
+}
+
+void FHE16_RNG_uniform_Q_vec(FHE16_RNG* rng, int32_t* out, size_t n, uint32_t Q) {
+    if (Q <= 1) { std::memset(out, 0, n * sizeof(int32_t)); return; }
+    const uint32_t thr = (uint32_t)(0u - Q) % Q;
+
+    alignas(64) uint32_t w[FHE16_RNG_BUF_WORDS * 2];
+    size_t k = 0;
+    while (k < n) {
+        const size_t want = std::min(n - k, sizeof(w) / sizeof(w[0]));
+        FHE16_RNG_u32(rng, w, want);
+        for (size_t i = 0; i < want; ++i) {
+            const uint64_t m = (uint64_t)w[i] * (uint64_t)Q;
+            out[k] = (int32_t)(m >> 32);
+            k += ((uint32_t)m >= thr);   // 거부 시 같은 칸을 다음 값으로 덮어씀
+        }
+    }
+}
+
+// ===== 반올림 가우시안 (Box-Muller) =====
+void FHE16_RNG_gauss_vec(FHE16_RNG* rng, int32_t* out, size_t n, double sigma) {
+    const double TWO_PI = 6.283185307179586476925286766559;
+    const double INV53  = 1.0 / 9007199254740992.0;   // 2^-53
+
+    alignas(64) uint32_t w[FHE16_RNG_BUF_WORDS * 2];
+    size_t i = 0;
+    while (i < n) {
+        const size_t pairs = std::min((n - i + 1) / 2, sizeof(w) / sizeof(w[0]) / 4);
+        FHE16_RNG_u32(rng, w, pairs * 4);
+        for (size_t p = 0; p < pairs; ++p) {
+            const uint64_t a = (((uint64_t)w[4 * p + 0] << 32) | w[4 * p + 1]) >> 11;
+            const uint64_t b = (((uint64_t)w[4 * p + 2] << 32) | w[4 * p + 3]) >> 11;
+            const double u1 = (double)(a + 1) * INV53;          // (0, 1]
+            const double u2 = (double)b * INV53;                // [0, 1)
+            const double r  = sigma * std::sqrt(-2.0 * std::log(u1));
+            const double th = TWO_PI * u2;
+            out[i++] = (int32_t)std::llround(r * std::cos(th));
+            if (i < n) out[i++] = (int32_t)std::llround(r * std::sin(th));
+        }
+    }
+}
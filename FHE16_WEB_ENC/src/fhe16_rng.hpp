@@ -0,0 +1,47 @@
+// fhe16_rng.hpp — ChaCha20 기반 난수 스트림 (암호화/키생성 공용)
+//
+// - 컨텍스트(스레드)당 OS 엔트로피로 1회만 시딩 (getentropy / crypto.getRandomValues)
+// - ChaCha20 블록을 여러 개 동시에 생성
+//     AVX2          : 8블록 병렬
+//     wasm SIMD128  : 4블록 병렬 (-msimd128)
+//     그 외         : 스칼라
+//   어느 경로든 같은 시드 → 같은 스트림 (결정적 확장에도 사용 가능)
+// - uniform mod Q : 블록 단위, 거부 샘플링(편향 없음). native 의 uniform_sampling_Q 대응
+// - 반올림 가우시안 : 블록 단위 Box-Muller, round(N(0, sigma))
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#define FHE16_RNG_BLOCK_WORDS 16
+#define FHE16_RNG_BUF_BLOCKS  8
+#define FHE16_RNG_BUF_WORDS   (FHE16_RNG_BLOCK_WORDS * FHE16_RNG_BUF_BLOCKS)
+
+struct FHE16_RNG {
+    uint32_t key[8];
+    uint32_t nonce[2];                 // 원본 ChaCha20 배치: 64bit counter + 64bit nonce
+    uint64_t counter;                  // 다음에 생성할 블록 번호
+    alignas(64) uint32_t buf[FHE16_RNG_BUF_WORDS];
+    size_t   pos;                      // buf 소비 위치 (== BUF_WORDS 이면 비어있음)
+    int      seeded;
+};
+
+// 고정 시드(32B) + 스트림 id 로 초기화 (결정적 스트림)
+void FHE16_RNG_seed(FHE16_RNG* rng, const uint8_t seed[32], uint64_t stream_id);
+
+// OS 엔트로피로 초기화. 성공 1, 실패 0
+int FHE16_RNG_seed_os(FHE16_RNG* rng);
+
+// 현재 스레드 컨텍스트 (첫 호출 시 한 번만 OS 시딩). 시딩 실패 시 nullptr → 호출자는 암호화를 실패시켜야 함
+FHE16_RNG* FHE16_RNG_thread();
+
+// 원시 32bit 워드
+void FHE16_RNG_u32(FHE16_RNG* rng, uint32_t* out, size_t n);
+
+// [0, Q) 균등 (Q < 2^32)
+uint32_t FHE16_RNG_uniform_Q(FHE16_RNG* rng, uint32_t Q);
+void     FHE16_RNG_uniform_Q_vec(FHE16_RNG* rng, int32_t* out, size_t n, uint32_t Q);
+
+// round(N(0, sigma))
+void FHE16_RNG_gauss_vec(FHE16_RNG* rng, int32_t* out, size_t n, double sigma);
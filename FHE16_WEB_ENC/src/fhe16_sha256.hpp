@@ -0,0 +1,16 @@
+// fhe16_sha256.hpp — SHA-256 (PK 내용 해시 / 캐시 키용, 스트리밍 갱신)
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct FHE16_SHA256 {
+    uint32_t h[8];
+    uint64_t nbytes;
+    uint8_t  blk[64];
+    size_t   blen;
+};
+
+void FHE16_SHA256_init(FHE16_SHA256* c);
+void FHE16_SHA256_update(FHE16_SHA256* c, const void* data, size_t len);
+void FHE16_SHA256_final(FHE16_SHA256* c, uint8_t out[32]);
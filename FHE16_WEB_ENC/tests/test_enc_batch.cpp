@@ -0,0 +1,161 @@
+// tests/test_enc_batch.cpp — 내보낸 암호화 API (enc_wasm.cpp) 를 비밀키를 아는 장난감 PK 로 끝까지 검사
+//
+// PK 행 r = (a_r, <a_r, s> + e_r) mod Q 로 만들고 (PK_Q = Q_TOT = 배포 Q, 행 64, n = 128),
+// 나온 암호문의 비트마다 위상 b - <a, s> 를 풀어 메시지와 비교한다.
+//  - PK 없음: FHE16_ENC_BATCH 0, FHE16_ENC_WASM nullptr
+//  - FHE16_ENC_WASM (CSV) 과 FHE16_ENC_BATCH (1 / 8 / 20 개, CHUNK 8 경계), 스레드 1 / 4
+//  - 풀: 채운 뒤 배치가 풀 항목을 쓰고 (hits 증가) 모자라면 직접 암호화
+//  - PK 를 바꾸면 이전 PK 로 만든 풀 항목은 나오지 않는다 (새 비밀키로 풀려야 함)
+// FHE16_ENC_BIN 은 포인터를 uint32 로 돌려주는 wasm32 전용이라 여기서는 부르지 않는다.
+
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+extern "C" {
+void  FHE16_init_params(int pk_row, int pk_col, int pk_Q, double Q_TOT, double sigma);
+void  FHE16_set_pk(const int32_t* pk_ptr, int length);
+char* FHE16_ENC_WASM(int32_t msg, int bit);
+int   FHE16_ENC_BATCH(const int32_t* msgs, int n, int32_t* out);
+void  FHE16_set_threads(int n);
+int   FHE16_POOL_start(int target_bits, int low_bits);
+void  FHE16_POOL_stop();
+void  FHE16_POOL_stats(double* out);
+void  FHE16_free(void* p);
+}
+
+static int g_fail = 0;
+#define CHECK(c) do { if (!(c)) { std::fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #c); ++g_fail; } } while (0)
+
+static const int     kRows  = 64;
+static const int     kN     = 128;
+static const int     kCols  = kN + 1;
+static const int32_t kQ     = 163603457;
+static const size_t  kPerCt = 16 + 1040 * 32;
+// 출력 배치 (원래 형식 그대로): 메타 16 + 코어 버퍼의 앞 여유 16 (0) + 비트당 1040, 데이터부는 1040*32 에서 잘림
+static const size_t  kBit0  = 16 + 16;
+
+static std::vector<int32_t> make_pk(const std::vector<int32_t>& s, std::mt19937_64& rng) {
+    std::vector<int32_t> pk((size_t)kRows * kCols);
+    for (int r = 0; r < kRows; ++r) {
+        int32_t* row = pk.data() + (size_t)r * kCols;
+        int64_t b = (int64_t)(rng() % 5) - 2;
+        for (int j = 0; j < kN; ++j) {
+            row[j] = (int32_t)(rng() % kQ);
+            b += (int64_t)row[j] * s[j];
+        }
+        row[kN] = (int32_t)(((b % kQ) + kQ) % kQ);
+    }
+    return pk;
+}
+
+// 비트별 위상을 풀어 정수로. 위상이 0 / Q/4 근처가 아니면 ok = false
+static int32_t decrypt(const int32_t* ct, const std::vector<int32_t>& s, int bits, bool* ok) {
+    uint32_t v = 0;
+    for (int i = 0; i < bits; ++i) {
+        const int32_t* lwe = ct + kBit0 + (size_t)i * 1040;
+        int64_t ph = lwe[kN];
+        for (int j = 0; j < kN; ++j) ph -= (int64_t)lwe[j] * s[j];
+        ph = ((ph % kQ) + kQ) % kQ;
+        const int64_t m = ((ph + kQ / 8) % kQ) / (kQ / 4);
+        if (m > 1) *ok = false;
+        v |= (uint32_t)(m & 1) << i;
+        for (int j = kCols; j < 1040 && kBit0 + (size_t)i * 1040 + j < kPerCt; ++j) if (lwe[j] != 0) *ok = false;   // 패딩
+    }
+    return (int32_t)v;
+}
+
+static bool check_batch(const std::vector<int32_t>& msgs, const std::vector<int32_t>& s) {
+    std::vector<int32_t> out(msgs.size() * kPerCt, -7);
+    if (FHE16_ENC_BATCH(msgs.data(), (int)msgs.size(), out.data()) != (int)(msgs.size() * kPerCt)) return false;
+    bool ok = true;
+    for (size_t i = 0; i < msgs.size(); ++i) {
+        const int32_t* ct = out.data() + i * kPerCt;
+        ok &= ct[0] == 32 && ct[1] == 1040 * 32 && ct[2] == 6;
+        for (size_t j = 3; j < kBit0; ++j) ok &= ct[j] == 0;
+        ok &= decrypt(ct, s, 32, &ok) == msgs[i];
+    }
+    return ok;
+}
+
+static bool check_csv(int32_t msg, const std::vector<int32_t>& s) {
+    char* str = FHE16_ENC_WASM(msg, 32);
+    if (!str) return false;
+    std::vector<int32_t> ct;
+    for (char* p = str; *p;) {
+        ct.push_back((int32_t)std::strtol(p, &p, 10));
+        if (*p == ',') ++p;
+    }
+    FHE16_free(str);
+    bool ok = ct.size() == kPerCt;
+    return ok && decrypt(ct.data(), s, 32, &ok) == msg && ok;
+}
+
+static std::vector<double> pool_stats() {
+    std::vector<double> st(8);
+    FHE16_POOL_stats(st.data());
+    return st;
+}
+
+int main() {
+    std::mt19937_64 rng(29);
+    std::vector<int32_t> s(kN), s2(kN);
+    for (int32_t& v : s)  v = (int32_t)(rng() % 3) - 1;
+    for (int32_t& v : s2) v = (int32_t)(rng() % 3) - 1;
+    const std::vector<int32_t> pk = make_pk(s, rng), pk2 = make_pk(s2, rng);
+
+    std::vector<int32_t> msgs = { 0, 1, -1, INT_MIN, INT_MAX, 12345, -98765 };
+    while (msgs.size() < 20) msgs.push_back((int32_t)rng());
+    const std::vector<int32_t> one(msgs.begin(), msgs.begin() + 1), eight(msgs.begin(), msgs.begin() + 8);
+
+    // ===== PK 없음 =====
+    FHE16_init_params(kRows, kCols, kQ, (double)kQ, 3.2);
+    {
+        std::vector<int32_t> out(kPerCt);
+        CHECK(FHE16_ENC_BATCH(one.data(), 1, out.data()) == 0);
+        CHECK(FHE16_ENC_WASM(1, 32) == nullptr);
+        CHECK(FHE16_ENC_BATCH(one.data(), 0, out.data()) == 0);
+        CHECK(FHE16_ENC_BATCH(nullptr, 1, out.data()) == 0);
+    }
+
+    // ===== 직접 암호화 (풀 없음) =====
+    FHE16_set_pk(pk.data(), (int)pk.size());
+    for (int threads : { 1, 4 }) {
+        FHE16_set_threads(threads);
+        CHECK(check_batch(one, s));
+        CHECK(check_batch(eight, s));
+        CHECK(check_batch(msgs, s));
+        CHECK(check_csv(-2, s));
+        CHECK(check_csv(INT_MIN, s));
+    }
+    FHE16_set_threads(0);
+
+    // ===== 풀 =====
+    CHECK(FHE16_POOL_start(4 * 32, 2 * 32) == 1);
+    for (int i = 0; i < 10000 && pool_stats()[0] < 4 * 32; ++i) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    CHECK(pool_stats()[0] == 4 * 32);
+    const double hits0 = pool_stats()[4];
+    CHECK(check_batch(msgs, s));                  // 앞 4 개는 풀, 나머지는 직접
+    CHECK(pool_stats()[4] >= hits0 + 4);
+    CHECK(check_csv(777, s));
+
+    // PK 교체: 이전 PK 로 만든 항목이 남아 있는 상태에서. 그 항목이 나오면 s2 로 풀리지 않는다
+    for (int i = 0; i < 10000 && pool_stats()[0] < 32; ++i) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    CHECK(pool_stats()[0] >= 32);
+    FHE16_set_pk(pk2.data(), (int)pk2.size());
+    for (int round = 0; round < 4; ++round) {
+        CHECK(check_batch(eight, s2));
+        CHECK(check_csv((int32_t)rng(), s2));
+    }
+    FHE16_POOL_stop();
+
+    if (g_fail) { std::fprintf(stderr, "test_enc_batch: %d failure(s)\n", g_fail); return 1; }
+    std::printf("test_enc_batch: ok\n");
+    return 0;
+}
@@ -0,0 +1,205 @@
+// tests/test_enc_pool.cpp — 0 암호문 풀 (FHE16_EncPool) 검사
+//
+// 생산자는 항목마다 일련번호와 세대 (clear 전/후) 를 찍는다. 확인하는 것:
+//  - 시작 전 (용량 0) 에는 take 가 miss 도 세지 않고 false, refill 은 0
+//  - 수동 refill / 백그라운드 생산이 목표치까지 채우고, 꺼낸 항목은 생산 순서 (FIFO), 중복 / 누락 없음 (링 순환 포함)
+//  - low 아래로 내려가면 다시 채운다, hits / misses / produced 통계
+//  - clear 뒤에는 clear 전에 생산을 시작한 배치도 나오지 않는다 (세대 확인)
+//  - 여러 스레드가 동시에 꺼내도 항목이 한 번씩만 나온다
+//  - 생산자 실패 시 refill 0, 워커는 clear 를 기다린다. push 는 용량까지만 넣는다
+
+#include "fhe16_enc_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <set>
+#include <thread>
+#include <vector>
+
+static int g_fail = 0;
+#define CHECK(c) do { if (!(c)) { std::fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #c); ++g_fail; } } while (0)
+
+static const int kCols = 5;
+static std::atomic<int32_t> g_seq{0};
+static std::atomic<int32_t> g_epoch{0};
+static std::atomic<bool>    g_fail_producer{false};
+static std::atomic<int>     g_slow_us{0};
+
+// 항목: [일련번호, 세대, 일련번호 ^ 0x5a5a, 0, -1]
+static bool stamp_producer(int nbits, int32_t* out) {
+    if (g_fail_producer) return false;
+    const int32_t epoch = g_epoch.load();
+    if (g_slow_us) std::this_thread::sleep_for(std::chrono::microseconds(g_slow_us.load()));
+    for (int b = 0; b < nbits; ++b) {
+        const int32_t s = g_seq++;
+        int32_t* row = out + (size_t)b * kCols;
+        row[0] = s; row[1] = epoch; row[2] = s ^ 0x5a5a; row[3] = 0; row[4] = -1;
+    }
+    return true;
+}
+
+static bool row_ok(const int32_t* row) { return row[2] == (row[0] ^ 0x5a5a) && row[3] == 0 && row[4] == -1; }
+
+static FHE16_EncPoolStats stats(FHE16_EncPool& pool) {
+    FHE16_EncPoolStats st;
+    pool.stats(&st);
+    return st;
+}
+
+// 조건이 될 때까지 (최대 10 초)
+template <class F> static bool wait_for(F f) {
+    for (int i = 0; i < 10000; ++i) {
+        if (f()) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+int main() {
+    const int B = FHE16_EncPool::BATCH_BITS;
+    std::vector<int32_t> buf((size_t)4 * B * kCols);
+
+    // ===== 시작 전 / 수동 refill =====
+    {
+        FHE16_EncPool pool;
+        pool.configure(kCols, stamp_producer);
+        CHECK(!pool.take(1, buf.data()));
+        CHECK(stats(pool).misses == 0);
+        CHECK(pool.refill(1000) == 0);
+
+        CHECK(pool.start(3 * B, B));
+        pool.stop();
+        CHECK(!pool.running());
+        CHECK(stats(pool).target_bits == 3 * B && stats(pool).low_bits == B);
+        // stop 전에 워커가 만든 만큼은 비우고 시작
+        if (stats(pool).depth_bits > 0) CHECK(pool.take((int)stats(pool).depth_bits, buf.data()));
+        const FHE16_EncPoolStats s_start = stats(pool);
+
+        // 목표치까지만 (3 배치)
+        const int before = g_seq;
+        CHECK(pool.refill(1000) == 3 * B);
+        CHECK(stats(pool).depth_bits == 3 * B);
+        CHECK(pool.refill(1000) == 0);
+
+        // FIFO, 링을 몇 바퀴 돌려도 순서 / 내용 유지
+        int32_t expect = before;
+        bool ok = true;
+        for (int round = 0; round < 10; ++round) {
+            const int n = 1 + round % 7;
+            while (stats(pool).depth_bits < n) pool.refill(B);
+            CHECK(pool.take(n, buf.data()));
+            for (int b = 0; b < n; ++b) ok &= buf[(size_t)b * kCols] == expect++ && row_ok(buf.data() + (size_t)b * kCols);
+            if (stats(pool).depth_bits + B <= 3 * B) CHECK(pool.refill(B) == B);
+        }
+        CHECK(ok);
+
+        // 부족하면 miss, 0 이하 요청도 miss
+        const FHE16_EncPoolStats s0 = stats(pool);
+        CHECK(!pool.take((int)s0.depth_bits + 1, buf.data()));
+        CHECK(!pool.take(0, buf.data()));
+        const FHE16_EncPoolStats s1 = stats(pool);
+        CHECK(s1.misses == s0.misses + 2 && s1.hits == s0.hits && s1.depth_bits == s0.depth_bits);
+        CHECK(s1.hits - s_start.hits == 10);
+        CHECK(s1.produced_bits - s_start.produced_bits == (int64_t)g_seq - before);
+        CHECK(s1.refill_batches * B == s1.produced_bits);
+
+        // configure 는 보유 항목을 폐기
+        pool.configure(kCols, stamp_producer);
+        CHECK(stats(pool).depth_bits == 0);
+    }
+
+    // ===== 백그라운드 생산 =====
+    {
+        FHE16_EncPool pool;
+        pool.configure(kCols, stamp_producer);
+        CHECK(pool.start(4 * B, 2 * B));
+        CHECK(pool.running());
+        CHECK(wait_for([&] { return stats(pool).depth_bits == 4 * B; }));
+
+        // low (2B) 아래로 내려가면 목표치까지 다시
+        CHECK(pool.take(B, buf.data()));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        CHECK(stats(pool).depth_bits == 3 * B);       // 아직 low 위 → 생산 안 함
+        CHECK(pool.take(B + 1, buf.data()));
+        CHECK(wait_for([&] { return stats(pool).depth_bits > 3 * B; }));
+
+        // clear: 그 전에 시작한 배치 (느린 생산자) 는 버려진다
+        g_slow_us = 3000;
+        CHECK(wait_for([&] { return stats(pool).depth_bits >= 3 * B; }));
+        pool.take((int)stats(pool).depth_bits, buf.data());     // 비워서 생산을 유도
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ++g_epoch;
+        pool.clear();
+        g_slow_us = 0;
+        CHECK(wait_for([&] { return stats(pool).depth_bits >= 2 * B; }));
+        bool fresh = true;
+        for (int i = 0; i < 6; ++i) {
+            CHECK(wait_for([&] { return stats(pool).depth_bits >= 8; }));
+            CHECK(pool.take(8, buf.data()));
+            for (int b = 0; b < 8; ++b) fresh &= buf[(size_t)b * kCols + 1] == g_epoch.load();
+        }
+        CHECK(fresh);
+
+        // 여러 스레드가 동시에 꺼낸다: 모든 항목이 한 번씩, 스레드 안에서는 오름차순
+        std::vector<std::vector<int32_t>> got(4);
+        std::vector<std::thread> th;
+        for (int t = 0; t < 4; ++t)
+            th.emplace_back([&, t] {
+                std::vector<int32_t> tmp((size_t)3 * kCols);
+                while (got[t].size() < 300) {
+                    if (!pool.take(3, tmp.data())) { std::this_thread::yield(); continue; }
+                    for (int b = 0; b < 3; ++b) {
+                        if (!row_ok(tmp.data() + (size_t)b * kCols)) got[t].push_back(-1);
+                        got[t].push_back(tmp[(size_t)b * kCols]);
+                    }
+                }
+            });
+        for (auto& x : th) x.join();
+        std::set<int32_t> all;
+        bool sorted = true;
+        size_t total = 0;
+        for (auto& g : got) {
+            sorted &= std::is_sorted(g.begin(), g.end()) && (g.empty() || g.front() >= 0);
+            all.insert(g.begin(), g.end());
+            total += g.size();
+        }
+        CHECK(sorted);
+        CHECK(all.size() == total);
+        pool.stop();
+        CHECK(!pool.running());
+    }
+
+    // ===== 생산자 실패 / push =====
+    {
+        FHE16_EncPool pool;
+        pool.configure(kCols, stamp_producer);
+        g_fail_producer = true;
+        CHECK(pool.start(2 * B, 0));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        CHECK(stats(pool).depth_bits == 0 && pool.refill(1000) == 0);
+        g_fail_producer = false;
+        pool.clear();                                 // 워커가 다시 시도
+        CHECK(wait_for([&] { return stats(pool).depth_bits == 2 * B; }));
+        pool.stop();
+
+        // push 는 용량 (목표 + 배치 하나) 까지만
+        std::vector<int32_t> src((size_t)2 * B * kCols);
+        for (size_t i = 0; i < src.size(); ++i) src[i] = (int32_t)i;
+        CHECK(pool.push(2 * B, src.data()) == B);
+        CHECK(stats(pool).depth_bits == 3 * B);
+
+        // 처음 쓰는 풀에 push: 용량을 잡는다
+        FHE16_EncPool fresh;
+        fresh.configure(kCols, nullptr);
+        CHECK(fresh.push(7, src.data()) == 7);
+        CHECK(fresh.take(7, buf.data()));
+        CHECK(std::equal(buf.begin(), buf.begin() + 7 * kCols, src.begin()));
+        CHECK(fresh.refill(100) == 0);                // 생산자 없음
+    }
+
+    if (g_fail) { std::fprintf(stderr, "test_enc_pool: %d failure(s)\n", g_fail); return 1; }
+    std::printf("test_enc_pool: ok\n");
+    return 0;
+}
@@ -0,0 +1,135 @@
+// tests/test_pk_compact.cpp — .fpk 인코더 / 스트리밍 디코더 왕복과 잘못된 입력 거부
+//
+// 전체 bit-pack / 시드 모드 PK 를 여러 조각 크기로 push 해서 원본과 같은지 확인하고,
+// 헤더 (파라미터 세트, 전체 길이, 크기 상한, reserved) 와 payload (계수 >= Q, 길이, 해시) 가
+// 틀린 스트림은 PK 버퍼를 잡기 전에 / 해당 행에서 실패해야 한다.
+
+#include "fhe16_pk_compact.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+static int g_fail = 0;
+#define CHECK(c) do { if (!(c)) { std::fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #c); ++g_fail; } } while (0)
+
+static void put_u32(std::vector<uint8_t>& b, size_t off, uint32_t v) {
+    for (int i = 0; i < 4; ++i) b[off + i] = (uint8_t)(v >> (8 * i));
+}
+
+// 해시 칸을 다시 계산 (헤더를 고친 뒤 해시 검사가 아니라 헤더 검사에서 걸리는지 보려고)
+static void rehash(std::vector<uint8_t>& b) {
+    std::memset(b.data() + 64, 0, 32);
+    FHE16_SHA256 sha;
+    FHE16_SHA256_init(&sha);
+    FHE16_SHA256_update(&sha, b.data(), b.size());
+    FHE16_SHA256_final(&sha, b.data() + 64);
+}
+
+static bool decode(const std::vector<uint8_t>& b, size_t chunk, std::vector<int32_t>* pk,
+                   uint32_t rows = 0, uint32_t cols = 0, uint32_t Q = 0, uint64_t total = 0) {
+    FHE16_PKStreamDecoder dec;
+    dec.reset();
+    dec.expect(rows, cols, Q, total);
+    for (size_t off = 0; off < b.size(); off += chunk)
+        if (dec.push(b.data() + off, std::min(chunk, b.size() - off)) < 0) {
+            CHECK(dec.failed() && dec.pk_mut().size() <= (size_t)dec.header().rows * dec.header().cols);
+            return false;
+        }
+    if (!dec.finish()) return false;
+    if (pk) pk->assign(dec.pk(), dec.pk() + (size_t)dec.header().rows * dec.header().cols);
+    return true;
+}
+
+int main() {
+    std::mt19937_64 rng(30);
+
+    // 왕복: 배포 Q 와 경계 Q, 전체 bit-pack 과 시드 모드, 여러 조각 크기
+    const uint32_t Qs[] = { 163603459, 2, 3, 256, 257, 65537, 2147483647 };
+    for (uint32_t Q : Qs) {
+        const int rows = 1 + (int)(rng() % 40), cols = 1 + (int)(rng() % 70);
+        for (int uniform : { 0, cols / 2, cols }) {
+            uint8_t seed[32];
+            for (uint8_t& x : seed) x = (uint8_t)rng();
+            std::vector<int32_t> pk((size_t)rows * cols);
+            for (int r = 0; r < rows; ++r) {
+                int32_t* row = pk.data() + (size_t)r * cols;
+                if (uniform > 0) FHE16_PK_expand_uniform_row(seed, r, uniform, Q, row);
+                for (int c = uniform; c < cols; ++c) row[c] = (int32_t)(rng() % 4 == 0 ? Q - 1 : rng() % Q);
+            }
+            std::vector<uint8_t> fpk;
+            FHE16_PKCompactHeader h;
+            CHECK(FHE16_PK_compact_encode(pk.data(), rows, cols, Q, uniform, uniform ? seed : nullptr, fpk, &h));
+            CHECK(FHE16_PK_compact_bytes(h) == fpk.size());
+            for (size_t chunk : { (size_t)1, (size_t)7, (size_t)96, (size_t)4096 }) {
+                std::vector<int32_t> got;
+                CHECK(decode(fpk, chunk, &got) && got == pk);
+                CHECK(decode(fpk, chunk, nullptr, rows, cols, Q, fpk.size()));
+            }
+            // 값이 [0, Q) 밖이면 인코딩부터 거부
+            pk[pk.size() - 1] = (int32_t)Q;
+            if (uniform < cols) CHECK(!FHE16_PK_compact_encode(pk.data(), rows, cols, Q, uniform, seed, fpk, nullptr));
+        }
+    }
+
+    // 잘못된 입력
+    const int rows = 8, cols = 9;
+    const uint32_t Q = 1000;   // 10 비트: [1000, 1024) 는 표현 가능하지만 범위 밖
+    std::vector<int32_t> pk((size_t)rows * cols);
+    for (int32_t& v : pk) v = (int32_t)(rng() % Q);
+    std::vector<uint8_t> good;
+    CHECK(FHE16_PK_compact_encode(pk.data(), rows, cols, Q, 0, nullptr, good, nullptr));
+    CHECK(decode(good, 5, nullptr, rows, cols, Q, good.size()));
+
+    // 파라미터 세트 / 전체 길이 불일치
+    CHECK(!decode(good, 5, nullptr, rows + 1, cols, Q, 0));
+    CHECK(!decode(good, 5, nullptr, rows, cols - 1, Q, 0));
+    CHECK(!decode(good, 5, nullptr, 0, 0, Q + 1, 0));
+    CHECK(!decode(good, 5, nullptr, 0, 0, 0, good.size() + 1));
+    {
+        // 헤더가 큰 PK 를 주장해도 버퍼를 잡기 전에 실패 (길이 / 상한)
+        std::vector<uint8_t> b = good;
+        put_u32(b, 8, 1u << 16);
+        put_u32(b, 12, 1u << 16);
+        rehash(b);
+        FHE16_PKStreamDecoder dec;
+        dec.reset();
+        CHECK(dec.push(b.data(), FHE16_FPK_HEADER_BYTES) == -1 && dec.pk_mut().capacity() == 0);
+        put_u32(b, 8, 1024);
+        put_u32(b, 12, 1025);
+        rehash(b);
+        dec.reset();
+        dec.expect(0, 0, 0, good.size());
+        CHECK(dec.push(b.data(), FHE16_FPK_HEADER_BYTES) == -1 && dec.pk_mut().capacity() == 0);
+    }
+    {
+        std::vector<uint8_t> b = good;
+        put_u32(b, 28, 1);   // reserved
+        rehash(b);
+        CHECK(!decode(b, 5, nullptr));
+    }
+    {
+        // 계수 >= Q : 첫 행 첫 계수를 1023 으로 (해시는 맞춰 둠)
+        std::vector<uint8_t> b = good;
+        b[FHE16_FPK_HEADER_BYTES] = 0xff;
+        b[FHE16_FPK_HEADER_BYTES + 1] |= 0x03;
+        rehash(b);
+        CHECK(!decode(b, 5, nullptr));
+        CHECK(!decode(b, b.size(), nullptr));
+    }
+    {
+        std::vector<uint8_t> b = good;
+        b.push_back(0);   // 뒤에 남는 데이터
+        CHECK(!decode(b, 5, nullptr));
+        b.resize(good.size() - 1);   // 모자람
+        CHECK(!decode(b, 5, nullptr));
+        b = good;
+        b[b.size() - 1] ^= 1;   // 해시 불일치 (계수는 여전히 범위 안일 수 있음)
+        CHECK(!decode(b, 5, nullptr));
+    }
+
+    if (g_fail) { std::fprintf(stderr, "test_pk_compact: %d failure(s)\n", g_fail); return 1; }
+    std::printf("test_pk_compact: ok\n");
+    return 0;
+}
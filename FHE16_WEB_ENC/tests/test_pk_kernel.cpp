@@ -0,0 +1,118 @@
+// tests/test_pk_kernel.cpp — PK 행렬곱 커널 (FHE16_PK_pack / FHE16_PK_matmul) 을 int64 정의와 비교
+//
+//  - 빠른 경로 (0 <= PK < 2^28, |SK| <= 511): 홀수 행 / SIMD 폭의 배수가 아닌 열 / 비트 수, 열 구간, ldc > cols
+//  - int32 누적 한계: PK = 2^28 - 1, SK = ±511 로 256 행 (내보내기 한 번 분량) 이상을 채운 경우
+//  - 참조 경로로 빠지는 경우: PK 음수 / 2^28 이상, SK 512, pack 없음, 다른 모양의 pack
+//  - 구간 밖 C 는 건드리지 않는다
+
+#include "fhe16_pk_kernel.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static int g_fail = 0;
+#define CHECK(c) do { if (!(c)) { std::fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #c); ++g_fail; } } while (0)
+
+static const int64_t kSentinel = 0x5a5a5a5a5a5a5a5all;
+
+static bool check_case(const std::vector<int32_t>& pk, int rows, int cols, const std::vector<int32_t>& sk, int nbit,
+                       const FHE16_PKPacked* P, int c_begin, int c_end, int ldc) {
+    std::vector<int64_t> C((size_t)nbit * ldc, kSentinel);
+    FHE16_PK_matmul(P, pk.data(), rows, cols, sk.data(), nbit, C.data(), ldc, c_begin, c_end);
+    const int lo = std::max(c_begin, 0), hi = std::min(c_end, cols);
+    for (int b = 0; b < nbit; ++b)
+        for (int c = 0; c < ldc; ++c) {
+            int64_t want = kSentinel;
+            if (c >= lo && c < hi) {
+                want = 0;
+                for (int r = 0; r < rows; ++r) want += (int64_t)sk[(size_t)b * rows + r] * pk[(size_t)r * cols + c];
+            }
+            if (C[(size_t)b * ldc + c] != want) return false;
+        }
+    return true;
+}
+
+int main() {
+    std::mt19937_64 rng(27);
+    const int32_t kTop = (1 << 28) - 1;
+
+    // ===== 빠른 경로: 무작위 모양 =====
+    for (int iter = 0; iter < 60; ++iter) {
+        const int rows = 1 + (int)(rng() % 600);
+        const int cols = 1 + (int)(rng() % 150);
+        const int nbit = 1 + (int)(rng() % 33);
+        std::vector<int32_t> pk((size_t)rows * cols), sk((size_t)nbit * rows);
+        for (int32_t& v : pk) v = (rng() & 7) == 0 ? kTop : (int32_t)(rng() % (1u << 28));
+        for (int32_t& v : sk) v = (rng() & 7) == 0 ? ((rng() & 1) ? 511 : -511) : (int32_t)(rng() % 1023) - 511;
+
+        FHE16_PKPacked P;
+        FHE16_PK_pack(pk.data(), rows, cols, &P);
+        CHECK(P.fast && P.pairs == (rows + 1) / 2 && P.cols_pad >= cols);
+
+        const int ldc = cols + (int)(rng() % 5);
+        CHECK(check_case(pk, rows, cols, sk, nbit, &P, 0, cols, ldc));
+        const int a = (int)(rng() % cols), b = a + 1 + (int)(rng() % (cols - a));
+        CHECK(check_case(pk, rows, cols, sk, nbit, &P, a, b, ldc));
+        // 범위 밖 구간은 잘라서
+        CHECK(check_case(pk, rows, cols, sk, nbit, &P, -3, cols + 7, ldc));
+        if (g_fail) { std::fprintf(stderr, "  rows %d cols %d nbit %d\n", rows, cols, nbit); break; }
+    }
+
+    // ===== int32 누적 한계 (배포 모양 1024 x 1025, 32 비트) =====
+    {
+        const int rows = 1024, cols = 1025, nbit = 32;
+        std::vector<int32_t> pk((size_t)rows * cols, kTop), sk((size_t)nbit * rows);
+        for (int b = 0; b < nbit; ++b)
+            for (int r = 0; r < rows; ++r) sk[(size_t)b * rows + r] = b == 0 ? 511 : b == 1 ? -511 : (r & 1) ? 511 : -511;
+        FHE16_PKPacked P;
+        FHE16_PK_pack(pk.data(), rows, cols, &P);
+        CHECK(P.fast);
+        CHECK(check_case(pk, rows, cols, sk, nbit, &P, 0, cols, cols));
+        CHECK(check_case(pk, rows, cols, sk, nbit, &P, 1000, 1025, cols));
+    }
+
+    // ===== 참조 경로로 빠지는 경우 =====
+    {
+        const int rows = 37, cols = 29, nbit = 5;
+        std::vector<int32_t> pk((size_t)rows * cols), sk((size_t)nbit * rows);
+        for (int32_t& v : pk) v = (int32_t)(rng() % (1u << 28));
+        for (int32_t& v : sk) v = (int32_t)(rng() % 1023) - 511;
+
+        std::vector<int32_t> bad = pk;
+        bad[17] = 1 << 28;
+        FHE16_PKPacked P;
+        FHE16_PK_pack(bad.data(), rows, cols, &P);
+        CHECK(!P.fast && P.lo.empty());
+        CHECK(check_case(bad, rows, cols, sk, nbit, &P, 0, cols, cols));
+        bad[17] = -5;
+        FHE16_PK_pack(bad.data(), rows, cols, &P);
+        CHECK(!P.fast);
+        CHECK(check_case(bad, rows, cols, sk, nbit, &P, 0, cols, cols));
+
+        FHE16_PK_pack(pk.data(), rows, cols, &P);
+        CHECK(P.fast);
+        std::vector<int32_t> big = sk;
+        big[3] = 512;
+        CHECK(check_case(pk, rows, cols, big, nbit, &P, 0, cols, cols));
+        big[3] = -100000;
+        CHECK(check_case(pk, rows, cols, big, nbit, &P, 0, cols, cols));
+        CHECK(check_case(pk, rows, cols, sk, nbit, nullptr, 0, cols, cols));
+
+        // 다른 모양으로 만든 pack 은 쓰지 않는다
+        FHE16_PKPacked other;
+        FHE16_PK_pack(pk.data(), rows - 1, cols, &other);
+        CHECK(check_case(pk, rows, cols, sk, nbit, &other, 0, cols, cols));
+
+        // 빈 구간 / 비트 없음: 아무것도 쓰지 않는다
+        CHECK(check_case(pk, rows, cols, sk, nbit, &P, 10, 10, cols));
+        std::vector<int64_t> C(cols, kSentinel);
+        FHE16_PK_matmul(&P, pk.data(), rows, cols, sk.data(), 0, C.data(), cols, 0, cols);
+        CHECK(C[0] == kSentinel && C[cols - 1] == kSentinel);
+    }
+
+    if (g_fail) { std::fprintf(stderr, "test_pk_kernel: %d failure(s)\n", g_fail); return 1; }
+    std::printf("test_pk_kernel: ok\n");
+    return 0;
+}
@@ -0,0 +1,189 @@
+// tests/test_rng.cpp — ChaCha20 난수 스트림 (fhe16_rng) 검사
+//
+//  - RFC 8439 의 블록 함수 시험 벡터 (A.1 #1: 키 / nonce 0, 2.3.2: 카운터 상위 워드가 0 이 아님)
+//  - 스칼라 기준 구현과 첫 64 블록 비교 (빌드 설정의 SIMD 경로가 레인 → 블록 순서로 맞게 전치하는지)
+//  - 읽는 조각 크기 (1 워드씩 / 버퍼 우회 큰 요청 / 섞어서) 와 무관하게 같은 스트림
+//  - uniform_Q_vec 이 uniform_Q 를 n 번 부른 것과 같은 값 (같은 워드를 같은 규칙으로 거부) 이고 [0, Q)
+//  - 가우시안의 평균 / 표준편차, 스레드 컨텍스트가 시딩되고 스레드마다 다른 스트림인지
+
+#include "fhe16_rng.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+static int g_fail = 0;
+#define CHECK(c) do { if (!(c)) { std::fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #c); ++g_fail; } } while (0)
+
+static uint32_t rotl(uint32_t x, int r) { return (x << r) | (x >> (32 - r)); }
+
+// 원본 ChaCha20 배치 (64bit 카운터 + 64bit nonce) 의 스칼라 블록 함수
+static void ref_block(const uint32_t key[8], const uint32_t nonce[2], uint64_t ctr, uint32_t out[16]) {
+    uint32_t s[16] = { 0x61707865u, 0x3320646eu, 0x79622d32u, 0x6b206574u };
+    for (int i = 0; i < 8; ++i) s[4 + i] = key[i];
+    s[12] = (uint32_t)ctr;
+    s[13] = (uint32_t)(ctr >> 32);
+    s[14] = nonce[0];
+    s[15] = nonce[1];
+    uint32_t x[16];
+    std::memcpy(x, s, sizeof(x));
+    auto qr = [&](int a, int b, int c, int d) {
+        x[a] += x[b]; x[d] = rotl(x[d] ^ x[a], 16);
+        x[c] += x[d]; x[b] = rotl(x[b] ^ x[c], 12);
+        x[a] += x[b]; x[d] = rotl(x[d] ^ x[a], 8);
+        x[c] += x[d]; x[b] = rotl(x[b] ^ x[c], 7);
+    };
+    for (int r = 0; r < 10; ++r) {
+        qr(0, 4, 8, 12); qr(1, 5, 9, 13); qr(2, 6, 10, 14); qr(3, 7, 11, 15);
+        qr(0, 5, 10, 15); qr(1, 6, 11, 12); qr(2, 7, 8, 13); qr(3, 4, 9, 14);
+    }
+    for (int i = 0; i < 16; ++i) out[i] = x[i] + s[i];
+}
+
+static bool block_is(FHE16_RNG* rng, const uint8_t want[64]) {
+    uint32_t w[16];
+    FHE16_RNG_u32(rng, w, 16);
+    uint8_t b[64];
+    for (int i = 0; i < 64; ++i) b[i] = (uint8_t)(w[i / 4] >> (8 * (i % 4)));
+    return std::memcmp(b, want, 64) == 0;
+}
+
+int main() {
+    // ===== RFC 8439 시험 벡터 =====
+    {
+        static const uint8_t zero_key[32] = {};
+        static const uint8_t a1[64] = {
+            0x76, 0xb8, 0xe0, 0xad, 0xa0, 0xf1, 0x3d, 0x90, 0x40, 0x5d, 0x6a, 0xe5, 0x53, 0x86, 0xbd, 0x28,
+            0xbd, 0xd2, 0x19, 0xb8, 0xa0, 0x8d, 0xed, 0x1a, 0xa8, 0x36, 0xef, 0xcc, 0x8b, 0x77, 0x0d, 0xc7,
+            0xda, 0x41, 0x59, 0x7c, 0x51, 0x57, 0x48, 0x8d, 0x77, 0x24, 0xe0, 0x3f, 0xb8, 0xd8, 0x4a, 0x37,
+            0x6a, 0x43, 0xb8, 0xf4, 0x15, 0x18, 0xa1, 0x1c, 0xc3, 0x87, 0xb6, 0x69, 0xb2, 0xee, 0x65, 0x86 };
+        FHE16_RNG rng;
+        FHE16_RNG_seed(&rng, zero_key, 0);
+        CHECK(block_is(&rng, a1));
+
+        // 2.3.2: 키 00..1f, 카운터 1, nonce 00000009 0000004a 00000000 → 원본 배치로는 카운터 상위 = 0x09000000
+        uint8_t key[32];
+        for (int i = 0; i < 32; ++i) key[i] = (uint8_t)i;
+        static const uint8_t b232[64] = {
+            0x10, 0xf1, 0xe7, 0xe4, 0xd1, 0x3b, 0x59, 0x15, 0x50, 0x0f, 0xdd, 0x1f, 0xa3, 0x20, 0x71, 0xc4,
+            0xc7, 0xd1, 0xf4, 0xc7, 0x33, 0xc0, 0x68, 0x03, 0x04, 0x22, 0xaa, 0x9a, 0xc3, 0xd4, 0x6c, 0x4e,
+            0xd2, 0x82, 0x64, 0x46, 0x07, 0x9f, 0xaa, 0x09, 0x14, 0xc2, 0xd7, 0x05, 0xd9, 0x8b, 0x02, 0xa2,
+            0xb5, 0x12, 0x9c, 0xd1, 0xde, 0x16, 0x4e, 0xb9, 0xcb, 0xd0, 0x83, 0xe8, 0xa2, 0x50, 0x3c, 0x4e };
+        FHE16_RNG_seed(&rng, key, 0x4a000000ull);
+        rng.counter = (0x09000000ull << 32) | 1;
+        CHECK(block_is(&rng, b232));
+    }
+
+    // ===== 스칼라 기준과 비교 (레인 순서, 카운터 하위 워드 넘침 포함) =====
+    std::mt19937_64 gen(26);
+    uint8_t seed[32];
+    for (uint8_t& b : seed) b = (uint8_t)gen();
+    for (uint64_t start : { 0ull, 0xfffffff0ull }) {
+        FHE16_RNG rng;
+        FHE16_RNG_seed(&rng, seed, 0x0123456789abcdefull);
+        rng.counter = start;
+        std::vector<uint32_t> got(64 * 16);
+        FHE16_RNG_u32(&rng, got.data(), got.size());
+        int bad = 0;
+        for (int b = 0; b < 64; ++b) {
+            uint32_t want[16];
+            ref_block(rng.key, rng.nonce, start + (uint64_t)b, want);
+            bad += std::memcmp(want, got.data() + b * 16, sizeof(want)) != 0;
+        }
+        CHECK(bad == 0);
+    }
+
+    // ===== 조각 크기와 무관한 스트림 =====
+    {
+        const size_t n = 5000;
+        FHE16_RNG a, b, c;
+        FHE16_RNG_seed(&a, seed, 7);
+        FHE16_RNG_seed(&b, seed, 7);
+        FHE16_RNG_seed(&c, seed, 7);
+        std::vector<uint32_t> whole(n), ones(n), mixed(n);
+        FHE16_RNG_u32(&a, whole.data(), n);
+        for (size_t i = 0; i < n; ++i) FHE16_RNG_u32(&b, &ones[i], 1);
+        for (size_t i = 0; i < n;) {
+            const size_t k = std::min(n - i, (size_t)(gen() % 300));
+            FHE16_RNG_u32(&c, mixed.data() + i, k);
+            i += k;
+        }
+        CHECK(whole == ones);
+        CHECK(whole == mixed);
+
+        FHE16_RNG d;
+        FHE16_RNG_seed(&d, seed, 8);
+        std::vector<uint32_t> other(n);
+        FHE16_RNG_u32(&d, other.data(), n);
+        CHECK(other != whole);
+    }
+
+    // ===== uniform mod Q =====
+    for (uint32_t Q : { 2u, 3u, 12289u, 163603457u, 2147483647u, 4294967291u }) {
+        FHE16_RNG a, b;
+        FHE16_RNG_seed(&a, seed, Q);
+        FHE16_RNG_seed(&b, seed, Q);
+        const size_t n = 3000;
+        std::vector<int32_t> vec(n);
+        FHE16_RNG_uniform_Q_vec(&a, vec.data(), n, Q);
+        int bad = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const uint32_t s = FHE16_RNG_uniform_Q(&b, Q);
+            bad += (uint32_t)vec[i] != s || s >= Q;
+        }
+        CHECK(bad == 0);
+    }
+    {
+        // Q = 3: 빈도가 고르게 (n/3 에서 5 표준편차 이내)
+        FHE16_RNG rng;
+        FHE16_RNG_seed(&rng, seed, 3);
+        const int n = 300000;
+        std::vector<int32_t> v(n);
+        FHE16_RNG_uniform_Q_vec(&rng, v.data(), n, 3);
+        int cnt[3] = {};
+        for (int32_t x : v) cnt[x]++;
+        for (int c : cnt) CHECK(std::fabs(c - n / 3.0) < 5 * std::sqrt(n * 2.0 / 9));
+        int32_t one = 5;
+        FHE16_RNG_uniform_Q_vec(&rng, &one, 1, 1);
+        CHECK(one == 0 && FHE16_RNG_uniform_Q(&rng, 1) == 0);
+    }
+
+    // ===== 가우시안 =====
+    for (double sigma : { 3.2, 100.0 }) {
+        FHE16_RNG rng;
+        FHE16_RNG_seed(&rng, seed, 99);
+        const int n = 200001;     // 홀수: 마지막 쌍의 반만 쓰는 경로
+        std::vector<int32_t> v(n);
+        FHE16_RNG_gauss_vec(&rng, v.data(), n, sigma);
+        double sum = 0, sq = 0;
+        for (int32_t x : v) { sum += x; sq += (double)x * x; }
+        const double mean = sum / n, sd = std::sqrt(sq / n - mean * mean);
+        CHECK(std::fabs(mean) < 5 * sigma / std::sqrt((double)n));
+        // 반올림이 분산에 1/12 를 더한다
+        CHECK(std::fabs(sd - std::sqrt(sigma * sigma + 1.0 / 12)) < 0.02 * sigma);
+    }
+
+    // ===== 스레드 컨텍스트 =====
+    {
+        FHE16_RNG* main_rng = FHE16_RNG_thread();
+        CHECK(main_rng && main_rng->seeded);
+        CHECK(FHE16_RNG_thread() == main_rng);
+        uint32_t mine[8], theirs[8] = {};
+        FHE16_RNG_u32(main_rng, mine, 8);
+        FHE16_RNG* other = nullptr;
+        std::thread t([&] {
+            other = FHE16_RNG_thread();
+            if (other) FHE16_RNG_u32(other, theirs, 8);
+        });
+        t.join();
+        CHECK(other && other != main_rng);
+        CHECK(std::memcmp(mine, theirs, sizeof(mine)) != 0);
+    }
+
+    if (g_fail) { std::fprintf(stderr, "test_rng: %d failure(s)\n", g_fail); return 1; }
+    std::printf("test_rng: ok\n");
+    return 0;
+}
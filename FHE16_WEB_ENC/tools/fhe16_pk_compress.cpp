@@ -0,0 +1,112 @@
+// fhe16_pk_compress.cpp — pk.bin → 압축 PK(.fpk) 변환 + 캐시용 매니페스트(.json)
+//
+// 사용법:
+//   fhe16_pk_compress <pk.bin> <out.fpk> <PK_row> <PK_col> <PK_Q> [--seed <64 hex> --uniform-cols <U>]
+//
+// --seed 를 주면 각 행의 앞 U 열이 시드 확장(FHE16_PK_expand_uniform_row)과 같은지 확인하고
+// 그 부분은 저장하지 않는다. 생략하면 전체를 ceil(log2 PK_Q) 비트로 bit-pack.
+// 변환 후 스트리밍 디코더로 다시 풀어서 원본과 같은지 검증한다.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "fhe16_pk_compact.hpp"
+
+static bool parse_hex32(const char* s, uint8_t out[32]) {
+    if (std::strlen(s) != 64) return false;
+    for (int i = 0; i < 32; ++i) {
+        unsigned v;
+        if (std::sscanf(s + 2 * i, "%2x", &v) != 1) return false;
+        out[i] = (uint8_t)v;
+    }
+    return true;
+}
+
+static std::string to_hex(const uint8_t* p, size_t n) {
+    static const char* d = "0123456789abcdef";
+    std::string s;
+    for (size_t i = 0; i < n; ++i) { s += d[p[i] >> 4]; s += d[p[i] & 15]; }
+    return s;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 6) {
+        std::fprintf(stderr, "usage: %s <pk.bin> <out.fpk> <PK_row> <PK_col> <PK_Q> "
+                             "[--seed <64 hex> --uniform-cols <U>]\n", argv[0]);
+        return 2;
+    }
+    const char* in_path  = argv[1];
+    const char* out_path = argv[2];
+    const int rows = std::atoi(argv[3]);
+    const int cols = std::atoi(argv[4]);
+    const uint32_t Q = (uint32_t)std::strtoul(argv[5], nullptr, 10);
+
+    uint8_t seed[32];
+    bool have_seed = false;
+    int uniform_cols = 0;
+    for (int i = 6; i + 1 < argc; i += 2) {
+        if (!std::strcmp(argv[i], "--seed")) {
+            if (!parse_hex32(argv[i + 1], seed)) { std::fprintf(stderr, "bad --seed\n"); return 2; }
+            have_seed = true;
+        } else if (!std::strcmp(argv[i], "--uniform-cols")) {
+            uniform_cols = std::atoi(argv[i + 1]);
+        } else {
+            std::fprintf(stderr, "unknown option %s\n", argv[i]); return 2;
+        }
+    }
+    if (uniform_cols > 0 && !have_seed) { std::fprintf(stderr, "--uniform-cols needs --seed\n"); return 2; }
+
+    // pk.bin 읽기
+    FILE* fp = std::fopen(in_path, "rb");
+    if (!fp) { std::perror(in_path); return 1; }
+    std::vector<int32_t> pk((size_t)rows * cols);
+    const size_t rd = std::fread(pk.data(), sizeof(int32_t), pk.size(), fp);
+    const bool extra = std::fgetc(fp) != EOF;
+    std::fclose(fp);
+    if (rd != pk.size() || extra) {
+        std::fprintf(stderr, "%s: expected %zu int32 words\n", in_path, pk.size());
+        return 1;
+    }
+
+    std::vector<uint8_t> fpk;
+    FHE16_PKCompactHeader hdr;
+    if (!FHE16_PK_compact_encode(pk.data(), rows, cols, Q, uniform_cols, have_seed ? seed : nullptr,
+                                 fpk, &hdr)) {
+        std::fprintf(stderr, "encode failed (value outside [0, Q) or seeded columns mismatch)\n");
+        return 1;
+    }
+
+    // 왕복 검증
+    FHE16_PKStreamDecoder dec;
+    dec.reset();
+    for (size_t off = 0; off < fpk.size(); off += 4096)
+        dec.push(fpk.data() + off, std::min<size_t>(4096, fpk.size() - off));
+    if (!dec.finish() || std::memcmp(dec.pk(), pk.data(), pk.size() * sizeof(int32_t)) != 0) {
+        std::fprintf(stderr, "round-trip verification failed\n");
+        return 1;
+    }
+
+    fp = std::fopen(out_path, "wb");
+    if (!fp) { std::perror(out_path); return 1; }
+    std::fwrite(fpk.data(), 1, fpk.size(), fp);
+    std::fclose(fp);
+
+    // 매니페스트: 브라우저가 받기 전에 캐시(IndexedDB) 키를 알 수 있도록
+    const std::string hash = to_hex(hdr.hash, 32);
+    const std::string json_path = std::string(out_path) + ".json";
+    const char* base = std::strrchr(out_path, '/');
+    base = base ? base + 1 : out_path;
+    fp = std::fopen(json_path.c_str(), "wb");
+    if (!fp) { std::perror(json_path.c_str()); return 1; }
+    std::fprintf(fp, "{\"file\":\"%s\",\"sha256\":\"%s\",\"rows\":%d,\"cols\":%d,\"Q\":%u,"
+                     "\"bits\":%u,\"uniform_cols\":%d,\"bytes\":%zu}\n",
+                 base, hash.c_str(), rows, cols, Q, hdr.bits, uniform_cols, fpk.size());
+    std::fclose(fp);
+
+    std::printf("%s: %zu -> %zu bytes (%.1f%%), sha256=%s\n", out_path, pk.size() * sizeof(int32_t),
+                fpk.size(), 100.0 * fpk.size() / (pk.size() * sizeof(int32_t)), hash.c_str());
+    return 0;
+}
@@ -0,0 +1,33 @@
+{
+  "variables": {
+    "fhe16_inc": "<(module_root_dir)/lib/include",
+    "fhe16_native_arch%": 1
+  },
+  "targets": [
+    {
+      "target_name": "fhe16_addon",
+      "sources": [ "native/fhe16_addon.cc", "native/fhe16_plan.cpp", "native/fhe16_plan_opt.cpp", "native/fhe16_dec_batch.cpp", "native/fhe16_stats.cpp", "native/fhe16_noise.cpp", "native/fhe16_gates.cpp", "native/fhe16_params.cpp" ],
+      "include_dirs": [
+        "<(fhe16_inc)",
+        "<(fhe16_inc)/FHE16/include",
+        "<(fhe16_inc)/FHE16/include/soAPI",
+        "<(fhe16_inc)/FHE16/include/math",
+        "<(fhe16_inc)/FHE16/include/lwe",
+        "<(fhe16_inc)/FHE16/include/thread",
+        "<(fhe16_inc)/FHE16_Module/include",
+        "<(fhe16_inc)/FHE16_Module/include/ntt"
+      ],
+      "defines": [ "NAPI_VERSION=8" ],
+      "cflags_cc": [ "-std=c++17", "-O2", "-fexceptions", "-Wno-ignored-attributes" ],
+      "cflags_cc!": [ "-fno-exceptions", "-std=gnu++1y", "-std=gnu++17" ],
+      "conditions": [
+        [ "fhe16_native_arch==1", { "cflags_cc": [ "-march=native" ] } ]
+      ],
+      "libraries": [
+        "-L<(module_root_dir)/lib/linux-x64",
+        "-lFHE16",
+        "-Wl,-rpath,'$$ORIGIN/../../lib/linux-x64'"
+      ]
+    }
+  ]
+}
@@ -0,0 +1,82 @@
+// FHE16/boot-profile.js — 부트스트랩 스케줄 보정 결과 (boot-tune.js 가 쓰고 server.js 가 읽는다)
+//
+// 키 팩(store/boot/bootparam.bin) 옆에 boot_profile.json 으로 저장:
+//   gate  : 작업 하나만 돌 때 가장 빠른 계획 스레드 수 (지연시간)
+//   batch : 여러 작업이 동시에 돌 때 가장 높은 처리량의 (계획 스레드 수, 동시 작업 수)
+// 키 파일이 바뀌었거나(크기 / 수정 시각 / 앞부분 해시) 코어 수 / 백엔드가 다르면 쓰지 않는다.
+
+const fs = require('fs');
+const path = require('path');
+const crypto = require('crypto');
+
+const PROFILE_VERSION = 1;
+const PROFILE_NAME = 'boot_profile.json';
+const HASH_BYTES = 1 << 20;
+
+function profilePath(bootPath) {
+  return path.join(path.dirname(bootPath), PROFILE_NAME);
+}
+
+// 키 식별자: 전체 해시는 수백 MB 를 읽어야 하므로 크기 + 수정 시각 + 앞 1 MB 해시
+function keyFingerprint(bootPath) {
+  const st = fs.statSync(bootPath);
+  const fd = fs.openSync(bootPath, 'r');
+  try {
+    const buf = Buffer.alloc(Math.min(HASH_BYTES, st.size));
+    fs.readSync(fd, buf, 0, buf.length, 0);
+    return {
+      size: st.size,
+      mtimeMs: Math.floor(st.mtimeMs),
+      head: crypto.createHash('sha256').update(buf).digest('hex').slice(0, 16)
+    };
+  } finally {
+    fs.closeSync(fd);
+  }
+}
+
+function saveBootProfile(bootPath, profile) {
+  const p = profilePath(bootPath);
+  const body = { version: PROFILE_VERSION, key: keyFingerprint(bootPath), ...profile };
+  fs.writeFileSync(p + '.tmp', JSON.stringify(body, null, 2) + '\n');
+  fs.renameSync(p + '.tmp', p);
+  return p;
+}
+
+/**
+ * @returns {{ profile: object|null, reason?: string, path: string }}
+ *   profile 이 null 이면 reason 에 이유 (파일 없음이면 reason 도 없음)
+ */
+function loadBootProfile(bootPath, { cores, backend } = {}) {
+  const p = profilePath(bootPath);
+  let body;
+  try {
+    body = JSON.parse(fs.readFileSync(p, 'utf8'));
+  } catch (e) {
+    return { profile: null, reason: e.code === 'ENOENT' ? undefined : e.message, path: p };
+  }
+  if (body.version !== PROFILE_VERSION) {
+    return { profile: null, reason: `version ${body.version}, want ${PROFILE_VERSION}`, path: p };
+  }
+  let key;
+  try {
+    key = keyFingerprint(bootPath);
+  } catch (e) {
+    return { profile: null, reason: e.message, path: p };
+  }
+  if (!body.key || body.key.size !== key.size || body.key.mtimeMs !== key.mtimeMs || body.key.head !== key.head) {
+    return { profile: null, reason: 'calibrated for a different key pack', path: p };
+  }
+  if (cores !== undefined && body.cores !== cores) {
+    return { profile: null, reason: `calibrated on ${body.cores} cores, this machine has ${cores}`, path: p };
+  }
+  if (backend !== undefined && body.backend !== backend) {
+    return { profile: null, reason: `calibrated with ${body.backend}, running ${backend}`, path: p };
+  }
+  const okInt = (v) => Number.isInteger(v) && v >= 1;
+  if (!body.gate || !okInt(body.gate.parallel) || !body.batch || !okInt(body.batch.parallel) || !okInt(body.batch.concurrency)) {
+    return { profile: null, reason: 'missing gate/batch selection', path: p };
+  }
+  return { profile: body, path: p };
+}
+
+module.exports = { PROFILE_NAME, profilePath, keyFingerprint, saveBootProfile, loadBootProfile };
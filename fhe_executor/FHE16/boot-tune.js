@@ -0,0 +1,199 @@
+/* eslint-disable no-console */
+// FHE16/boot-tune.js — 부트스트랩 스케줄 보정 (이 장비 / 이 키 팩 기준)
+//
+//   node FHE16/boot-tune.js [--parallel 1,2,4,8] [--max-concurrency 1] [--bits 32] [--samples 5] [--jobs-per-slot 2] [--json boot_tune.json]
+//
+// 대표 계획(8 입력 max 트리 → ge → select → add, 부트스트랩 연산 9 단계)을
+//   1) gate  : 혼자 실행할 때 계획 스레드 수(parallel)별 지연시간 중앙값
+//   2) batch : parallel 마다 동시 작업 수 c = min(floor(cores / parallel), max-concurrency) 로 c * jobs-per-slot 개를 돌린 처리량
+// 으로 재서 가장 빠른 조합을 store/boot/boot_profile.json 에 쓴다. server.js 는 FHE16_BOOT_PROFILE=1 일 때만
+// 적용한다 (FHE16_PLAN_PARALLEL / FHE16_THREADS_PER_JOB / FHE16_MAX_JOBS 가 있으면 그쪽이 우선).
+//
+// 모든 실행 결과를 store/keys/secret.bin 으로 복호화해 평문 결과와 비교하고, 틀린 값을 낸 조합은 버린다.
+// 배포된 libFHE16 은 스크래치 버퍼를 호출 스레드의 CPU 로 골라 동시 호출에 안전하지 않으므로,
+// parallel / 동시 작업 수는 라이브러리 동시 호출 한도 (--max-concurrency, 기본 FHE16_MAX_CONCURRENCY 또는 1) 를
+// 넘겨 재지 않는다. 기본 한도 1 에서는 parallel 1 x 작업 1 만 잰다 (틀린 결과 검사는 한도 안에서도 그대로).
+//
+// 블라인드 회전 자체의 변형(BootstrappingRawCRT_SIMD_16bit_*_4_*, _accelerate 등)은 배포된 libFHE16 이
+// 내보내지 않아 여기서 고를 수 없다. 고를 수 있는 것은 라이브러리 밖의 스케줄(스레드 / 동시 실행 수)뿐이다.
+
+const path = require('path');
+const { FHE16, FHE16Async } = require('./index.js');
+const { encodePlan } = require('./plan.js');
+const { saveBootProfile } = require('./boot-profile.js');
+
+const BOOT_PATH = path.join(__dirname, 'store', 'boot', 'bootparam.bin');
+const SECRET_PATH = path.join(__dirname, 'store', 'keys', 'secret.bin');
+const MSGS = [7, -3, 12, 5, 0, 9, -8, 4];
+
+function parseArgs(cores) {
+  const a = {
+    parallel: null,
+    maxConcurrency: Math.max(1, parseInt(process.env.FHE16_MAX_CONCURRENCY || '1', 10) || 1),
+    bits: 32,
+    samples: 5,
+    jobsPerSlot: 2,
+    json: null
+  };
+  const argv = process.argv.slice(2);
+  for (let i = 0; i < argv.length; i += 2) {
+    const flag = argv[i];
+    const val = argv[i + 1];
+    if (val === undefined) throw new Error(`${flag}: missing value`);
+    const num = () => {
+      const n = parseInt(val, 10);
+      if (!(n >= 1)) throw new Error(`${flag}: positive integer expected, got '${val}'`);
+      return n;
+    };
+    switch (flag) {
+      case '--parallel': a.parallel = val.split(',').filter(Boolean).map((s) => Math.max(1, parseInt(s, 10) || 1)); break;
+      case '--max-concurrency': a.maxConcurrency = num(); break;
+      case '--bits': a.bits = num(); break;
+      case '--samples': a.samples = num(); break;
+      case '--jobs-per-slot': a.jobsPerSlot = num(); break;
+      case '--json': a.json = val; break;
+      default: throw new Error(`unknown flag '${flag}'`);
+    }
+  }
+  if (!a.parallel) {
+    a.parallel = [];
+    for (let p = 1; p <= cores; p *= 2) a.parallel.push(p);
+    if (a.parallel[a.parallel.length - 1] !== cores) a.parallel.push(cores);
+  }
+  a.parallel = [...new Set(a.parallel.map((p) => Math.min(p, a.maxConcurrency)))].sort((x, y) => x - y);
+  return a;
+}
+
+// 입력 0..7: max 트리 (독립 단계 4 → 2 → 1), 이후 ge / select / add 는 순차
+function tunePlan() {
+  const steps = [
+    { op: 'max', inputs: [0, 1], output: 'm01' },
+    { op: 'max', inputs: [2, 3], output: 'm23' },
+    { op: 'max', inputs: [4, 5], output: 'm45' },
+    { op: 'max', inputs: [6, 7], output: 'm67' },
+    { op: 'max', inputs: ['m01', 'm23'], output: 'm0' },
+    { op: 'max', inputs: ['m45', 'm67'], output: 'm1' },
+    { op: 'max', inputs: ['m0', 'm1'], output: 'top' },
+    { op: 'ge', inputs: ['top', 0], output: 'flag' },
+    { op: 'select', inputs: ['flag', 'top', 1], output: 'pick' },
+    { op: 'add', inputs: ['pick', 2], output: 'result' },
+  ];
+  return encodePlan(steps, 8, ['result']);
+}
+
+// tunePlan 의 평문 결과
+function expectedResult(m) {
+  const top = Math.max(...m);
+  const pick = top >= m[0] ? top : m[1];
+  return pick + m[2];
+}
+
+function median(v) {
+  const s = [...v].sort((x, y) => x - y);
+  return s[s.length >> 1];
+}
+
+// 결과 암호문들을 복호화해 틀린 개수를 센다 (시간 측정 밖에서)
+async function countWrong(results, sk, want) {
+  let wrong = 0;
+  for (const r of results) {
+    if ((await FHE16Async.decInt(r.outputs[0], sk)) !== want) wrong++;
+  }
+  return wrong;
+}
+
+async function runOnce(plan, inputs, parallel) {
+  const t0 = process.hrtime.bigint();
+  const r = await FHE16Async.runPlan(plan, inputs, { parallel });
+  return { ms: Number(process.hrtime.bigint() - t0) / 1e6, r };
+}
+
+(async () => {
+  if (!FHE16Async.native) {
+    // ffi 폴백은 계획을 단계별로 돌리므로 parallel 이 의미가 없다
+    console.warn('[boot-tune] N-API addon not loaded; only concurrency is calibrated (parallel = 1)');
+  }
+  const cores = FHE16Async.physicalCores();
+  const args = parseArgs(cores);
+  const parallels = FHE16Async.native ? args.parallel : [1];
+
+  console.log('[boot-tune] GenEval + bootparam', BOOT_PATH);
+  if (!FHE16.FHE16_GenEval()) throw new Error('GenEval returned null');
+  FHE16.bootparamLoadFileGlobal(BOOT_PATH);
+  // 결과 검증용. 없으면 빠르기만 하고 틀린 조합을 고를 수 있으므로 보정하지 않는다
+  const sk = FHE16.secretKeyLoadFileSafe ? FHE16.secretKeyLoadFileSafe(SECRET_PATH) : null;
+  if (!sk) throw new Error(`secret key required to verify outputs: ${SECRET_PATH}`);
+
+  const inputs = await Promise.all(MSGS.map((m) => FHE16Async.encInt(m, args.bits)));
+  const plan = tunePlan();
+  const want = expectedResult(MSGS);
+  const rows = [];
+
+  // 0) 기준: 순차 실행 결과부터 맞아야 한다 (아니면 키 팩 불일치)
+  FHE16Async.setMaxConcurrency(1);
+  const warm = await runOnce(plan, inputs, 1); // 워밍업 (키 페이지 적재)
+  if (await countWrong([warm.r], sk, want)) {
+    throw new Error(`sequential run decrypts to a wrong value (want ${want}); check the key pack`);
+  }
+
+  // 1) gate: 혼자 돌 때의 지연시간
+  let gate = null;
+  for (const p of parallels) {
+    const ms = [];
+    const results = [];
+    for (let s = 0; s < args.samples; s++) {
+      const o = await runOnce(plan, inputs, p);
+      ms.push(o.ms);
+      results.push(o.r);
+    }
+    const med = median(ms);
+    const wrong = await countWrong(results, sk, want);
+    console.log(`[boot-tune] gate  parallel ${String(p).padStart(3)}  median ${med.toFixed(1).padStart(9)} ms` +
+                (wrong ? `  REJECTED (${wrong}/${results.length} wrong)` : ''));
+    rows.push({ mode: 'gate', parallel: p, medianMs: +med.toFixed(3), samples: ms.length, wrong });
+    if (!wrong && (!gate || med < gate.ms)) gate = { parallel: p, ms: +med.toFixed(3) };
+  }
+
+  // 2) batch: 코어를 나눠 여러 작업을 동시에
+  let batch = null;
+  for (const p of parallels) {
+    const c = Math.max(1, Math.min(Math.floor(cores / p), args.maxConcurrency));
+    const n = c * args.jobsPerSlot;
+    FHE16Async.setMaxConcurrency(c);
+    const t0 = process.hrtime.bigint();
+    const results = await Promise.all(Array.from({ length: n }, () => FHE16Async.runPlan(plan, inputs, { parallel: p })));
+    const ms = Number(process.hrtime.bigint() - t0) / 1e6;
+    FHE16Async.setMaxConcurrency(1);
+    const wrong = await countWrong(results, sk, want);
+    const jobsPerSec = n / (ms / 1e3);
+    console.log(`[boot-tune] batch parallel ${String(p).padStart(3)}  x ${String(c).padStart(3)} jobs  ${jobsPerSec.toFixed(2).padStart(9)} jobs/s` +
+                (wrong ? `  REJECTED (${wrong}/${n} wrong)` : ''));
+    rows.push({ mode: 'batch', parallel: p, concurrency: c, jobs: n, elapsedMs: +ms.toFixed(3), jobsPerSec: +jobsPerSec.toFixed(3), wrong });
+    if (!wrong && (!batch || jobsPerSec > batch.jobsPerSec)) batch = { parallel: p, concurrency: c, jobsPerSec: +jobsPerSec.toFixed(3) };
+  }
+  // 기준 실행(parallel 1)은 맞았으므로, 모두 거부되면 순차 실행을 고른다
+  if (!gate) gate = { parallel: 1, ms: +warm.ms.toFixed(3) };
+  if (!batch) batch = { parallel: 1, concurrency: 1, jobsPerSec: +(1e3 / warm.ms).toFixed(3) };
+
+  const backend = FHE16Async.native ? 'napi-addon' : 'ffi-async';
+  const out = saveBootProfile(BOOT_PATH, {
+    timestamp: Math.floor(Date.now() / 1000),
+    cores,
+    backend,
+    bits: args.bits,
+    maxConcurrency: args.maxConcurrency,
+    gate,
+    batch
+  });
+  console.log(`[boot-tune] gate: parallel ${gate.parallel} (${gate.ms} ms), batch: parallel ${batch.parallel} x ${batch.concurrency} (${batch.jobsPerSec} jobs/s)`);
+  console.log('[boot-tune] wrote', out);
+
+  if (args.json) {
+    require('fs').writeFileSync(args.json, JSON.stringify({ version: 1, cores, backend, bits: args.bits, maxConcurrency: args.maxConcurrency, results: rows }, null, 2) + '\n');
+    console.log('[boot-tune] wrote', args.json);
+  }
+  process.exit(0);
+})().catch((e) => {
+  console.error('[boot-tune] failed:', e.message || e);
+  process.exit(1);
+});
@@ -153,3 +153,174 @@ export const FHE16Storage: {
   listCiphertextIndices(): number[];
 };
 
+
+// ===== Async API (N-API 애드온 우선, 없으면 ffi-napi async) =====
+// 암호문은 16 meta + 데이터 워드를 담은 Buffer. 애드온 결과 Buffer 는 GC 시 자동 해제.
+export type CtBuffer = Buffer;
+export type SecretKey = Buffer | object; // ref-napi 포인터 Buffer 또는 애드온 external
+
+// 라이브러리 함수별 누적값 (opStats)
+export interface OpStats {
+  op: string;          // 예: "FHE16_GE" (폴백은 호출 이름)
+  calls: number;
+  errors: number;
+  totalMs: number;
+  maxMs: number;
+  bootstraps: number;  // 게이트 수 모델 추정치 (폴백은 0)
+}
+
+export const FHE16Async: {
+  readonly native: boolean;   // N-API 애드온 사용 여부
+  readonly CT_WORDS: number;  // 32비트 암호문 워드 수 (16 + 1040*32)
+
+  fromArray(words: ArrayLike<number>): CtBuffer;
+  toArray(ct: CtBuffer): number[];
+
+  setMaxConcurrency(n: number): void;
+  stats(): { maxConcurrency: number; running: number; queued: number; completed?: number; failed?: number };
+  physicalCores(): number;   // get_physical_core_count (없으면 논리 코어 수)
+  opStats(): OpStats[];
+  resetOpStats(): void;
+  traceStart(capacity?: number): void;
+  traceStop(): string | null;  // Chrome trace JSON (폴백은 null)
+
+  // ENC / DEC
+  enc(msg: number, bit: number): Promise<CtBuffer>;
+  encInt(msg: number, bit: number): Promise<CtBuffer>;
+  encIntVec(msgBuf: Buffer, bit: number): Promise<CtBuffer>;
+  dec(ct: CtBuffer, sk: SecretKey, bits: number): Promise<{ value: number; E: number }>;
+  decInt(ct: CtBuffer, sk: SecretKey): Promise<number>;
+  /** 암호문 여러 개를 한 번에 복호화 (실패한 항목은 null). threads: 0 = 물리 코어 수 */
+  decIntBatch(cts: CtBuffer[], sk: SecretKey, opts?: { threads?: number }): Promise<(number | null)[]>;
+
+  // Compare / Flag
+  compare(a: CtBuffer, b: CtBuffer, flag: boolean): Promise<CtBuffer>;
+  maxOrMin(a: CtBuffer, b: CtBuffer, flag: boolean): Promise<CtBuffer>;
+
+  // Arithmetic / Relational / Logic
+  add(a: CtBuffer, b: CtBuffer): Promise<CtBuffer>;
+  add3(a: CtBuffer, b: CtBuffer, c: CtBuffer): Promise<CtBuffer>;
+  sub(a: CtBuffer, b: CtBuffer): Promise<CtBuffer>;
+  le(a: CtBuffer, b: CtBuffer): Promise<CtBuffer>;
+  lt(a: CtBuffer, b: CtBuffer): Promise<CtBuffer>;
+  ge(a: CtBuffer, b: CtBuffer): Promise<CtBuffer>;
+  gt(a: CtBuffer, b: CtBuffer): Promise<CtBuffer>;
+  max(a: CtBuffer, b: CtBuffer): Promise<CtBuffer>;
+  min(a: CtBuffer, b: CtBuffer): Promise<CtBuffer>;
+  eq(a: CtBuffer, b: CtBuffer): Promise<CtBuffer>;
+  neq(a: CtBuffer, b: CtBuffer): Promise<CtBuffer>;
+  andVec(a: CtBuffer, b: CtBuffer): Promise<CtBuffer>;
+  orVec(a: CtBuffer, b: CtBuffer): Promise<CtBuffer>;
+  xorVec(a: CtBuffer, b: CtBuffer): Promise<CtBuffer>;
+  xor3Vec(a: CtBuffer, b: CtBuffer, c: CtBuffer): Promise<CtBuffer>;   // 애드온: 비트마다 부트스트랩 1회
+  select(sel: CtBuffer, a: CtBuffer, b: CtBuffer): Promise<CtBuffer>;
+
+  // Mult / Div / Relu
+  smull(a: CtBuffer, b: CtBuffer): Promise<CtBuffer>;
+  sdiv3(a: CtBuffer, b: CtBuffer, helper: CtBuffer): Promise<CtBuffer>;
+  relu(a: CtBuffer): Promise<CtBuffer>;
+
+  // Constant
+  smullConst_cvec(ct: CtBuffer, cvec: Buffer): Promise<CtBuffer>;
+  smullConst_i32(ct: CtBuffer, k: number): Promise<CtBuffer>;
+  smullConst_long(ct: CtBuffer, k: number | bigint): Promise<CtBuffer>;
+  addConst_cvec(ct: CtBuffer, cvec: Buffer): Promise<CtBuffer>;
+  addConst_i32(ct: CtBuffer, k: number): Promise<CtBuffer>;
+  addConst_long(ct: CtBuffer, k: number | bigint): Promise<CtBuffer>;
+
+  // Shift / Pow2 / Neg / Abs
+  lshiftlPtr(ct: CtBuffer, ctK: CtBuffer): Promise<CtBuffer>;
+  addPow2(ct: CtBuffer, p: number): Promise<CtBuffer>;
+  subPow2(ct: CtBuffer, p: number): Promise<CtBuffer>;
+  neg(ct: CtBuffer): Promise<CtBuffer>;
+  abs(ct: CtBuffer): Promise<CtBuffer>;
+
+  // Execution plan (plan.js / native/fhe16_plan.hpp)
+  encodePlan(executionPlan: PlanStep[], nInputs: number, outputs?: (string | number)[]): EncodedPlan;
+  optimizePlan(plan: EncodedPlan, opts?: { log2Pfail?: number }): EncodedPlan & { report: PlanOptReport | null };
+  noiseModel(opts?: { log2Pfail?: number; params?: string | ParamsInput }): NoiseModel | null;
+  paramSets(): (FHE16ParamSet & { name: string; note: string })[] | null;
+  currentParams(): (FHE16ParamSet & { name: string }) | null;
+  selectParams(params: string | ParamsInput): FHE16ParamSet & { name: string };
+  runPlan(plan: EncodedPlan, inputs: CtBuffer[], opts?: { parallel?: number }): Promise<PlanResult>;
+};
+
+export interface PlanStep {
+  op: string;                      // 'add' | 'sub' | 'ge' | 'select' | 'smull_constant' | ...
+  inputs: (number | string)[];     // 숫자 = 입력 슬롯, 문자열 = 앞 단계 output 이름
+  output: string | number;
+  constant?: number;               // smull_constant / add_constant
+  pow?: number;                    // add_pow2 / sub_pow2 (shl_constant 는 constant = k)
+}
+
+export interface EncodedPlan {
+  words: Int32Array;               // 'FPL1' 직렬화
+  steps: { op: number; ins: number[]; imm: number }[];
+  nInputs: number;
+  outputs: number[];
+}
+
+export interface PlanOptReport {
+  stepsBefore: number;
+  stepsAfter: number;
+  bootstrapsBefore: number;        // 32비트 게이트 수 모델 추정치 (실측 아님)
+  bootstrapsAfter: number;
+  folded: number;                  // 상수 접기 / 항등식 제거
+  strengthReduced: number;         // 2^k 상수곱 → shl_constant
+  fused: number;                   // select(cmp(a,b), a, b) → max/min
+  xorFused: number;                // xor(xor(a,b), c) → xor3
+  maxXorFanin: number;             // 잡음 한도가 허용한 XOR 입력 수 (2 = 융합 안 함)
+  cse: number;                     // 공통 부분식 제거
+  dead: number;                    // 죽은 단계 제거
+}
+
+export interface NoiseModel {
+  available: boolean;              // 평가 키가 로드됐는지
+  log2Bound: number;               // 실패 확률 한도 (log2)
+  maxXorFanin: number;
+  log2Pfail: number[];             // [i] = 입력 i+1 개를 더한 뒤 부트스트랩할 때의 추정 실패 확률 (log2)
+}
+
+// FHE16Params 필드 (앞의 '_' 없이). n_bk / k_bk / q_bk 는 라이브러리 빌드에 고정
+export interface FHE16ParamSet {
+  n_lwe: number;
+  sigma_lwe: number;
+  sigma_ks: number;
+  sigma_bs: number;
+  q_lwe: number;
+  scaling_lwe: number;
+  q_ks: number;
+  n_ks: number;
+  base_ks: number;
+  base_rm_ks: number;
+  gadget_len_ks: number;
+  base_bk_a: number;
+  base_rm_bk_a: number;
+  base_len_bk_a: number;
+  base_bk_b: number;
+  base_rm_bk_b: number;
+  base_len_bk_b: number;
+  ks_first: boolean;
+  packed_ks: boolean;
+  pk_row: number;
+  pk_col: number;
+  pk_q: number;
+  // 읽기 전용 (빌드 고정 / 계산 값)
+  n_bk: number;
+  k_bk: number;
+  q_num: number;
+  n_lwe_cache: number;
+  q_lwe_bit: number;
+  q_ks_bit: number;
+  q_bk_bit16: number;
+  q_tot: number;
+  q_bk: number[];
+}
+
+// base (세트 이름, 없으면 현재 세트) 에서 주어진 필드만 바꾼다. 가젯 길이를 안 주면 다시 계산
+export type ParamsInput = Partial<FHE16ParamSet> & { base?: string; name?: string };
+
+export interface PlanResult {
+  outputs: CtBuffer[];
+  stats: { steps: number; maxLive: number; elapsedUs: number };
+}
@@ -2,6 +2,7 @@
 const path = require('path');
 const ffi = require('ffi-napi');
 const ref = require('ref-napi');
+const { encodePlan, decodePlan, runPlanJS } = require('./plan.js');
 
 const int = ref.types.int;
 const int32 = ref.types.int32;
@@ -54,6 +55,7 @@ function bufFromCharPtr(ptr, len) {
 /* ---------------- core / serialization ---------------- */
 
 const fnGenEval = must(['_Z13FHE16_GenEvalv', 'FHE16_GenEval'], int32Ptr, []);
+const fnPhysicalCores = first(['_Z23get_physical_core_countv', 'get_physical_core_count'], int, []);
 
 const fnBpLoadGlobal      = must(['_Z31fhe16bootparam_load_file_globalPKc', 'fhe16bootparam_load_file_global'], int, ['string']);
 const fnBpSaveGlobal      = first(['_Z31fhe16bootparam_save_file_globalPKc', 'fhe16bootparam_save_file_global'], int, ['string']);
@@ -324,5 +326,211 @@ const FHE16 = {
   neq(a,b){ if (!fnNEQ) throw new Error('FHE16_NEQ not exported'); return fnNEQ(a,b); },
 };
 
-module.exports = { FHE16 };
+/* ------------------------------ async API ------------------------------ */
+// 모든 연산이 Promise<Buffer> 를 돌려준다 (결과 Buffer = 암호문 전체, 16 meta + 데이터).
+// 1순위: N-API 애드온 (build/Release/fhe16_addon.node) — 워커 스레드 실행, 입력 제로카피,
+//        결과 메모리는 GC 시 finalizer 가 해제.
+// 2순위: ffi-napi 의 .async() (libuv 스레드풀) — 결과 포인터는 해제되지 않음 (기존 동작과 동일).
+// 두 경로 모두 libFHE16 전역 상태 때문에 동시 실행 수를 제한한다 (기본 1, setMaxConcurrency).
+
+const CT_META = 16;
+const LWE_WORDS = 1040;
+const CT_WORDS = CT_META + LWE_WORDS * 32;
+
+let addon = null;
+if (!process.env.FHE16_NO_ADDON) {
+  for (const rel of ['build/Release/fhe16_addon.node', 'lib/linux-x64/fhe16_addon.node']) {
+    try {
+      addon = require(path.join(__dirname, rel));
+      if (!process.env.QUIET_FHE16) console.log('[FHE16] N-API addon:', rel);
+      break;
+    } catch (e) {
+      if (e.code !== 'MODULE_NOT_FOUND' && !process.env.QUIET_FHE16) console.log('[FHE16] addon load failed:', rel, `(${e.message})`);
+    }
+  }
+}
+
+// 메타 [0] = 비트 수, [1] = 비트당 워드 수 (1040). 애드온의 FHE16_ct_words() 와 동일 규칙
+function ctWordsOf(ptr) {
+  const meta = ref.reinterpret(ptr, CT_META * 4, 0);
+  const bits = meta.readInt32LE(0);
+  return (bits > 0 && bits <= 64 && meta.readInt32LE(4) === LWE_WORDS) ? CT_META + bits * LWE_WORDS : CT_WORDS;
+}
+
+// ffi 경로의 동시 실행 제한
+const ffiGate = { max: 1, running: 0, queue: [] };
+// ffi 경로의 연산별 카운터 (opStats). 키는 호출 이름 그대로, 부트스트랩 추정 없음
+let ffiOpStats = new Map();
+function ffiRecord(name, ms, ok) {
+  let s = ffiOpStats.get(name);
+  if (!s) ffiOpStats.set(name, (s = { op: name, calls: 0, errors: 0, totalMs: 0, maxMs: 0, bootstraps: 0 }));
+  s.calls++;
+  if (!ok) s.errors++;
+  s.totalMs += ms;
+  if (ms > s.maxMs) s.maxMs = ms;
+}
+function ffiPump() {
+  while (ffiGate.running < ffiGate.max && ffiGate.queue.length) {
+    const job = ffiGate.queue.shift();
+    ffiGate.running++;
+    const t0 = process.hrtime.bigint();
+    job.fn.async(...job.args, (err, res) => {
+      ffiGate.running--;
+      const ms = Number(process.hrtime.bigint() - t0) / 1e6;
+      ffiRecord(job.name, ms, !err);
+      if (job.acct) job.acct.execMs += ms;
+      ffiPump();
+      if (err) job.reject(err); else job.resolve(res);
+    });
+  }
+}
+// acct 가 있으면 슬롯을 잡고 실행한 시간(큐 대기 제외)을 acct.execMs 에 더한다
+function ffiAsync(fn, name, args, acct = null) {
+  if (!fn) return Promise.reject(new Error(`${name} not exported`));
+  return new Promise((resolve, reject) => { ffiGate.queue.push({ fn, name, args, acct, resolve, reject }); ffiPump(); });
+}
+async function ffiCt(fn, name, args, acct = null) {
+  const ptr = await ffiAsync(fn, name, args, acct);
+  if (!ptr || ref.isNull(ptr)) throw new Error(`${name} returned null`);
+  return ref.reinterpret(ptr, ctWordsOf(ptr) * 4, 0);
+}
+
+// [jsName, ffi fn, ffi 인자 변환]
+const ASYNC_CT_OPS = [
+  ['add', fnAdd], ['add3', fnAdd3], ['sub', fnSub],
+  ['le', fnLE], ['lt', fnLT], ['ge', fnGE], ['gt', fnGT], ['max', fnMAX], ['min', fnMIN],
+  ['eq', fnEQ], ['neq', fnNEQ],
+  ['andVec', fnANDVEC], ['orVec', fnORVEC], ['xorVec', fnXORVEC], ['select', fnSELECT],
+  ['smull', fnSMULL], ['sdiv3', fnSDIV3], ['relu', fnRELU], ['neg', fnNEG], ['abs', fnABS],
+  ['lshiftlPtr', fnLSHIFTL_PTR],
+  ['smullConst_cvec', fnSMULL_CONST_CVEC], ['addConst_cvec', fnADD_CONST_CVEC],
+  ['smullConst_i32', fnSMULL_CONST_I32, (ct, k) => [ct, k | 0]],
+  ['smullConst_long', fnSMULL_CONST_LONG, (ct, k) => [ct, Number(k)]],
+  ['addConst_i32', fnADD_CONST_I32, (ct, k) => [ct, k | 0]],
+  ['addConst_long', fnADD_CONST_LONG, (ct, k) => [ct, Number(k)]],
+  ['addPow2', fnADD_POWTWO, (ct, p) => [ct, p | 0]],
+  ['subPow2', fnSUB_POWTWO, (ct, p) => [ct, p | 0]],
+  ['compare', fnCompare, (a, b, flag) => [a, b, flag ? 1 : 0]],
+  ['maxOrMin', fnMaxOrMin, (a, b, flag) => [a, b, flag ? 1 : 0]],
+  ['enc', fnEnc, (msg, bit) => [msg | 0, bit | 0]],
+  ['encInt', fnEncInt, (msg, bit) => [msg | 0, bit | 0]],
+  ['encIntVec', fnEncIntVec, (vec, bit) => [vec, bit | 0]],
+];
+
+const FHE16Async = {
+  native: !!addon,
+  CT_WORDS,
+
+  // JSON 숫자 배열 ↔ 암호문 Buffer (복사 1회, 더미 암호화 불필요)
+  fromArray(words) {
+    const buf = Buffer.allocUnsafeSlow(words.length * 4);
+    new Int32Array(buf.buffer, buf.byteOffset, words.length).set(words);
+    return buf;
+  },
+  toArray(ct) {
+    return Array.from(new Int32Array(ct.buffer, ct.byteOffset, ct.length >> 2));
+  },
+
+  setMaxConcurrency(n) {
+    if (!(n >= 1)) throw new RangeError('setMaxConcurrency: n must be >= 1');
+    if (addon) addon.setMaxConcurrency(n | 0);
+    ffiGate.max = n | 0;
+    ffiPump();
+  },
+  // 물리 코어 수 (libFHE16 get_physical_core_count). 심볼이 없으면 논리 코어 수
+  physicalCores() {
+    const n = addon ? addon.physicalCores() : (fnPhysicalCores ? fnPhysicalCores() : 0);
+    return n > 0 ? n : require('os').cpus().length;
+  },
+  stats() {
+    if (addon) return addon.stats();
+    return { maxConcurrency: ffiGate.max, running: ffiGate.running, queued: ffiGate.queue.length };
+  },
+  // 라이브러리 함수별 호출 수 / 실패 수 / 누적·최대 시간 / 추정 부트스트랩 수 (마지막 resetOpStats 이후)
+  //   애드온: FHE16_* 함수 이름별, 계획 단계와 배치 복호화의 개별 호출 포함
+  //   폴백  : 호출 이름별 (bootstraps = 0)
+  opStats() {
+    if (addon) return addon.opStats();
+    return [...ffiOpStats.values()].map((s) => ({ ...s }));
+  },
+  resetOpStats() {
+    if (addon) addon.resetOpStats();
+    else ffiOpStats = new Map();
+  },
+  // 추적: traceStart 이후의 라이브러리 호출을 span 으로 기록 → traceStop 이 Chrome trace JSON 문자열
+  //   (chrome://tracing, ui.perfetto.dev). 애드온 전용 — 폴백에서는 traceStop 이 null
+  traceStart(capacity = 65536) {
+    if (addon) addon.traceStart(capacity);
+  },
+  traceStop() {
+    return addon ? addon.traceStop() : null;
+  },
+
+  decInt(ct, sk) {
+    if (addon) return addon.decInt(ct, sk);
+    return ffiAsync(fnDecInt, 'FHE16_DECInt', [ct, sk]).then(Number);
+  },
+  // 암호문 여러 개를 한 번에 복호화 → (number|null)[] (실패한 항목은 null)
+  //   애드온: 비동기 작업 1회, threads 개 스레드가 블록 단위로 나눠 처리 (기본 1)
+  //   폴백  : 암호문마다 FFI 비동기 호출
+  decIntBatch(cts, sk, opts = {}) {
+    if (addon) return addon.decIntBatch(cts, sk, opts.threads | 0);
+    return Promise.all(cts.map((ct) => ffiAsync(fnDecInt, 'FHE16_DECInt', [ct, sk]).then(Number, () => null)));
+  },
+  dec(ct, sk, bits) {
+    if (addon) return addon.dec(ct, sk, bits | 0);
+    const E_out = ref.alloc(int);
+    return ffiAsync(fnDec, 'FHE16_DEC', [ct, sk, bits | 0, E_out]).then((v) => ({ value: v | 0, E: E_out.deref() | 0 }));
+  },
+};
+
+for (const [name, fn, conv] of ASYNC_CT_OPS) {
+  FHE16Async[name] = addon
+    ? (...args) => addon[name](...args)
+    : (...args) => ffiCt(fn, name, conv ? conv(...args) : args);
+}
+
+// 실행 계획 전체를 한 번에 실행 (plan = encodePlan(...) 결과)
+//   애드온: 네이티브 인터프리터 1회 호출 (생존 구간 기반 해제, parallel 개 스레드, setMaxConcurrency 한도 이내)
+//   폴백  : runPlanJS (단계별 FHE16Async 호출)
+FHE16Async.encodePlan = encodePlan;
+// 실행 전 계획 최적화 (CSE / 상수 접기 / 비교+선택 → MAX/MIN / XOR 융합 / DCE). 애드온 없으면 그대로 (report = null)
+//   XOR 융합은 잡음 모델의 실패 확률이 opts.log2Pfail (기본 FHE16_NOISE_LOG2_PFAIL 또는 -40) 이하일 때만
+FHE16Async.optimizePlan = (plan, opts = {}) => {
+  if (!addon) return { ...plan, report: null };
+  const { words, report } = addon.optimizePlan(plan.words, opts);
+  return { ...decodePlan(words), report };
+};
+// 평가 키의 잡음 추정 (fhe16_noise.hpp). 애드온 전용 — 폴백에서는 null
+FHE16Async.noiseModel = (opts = {}) => (addon ? addon.noiseModel(opts) : null);
+// 파라미터 세트 (fhe16_params.hpp). 애드온 전용 — 폴백에서는 null / selectParams 는 throw
+//   selectParams 는 GenEval / 평가 키 로드 전에만. 평가 키는 그 키를 만든 세트에서만 쓸 수 있다
+FHE16Async.paramSets = () => (addon ? addon.paramSets() : null);
+FHE16Async.currentParams = () => (addon ? addon.currentParams() : null);
+FHE16Async.selectParams = (params) => {
+  if (!addon) throw new Error('selectParams: N-API addon not loaded');
+  return addon.selectParams(params);
+};
+// a ^ b ^ c: 애드온은 비트마다 부트스트랩 1회 (C_FHE16_XOR3), 폴백은 xorVec 두 번
+FHE16Async.xor3Vec = addon
+  ? (a, b, c) => addon.xor3Vec(a, b, c)
+  : async (a, b, c) => FHE16Async.xorVec(await FHE16Async.xorVec(a, b), c);
+//   stats.execUs = 실행 시간 (큐 대기 제외). 애드온은 작업 스레드 안에서 잰 elapsedUs,
+//   폴백은 단계 호출이 ffi 슬롯을 잡고 있던 시간의 합
+FHE16Async.runPlan = async (plan, inputs, opts = {}) => {
+  if (addon) {
+    const r = await addon.runPlan(plan.words, inputs, opts.parallel || 1);
+    r.stats.execUs = r.stats.elapsedUs;
+    return r;
+  }
+  const acct = { execMs: 0 };
+  const api = {};
+  for (const [name, fn, conv] of ASYNC_CT_OPS) api[name] = (...args) => ffiCt(fn, name, conv ? conv(...args) : args, acct);
+  api.xor3Vec = async (a, b, c) => api.xorVec(await api.xorVec(a, b), c);
+  const r = await runPlanJS(api, plan, inputs);
+  r.stats.execUs = Math.round(acct.execMs * 1000);
+  return r;
+};
+
+module.exports = { FHE16, FHE16Async };
 
@@ -481,6 +481,214 @@ inline int16_t ShoupMulARM_16bit(int16_t a, int16_t w, int16_t w_prime, int16_t
 
 
 
+/******************************** 16bit lazy reduction (accumulator) ***********************************
+* 누산기를 매 덧셈마다 [0, Q) 로 줄이지 않고 uint16 레인의 여유 안에서 미뤘다가 한 번에 줄인다.
+*
+* 표현 : 레인은 uint16 으로 해석 (저장은 기존과 같은 int16_t 배열). 값 x 는 합동류 x mod Q 를 나타낸다.
+* 한도 : "bound = b" 는 모든 레인이 0 <= x < b*Q 임을 뜻한다. 정규형 [0, Q) 는 b = 1.
+*   - 더하기 (a + y,        y < kQ)   : b -> b + k
+*   - 빼기   (a + (kQ - y), y < kQ)   : b -> b + k     (음수가 되지 않게 kQ 를 더해 둔다)
+*   - 오버플로 없음 <=> b*Q <= 2^16, 즉 b <= LAZY_MAX_BOUND_16bit(Q) = floor(2^16 / Q)
+*     Q = 12289 -> 5, 13313 -> 4, 18433 -> 3 (정규형 입력이면 4 / 3 / 2 번 더할 때마다 한 번 줄이면 된다)
+*
+* 줄이기 : x in [0, 2^16) -> [0, Q), Q 는 2 의 거듭제곱이 아닌 2^8 < Q < 2^15
+*   s = floor(log2 Q), M = floor(2^(16+s) / Q)            (2^s < Q 이므로 M < 2^16)
+*   q' = floor(x*M / 2^(16+s)) = mulhi_epu16(x, M) >> s
+*   q  = floor(x / Q) 라 하면 0 <= x/Q - x*M/2^(16+s) < x/2^(16+s) < 2^-s < 1 이므로 q' in {q - 1, q}
+*   r  = x - q'*Q in [0, 2Q) 이고 2Q < 2^16 이므로 mod 2^16 (mullo / sub) 으로 정확히 계산된다
+*   r >= Q 면 r - Q : min_epu16(r, r - Q) (r < Q 면 r - Q 가 감겨서 커지므로 r 이 선택됨)
+*
+* 따로 줄이는 패스를 만들지 않도록 누산기는 넘치기 직전의 덧셈 / 뺄셈에 줄이기를 합쳐 한 패스로 처리한다
+* (LazyReduceAccVec_16bit). 정규형 입력 K 개를 더하면 즉시 줄이는 방식의 K 번 축약 대신 약 K / (b_max - 1) 번.
+* 분해 (SignedDecompTwoPowRemoveCRT2_16bit 등) 와 NTT 는 정규형 입력을 가정하므로 그 전에 LazyAccFlush_16bit.
+* 헤더 전용 — libFHE16 의 블라인드 회전과 애드온은 아직 쓰지 않는다. 검사: fhe_executor/FHE16/tests/test_reduction.cpp
+******************************************************************************************************/
+
+#define LAZY_MAX_BOUND_16bit(Q)	((int)(65536 / (int)(Q)))
+
+inline int LazyBarrettShift_16bit(int16_t Q) {
+	int s = 0;
+	while ((2 << s) <= Q) s++;
+	return s;
+}
+
+inline uint16_t LazyBarrettConst_16bit(int16_t Q, int s) {
+	return (uint16_t)((1u << (16 + s)) / (uint32_t)Q);
+}
+
+inline uint16_t LazyReduce_16bit(uint16_t v, uint16_t M, int s, int16_t Q) {
+	uint16_t r = (uint16_t)(v - (uint16_t)((((uint32_t)v * M) >> (16 + s)) * (uint32_t)Q));
+	return r >= (uint16_t)Q ? (uint16_t)(r - (uint16_t)Q) : r;
+}
+
+// 레지스터 하나 줄이기 (r 은 임시 레지스터, vM / vQ / vs 는 위 상수)
+#define LAZY_REDUCE_16bitVec512(v, r, vM, vQ, vs) \
+	r = _mm512_sub_epi16(v, _mm512_mullo_epi16(_mm512_srl_epi16(_mm512_mulhi_epu16(v, vM), vs), vQ)); \
+	v = _mm512_min_epu16(r, _mm512_sub_epi16(r, vQ));
+
+#define LAZY_REDUCE_16bitVec256(v, r, vM, vQ, vs) \
+	r = _mm256_sub_epi16(v, _mm256_mullo_epi16(_mm256_srl_epi16(_mm256_mulhi_epu16(v, vM), vs), vQ)); \
+	v = _mm256_min_epu16(r, _mm256_sub_epi16(r, vQ));
+
+// x in [0, 2^16) (uint16 로 해석) -> [0, Q)
+inline void LazyReduceVec_16bit(int16_t *x, int N, int16_t Q) {
+	const int s			= LazyBarrettShift_16bit(Q);
+	const uint16_t M	= LazyBarrettConst_16bit(Q, s);
+	int ii = 0;
+#if AVXTYPE == 3
+	const __m512i vM = _mm512_set1_epi16((int16_t)M);
+	const __m512i vQ = _mm512_set1_epi16(Q);
+	const __m128i vs = _mm_cvtsi32_si128(s);
+	for (; ii + 32 <= N; ii += 32) {
+		__m512i v = _mm512_loadu_si512(x + ii), r;
+		LAZY_REDUCE_16bitVec512(v, r, vM, vQ, vs);
+		_mm512_storeu_si512(x + ii, v);
+	}
+#elif AVXTYPE == 2
+	const __m256i vM = _mm256_set1_epi16((int16_t)M);
+	const __m256i vQ = _mm256_set1_epi16(Q);
+	const __m128i vs = _mm_cvtsi32_si128(s);
+	for (; ii + 16 <= N; ii += 16) {
+		__m256i v = _mm256_loadu_si256((const __m256i *)(x + ii)), r;
+		LAZY_REDUCE_16bitVec256(v, r, vM, vQ, vs);
+		_mm256_storeu_si256((__m256i *)(x + ii), v);
+	}
+#endif
+	for (; ii < N; ii++) x[ii] = (int16_t)LazyReduce_16bit((uint16_t)x[ii], M, s, Q);
+}
+
+// c = a + b (mod 2^16, 줄이지 않음). 한도: bound(c) = bound(a) + bound(b)
+inline void LazyAddVec_16bit(const int16_t *a, const int16_t *b, int16_t *c, int N) {
+	int ii = 0;
+#if AVXTYPE == 3
+	for (; ii + 32 <= N; ii += 32)
+		_mm512_storeu_si512(c + ii, _mm512_add_epi16(_mm512_loadu_si512(a + ii), _mm512_loadu_si512(b + ii)));
+#elif AVXTYPE == 2
+	for (; ii + 16 <= N; ii += 16)
+		_mm256_storeu_si256((__m256i *)(c + ii), _mm256_add_epi16(_mm256_loadu_si256((const __m256i *)(a + ii)),
+		                                                          _mm256_loadu_si256((const __m256i *)(b + ii))));
+#endif
+	for (; ii < N; ii++) c[ii] = (int16_t)((uint16_t)a[ii] + (uint16_t)b[ii]);
+}
+
+// c = a + (kQ - b), b < kQ. 한도: bound(c) = bound(a) + k
+inline void LazySubVec_16bit(const int16_t *a, const int16_t *b, int16_t *c, int k, int16_t Q, int N) {
+	const uint16_t kQ = (uint16_t)(k * Q);
+	int ii = 0;
+#if AVXTYPE == 3
+	const __m512i vkQ = _mm512_set1_epi16((int16_t)kQ);
+	for (; ii + 32 <= N; ii += 32)
+		_mm512_storeu_si512(c + ii, _mm512_sub_epi16(_mm512_add_epi16(_mm512_loadu_si512(a + ii), vkQ), _mm512_loadu_si512(b + ii)));
+#elif AVXTYPE == 2
+	const __m256i vkQ = _mm256_set1_epi16((int16_t)kQ);
+	for (; ii + 16 <= N; ii += 16)
+		_mm256_storeu_si256((__m256i *)(c + ii), _mm256_sub_epi16(_mm256_add_epi16(_mm256_loadu_si256((const __m256i *)(a + ii)), vkQ),
+		                                                          _mm256_loadu_si256((const __m256i *)(b + ii))));
+#endif
+	for (; ii < N; ii++) c[ii] = (int16_t)((uint16_t)a[ii] + kQ - (uint16_t)b[ii]);
+}
+
+// x = reduce(x) + y            (sub = 0, off 무시)      한도: 1 + bound(y)
+// x = reduce(x) + (off - y)    (sub = 1, off = kQ > y) 한도: 1 + k
+inline void LazyReduceAccVec_16bit(int16_t *x, const int16_t *y, int sub, uint16_t off, int16_t Q, int N) {
+	const int s			= LazyBarrettShift_16bit(Q);
+	const uint16_t M	= LazyBarrettConst_16bit(Q, s);
+	if (!sub) off = 0;
+	int ii = 0;
+#if AVXTYPE == 3
+	const __m512i vM	= _mm512_set1_epi16((int16_t)M);
+	const __m512i vQ	= _mm512_set1_epi16(Q);
+	const __m128i vs	= _mm_cvtsi32_si128(s);
+	const __m512i voff	= _mm512_set1_epi16((int16_t)off);
+	if (sub) {
+		for (; ii + 32 <= N; ii += 32) {
+			__m512i v = _mm512_loadu_si512(x + ii), r;
+			LAZY_REDUCE_16bitVec512(v, r, vM, vQ, vs);
+			_mm512_storeu_si512(x + ii, _mm512_sub_epi16(_mm512_add_epi16(v, voff), _mm512_loadu_si512(y + ii)));
+		}
+	} else {
+		for (; ii + 32 <= N; ii += 32) {
+			__m512i v = _mm512_loadu_si512(x + ii), r;
+			LAZY_REDUCE_16bitVec512(v, r, vM, vQ, vs);
+			_mm512_storeu_si512(x + ii, _mm512_add_epi16(v, _mm512_loadu_si512(y + ii)));
+		}
+	}
+#elif AVXTYPE == 2
+	const __m256i vM	= _mm256_set1_epi16((int16_t)M);
+	const __m256i vQ	= _mm256_set1_epi16(Q);
+	const __m128i vs	= _mm_cvtsi32_si128(s);
+	const __m256i voff	= _mm256_set1_epi16((int16_t)off);
+	if (sub) {
+		for (; ii + 16 <= N; ii += 16) {
+			__m256i v = _mm256_loadu_si256((const __m256i *)(x + ii)), r;
+			LAZY_REDUCE_16bitVec256(v, r, vM, vQ, vs);
+			_mm256_storeu_si256((__m256i *)(x + ii), _mm256_sub_epi16(_mm256_add_epi16(v, voff), _mm256_loadu_si256((const __m256i *)(y + ii))));
+		}
+	} else {
+		for (; ii + 16 <= N; ii += 16) {
+			__m256i v = _mm256_loadu_si256((const __m256i *)(x + ii)), r;
+			LAZY_REDUCE_16bitVec256(v, r, vM, vQ, vs);
+			_mm256_storeu_si256((__m256i *)(x + ii), _mm256_add_epi16(v, _mm256_loadu_si256((const __m256i *)(y + ii))));
+		}
+	}
+#endif
+	for (; ii < N; ii++) {
+		uint16_t r = (uint16_t)(LazyReduce_16bit((uint16_t)x[ii], M, s, Q) + off);
+		x[ii] = (int16_t)(sub ? (uint16_t)(r - (uint16_t)y[ii]) : (uint16_t)(r + (uint16_t)y[ii]));
+	}
+}
+
+// 누산기: 한도를 들고 다니다가 다음 연산이 넘칠 때만 (그 연산과 합쳐서) 줄인다
+typedef struct {
+	int16_t *x;			// N 개 (uint16 로 해석)
+	int		N;
+	int16_t	Q;
+	int		bound;		// 0 <= x < bound * Q
+	int		max_bound;	// LAZY_MAX_BOUND_16bit(Q)
+} LazyAcc_16bit;
+
+// x 는 [0, Q) 로 시작 (bound = 1)
+inline void LazyAccInit_16bit(LazyAcc_16bit *acc, int16_t *x, int N, int16_t Q) {
+	acc->x			= x;
+	acc->N			= N;
+	acc->Q			= Q;
+	acc->bound		= 1;
+	acc->max_bound	= LAZY_MAX_BOUND_16bit(Q);
+}
+
+// x += y, y < bound_y * Q (정규형이면 1). bound_y < max_bound 이어야 한다
+inline void LazyAccAdd_16bit(LazyAcc_16bit *acc, const int16_t *y, int bound_y) {
+	if (acc->bound + bound_y > acc->max_bound) {
+		LazyReduceAccVec_16bit(acc->x, y, 0, 0, acc->Q, acc->N);
+		acc->bound = 1 + bound_y;
+	} else {
+		LazyAddVec_16bit(acc->x, y, acc->x, acc->N);
+		acc->bound += bound_y;
+	}
+}
+
+// x -= y, y < bound_y * Q. bound_y < max_bound 이어야 한다
+inline void LazyAccSub_16bit(LazyAcc_16bit *acc, const int16_t *y, int bound_y) {
+	if (acc->bound + bound_y > acc->max_bound) {
+		LazyReduceAccVec_16bit(acc->x, y, 1, (uint16_t)(bound_y * acc->Q), acc->Q, acc->N);
+		acc->bound = 1 + bound_y;
+	} else {
+		LazySubVec_16bit(acc->x, y, acc->x, bound_y, acc->Q, acc->N);
+		acc->bound += bound_y;
+	}
+}
+
+// 분해 / NTT / 외부로 내보내기 전에: [0, Q) 로
+inline void LazyAccFlush_16bit(LazyAcc_16bit *acc) {
+	if (acc->bound > 1) {
+		LazyReduceVec_16bit(acc->x, acc->N, acc->Q);
+		acc->bound = 1;
+	}
+}
+
+
+
+
 
 
 
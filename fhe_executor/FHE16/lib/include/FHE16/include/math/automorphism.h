@@ -13,6 +13,12 @@
 	#include<stdint.h>
 #endif
 
+#if AVXTYPE == 2
+	#include<immintrin.h>
+#elif AVXTYPE == 3
+	#include<immintrin.h>
+#endif
+
 
 #ifdef __cplusplus
 extern "C" {
@@ -71,6 +77,120 @@ inline void Automorphism_Coeff_32bit(int32_t *x, int32_t *tmps, int32_t *Q_arr,
 
 
 
+/******************************** Automorphism without copy-back ***********************************/
+// 아래 함수들은 헤더 전용 보조 함수로, libFHE16 (블라인드 회전) 과 애드온은 아직 호출하지 않는다.
+// 스칼라 정의와의 비교: fhe_executor/FHE16/tests/test_automorphism.cpp
+// x -> y (out-of-place), X -> X^idx.  Automorphism_Coeff_*bit 과 같은 결과지만 tmps 복사가 없고
+// 곱셈 대신 누적 덧셈으로 위치를 구하며, 부정은 마스크로 (분기 없음).  x 와 y 는 겹치면 안 됨
+
+inline void Automorphism_Coeff_16bit_To(const int16_t *x, int16_t *y, const int16_t *Q_arr, int idx, int N, int q_num) {
+
+	const int M_mask = (N << 1) - 1;
+	const int N_mask = N - 1;
+	const int step = idx & M_mask;
+	for (int jj = 0; jj < q_num; jj++) {
+		const int Q = Q_arr[jj];
+		const int16_t *xj = x + jj*N;
+		int16_t *yj = y + jj*N;
+		int to = 0;
+		for (int ii = 0; ii < N; ii++) {
+			const int v = xj[ii];
+			const int neg = -(to >= N);				// 0 or -1
+			yj[to & N_mask] = (int16_t)(v + (neg & (Q - 2*v)));	// neg ? Q - v : v
+			to = (to + step) & M_mask;
+		}
+	}
+}
+
+inline void Automorphism_Coeff_32bit_To(const int32_t *x, int32_t *y, const int32_t *Q_arr, int idx, int N, int q_num) {
+
+	const int M_mask = (N << 1) - 1;
+	const int N_mask = N - 1;
+	const int step = idx & M_mask;
+	for (int jj = 0; jj < q_num; jj++) {
+		const int64_t Q = Q_arr[jj];
+		const int32_t *xj = x + jj*N;
+		int32_t *yj = y + jj*N;
+		int to = 0;
+		for (int ii = 0; ii < N; ii++) {
+			const int64_t v = xj[ii];
+			const int64_t neg = -(int64_t)(to >= N);
+			yj[to & N_mask] = (int32_t)(v + (neg & (Q - 2*v)));
+			to = (to + step) & M_mask;
+		}
+	}
+}
+
+
+/******************************** NTT-domain automorphism ***********************************/
+// 완전 NTT(깊이 0)에서 NTT 값은 X^N + 1 의 근에서의 평가값이므로 X -> X^idx 는 슬롯 순열이다
+// (부정 없음, INTT/NTT 왕복 없음).  순열은 NTT 구현의 출력 순서에 따르므로 NTT 로 직접 구한다:
+//   a = NTT(X), b = NTT(X^idx)  →  perm[j] = a 에서 b[j] 값이 있는 위치
+// 몽고메리 등 상수배는 a, b 에 똑같이 걸리므로 상관없다.  불완전 NTT(깊이 > 0)는 슬롯이 다항식이라
+// 순열이 아니다 → Automorphism_NTT_Perm_16bit 가 -1.
+
+// X^idx mod (X^N + 1) 의 계수 (idx mod 2N >= N 이면 -X^(idx-N) → Q - 1)
+inline void Automorphism_Monomial_16bit(int16_t *out, int idx, int N, int16_t Q) {
+	const int e = idx & ((N << 1) - 1);
+	for (int ii = 0; ii < N; ii++) out[ii] = 0;
+	out[e & (N - 1)] = (e >= N) ? (int16_t)(Q - 1) : 1;
+}
+
+// 모듈러스 하나의 순열. scratch 는 Q 개 (NTT 값 → 위치), 값은 [0, Q) 여야 함
+// 반환: 0 = 성공, -1 = 순열이 아님 (불완전 NTT / 값 범위 밖 / 중복)
+inline int Automorphism_NTT_Perm_16bit(const int16_t *ntt_x, const int16_t *ntt_x_idx, int16_t *perm,
+		int16_t *scratch, int N, int16_t Q) {
+
+	for (int v = 0; v < Q; v++) scratch[v] = -1;
+	for (int k = 0; k < N; k++) {
+		const int v = ntt_x[k];
+		if (v < 0 || v >= Q || scratch[v] >= 0) return -1;
+		scratch[v] = (int16_t)k;
+	}
+	for (int j = 0; j < N; j++) {
+		const int v = ntt_x_idx[j];
+		if (v < 0 || v >= Q || scratch[v] < 0) return -1;
+		perm[j] = scratch[v];
+		scratch[v] = -2;		// 같은 값이 두 번 나오면 순열이 아님
+	}
+	return 0;
+}
+
+// y[j] = x[perm[j]], j < len.  perm 은 절대 위치 (모듈러스 jj 의 순열에 jj*N 을 더한 것)
+// gather 는 32비트 단위라 x[perm[j] + 1] 까지 읽으므로 마지막 원소(len-1)를 읽는 묶음은 스칼라로
+inline void Automorphism_NTT_16bit(const int16_t *x, int16_t *y, const int16_t *perm, int len) {
+
+	int j = 0;
+#if AVXTYPE == 3 && defined(__AVX512F__)
+	const __m512i last16 = _mm512_set1_epi32(len - 1);
+	const __m512i low16 = _mm512_set1_epi32(0xffff);
+	for (; j + 16 <= len; j += 16) {
+		const __m512i p = _mm512_cvtepi16_epi32(_mm256_loadu_si256((const __m256i *)(perm + j)));
+		if (_mm512_cmpeq_epi32_mask(p, last16)) {
+			for (int k = j; k < j + 16; k++) y[k] = x[perm[k]];
+			continue;
+		}
+		const __m512i g = _mm512_and_si512(_mm512_i32gather_epi32(p, (const void *)x, 2), low16);
+		_mm256_storeu_si256((__m256i *)(y + j), _mm512_cvtepi32_epi16(g));
+	}
+#elif AVXTYPE >= 2 && defined(__AVX2__)
+	const __m256i last8 = _mm256_set1_epi32(len - 1);
+	const __m256i low8 = _mm256_set1_epi32(0xffff);
+	for (; j + 8 <= len; j += 8) {
+		const __m256i p = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(perm + j)));
+		if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(p, last8))) {
+			for (int k = j; k < j + 8; k++) y[k] = x[perm[k]];
+			continue;
+		}
+		const __m256i g = _mm256_and_si256(_mm256_i32gather_epi32((const int *)x, p, 2), low8);
+		_mm_storeu_si128((__m128i *)(y + j),
+			_mm_packus_epi32(_mm256_castsi256_si128(g), _mm256_extracti128_si256(g, 1)));
+	}
+#endif
+	for (; j < len; j++) y[j] = x[perm[j]];
+}
+
+
 
 
 #ifdef __cplusplus
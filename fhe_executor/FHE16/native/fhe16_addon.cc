@@ -0,0 +1,1212 @@
+// native/fhe16_addon.cc — libFHE16 N-API 애드온 (비동기 연산 / 제로카피 Buffer)
+//
+// ffi-napi 바인딩(index.js)은 모든 호출이 이벤트 루프에서 동기로 돌아서 SMULL 같은
+// 수 초짜리 연산 동안 헬스체크/폴링이 멈춘다. 이 애드온은
+//   - 연산을 napi_async_work 로 libuv 워커 스레드에서 실행하고 Promise 로 돌려준다.
+//   - 입력 암호문은 Buffer/TypedArray 메모리를 그대로 넘긴다 (작업이 끝날 때까지 napi_ref 로 고정).
+//   - 결과 암호문은 라이브러리가 할당한 메모리를 external Buffer 로 감싸고, GC 시 finalizer 가 free.
+//   - libFHE16 은 전역 상태(G_FHE16_PARAM, 부트스트랩 키)를 공유하므로 동시에 실행되는 연산 수를
+//     env 별 큐로 제한한다 (기본 1, setMaxConcurrency). 대기 중인 작업은 워커 스레드를 잡지 않는다.
+//     라이브러리 호출 자체도 모두 FHE16_LibSlot (같은 한도의 프로세스 전역 세마포어) 을 잡는다
+//     → 계획의 병렬 단계나 다른 env 의 작업이 있어도 동시 호출 수는 한도 이하.
+//   - runPlan: 실행 계획 전체를 작업 하나로 실행 (fhe16_plan.hpp)
+//   - decIntBatch: 암호문 배열을 작업 하나로 복호화 (fhe16_dec_batch.hpp)
+//   - opStats / traceStart / traceStop: 라이브러리 함수별 카운터와 Chrome trace (fhe16_stats.hpp)
+//   - xor3Vec / noiseModel: 잡음 한도 안에서 XOR 를 합쳐 부트스트랩 1회로 (fhe16_gates.hpp, fhe16_noise.hpp)
+//   - paramSets / currentParams / selectParams: 키 생성 전에 파라미터 세트 선택 (fhe16_params.hpp)
+//
+// node-addon-api(napi.h) 없이 C N-API(node_api.h)만 사용 → 별도 의존성 없이 ABI 안정.
+//
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <node_api.h>
+
+#include "fhe16_dec_batch.hpp"
+#include "fhe16_gates.hpp"
+#include "fhe16_params.hpp"
+#include "fhe16_plan.hpp"
+#include "fhe16_stats.hpp"
+
+// include 순서는 fhe16_capi.cc 와 동일하게
+#include "BinOperationCstyle.hpp"
+#include "soAPI.hpp"
+#include "Core.hpp"         // get_physical_core_count (작업 풀 크기)
+
+// soAPI.hpp 에 선언이 없는 직렬화 함수 (libFHE16.so 에서 export, C++ 링키지)
+int fhe16bootparam_load_file_global(const char* path);
+int secret_key_load_file_safe(const char* path, int32_t** out_sk);
+
+// 배포된 lib/linux-x64/libFHE16.so 의 실제 시그니처 (soAPI.hpp 와 다름, index.js 와 동일하게 바인딩)
+//   SDIV 는 3 인자, LSHIFTL 은 시프트 양도 암호문. LSHIFTR/ASHIFTR/ROTATE*/PREFIX_FLAG 는 export 되지 않음
+int32_t* FHE16_SDIV(int32_t* CT1, int32_t* CT2, int32_t* CT3);
+int32_t* FHE16_LSHIFTL(int32_t* CT, int32_t* CT_K);
+
+#define NAPI_CALL(env, call)                                                   \
+    do {                                                                       \
+        if ((call) != napi_ok) {                                               \
+            const napi_extended_error_info* ei = nullptr;                      \
+            napi_get_last_error_info((env), &ei);                              \
+            bool pending = false;                                              \
+            napi_is_exception_pending((env), &pending);                        \
+            if (!pending)                                                      \
+                napi_throw_error((env), nullptr,                               \
+                    (ei && ei->error_message) ? ei->error_message : #call);    \
+            return nullptr;                                                    \
+        }                                                                      \
+    } while (0)
+
+// ===== 연산 테이블 =====
+// 인자 스펙 문자:  c = 암호문 Buffer,  s = 비밀키(external 또는 포인터 Buffer),  v = int32 벡터 Buffer,
+//                 i = int32,  l = int64 (number/bigint),  b = bool
+// 반환 종류:      c = 암호문,  n = 정수,  d = { value, E },  p = 실행 계획 출력 배열,  b = 배치 복호화 값 배열
+struct Call {
+    int32_t* p[4] = {};
+    int64_t  k[2] = {};
+    int32_t* out_ct = nullptr;
+    int64_t  out_n  = 0;
+    int      out_e  = 0;
+};
+
+typedef void (*OpFn)(Call& c);
+
+// lib = 호출하는 라이브러리 함수 이름 (연산별 카운터 키, 오버로드는 같은 이름으로 합산)
+struct OpDesc {
+    const char* name;
+    const char* args;
+    char        ret;
+    const char* lib;
+    OpFn        fn;
+};
+
+#define CT_OP1(JS, FN) { JS, "c",   'c', #FN, [](Call& c) { c.out_ct = FN(c.p[0]); } }
+#define CT_OP2(JS, FN) { JS, "cc",  'c', #FN, [](Call& c) { c.out_ct = FN(c.p[0], c.p[1]); } }
+#define CT_OP3(JS, FN) { JS, "ccc", 'c', #FN, [](Call& c) { c.out_ct = FN(c.p[0], c.p[1], c.p[2]); } }
+#define CT_OPI(JS, FN) { JS, "ci",  'c', #FN, [](Call& c) { c.out_ct = FN(c.p[0], (int)c.k[0]); } }
+
+static const OpDesc kOps[] = {
+    // enc / dec
+    { "enc",       "ii", 'c', "FHE16_ENC", [](Call& c) { c.out_ct = FHE16_ENC((int)c.k[0], (int)c.k[1]); } },
+    { "encInt",    "ii", 'c', "FHE16_ENCInt", [](Call& c) { c.out_ct = FHE16_ENCInt((int)c.k[0], (int)c.k[1]); } },
+    { "encIntVec", "vi", 'c', "FHE16_ENCInt", [](Call& c) { c.out_ct = FHE16_ENCInt(c.p[0], (int)c.k[0]); } },
+    { "dec",       "csi", 'd', "FHE16_DEC", [](Call& c) { c.out_n = FHE16_DEC(c.p[0], c.p[1], (int)c.k[0], c.out_e); } },
+    { "decInt",    "cs",  'n', "FHE16_DECInt", [](Call& c) { c.out_n = FHE16_DECInt(c.p[0], c.p[1]); } },
+
+    // compare / flag
+    { "compare",    "ccb", 'c', "FHE16_COMPARE", [](Call& c) { c.out_ct = FHE16_COMPARE(c.p[0], c.p[1], c.k[0] != 0); } },
+    { "maxOrMin",   "ccb", 'c', "FHE16_MAXorMIN", [](Call& c) { c.out_ct = FHE16_MAXorMIN(c.p[0], c.p[1], c.k[0] != 0); } },
+
+    // arithmetic
+    CT_OP2("add",  FHE16_ADD),
+    CT_OP3("add3", FHE16_ADD3),
+    CT_OP2("sub",  FHE16_SUB),
+
+    // relational
+    CT_OP2("le",  FHE16_LE),
+    CT_OP2("lt",  FHE16_LT),
+    CT_OP2("ge",  FHE16_GE),
+    CT_OP2("gt",  FHE16_GT),
+    CT_OP2("max", FHE16_MAX),
+    CT_OP2("min", FHE16_MIN),
+    CT_OP2("eq",  FHE16_EQ),
+    CT_OP2("neq", FHE16_NEQ),
+
+    // logic / select
+    CT_OP2("andVec", FHE16_ANDVEC),
+    CT_OP2("orVec",  FHE16_ORVEC),
+    CT_OP2("xorVec", FHE16_XORVEC),
+    CT_OP3("xor3Vec", FHE16_XOR3VEC),
+    CT_OP3("select", FHE16_SELECT),
+
+    // mult / div / relu
+    CT_OP2("smull", FHE16_SMULL),
+    { "sdiv3", "ccc", 'c', "FHE16_SDIV", [](Call& c) { c.out_ct = FHE16_SDIV(c.p[0], c.p[1], c.p[2]); } },
+    CT_OP1("relu", FHE16_RELU),
+
+    // constants
+    { "smullConst_cvec", "cv", 'c', "FHE16_SMULL_CONSTANT", [](Call& c) { c.out_ct = FHE16_SMULL_CONSTANT(c.p[0], c.p[1]); } },
+    { "smullConst_i32",  "ci", 'c', "FHE16_SMULL_CONSTANT", [](Call& c) { c.out_ct = FHE16_SMULL_CONSTANT(c.p[0], (int)c.k[0]); } },
+    { "smullConst_long", "cl", 'c', "FHE16_SMULL_CONSTANT", [](Call& c) { c.out_ct = FHE16_SMULL_CONSTANT(c.p[0], (int64_t)c.k[0]); } },
+    { "addConst_cvec",   "cv", 'c', "FHE16_ADD_CONSTANT", [](Call& c) { c.out_ct = FHE16_ADD_CONSTANT(c.p[0], c.p[1]); } },
+    { "addConst_i32",    "ci", 'c', "FHE16_ADD_CONSTANT", [](Call& c) { c.out_ct = FHE16_ADD_CONSTANT(c.p[0], (int)c.k[0]); } },
+    { "addConst_long",   "cl", 'c', "FHE16_ADD_CONSTANT", [](Call& c) { c.out_ct = FHE16_ADD_CONSTANT(c.p[0], (int64_t)c.k[0]); } },
+
+    // shift (ct, ctK)
+    { "lshiftlPtr", "cc", 'c', "FHE16_LSHIFTL", [](Call& c) { c.out_ct = FHE16_LSHIFTL(c.p[0], c.p[1]); } },
+
+    // pow2 / neg / abs
+    CT_OPI("addPow2", FHE16_ADD_POWTWO),
+    CT_OPI("subPow2", FHE16_SUB_POWTWO),
+    CT_OP1("neg", FHE16_NEG),
+    CT_OP1("abs", FHE16_ABS),
+};
+
+// runPlan 용 (인자는 js_run_plan 이 직접 바인딩)
+static const OpDesc kPlanOp = { "runPlan", "", 'p', nullptr, nullptr };
+// decIntBatch 용 (인자는 js_dec_int_batch 가 직접 바인딩)
+static const OpDesc kDecBatchOp = { "decIntBatch", "", 'b', "FHE16_DECInt_BATCH", nullptr };
+
+// ===== 실행 계획 =====
+static void plan_free(int32_t* ct) { std::free(ct); }
+
+static int32_t* plan_call(const FHE16_PlanStep& s, int32_t* const* in, std::string& err) {
+    try {
+        switch (s.op) {
+        case FHE16_OP_ADD:         return FHE16_ADD(in[0], in[1]);
+        case FHE16_OP_SUB:         return FHE16_SUB(in[0], in[1]);
+        case FHE16_OP_ADD3:        return FHE16_ADD3(in[0], in[1], in[2]);
+        case FHE16_OP_GE:          return FHE16_GE(in[0], in[1]);
+        case FHE16_OP_GT:          return FHE16_GT(in[0], in[1]);
+        case FHE16_OP_LE:          return FHE16_LE(in[0], in[1]);
+        case FHE16_OP_LT:          return FHE16_LT(in[0], in[1]);
+        case FHE16_OP_EQ:          return FHE16_EQ(in[0], in[1]);
+        case FHE16_OP_NEQ:         return FHE16_NEQ(in[0], in[1]);
+        case FHE16_OP_MAX:         return FHE16_MAX(in[0], in[1]);
+        case FHE16_OP_MIN:         return FHE16_MIN(in[0], in[1]);
+        case FHE16_OP_AND:         return FHE16_ANDVEC(in[0], in[1]);
+        case FHE16_OP_OR:          return FHE16_ORVEC(in[0], in[1]);
+        case FHE16_OP_XOR:         return FHE16_XORVEC(in[0], in[1]);
+        case FHE16_OP_SELECT:      return FHE16_SELECT(in[0], in[1], in[2]);
+        case FHE16_OP_SMULL:       return FHE16_SMULL(in[0], in[1]);
+        case FHE16_OP_SMULL_CONST: return FHE16_SMULL_CONSTANT(in[0], (int)s.imm);
+        case FHE16_OP_ADD_CONST:   return FHE16_ADD_CONSTANT(in[0], (int)s.imm);
+        case FHE16_OP_NEG:         return FHE16_NEG(in[0]);
+        case FHE16_OP_ABS:         return FHE16_ABS(in[0]);
+        case FHE16_OP_RELU:        return FHE16_RELU(in[0]);
+        case FHE16_OP_ADD_POW2:    return FHE16_ADD_POWTWO(in[0], (int)s.imm);
+        case FHE16_OP_SUB_POW2:    return FHE16_SUB_POWTWO(in[0], (int)s.imm);
+        case FHE16_OP_XOR3:        return FHE16_XOR3VEC(in[0], in[1], in[2]);
+        }
+        err = "plan: unsupported op " + std::to_string(s.op);
+    } catch (const std::exception& e) {
+        err = std::string("plan: ") + FHE16_plan_op_name(s.op) + ": " + e.what();
+    } catch (...) {
+        err = std::string("plan: ") + FHE16_plan_op_name(s.op) + ": unknown C++ exception";
+    }
+    return nullptr;
+}
+
+// ===== 연산별 카운터 =====
+// 계획 단계 op → 라이브러리 함수 (plan_call 과 같은 대응, SHL_CONST 는 내장 연산이라 없음)
+static const char* const kPlanLib[FHE16_OP_COUNT_] = {
+    nullptr,
+    "FHE16_ADD", "FHE16_SUB", "FHE16_ADD3", "FHE16_GE", "FHE16_GT", "FHE16_LE", "FHE16_LT",
+    "FHE16_EQ", "FHE16_NEQ", "FHE16_MAX", "FHE16_MIN", "FHE16_ANDVEC", "FHE16_ORVEC", "FHE16_XORVEC",
+    "FHE16_SELECT", "FHE16_SMULL", "FHE16_SMULL_CONSTANT", "FHE16_ADD_CONSTANT", "FHE16_NEG",
+    "FHE16_ABS", "FHE16_RELU", "FHE16_ADD_POWTWO", "FHE16_SUB_POWTWO", nullptr, "FHE16_XOR3VEC",
+};
+
+static const size_t kNumOps = sizeof(kOps) / sizeof(kOps[0]);
+
+static std::once_flag g_slots_once;
+static int g_op_slot[kNumOps];                 // kOps 순서
+static int g_op_plan[kNumOps];                 // 부트스트랩 추정용 계획 op (0 = 추정 없음)
+static int g_plan_slot[FHE16_OP_COUNT_];
+static int g_dec_batch_slot = -1;
+
+// 카운터는 프로세스 전역 (worker_threads 의 env 들도 같은 slot 을 쓴다)
+static void register_slots() {
+    std::call_once(g_slots_once, [] {
+        for (int op = 0; op < FHE16_OP_COUNT_; ++op)
+            g_plan_slot[op] = kPlanLib[op] ? FHE16_stats_register(kPlanLib[op]) : -1;
+        for (size_t i = 0; i < kNumOps; ++i) {
+            g_op_slot[i] = FHE16_stats_register(kOps[i].lib);
+            g_op_plan[i] = 0;
+            for (int op = 1; op < FHE16_OP_COUNT_; ++op)
+                if (kPlanLib[op] && std::strcmp(kPlanLib[op], kOps[i].lib) == 0) { g_op_plan[i] = op; break; }
+        }
+        g_dec_batch_slot = FHE16_stats_register(kDecBatchOp.lib);
+    });
+}
+
+// 직접 호출의 부트스트랩 추정: 같은 계획 op 의 게이트 수 모델 (imm 은 정수 인자, 벡터 상수는 추정 안 함)
+static int64_t op_bootstraps(size_t i, const Call& c) {
+    if (!g_op_plan[i] || kOps[i].args[1] == 'v') return 0;
+    FHE16_PlanStep s = {};
+    s.op  = g_op_plan[i];
+    s.imm = (int32_t)c.k[0];
+    return FHE16_plan_step_bootstraps(s);
+}
+
+static int32_t* plan_apply(const FHE16_PlanStep& s, int32_t* const* in, std::string& err) {
+    const int slot = s.op > 0 && s.op < FHE16_OP_COUNT_ ? g_plan_slot[s.op] : -1;
+    FHE16_StatScope scope(slot, FHE16_plan_step_bootstraps(s));
+    FHE16_LibSlot lib;
+    int32_t* r = plan_call(s, in, err);
+    scope.ok = r != nullptr;
+    return r;
+}
+
+struct PlanJob {
+    FHE16_Plan            plan;
+    int                   parallel = 1;
+    std::vector<int32_t*> inputs;
+    std::vector<int32_t*> outputs;
+    FHE16_PlanStats       stats = {};
+};
+
+struct DecBatchJob {
+    std::vector<int32_t*> cts;
+    int32_t*              sk      = nullptr;
+    int                   threads = 0;
+    std::vector<int64_t>  out;
+    std::vector<uint8_t>  ok;
+};
+
+// ===== env 별 실행 큐 =====
+struct Work;
+
+struct AddonState {
+    int               max_running = 1;
+    int               running     = 0;
+    std::deque<Work*> queue;
+    int64_t           completed   = 0;
+    int64_t           failed      = 0;
+};
+
+struct Work {
+    napi_async_work     work     = nullptr;
+    napi_deferred       deferred = nullptr;
+    const OpDesc*       op       = nullptr;
+    AddonState*         st       = nullptr;
+    Call                call;
+    std::unique_ptr<PlanJob> plan;                 // runPlan 일 때만
+    std::unique_ptr<DecBatchJob> dec;              // decIntBatch 일 때만
+    std::vector<napi_ref> refs;                    // 입력 Buffer 고정
+    std::deque<std::vector<int32_t>> copies;       // 4바이트 정렬이 안 된 입력만 복사
+    std::string         err;
+};
+
+static void pump(napi_env env, AddonState* st) {
+    while (st->running < st->max_running && !st->queue.empty()) {
+        Work* w = st->queue.front();
+        st->queue.pop_front();
+        if (napi_queue_async_work(env, w->work) == napi_ok) {
+            ++st->running;
+        } else {
+            // 큐잉 실패: 바로 거절 (complete 콜백은 오지 않음)
+            napi_value e, msg;
+            napi_create_string_utf8(env, "napi_queue_async_work failed", NAPI_AUTO_LENGTH, &msg);
+            napi_create_error(env, nullptr, msg, &e);
+            napi_reject_deferred(env, w->deferred, e);
+            for (napi_ref r : w->refs) napi_delete_reference(env, r);
+            napi_delete_async_work(env, w->work);
+            delete w;
+        }
+    }
+}
+
+static void free_ct(napi_env env, void* data, void* hint) {
+    int64_t adjusted;
+    napi_adjust_external_memory(env, -(int64_t)(uintptr_t)hint, &adjusted);
+    std::free(data);    // 라이브러리는 malloc/aligned_alloc 계열로 할당
+}
+
+static bool wrap_ct(napi_env env, int32_t* ct, napi_value* out) {
+    const size_t bytes = FHE16_ct_words(ct) * sizeof(int32_t);
+    if (napi_create_external_buffer(env, bytes, ct, free_ct, (void*)(uintptr_t)bytes, out) != napi_ok)
+        return false;
+    int64_t adjusted;
+    napi_adjust_external_memory(env, (int64_t)bytes, &adjusted);
+    return true;
+}
+
+static void op_execute(napi_env, void* data) {
+    Work* w = static_cast<Work*>(data);
+    if (w->plan) {
+        PlanJob& j = *w->plan;
+        FHE16_plan_run(j.plan, j.inputs.data(), j.parallel, plan_apply, plan_free, j.outputs, &j.stats, w->err);
+        return;
+    }
+    if (w->dec) {
+        DecBatchJob& j = *w->dec;
+        j.out.resize(j.cts.size());
+        j.ok.resize(j.cts.size());
+        FHE16_StatScope scope(g_dec_batch_slot, 0);
+        if (FHE16_DECInt_BATCH(j.cts.data(), (int)j.cts.size(), j.sk, j.out.data(), j.threads, j.ok.data()) < 0)
+            w->err = "decIntBatch: evaluation parameters not loaded (FHE16_GenEval / FHE16_LoadEval)";
+        scope.ok = w->err.empty();
+        return;
+    }
+    const size_t i = (size_t)(w->op - kOps);
+    FHE16_StatScope scope(g_op_slot[i], op_bootstraps(i, w->call));
+    FHE16_LibSlot lib;
+    try {
+        w->op->fn(w->call);
+    } catch (const std::exception& e) {
+        w->err = std::string(w->op->name) + ": " + e.what();
+    } catch (...) {
+        w->err = std::string(w->op->name) + ": unknown C++ exception";
+    }
+    if (w->err.empty() && w->op->ret == 'c' && !w->call.out_ct)
+        w->err = std::string(w->op->name) + " returned null";
+    scope.ok = w->err.empty();
+}
+
+static void op_complete(napi_env env, napi_status status, void* data) {
+    Work* w = static_cast<Work*>(data);
+    AddonState* st = w->st;
+    --st->running;
+
+    if (status != napi_ok && w->err.empty()) w->err = std::string(w->op->name) + ": cancelled";
+
+    napi_value result = nullptr;
+    if (w->err.empty()) {
+        switch (w->op->ret) {
+        case 'c':
+            if (!wrap_ct(env, w->call.out_ct, &result)) {
+                std::free(w->call.out_ct);
+                w->err = "napi_create_external_buffer failed";
+            }
+            w->call.out_ct = nullptr;
+            break;
+        case 'n':
+            napi_create_int64(env, w->call.out_n, &result);
+            break;
+        case 'd': {
+            napi_value v, e;
+            napi_create_object(env, &result);
+            napi_create_int64(env, w->call.out_n, &v);
+            napi_create_int32(env, w->call.out_e, &e);
+            napi_set_named_property(env, result, "value", v);
+            napi_set_named_property(env, result, "E", e);
+            break;
+        }
+        case 'p': {
+            // { outputs: Buffer[], stats: { steps, maxLive, elapsedUs } }
+            PlanJob& j = *w->plan;
+            napi_value arr, stats, v;
+            napi_create_object(env, &result);
+            napi_create_array_with_length(env, j.outputs.size(), &arr);
+            for (size_t i = 0; i < j.outputs.size(); ++i) {
+                napi_value b = nullptr;
+                if (!wrap_ct(env, j.outputs[i], &b)) { std::free(j.outputs[i]); w->err = "napi_create_external_buffer failed"; }
+                j.outputs[i] = nullptr;
+                if (b) napi_set_element(env, arr, (uint32_t)i, b);
+            }
+            napi_set_named_property(env, result, "outputs", arr);
+            napi_create_object(env, &stats);
+            napi_create_int32(env, j.stats.steps_run, &v);   napi_set_named_property(env, stats, "steps", v);
+            napi_create_int32(env, j.stats.max_live, &v);    napi_set_named_property(env, stats, "maxLive", v);
+            napi_create_int64(env, j.stats.elapsed_us, &v);  napi_set_named_property(env, stats, "elapsedUs", v);
+            napi_set_named_property(env, result, "stats", stats);
+            break;
+        }
+        case 'b': {
+            // 실패한 항목은 null
+            DecBatchJob& j = *w->dec;
+            napi_create_array_with_length(env, j.out.size(), &result);
+            for (size_t i = 0; i < j.out.size(); ++i) {
+                napi_value v;
+                if (j.ok[i]) napi_create_int64(env, j.out[i], &v);
+                else         napi_get_null(env, &v);
+                napi_set_element(env, result, (uint32_t)i, v);
+            }
+            break;
+        }
+        }
+    } else {
+        if (w->call.out_ct) std::free(w->call.out_ct);
+        if (w->plan) for (int32_t* ct : w->plan->outputs) std::free(ct);
+    }
+
+    if (w->err.empty()) {
+        ++st->completed;
+        napi_resolve_deferred(env, w->deferred, result);
+    } else {
+        ++st->failed;
+        napi_value msg, e;
+        napi_create_string_utf8(env, w->err.c_str(), w->err.size(), &msg);
+        napi_create_error(env, nullptr, msg, &e);
+        napi_reject_deferred(env, w->deferred, e);
+    }
+
+    for (napi_ref r : w->refs) napi_delete_reference(env, r);
+    napi_delete_async_work(env, w->work);
+    delete w;
+
+    pump(env, st);
+}
+
+// Buffer / TypedArray / ArrayBuffer 의 메모리 (복사 없음)
+static bool get_bytes(napi_env env, napi_value v, void** data, size_t* len) {
+    bool is = false;
+    if (napi_is_buffer(env, v, &is) == napi_ok && is)
+        return napi_get_buffer_info(env, v, data, len) == napi_ok;
+    if (napi_is_typedarray(env, v, &is) == napi_ok && is) {
+        napi_typedarray_type type;
+        size_t n;
+        if (napi_get_typedarray_info(env, v, &type, &n, data, nullptr, nullptr) != napi_ok) return false;
+        size_t esz = 1;
+        switch (type) {
+        case napi_int16_array: case napi_uint16_array: esz = 2; break;
+        case napi_int32_array: case napi_uint32_array: case napi_float32_array: esz = 4; break;
+        case napi_float64_array: case napi_bigint64_array: case napi_biguint64_array: esz = 8; break;
+        default: break;
+        }
+        *len = n * esz;
+        return true;
+    }
+    if (napi_is_arraybuffer(env, v, &is) == napi_ok && is)
+        return napi_get_arraybuffer_info(env, v, data, len) == napi_ok;
+    return false;
+}
+
+static std::string arg_error(const OpDesc* op, size_t i, const char* what) {
+    return std::string(op->name) + ": argument " + std::to_string(i) + " " + what;
+}
+
+// 포인터 인자 (c/v/s) 하나를 바인딩: 메모리를 고정하고 주소를 out 에
+static bool bind_ptr(napi_env env, Work* w, char kind, size_t i, napi_value v, int32_t** out, std::string& err) {
+    const OpDesc* op = w->op;
+    napi_valuetype t;
+    napi_typeof(env, v, &t);
+    void* data = nullptr;
+    size_t len = 0;
+    if (kind == 's' && t == napi_external) {
+        napi_get_value_external(env, v, &data);
+        *out = static_cast<int32_t*>(data);
+        return true;
+    }
+    if (!get_bytes(env, v, &data, &len)) { err = arg_error(op, i, "must be a Buffer"); return false; }
+    if (kind == 'c') {
+        // 라이브러리는 메타 [0] * [1] 워드를 그대로 읽으므로 메타와 길이를 먼저 확인 (정렬과 무관하게 복사해 읽음)
+        int32_t meta[2] = { 0, 0 };
+        if (len < FHE16_CT_META * sizeof(int32_t)) {
+            err = arg_error(op, i, "is too short for a ciphertext");
+            return false;
+        }
+        std::memcpy(meta, data, sizeof(meta));
+        if (!FHE16_ct_meta_ok(meta)) {
+            err = arg_error(op, i, "has an invalid ciphertext header (bits / words per bit)");
+            return false;
+        }
+        if (len < FHE16_ct_words(meta) * sizeof(int32_t)) {
+            err = arg_error(op, i, "is too short for a ciphertext");
+            return false;
+        }
+    } else if (kind == 'v' && len < sizeof(int32_t)) {
+        err = arg_error(op, i, "is empty");
+        return false;
+    }
+    // 비밀키는 ref-napi 포인터 Buffer(길이 0)도 허용 → 주소만 사용
+    if (kind != 's' && (uintptr_t)data % alignof(int32_t) != 0) {
+        w->copies.emplace_back((len + 3) / 4);
+        std::memcpy(w->copies.back().data(), data, len);
+        data = w->copies.back().data();
+    } else {
+        napi_ref r;
+        if (napi_create_reference(env, v, 1, &r) != napi_ok) { err = arg_error(op, i, "cannot be referenced"); return false; }
+        w->refs.push_back(r);
+    }
+    *out = static_cast<int32_t*>(data);
+    return true;
+}
+
+// 인자 하나를 Work 에 채운다. 실패 시 오류 메시지
+static bool bind_arg(napi_env env, Work* w, char kind, size_t i, napi_value v, int& np, int& nk, std::string& err) {
+    const OpDesc* op = w->op;
+    switch (kind) {
+    case 'c': case 'v': case 's':
+        return bind_ptr(env, w, kind, i, v, &w->call.p[np++], err);
+    case 'i': {
+        int32_t x;
+        if (napi_get_value_int32(env, v, &x) != napi_ok) { err = arg_error(op, i, "must be a number"); return false; }
+        w->call.k[nk++] = x;
+        return true;
+    }
+    case 'l': {
+        napi_valuetype t;
+        napi_typeof(env, v, &t);
+        int64_t x;
+        bool lossless = true;
+        if (t == napi_bigint) {
+            if (napi_get_value_bigint_int64(env, v, &x, &lossless) != napi_ok || !lossless) {
+                err = arg_error(op, i, "does not fit in int64");
+                return false;
+            }
+        } else if (napi_get_value_int64(env, v, &x) != napi_ok) {
+            err = arg_error(op, i, "must be a number or bigint");
+            return false;
+        }
+        w->call.k[nk++] = x;
+        return true;
+    }
+    case 'b': {
+        napi_value bv;
+        bool x = false;
+        napi_coerce_to_bool(env, v, &bv);
+        napi_get_value_bool(env, bv, &x);
+        w->call.k[nk++] = x ? 1 : 0;
+        return true;
+    }
+    }
+    err = arg_error(op, i, "has an unknown kind");
+    return false;
+}
+
+static void release_unqueued(napi_env env, Work* w) {
+    for (napi_ref r : w->refs) napi_delete_reference(env, r);
+    delete w;
+}
+
+static napi_value enqueue(napi_env env, AddonState* st, Work* w) {
+    napi_value promise, name;
+    if (napi_create_promise(env, &w->deferred, &promise) != napi_ok ||
+        napi_create_string_utf8(env, w->op->name, NAPI_AUTO_LENGTH, &name) != napi_ok ||
+        napi_create_async_work(env, nullptr, name, op_execute, op_complete, w, &w->work) != napi_ok) {
+        release_unqueued(env, w);
+        napi_throw_error(env, nullptr, "failed to create async work");
+        return nullptr;
+    }
+    st->queue.push_back(w);
+    pump(env, st);
+    return promise;
+}
+
+// 모든 비동기 연산의 공통 진입점 (data = OpDesc*)
+static napi_value op_call(napi_env env, napi_callback_info info) {
+    size_t argc = 4;
+    napi_value argv[4];
+    void* data = nullptr;
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, nullptr, &data));
+    const OpDesc* op = static_cast<const OpDesc*>(data);
+
+    AddonState* st = nullptr;
+    NAPI_CALL(env, napi_get_instance_data(env, (void**)&st));
+
+    const size_t want = std::strlen(op->args);
+    if (argc < want) {
+        const std::string m = std::string(op->name) + ": expected " + std::to_string(want) + " arguments";
+        napi_throw_type_error(env, nullptr, m.c_str());
+        return nullptr;
+    }
+
+    Work* w = new Work();
+    w->op = op;
+    w->st = st;
+    int np = 0, nk = 0;
+    std::string err;
+    for (size_t i = 0; i < want; ++i) {
+        if (!bind_arg(env, w, op->args[i], i, argv[i], np, nk, err)) {
+            release_unqueued(env, w);
+            napi_throw_type_error(env, nullptr, err.c_str());
+            return nullptr;
+        }
+    }
+
+    return enqueue(env, st, w);
+}
+
+// runPlan(plan: Int32Array|Buffer, inputs: Buffer[], parallel?: number)
+//   → Promise<{ outputs: Buffer[], stats }>. 계획 전체를 한 번의 비동기 작업으로 실행
+static napi_value js_run_plan(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+    AddonState* st = nullptr;
+    NAPI_CALL(env, napi_get_instance_data(env, (void**)&st));
+    if (argc < 2) { napi_throw_type_error(env, nullptr, "runPlan: expected (plan, inputs[, parallel])"); return nullptr; }
+
+    Work* w = new Work();
+    w->op = &kPlanOp;
+    w->st = st;
+    w->plan.reset(new PlanJob());
+    PlanJob& j = *w->plan;
+    std::string err;
+
+    void* pw = nullptr;
+    size_t plen = 0;
+    if (!get_bytes(env, argv[0], &pw, &plen) || plen % sizeof(int32_t) != 0) {
+        err = "runPlan: plan must be an Int32Array or Buffer";
+    } else {
+        // 계획은 작으므로 복사해서 디코딩 (정렬 무관)
+        std::vector<int32_t> words(plen / sizeof(int32_t));
+        std::memcpy(words.data(), pw, plen);
+        FHE16_plan_decode(words.data(), words.size(), j.plan, err);
+    }
+
+    bool is_array = false;
+    uint32_t n = 0;
+    if (err.empty() && (napi_is_array(env, argv[1], &is_array) != napi_ok || !is_array))
+        err = "runPlan: inputs must be an array";
+    if (err.empty()) {
+        napi_get_array_length(env, argv[1], &n);
+        if ((int32_t)n != j.plan.n_inputs)
+            err = "runPlan: plan expects " + std::to_string(j.plan.n_inputs) + " inputs, got " + std::to_string(n);
+    }
+    for (uint32_t i = 0; err.empty() && i < n; ++i) {
+        napi_value e;
+        int32_t* ptr = nullptr;
+        napi_get_element(env, argv[1], i, &e);
+        if (bind_ptr(env, w, 'c', i, e, &ptr, err)) j.inputs.push_back(ptr);
+    }
+    if (err.empty() && argc > 2) {
+        napi_valuetype t;
+        napi_typeof(env, argv[2], &t);
+        if (t == napi_number) napi_get_value_int32(env, argv[2], &j.parallel);
+        if (j.parallel < 1) j.parallel = 1;
+    }
+    if (!err.empty()) {
+        release_unqueued(env, w);
+        napi_throw_type_error(env, nullptr, err.c_str());
+        return nullptr;
+    }
+    return enqueue(env, st, w);
+}
+
+// decIntBatch(cts: Buffer[], sk, threads?: number) → Promise<(number|null)[]>
+//   배열 전체를 한 번의 비동기 작업으로 복호화. threads 개 스레드가 블록 단위로 나눠 처리 (기본 1)
+static napi_value js_dec_int_batch(napi_env env, napi_callback_info info) {
+    size_t argc = 3;
+    napi_value argv[3];
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+    AddonState* st = nullptr;
+    NAPI_CALL(env, napi_get_instance_data(env, (void**)&st));
+    if (argc < 2) { napi_throw_type_error(env, nullptr, "decIntBatch: expected (cts[], sk[, threads])"); return nullptr; }
+
+    Work* w = new Work();
+    w->op = &kDecBatchOp;
+    w->st = st;
+    w->dec.reset(new DecBatchJob());
+    DecBatchJob& j = *w->dec;
+    std::string err;
+
+    bool is_array = false;
+    uint32_t n = 0;
+    if (napi_is_array(env, argv[0], &is_array) != napi_ok || !is_array)
+        err = "decIntBatch: cts must be an array";
+    else
+        napi_get_array_length(env, argv[0], &n);
+    j.cts.reserve(n);
+    for (uint32_t i = 0; err.empty() && i < n; ++i) {
+        napi_value e;
+        int32_t* ptr = nullptr;
+        napi_get_element(env, argv[0], i, &e);
+        if (bind_ptr(env, w, 'c', i, e, &ptr, err)) j.cts.push_back(ptr);
+    }
+    if (err.empty()) bind_ptr(env, w, 's', 1, argv[1], &j.sk, err);
+    if (err.empty() && argc > 2) {
+        napi_valuetype t;
+        napi_typeof(env, argv[2], &t);
+        if (t == napi_number) napi_get_value_int32(env, argv[2], &j.threads);
+    }
+    if (!err.empty()) {
+        release_unqueued(env, w);
+        napi_throw_type_error(env, nullptr, err.c_str());
+        return nullptr;
+    }
+    return enqueue(env, st, w);
+}
+
+// 잡음 한도(log2): opts.log2Pfail 이 음수면 그 값, 아니면 FHE16_NOISE_LOG2_PFAIL / 기본 -40
+// opts.log2Pfail 이 없으면 기본 한도. 있는데 음의 유한 수가 아니면 RangeError 를 던지고 false
+static bool opt_log2_bound(napi_env env, napi_value opts, double& out) {
+    napi_valuetype t = napi_undefined;
+    napi_value v;
+    bool has = false;
+    double d = 0;
+    out = FHE16_noise_log2_bound();
+    if (!opts || napi_typeof(env, opts, &t) != napi_ok || t != napi_object ||
+        napi_has_named_property(env, opts, "log2Pfail", &has) != napi_ok || !has)
+        return true;
+    napi_get_named_property(env, opts, "log2Pfail", &v);
+    if (napi_get_value_double(env, v, &d) != napi_ok || !std::isfinite(d) || d >= 0) {
+        napi_throw_range_error(env, nullptr, "log2Pfail: expected a finite negative number");
+        return false;
+    }
+    out = d;
+    return true;
+}
+
+// 현재 키 + 한도로 합칠 수 있는 XOR 입력 수 (키가 없으면 2)
+static int live_xor_fanin(double log2_bound) {
+    FHE16_NoiseParams np;
+    if (!FHE16_noise_params_live(np)) return 2;
+    const int f = FHE16_noise_max_fanin(np, log2_bound);
+    return f < 2 ? 2 : f;
+}
+
+// optimizePlan(plan: Int32Array|Buffer, opts?: { log2Pfail }) → { words: Int32Array, report }
+//   CSE / 상수 접기 / 비교+선택 융합 / XOR 융합 / DCE (fhe16_plan_opt.cpp). 동기 — 계획 크기에 비례하는 짧은 작업
+//   XOR 융합은 평가 키가 로드돼 있고 잡음 모델의 실패 확률이 한도 안일 때만
+static napi_value js_optimize_plan(napi_env env, napi_callback_info info) {
+    size_t argc = 2;
+    napi_value argv[2];
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+
+    void* pw = nullptr;
+    size_t plen = 0;
+    if (argc < 1 || !get_bytes(env, argv[0], &pw, &plen) || plen % sizeof(int32_t) != 0) {
+        napi_throw_type_error(env, nullptr, "optimizePlan: plan must be an Int32Array or Buffer");
+        return nullptr;
+    }
+    std::vector<int32_t> words(plen / sizeof(int32_t));
+    std::memcpy(words.data(), pw, plen);
+    FHE16_Plan plan;
+    std::string err;
+    if (!FHE16_plan_decode(words.data(), words.size(), plan, err)) {
+        napi_throw_error(env, nullptr, err.c_str());
+        return nullptr;
+    }
+
+    double bound;
+    if (!opt_log2_bound(env, argc > 1 ? argv[1] : nullptr, bound)) return nullptr;
+    const int fanin = live_xor_fanin(bound);
+    FHE16_PlanOptReport rep;
+    FHE16_plan_optimize(plan, &rep, fanin);
+    FHE16_plan_encode(plan, words);
+
+    napi_value ab, arr, o, r, v;
+    void* data = nullptr;
+    NAPI_CALL(env, napi_create_arraybuffer(env, words.size() * sizeof(int32_t), &data, &ab));
+    std::memcpy(data, words.data(), words.size() * sizeof(int32_t));
+    NAPI_CALL(env, napi_create_typedarray(env, napi_int32_array, words.size(), ab, 0, &arr));
+
+    NAPI_CALL(env, napi_create_object(env, &r));
+    napi_create_int32(env, rep.steps_before, &v);                 napi_set_named_property(env, r, "stepsBefore", v);
+    napi_create_int32(env, rep.steps_after, &v);                  napi_set_named_property(env, r, "stepsAfter", v);
+    napi_create_int64(env, rep.bootstraps_before, &v);            napi_set_named_property(env, r, "bootstrapsBefore", v);
+    napi_create_int64(env, rep.bootstraps_after, &v);             napi_set_named_property(env, r, "bootstrapsAfter", v);
+    napi_create_int32(env, rep.folded, &v);                       napi_set_named_property(env, r, "folded", v);
+    napi_create_int32(env, rep.strength_reduced, &v);             napi_set_named_property(env, r, "strengthReduced", v);
+    napi_create_int32(env, rep.fused, &v);                        napi_set_named_property(env, r, "fused", v);
+    napi_create_int32(env, rep.xor_fused, &v);                    napi_set_named_property(env, r, "xorFused", v);
+    napi_create_int32(env, fanin, &v);                            napi_set_named_property(env, r, "maxXorFanin", v);
+    napi_create_int32(env, rep.cse, &v);                          napi_set_named_property(env, r, "cse", v);
+    napi_create_int32(env, rep.dead, &v);                         napi_set_named_property(env, r, "dead", v);
+
+    NAPI_CALL(env, napi_create_object(env, &o));
+    NAPI_CALL(env, napi_set_named_property(env, o, "words", arr));
+    NAPI_CALL(env, napi_set_named_property(env, o, "report", r));
+    return o;
+}
+
+// ===== 동기 초기화 함수 (서버 시작 시 1회) =====
+static napi_value make_external_key(napi_env env, int32_t* p) {
+    napi_value v;
+    NAPI_CALL(env, napi_create_external(env, p, nullptr, nullptr, &v));   // 프로세스 수명 동안 유지
+    return v;
+}
+
+static bool get_string(napi_env env, napi_value v, std::string& out) {
+    size_t n = 0;
+    if (napi_get_value_string_utf8(env, v, nullptr, 0, &n) != napi_ok) return false;
+    out.resize(n + 1);
+    if (napi_get_value_string_utf8(env, v, &out[0], n + 1, &n) != napi_ok) return false;
+    out.resize(n);
+    return true;
+}
+
+static napi_value js_gen_eval(napi_env env, napi_callback_info) {
+    FHE16_LibSlot lib;
+    int32_t* sk = FHE16_GenEval();
+    if (!sk) { napi_throw_error(env, nullptr, "FHE16_GenEval returned null"); return nullptr; }
+    return make_external_key(env, sk);
+}
+
+static napi_value js_load_eval(napi_env, napi_callback_info) {
+    FHE16_LibSlot lib;
+    FHE16_LoadEval();
+    return nullptr;
+}
+
+static napi_value js_bootparam_load_global(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+    std::string path;
+    if (argc < 1 || !get_string(env, argv[0], path)) {
+        napi_throw_type_error(env, nullptr, "bootparamLoadFileGlobal: path must be a string");
+        return nullptr;
+    }
+    FHE16_LibSlot lib;
+    const int rc = fhe16bootparam_load_file_global(path.c_str());
+    if (rc != 0) {
+        const std::string m = "fhe16bootparam_load_file_global failed: rc=" + std::to_string(rc);
+        napi_throw_error(env, nullptr, m.c_str());
+        return nullptr;
+    }
+    napi_value v;
+    NAPI_CALL(env, napi_create_int32(env, rc, &v));
+    return v;
+}
+
+static napi_value js_secret_key_load(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+    std::string path;
+    if (argc < 1 || !get_string(env, argv[0], path)) {
+        napi_throw_type_error(env, nullptr, "secretKeyLoadFileSafe: path must be a string");
+        return nullptr;
+    }
+    int32_t* sk = nullptr;
+    int rc;
+    {
+        FHE16_LibSlot lib;
+        rc = secret_key_load_file_safe(path.c_str(), &sk);
+    }
+    if (rc != 0 || !sk) {
+        const std::string m = "secret_key_load_file_safe failed: rc=" + std::to_string(rc);
+        napi_throw_error(env, nullptr, m.c_str());
+        return nullptr;
+    }
+    return make_external_key(env, sk);
+}
+
+static napi_value js_set_max_concurrency(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+    AddonState* st = nullptr;
+    NAPI_CALL(env, napi_get_instance_data(env, (void**)&st));
+    int32_t n = 1;
+    if (argc < 1 || napi_get_value_int32(env, argv[0], &n) != napi_ok || n < 1) {
+        napi_throw_range_error(env, nullptr, "setMaxConcurrency: n must be >= 1");
+        return nullptr;
+    }
+    st->max_running = n;
+    FHE16_lib_set_limit(n);
+    pump(env, st);
+    return nullptr;
+}
+
+static napi_value js_stats(napi_env env, napi_callback_info) {
+    AddonState* st = nullptr;
+    NAPI_CALL(env, napi_get_instance_data(env, (void**)&st));
+    napi_value o, v;
+    NAPI_CALL(env, napi_create_object(env, &o));
+    napi_create_int32(env, st->max_running, &v);            napi_set_named_property(env, o, "maxConcurrency", v);
+    napi_create_int32(env, st->running, &v);                napi_set_named_property(env, o, "running", v);
+    napi_create_int64(env, (int64_t)st->queue.size(), &v);  napi_set_named_property(env, o, "queued", v);
+    napi_create_int64(env, st->completed, &v);              napi_set_named_property(env, o, "completed", v);
+    napi_create_int64(env, st->failed, &v);                 napi_set_named_property(env, o, "failed", v);
+    return o;
+}
+
+// opStats() → [{ op, calls, errors, totalMs, maxMs, bootstraps }]
+//   라이브러리 함수별 누적값 (프로세스 전역, 마지막 resetOpStats 이후). bootstraps 는 게이트 수 모델 추정치
+static napi_value js_op_stats(napi_env env, napi_callback_info) {
+    FHE16_OpStats s[FHE16_STATS_MAX_SLOTS];
+    const int n = FHE16_GetStats(s, FHE16_STATS_MAX_SLOTS);
+    napi_value arr, o, v;
+    NAPI_CALL(env, napi_create_array_with_length(env, n, &arr));
+    for (int i = 0; i < n; ++i) {
+        NAPI_CALL(env, napi_create_object(env, &o));
+        napi_create_string_utf8(env, s[i].name, NAPI_AUTO_LENGTH, &v); napi_set_named_property(env, o, "op", v);
+        napi_create_int64(env, s[i].calls, &v);                        napi_set_named_property(env, o, "calls", v);
+        napi_create_int64(env, s[i].errors, &v);                       napi_set_named_property(env, o, "errors", v);
+        napi_create_double(env, s[i].total_ns / 1e6, &v);              napi_set_named_property(env, o, "totalMs", v);
+        napi_create_double(env, s[i].max_ns / 1e6, &v);                napi_set_named_property(env, o, "maxMs", v);
+        napi_create_int64(env, s[i].bootstraps, &v);                   napi_set_named_property(env, o, "bootstraps", v);
+        napi_set_element(env, arr, i, o);
+    }
+    return arr;
+}
+
+static napi_value js_reset_op_stats(napi_env, napi_callback_info) {
+    FHE16_ResetStats();
+    return nullptr;
+}
+
+// traceStart(capacity?) : 이후 호출을 span 으로 기록 (기본 65536 개, 넘치면 버림)
+static napi_value js_trace_start(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+    int64_t cap = 65536;
+    if (argc > 0) {
+        napi_valuetype t;
+        napi_typeof(env, argv[0], &t);
+        if (t == napi_number) napi_get_value_int64(env, argv[0], &cap);
+    }
+    if (cap < 1 || cap > (1 << 24)) {
+        napi_throw_range_error(env, nullptr, "traceStart: capacity must be in [1, 16777216]");
+        return nullptr;
+    }
+    FHE16_TraceStart((size_t)cap);
+    return nullptr;
+}
+
+// traceStop() → Chrome trace JSON 문자열 (chrome://tracing, ui.perfetto.dev 에서 열기)
+static napi_value js_trace_stop(napi_env env, napi_callback_info) {
+    std::string json;
+    FHE16_TraceStop(json);
+    napi_value v;
+    NAPI_CALL(env, napi_create_string_utf8(env, json.data(), json.size(), &v));
+    return v;
+}
+
+// ===== 파라미터 세트 (fhe16_params.hpp) =====
+// JS 객체 ↔ FHE16Params. 이름은 구조체 필드에서 앞의 '_' 를 뺀 것. 파생 필드는 읽기 전용
+struct ParamField { const char* name; char type; size_t off; bool derived; };   // type: d double / i int / b bool
+static const ParamField kParamFields[] = {
+    { "n_lwe",         'i', offsetof(FHE16Params, _n_lwe),         false },
+    { "sigma_lwe",     'd', offsetof(FHE16Params, _sigma_lwe),     false },
+    { "sigma_ks",      'd', offsetof(FHE16Params, _sigma_ks),      false },
+    { "sigma_bs",      'd', offsetof(FHE16Params, _sigma_bs),      false },
+    { "q_lwe",         'i', offsetof(FHE16Params, _q_lwe),         false },
+    { "scaling_lwe",   'i', offsetof(FHE16Params, _scaling_lwe),   false },
+    { "q_ks",          'i', offsetof(FHE16Params, _q_ks),          false },
+    { "n_ks",          'i', offsetof(FHE16Params, _n_ks),          false },
+    { "base_ks",       'i', offsetof(FHE16Params, _base_ks),       false },
+    { "base_rm_ks",    'i', offsetof(FHE16Params, _base_rm_ks),    false },
+    { "gadget_len_ks", 'i', offsetof(FHE16Params, _gadget_len_ks), false },
+    { "base_bk_a",     'i', offsetof(FHE16Params, _base_bk_a),     false },
+    { "base_rm_bk_a",  'i', offsetof(FHE16Params, _base_rm_bk_a),  false },
+    { "base_len_bk_a", 'i', offsetof(FHE16Params, _base_len_bk_a), false },
+    { "base_bk_b",     'i', offsetof(FHE16Params, _base_bk_b),     false },
+    { "base_rm_bk_b",  'i', offsetof(FHE16Params, _base_rm_bk_b),  false },
+    { "base_len_bk_b", 'i', offsetof(FHE16Params, _base_len_bk_b), false },
+    { "ks_first",      'b', offsetof(FHE16Params, _KS_FIRST),      false },
+    { "packed_ks",     'b', offsetof(FHE16Params, _PACKED_KS),     false },
+    { "pk_row",        'i', offsetof(FHE16Params, _PK_row),        false },
+    { "pk_col",        'i', offsetof(FHE16Params, _PK_col),        false },
+    { "pk_q",          'i', offsetof(FHE16Params, _PK_Q),          false },
+    { "n_bk",          'i', offsetof(FHE16Params, _n_bk),          true },
+    { "k_bk",          'i', offsetof(FHE16Params, _k_bk),          true },
+    { "q_num",         'i', offsetof(FHE16Params, _q_num),         true },
+    { "n_lwe_cache",   'i', offsetof(FHE16Params, _n_lwe_cache),   true },
+    { "q_lwe_bit",     'i', offsetof(FHE16Params, _q_lwe_bit),     true },
+    { "q_ks_bit",      'i', offsetof(FHE16Params, _q_ks_bit),      true },
+    { "q_bk_bit16",    'i', offsetof(FHE16Params, _q_bk_bit16),    true },
+};
+
+static napi_value params_to_js(napi_env env, const FHE16Params& p, const char* name) {
+    napi_value o, v;
+    NAPI_CALL(env, napi_create_object(env, &o));
+    if (name) { napi_create_string_utf8(env, name, NAPI_AUTO_LENGTH, &v); napi_set_named_property(env, o, "name", v); }
+    const char* base = reinterpret_cast<const char*>(&p);
+    for (const ParamField& f : kParamFields) {
+        if (f.type == 'd')      napi_create_double(env, *reinterpret_cast<const double*>(base + f.off), &v);
+        else if (f.type == 'b') napi_get_boolean(env, *reinterpret_cast<const bool*>(base + f.off), &v);
+        else                    napi_create_int32(env, *reinterpret_cast<const int*>(base + f.off), &v);
+        napi_set_named_property(env, o, f.name, v);
+    }
+    napi_create_double(env, (double)p._Q_TOT, &v);
+    napi_set_named_property(env, o, "q_tot", v);
+    NAPI_CALL(env, napi_create_array(env, &v));
+    for (int i = 0; i < p._q_num; ++i) {
+        napi_value q;
+        napi_create_int32(env, p._q_bk16[i], &q);
+        napi_set_element(env, v, i, q);
+    }
+    napi_set_named_property(env, o, "q_bk", v);
+    return o;
+}
+
+static bool has_prop(napi_env env, napi_value o, const char* name) {
+    bool has = false;
+    return napi_has_named_property(env, o, name, &has) == napi_ok && has;
+}
+
+// 이름(string) 또는 { base?: 이름, ...필드 } → FHE16Params. base 가 없으면 현재 세트에서 시작
+// 밑 / 버리는 비트만 바꾸고 길이를 안 주면 길이는 다시 계산 (FHE16_params_normalize)
+static bool params_from_js(napi_env env, napi_value v, FHE16Params& out, std::string& name, std::string& err) {
+    napi_valuetype t = napi_undefined;
+    napi_typeof(env, v, &t);
+    if (t == napi_string) {
+        if (!get_string(env, v, name)) { err = "params: invalid string"; return false; }
+        const FHE16_ParamSet* s = FHE16_param_set_find(name.c_str());
+        if (!s) { err = "params: unknown set '" + name + "'"; return false; }
+        out = *s->params;
+        return true;
+    }
+    if (t != napi_object) { err = "params: expected a set name or an object"; return false; }
+
+    napi_value pv;
+    out = FHE16_params_current();
+    name = "custom";
+    if (has_prop(env, v, "base")) {
+        std::string b;
+        napi_get_named_property(env, v, "base", &pv);
+        const FHE16_ParamSet* s = get_string(env, pv, b) ? FHE16_param_set_find(b.c_str()) : nullptr;
+        if (!s) { err = "params.base: unknown set '" + b + "'"; return false; }
+        out = *s->params;
+    }
+    if (has_prop(env, v, "name")) {
+        napi_get_named_property(env, v, "name", &pv);
+        if (!get_string(env, pv, name)) { err = "params.name: expected a string"; return false; }
+    }
+    char* base = reinterpret_cast<char*>(&out);
+    for (const ParamField& f : kParamFields) {
+        if (!has_prop(env, v, f.name)) continue;
+        if (f.derived) continue;                   // 빌드 고정 / 계산 값은 무시 (paramSets 출력을 그대로 넘겨도 되게)
+        napi_get_named_property(env, v, f.name, &pv);
+        if (f.type == 'b') {
+            bool b = false;
+            if (napi_get_value_bool(env, pv, &b) != napi_ok) { err = std::string("params.") + f.name + ": expected a boolean"; return false; }
+            *reinterpret_cast<bool*>(base + f.off) = b;
+            continue;
+        }
+        double d = 0;
+        if (napi_get_value_double(env, pv, &d) != napi_ok || !std::isfinite(d)) {
+            err = std::string("params.") + f.name + ": expected a finite number";
+            return false;
+        }
+        if (f.type == 'd') { *reinterpret_cast<double*>(base + f.off) = d; continue; }
+        // 범위 밖 / 소수 double → int 변환은 UB 라서 먼저 확인
+        if (d != std::trunc(d) || d < (double)INT32_MIN || d > (double)INT32_MAX) {
+            err = std::string("params.") + f.name + ": expected an integer in int32 range";
+            return false;
+        }
+        *reinterpret_cast<int*>(base + f.off) = (int)d;
+    }
+    if (has_prop(env, v, "n_lwe") && !has_prop(env, v, "n_ks")) out._n_ks = out._n_lwe;
+    if ((has_prop(env, v, "base_ks") || has_prop(env, v, "base_rm_ks")) && !has_prop(env, v, "gadget_len_ks")) out._gadget_len_ks = 0;
+    if ((has_prop(env, v, "base_bk_a") || has_prop(env, v, "base_rm_bk_a")) && !has_prop(env, v, "base_len_bk_a")) out._base_len_bk_a = 0;
+    if ((has_prop(env, v, "base_bk_b") || has_prop(env, v, "base_rm_bk_b")) && !has_prop(env, v, "base_len_bk_b")) out._base_len_bk_b = 0;
+    return true;
+}
+
+// paramSets() → [{ name, note, ...params }]  내장 세트
+static napi_value js_param_sets(napi_env env, napi_callback_info) {
+    const FHE16_ParamSet* sets = nullptr;
+    const int n = FHE16_param_sets(&sets);
+    napi_value arr, v;
+    NAPI_CALL(env, napi_create_array(env, &arr));
+    for (int i = 0; i < n; ++i) {
+        napi_value o = params_to_js(env, *sets[i].params, sets[i].name);
+        if (!o) return nullptr;
+        napi_create_string_utf8(env, sets[i].note, NAPI_AUTO_LENGTH, &v);
+        napi_set_named_property(env, o, "note", v);
+        napi_set_element(env, arr, i, o);
+    }
+    return arr;
+}
+
+// currentParams() → GenEval / LoadEval 이 쓰는 (또는 쓴) 세트
+static napi_value js_current_params(napi_env env, napi_callback_info) {
+    return params_to_js(env, FHE16_params_current(), FHE16_params_current_name());
+}
+
+// selectParams(nameOrObject) → currentParams(). 키 생성 전에만, 검사에 걸리면 throw
+static napi_value js_select_params(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+    if (argc < 1) { napi_throw_type_error(env, nullptr, "selectParams: expected a set name or an object"); return nullptr; }
+    FHE16Params p;
+    std::string name, err;
+    if (!params_from_js(env, argv[0], p, name, err)) { napi_throw_type_error(env, nullptr, err.c_str()); return nullptr; }
+    if (!FHE16_params_select(p, name.c_str(), err)) { napi_throw_error(env, nullptr, err.c_str()); return nullptr; }
+    return js_current_params(env, nullptr);
+}
+
+// noiseModel(opts?: { log2Pfail, params }) → { available, log2Bound, maxXorFanin, log2Pfail: [f = 1..7] }
+//   평가 키의 파라미터로 추정한 실패 확률 (fhe16_noise.hpp). 키가 없으면 available = false
+//   opts.params (세트 이름 / 객체, selectParams 와 같은 형식) 를 주면 키 없이 그 세트로 추정
+static napi_value js_noise_model(napi_env env, napi_callback_info info) {
+    size_t argc = 1;
+    napi_value argv[1];
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+    napi_value opts = argc > 0 ? argv[0] : nullptr;
+    double bound;
+    if (!opt_log2_bound(env, opts, bound)) return nullptr;
+
+    FHE16_NoiseParams np;
+    bool ok;
+    int fanin;
+    napi_valuetype t = napi_undefined;
+    if (opts && napi_typeof(env, opts, &t) == napi_ok && t == napi_object && has_prop(env, opts, "params")) {
+        napi_value pv;
+        FHE16Params p;
+        std::string name, err;
+        napi_get_named_property(env, opts, "params", &pv);
+        if (!params_from_js(env, pv, p, name, err) || !FHE16_params_normalize(p, err)) {
+            napi_throw_type_error(env, nullptr, err.c_str());
+            return nullptr;
+        }
+        FHE16_noise_params_from(p, np);
+        ok = true;
+        fanin = FHE16_noise_max_fanin(np, bound);
+        if (fanin < 2) {
+            // 입력 2 개 (일반 XOR / 이항 게이트) 부터 한도를 넘는 세트 — 2 로 보고하면 쓸 수 있는 것처럼 보인다
+            char msg[160];
+            std::snprintf(msg, sizeof(msg), "noiseModel: params exceed the noise bound at XOR fan-in 2 "
+                          "(log2 pfail %.1f > %.1f)", FHE16_noise_log2_pfail(np, 2), bound);
+            napi_throw_range_error(env, nullptr, msg);
+            return nullptr;
+        }
+    } else {
+        ok = FHE16_noise_params_live(np);
+        fanin = live_xor_fanin(bound);
+    }
+    napi_value o, v, arr;
+    NAPI_CALL(env, napi_create_object(env, &o));
+    napi_get_boolean(env, ok, &v);             napi_set_named_property(env, o, "available", v);
+    napi_create_double(env, bound, &v);        napi_set_named_property(env, o, "log2Bound", v);
+    napi_create_int32(env, fanin, &v);         napi_set_named_property(env, o, "maxXorFanin", v);
+    NAPI_CALL(env, napi_create_array(env, &arr));
+    if (ok) {
+        for (int f = 1; f <= FHE16_NOISE_MAX_FANIN; ++f) {
+            napi_create_double(env, FHE16_noise_log2_pfail(np, f), &v);
+            napi_set_element(env, arr, f - 1, v);
+        }
+    }
+    napi_set_named_property(env, o, "log2Pfail", arr);
+    return o;
+}
+
+// physicalCores() → 물리 코어 수 (하이퍼스레드 제외). 실행기 작업 풀 크기 산정용
+static napi_value js_physical_cores(napi_env env, napi_callback_info) {
+    napi_value v;
+    NAPI_CALL(env, napi_create_int32(env, get_physical_core_count(), &v));
+    return v;
+}
+
+static void free_state(napi_env, void* data, void*) {
+    delete static_cast<AddonState*>(data);
+}
+
+static bool set_fn(napi_env env, napi_value exports, const char* name, napi_callback cb, void* data) {
+    napi_value fn;
+    return napi_create_function(env, name, NAPI_AUTO_LENGTH, cb, data, &fn) == napi_ok &&
+           napi_set_named_property(env, exports, name, fn) == napi_ok;
+}
+
+static napi_value Init(napi_env env, napi_value exports) {
+    NAPI_CALL(env, napi_set_instance_data(env, new AddonState(), free_state, nullptr));
+    register_slots();
+
+    for (const OpDesc& op : kOps)
+        if (!set_fn(env, exports, op.name, op_call, (void*)&op)) return nullptr;
+
+    if (!set_fn(env, exports, "genEval", js_gen_eval, nullptr) ||
+        !set_fn(env, exports, "loadEval", js_load_eval, nullptr) ||
+        !set_fn(env, exports, "bootparamLoadFileGlobal", js_bootparam_load_global, nullptr) ||
+        !set_fn(env, exports, "secretKeyLoadFileSafe", js_secret_key_load, nullptr) ||
+        !set_fn(env, exports, "runPlan", js_run_plan, nullptr) ||
+        !set_fn(env, exports, "decIntBatch", js_dec_int_batch, nullptr) ||
+        !set_fn(env, exports, "optimizePlan", js_optimize_plan, nullptr) ||
+        !set_fn(env, exports, "noiseModel", js_noise_model, nullptr) ||
+        !set_fn(env, exports, "paramSets", js_param_sets, nullptr) ||
+        !set_fn(env, exports, "currentParams", js_current_params, nullptr) ||
+        !set_fn(env, exports, "selectParams", js_select_params, nullptr) ||
+        !set_fn(env, exports, "setMaxConcurrency", js_set_max_concurrency, nullptr) ||
+        !set_fn(env, exports, "stats", js_stats, nullptr) ||
+        !set_fn(env, exports, "opStats", js_op_stats, nullptr) ||
+        !set_fn(env, exports, "resetOpStats", js_reset_op_stats, nullptr) ||
+        !set_fn(env, exports, "traceStart", js_trace_start, nullptr) ||
+        !set_fn(env, exports, "traceStop", js_trace_stop, nullptr) ||
+        !set_fn(env, exports, "physicalCores", js_physical_cores, nullptr))
+        return nullptr;
+
+    napi_value words;
+    NAPI_CALL(env, napi_create_int32(env, FHE16_CT_WORDS, &words));
+    NAPI_CALL(env, napi_set_named_property(env, exports, "ctWords", words));
+    return exports;
+}
+
+NAPI_MODULE(NODE_GYP_MODULE_NAME, Init)
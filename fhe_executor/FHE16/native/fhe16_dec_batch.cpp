@@ -0,0 +1,223 @@
+// native/fhe16_dec_batch.cpp — 배치 복호화 (fhe16_dec_batch.hpp 참고)
+
+#include "fhe16_dec_batch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+  #include <immintrin.h>
+#endif
+
+// include 순서는 fhe16_addon.cc 와 동일하게
+#include "BinOperationCstyle.hpp"
+#include "soAPI.hpp"
+#include "Core.hpp"
+
+#define FHE16_DEC_K 8        // 전치 한 번에 처리하는 마스크 워드 수
+
+// ===== 벡터 추상화 : 레인 하나 = LWE 하나 =====
+// 모든 연산은 int32 에서 넘침 그대로 (FHE16_DECInt 의 imul / sub / add 와 같음)
+struct DecVecScalar {
+    typedef int32_t T;
+    enum { L = 1 };
+    static inline T load(const int32_t* p)         { return *p; }
+    static inline void store(int32_t* p, T v)      { *p = v; }
+    static inline T splat(int32_t v)               { return v; }
+    static inline T add(T a, T b)                  { return (int32_t)((uint32_t)a + (uint32_t)b); }
+    static inline T sub(T a, T b)                  { return (int32_t)((uint32_t)a - (uint32_t)b); }
+    static inline T mul(T a, T b)                  { return (int32_t)((uint32_t)a * (uint32_t)b); }
+    static inline T and_neg(T a, T q)              { return (a >> 31) & q; }
+    static inline void block(const int32_t* const* row, int j, T v[FHE16_DEC_K]) {
+        for (int t = 0; t < FHE16_DEC_K; ++t) v[t] = row[0][j + t];
+    }
+};
+
+#if defined(__AVX2__)
+// r[k] = 행 k 의 워드 8개 → r[t] = 각 행의 워드 t
+static inline void dec_transpose8(__m256i r[8]) {
+    const __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+    const __m256i t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+    const __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+    const __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+    const __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+    const __m256i t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+    const __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+    const __m256i t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+    const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+    const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+    const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+    const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+    const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+    const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+    const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+    const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+    r[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+    r[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+    r[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+    r[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+    r[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+    r[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+    r[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+    r[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+static inline void dec_load8x8(const int32_t* const* row, int j, __m256i r[8]) {
+    for (int k = 0; k < 8; ++k) r[k] = _mm256_loadu_si256((const __m256i*)(row[k] + j));
+    dec_transpose8(r);
+}
+#endif
+
+#if defined(__AVX512F__) && defined(__AVX2__)
+struct DecVecAVX512 {
+    typedef __m512i T;
+    enum { L = 16 };
+    static inline T load(const int32_t* p)         { return _mm512_loadu_si512((const void*)p); }
+    static inline void store(int32_t* p, T v)      { _mm512_storeu_si512((void*)p, v); }
+    static inline T splat(int32_t v)               { return _mm512_set1_epi32(v); }
+    static inline T add(T a, T b)                  { return _mm512_add_epi32(a, b); }
+    static inline T sub(T a, T b)                  { return _mm512_sub_epi32(a, b); }
+    static inline T mul(T a, T b)                  { return _mm512_mullo_epi32(a, b); }
+    static inline T and_neg(T a, T q)              { return _mm512_and_si512(_mm512_srai_epi32(a, 31), q); }
+    static inline void block(const int32_t* const* row, int j, T v[FHE16_DEC_K]) {
+        __m256i lo[8], hi[8];
+        dec_load8x8(row, j, lo);
+        dec_load8x8(row + 8, j, hi);
+        for (int t = 0; t < FHE16_DEC_K; ++t)
+            v[t] = _mm512_inserti64x4(_mm512_zextsi256_si512(lo[t]), hi[t], 1);
+    }
+};
+typedef DecVecAVX512 DecVecBest;
+#elif defined(__AVX2__)
+struct DecVecAVX2 {
+    typedef __m256i T;
+    enum { L = 8 };
+    static inline T load(const int32_t* p)         { return _mm256_loadu_si256((const __m256i*)p); }
+    static inline void store(int32_t* p, T v)      { _mm256_storeu_si256((__m256i*)p, v); }
+    static inline T splat(int32_t v)               { return _mm256_set1_epi32(v); }
+    static inline T add(T a, T b)                  { return _mm256_add_epi32(a, b); }
+    static inline T sub(T a, T b)                  { return _mm256_sub_epi32(a, b); }
+    static inline T mul(T a, T b)                  { return _mm256_mullo_epi32(a, b); }
+    static inline T and_neg(T a, T q)              { return _mm256_and_si256(_mm256_srai_epi32(a, 31), q); }
+    static inline void block(const int32_t* const* row, int j, T v[FHE16_DEC_K]) { dec_load8x8(row, j, v); }
+};
+typedef DecVecAVX2 DecVecBest;
+#else
+typedef DecVecScalar DecVecBest;
+#endif
+
+// acc ← acc - (a * s + (s < 0 ? q : 0)),  음수면 + q   (FHE16_DECInt 의 한 단계)
+template <class V>
+static inline typename V::T dec_step(typename V::T acc, typename V::T a, int32_t s,
+                                     int32_t q, typename V::T qv) {
+    const typename V::T t = V::add(V::mul(a, V::splat(s)), V::splat((s >> 31) & q));
+    acc = V::sub(acc, t);
+    return V::add(acc, V::and_neg(acc, qv));
+}
+
+// 행 V::L 개의 위상을 phase 에 (행 = LWE 시작 포인터)
+template <class V>
+static void dec_phase(const int32_t* const* row, const int32_t* sk, const FHE16_DecParams& p, int32_t* phase) {
+    const int m = p.width - 1;
+    const typename V::T qv = V::splat(p.q);
+    alignas(64) int32_t lane[V::L];
+
+    for (int k = 0; k < V::L; ++k) lane[k] = row[k][m];
+    typename V::T acc = V::load(lane);
+
+    int j = 0;
+    typename V::T a[FHE16_DEC_K];
+    for (; j + FHE16_DEC_K <= m; j += FHE16_DEC_K) {
+        V::block(row, j, a);
+        for (int t = 0; t < FHE16_DEC_K; ++t) acc = dec_step<V>(acc, a[t], sk[j + t], p.q, qv);
+    }
+    for (; j < m; ++j) {
+        for (int k = 0; k < V::L; ++k) lane[k] = row[k][j];
+        acc = dec_step<V>(acc, V::load(lane), sk[j], p.q, qv);
+    }
+    V::store(phase, acc);
+}
+
+// 위상 → 비트 i 의 기여분 (FHE16_DECInt: idiv 두 번, 64비트 shlx 후 하위 32비트만 더함)
+static inline uint32_t dec_term(int32_t phase, int32_t q, int i) {
+    const int32_t v   = (int32_t)((uint32_t)phase + (uint32_t)(q >> 3));
+    const int32_t bit = (v % q) / (q >> 2);
+    return (uint32_t)((uint64_t)(uint32_t)bit << (i & 63));
+}
+
+bool FHE16_dec_params_live(FHE16_DecParams& p) {
+    const EFHEs::EFHE_BIN_Param_List* P = G_FHE16_PARAM;
+    const FHE16Params* F = P ? P->GetFHE16PARAM() : nullptr;
+    if (!F) return false;
+    p.q     = (int32_t)F->_Q_TOT;
+    p.width = F->_PK_col;
+    return p.q >= 4 && p.width >= 1;
+}
+
+int FHE16_DECInt_BATCH_P(const FHE16_DecParams& p, int32_t* const* ct, int n, const int32_t* sk,
+                         int64_t* out, int threads, uint8_t* ok) {
+    if (p.q < 4 || p.width < 1 || (!sk && p.width > 1)) return -1;
+    if (n <= 0) return 0;
+
+    const int blocks = (n + FHE16_DEC_BATCH_BLOCK - 1) / FHE16_DEC_BATCH_BLOCK;
+    threads = std::max(1, std::min(threads, blocks));
+
+    std::atomic<int> next{0};
+    std::atomic<int> done{0};
+
+    // 블록 안 암호문들의 비트를 차례로 레인에 채운다. 다 못 채운 묶음은 첫 행을 반복 (결과는 버림)
+    auto worker = [&]() {
+        const int32_t* row[DecVecBest::L];
+        int            owner[DecVecBest::L];
+        int            bit[DecVecBest::L];
+        alignas(64) int32_t phase[DecVecBest::L];
+        uint32_t       acc[FHE16_DEC_BATCH_BLOCK];
+        int local = 0;
+
+        for (int b; (b = next.fetch_add(1, std::memory_order_relaxed)) < blocks;) {
+            const int first = b * FHE16_DEC_BATCH_BLOCK;
+            const int end   = std::min(n, first + FHE16_DEC_BATCH_BLOCK);
+            int fill = 0;
+            auto flush = [&]() {
+                for (int k = fill; k < DecVecBest::L; ++k) row[k] = row[0];
+                dec_phase<DecVecBest>(row, sk, p, phase);
+                for (int k = 0; k < fill; ++k) acc[owner[k]] += dec_term(phase[k], p.q, bit[k]);
+                fill = 0;
+            };
+            for (int i = first; i < end; ++i) {
+                acc[i - first] = 0;
+                if (!ct[i]) continue;
+                const int32_t bits = ct[i][0];
+                const int64_t stride = ct[i][1];
+                for (int k = 0; k < bits; ++k) {
+                    row[fill]   = ct[i] + 16 + k * stride;
+                    owner[fill] = i - first;
+                    bit[fill]   = k;
+                    if (++fill == DecVecBest::L) flush();
+                }
+            }
+            if (fill) flush();
+            for (int i = first; i < end; ++i) {
+                const bool good = ct[i] != nullptr;
+                out[i] = good ? (int64_t)(int32_t)acc[i - first] : 0;
+                if (ok) ok[i] = good ? 1 : 0;
+                local += good;
+            }
+        }
+        done.fetch_add(local, std::memory_order_relaxed);
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (std::thread& th : pool) th.join();
+    return done.load();
+}
+
+int FHE16_DECInt_BATCH(int32_t* const* ct, int n, int32_t* sk, int64_t* out, int threads, uint8_t* ok) {
+    FHE16_DecParams p;
+    if (!FHE16_dec_params_live(p)) return -1;
+    return FHE16_DECInt_BATCH_P(p, ct, n, sk, out, threads, ok);
+}
@@ -0,0 +1,37 @@
+// native/fhe16_dec_batch.hpp — 암호문 여러 개를 한 번에 복호화
+//
+// 정산 결과처럼 수천 개의 값을 복호화할 때 호출마다 이벤트 루프/FFI 를 오가지 않도록
+// 암호문 배열을 한 번에 받아 직접 복호화한다 (libFHE16 호출 없음 → 스레드를 나눠도 안전).
+//
+// 결과는 라이브러리의 FHE16_DECInt 와 비트 단위로 같다:
+//   비트 i 의 LWE = CT + 16 + i * CT[1]  (CT[0] = 비트 수, CT[1] = 비트당 워드 수)
+//   위상 = b - Σ_{j < width-1} a_j * s_j  (b = LWE[width-1]), 매 j 마다 int32 로 빼고 음수면 q 를 더한다
+//   비트 = ((위상 + q/8) % q) / (q/4),  결과 = Σ 비트 << i  (int32 에서 넘침 그대로)
+// q / width 는 평가 파라미터의 공개키 모듈러스 (_Q_TOT 하위 32비트) / 공개키 열 수 (_PK_col).
+// GetQLWE() / GetNLWE() 는 부트스트랩용 LWE (q = 2^14, n = 585) 라 FHE16_DECInt 가 쓰는 값이 아니다.
+//
+// 여러 비트의 LWE 를 벡터 레인 하나씩에 올려 (AVX-512 16 / AVX2 8 레인) s_j 를 한 번 broadcast 해 모든 레인에 쓴다.
+// 8 워드씩 레인 수만큼 행을 읽어 전치하므로 행마다 연속으로 읽는다. 레인별 연산 순서는 FHE16_DECInt 와 같다.
+//
+#pragma once
+
+#include <cstdint>
+
+#define FHE16_DEC_BATCH_BLOCK 16     // 스레드가 한 번에 가져가는 암호문 수
+
+struct FHE16_DecParams {
+    int32_t q;          // 복호화 모듈러스 (>= 4)
+    int32_t width;      // 비트당 쓰는 워드 수 = 마스크 width-1 + b (>= 1)
+};
+
+// 로드된 평가 파라미터에서 (GenEval / LoadEval 이후). 없으면 false
+bool FHE16_dec_params_live(FHE16_DecParams& p);
+
+// p 로 복호화: out[i] = FHE16_DECInt(ct[i], sk) 와 같은 값. threads <= 0 이면 1 (n 에 맞춰 줄임)
+// ok 가 있으면 ok[i] = 1 (성공) / 0 (ct[i] 가 null). 반환값 = 성공 개수, p 가 잘못되면 -1
+int FHE16_DECInt_BATCH_P(const FHE16_DecParams& p, int32_t* const* ct, int n, const int32_t* sk,
+                         int64_t* out, int threads = 1, uint8_t* ok = nullptr);
+
+// 로드된 평가 파라미터로 복호화. 파라미터가 없으면 -1
+int FHE16_DECInt_BATCH(int32_t* const* ct, int n, int32_t* sk, int64_t* out,
+                       int threads = 1, uint8_t* ok = nullptr);
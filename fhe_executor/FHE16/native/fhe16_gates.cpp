@@ -0,0 +1,79 @@
+// native/fhe16_gates.cpp — 비트 게이트 기반 정수 연산 (fhe16_gates.hpp 참고)
+
+#include "fhe16_gates.hpp"
+#include "fhe16_plan.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+// include 순서는 fhe16_addon.cc 와 동일하게
+#include "BinOperationCstyle.hpp"
+#include "soAPI.hpp"
+#include "Core.hpp"
+
+// 코어별 부트스트랩 버퍼 (라이브러리의 GetKSRaw16 / GetBKRaw16 와 같게). 키가 없으면 throw
+static FHE16BOOTParam* xor3_boot_param() {
+    const EFHEs::EFHE_BIN_Param_List* P = G_FHE16_PARAM;
+    EFHEs::EvaluationKey32* ev = P ? P->GetEV() : nullptr;
+    FHE16BOOTParam** per_core = ev ? ev->GetBOOTThreadParam() : nullptr;
+    FHE16BOOTParam* bp = per_core ? per_core[get_core_id()] : nullptr;
+    if (!bp) throw std::runtime_error("evaluation key not loaded (FHE16_GenEval / FHE16_LoadEval)");
+    return bp;
+}
+
+int32_t* FHE16_XOR3VEC(int32_t* CT1, int32_t* CT2, int32_t* CT3) {
+    if (!CT1 || !CT2 || !CT3) throw std::runtime_error("null ciphertext");
+    if (!FHE16_ct_meta_ok(CT1) || !FHE16_ct_meta_ok(CT2) || !FHE16_ct_meta_ok(CT3))
+        throw std::runtime_error("invalid ciphertext header (bits / words per bit)");
+    FHE16BOOTParam* bp = xor3_boot_param();
+
+    const size_t words = FHE16_ct_words(CT1);
+    if (FHE16_ct_words(CT2) != words || FHE16_ct_words(CT3) != words) {
+        int32_t* t = FHE16_XORVEC(CT1, CT2);
+        if (!t) return nullptr;
+        int32_t* r = FHE16_XORVEC(t, CT3);
+        std::free(t);
+        return r;
+    }
+    const int bits = (int)((words - FHE16_CT_META) / FHE16_LWE_WORDS);
+
+    int32_t* res = static_cast<int32_t*>(std::malloc(words * sizeof(int32_t)));
+    if (!res) return nullptr;
+    std::memcpy(res, CT1, FHE16_CT_META * sizeof(int32_t));
+
+    // 평가 키는 GenEval / LoadEval 의 기본 방식 GINX_16bit
+    for (int i = 0; i < bits; ++i) {
+        const size_t off = FHE16_CT_META + (size_t)i * FHE16_LWE_WORDS;
+        C_FHE16_XOR3(CT1 + off, CT2 + off, CT3 + off, res + off, bp, GINX_16bit);
+    }
+    return res;
+}
+
+bool FHE16_noise_params_live(FHE16_NoiseParams& p) {
+    const EFHEs::EFHE_BIN_Param_List* P = G_FHE16_PARAM;
+    if (!P) return false;
+    p.delta    = P->GetQLWE() > 0 ? (double)P->GetScalingLWE() / P->GetQLWE() : 0;
+    p.n_lwe    = P->GetNLWE();
+    p.n_bk     = (int)P->GetNBK();
+    p.k_bk     = (int)P->GetKBK();
+    p.q_bk     = (double)P->GetQBKTOT();
+    p.sigma_bk = P->GetSigmaBK();
+    p.base_bk  = P->GetBaseBKA();
+    p.rm_bk    = P->GetBaseRMBKA();
+    p.len_bk   = P->GetGadgetLenBKA();
+    p.q_ks     = (double)P->GetQKS();
+    p.sigma_ks = P->GetSigmaKS();
+    p.base_ks  = (int)P->GetBaseKS();
+    p.rm_ks    = (int)P->GetBaseRMKS();
+    p.len_ks   = (int)P->GetGadgetLenKS();
+    return p.delta > 0 && p.n_lwe > 0 && p.n_bk > 0 && p.q_bk > 0 && p.q_ks > 0;
+}
+
+double FHE16_noise_log2_bound() {
+    const char* s = std::getenv("FHE16_NOISE_LOG2_PFAIL");
+    if (!s || !*s) return FHE16_NOISE_LOG2_PFAIL_DEFAULT;
+    char* end = nullptr;
+    const double v = std::strtod(s, &end);
+    return (end != s && v < 0) ? v : FHE16_NOISE_LOG2_PFAIL_DEFAULT;
+}
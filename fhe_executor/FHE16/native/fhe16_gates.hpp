@@ -0,0 +1,22 @@
+// native/fhe16_gates.hpp — libFHE16 의 비트 게이트(C_FHE16_*)로 만든 정수 단위 연산
+//
+// FHE16_XORVEC(a, XORVEC(b, c)) 는 비트마다 부트스트랩 2 회지만 C_FHE16_XOR3 는 세 입력을 더한 뒤
+// 한 번만 부트스트랩한다. 합칠 수 있는지는 잡음 모델(fhe16_noise.hpp)로 판단한다.
+//
+#pragma once
+
+#include <cstdint>
+
+#include "fhe16_noise.hpp"
+
+// 비트별 C_FHE16_XOR3. 세 입력의 비트 수가 다르면 FHE16_XORVEC 두 번으로
+// 결과는 malloc (FHE16_* 결과와 같이 free 로 해제). 메모리가 없으면 nullptr
+// null / 메타가 잘못된 암호문, 평가 키가 없을 때 (GenEval / LoadEval 전) 는 std::runtime_error
+// (애드온의 직접 호출과 계획 단계는 예외를 잡아 작업 오류로 돌려준다)
+int32_t* FHE16_XOR3VEC(int32_t* CT1, int32_t* CT2, int32_t* CT3);
+
+// 현재 평가 키(G_FHE16_PARAM)의 잡음 파라미터. 키가 없으면 false
+bool FHE16_noise_params_live(FHE16_NoiseParams& out);
+
+// 실패 확률 한도: FHE16_NOISE_LOG2_PFAIL (기본 -40)
+double FHE16_noise_log2_bound();
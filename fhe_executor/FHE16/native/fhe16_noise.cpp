@@ -0,0 +1,39 @@
+// native/fhe16_noise.cpp — LWE 잡음 분산 추정 (fhe16_noise.hpp 참고)
+
+#include "fhe16_noise.hpp"
+
+#include <cmath>
+
+double FHE16_noise_variance(const FHE16_NoiseParams& p, int fanin) {
+    const double N  = p.n_bk;
+    const double kN = (double)p.k_bk * N;
+    const double B  = std::ldexp(1.0, p.base_bk);
+
+    const double ep = (p.k_bk + 1.0) * p.len_bk * N * (B * B / 12.0) * std::pow(p.sigma_bk / p.q_bk, 2)
+                    + (1.0 + kN / 2.0) * std::ldexp(1.0, 2 * p.rm_bk) / 12.0 / (p.q_bk * p.q_bk);
+    const double v_br  = p.n_lwe * ep;
+    const double v_ms1 = (1.0 + kN / 2.0) / (12.0 * p.q_ks * p.q_ks);
+    const double v_ks  = kN * (p.len_ks * std::pow(p.sigma_ks / p.q_ks, 2)
+                             + std::ldexp(1.0, 2 * p.rm_ks) / 24.0 / (p.q_ks * p.q_ks));
+    const double v_ms2 = (1.0 + p.n_lwe / 2.0) / (12.0 * 4.0 * N * N);
+    return fanin * v_br + v_ms1 + v_ks + v_ms2;
+}
+
+double FHE16_noise_log2_pfail(const FHE16_NoiseParams& p, int fanin) {
+    const double var = FHE16_noise_variance(p, fanin);
+    if (!(var > 0)) return 0;   // 파라미터 이상 → 항상 실패로 본다
+    const double x = (p.delta / 2.0) / std::sqrt(2.0 * var);
+    const double e = std::erfc(x);
+    if (e > 1e-300) return std::log2(e);
+    // erfc(x) ~ exp(-x^2) / (x sqrt(pi))
+    return (-x * x - std::log(x * std::sqrt(M_PI))) / std::log(2.0);
+}
+
+int FHE16_noise_max_fanin(const FHE16_NoiseParams& p, double log2_bound) {
+    int best = 1;
+    for (int f = 2; f <= FHE16_NOISE_MAX_FANIN; ++f) {
+        if (FHE16_noise_log2_pfail(p, f) > log2_bound) break;
+        best = f;
+    }
+    return best;
+}
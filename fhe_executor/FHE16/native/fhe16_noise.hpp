@@ -0,0 +1,48 @@
+// native/fhe16_noise.hpp — LWE 잡음 분산 추정 (선형 게이트를 부트스트랩 없이 합칠 수 있는지 판단)
+//
+// XOR 은 LWE 덧셈 + 패리티 LUT 부트스트랩 1회로 끝나므로 XOR 를 k 개 이어 붙이는 대신
+// 입력 f 개를 더한 뒤 한 번만 부트스트랩하면 부트스트랩 f-2 회가 사라진다 (libFHE16 의 C_FHE16_XOR3..XOR7).
+// 합칠수록 잡음이 커지므로, 파라미터에서 보수적으로 추정한 실패 확률이 한도(기본 2^-40) 안일 때만 합친다.
+//
+// 모델 (분산은 토러스 단위 = 모듈러스 대비 비율의 제곱, 이진 비밀키, KS-first):
+//   v_br  = n_lwe * [ (k+1) * len_bk * N * B_bk^2/12 * (sigma_bk/Q)^2 + (1 + kN/2) * 2^(2 rm_bk)/12 / Q^2 ]
+//           블라인드 회전 출력 (외부곱 n_lwe 회, 숫자는 [-B/2, B/2) 균등, 하위 rm 비트 버림 오차 포함)
+//   v_ms1 = (1 + kN/2) / (12 q_ks^2)                         Q → q_ks 모듈러스 전환
+//   v_ks  = kN * [ len_ks * (sigma_ks/q_ks)^2 + 2^(2 rm_ks)/24 / q_ks^2 ]   키 스위칭 (버린 하위 비트 포함)
+//   v_ms2 = (1 + n_lwe/2) / (12 (2N)^2)                      q_ks → 2N 모듈러스 전환
+//   var(f) = f * v_br + v_ms1 + v_ks + v_ms2                 부트스트랩 출력 f 개의 합 → 다음 부트스트랩 입력
+// 비트는 Δ = scaling_lwe / q_lwe (배포 파라미터 = 1/4) 배수로 실리고 패리티는 합이 mod 1 로 감겨도
+// 보존되므로 입력 수와 무관하게 여유 = Δ/2, 실패 확률 = erfc(여유 / (sigma * sqrt 2)).
+//
+// 라이브러리에 의존하지 않는다 (파라미터는 FHE16_noise_params_live 가 채움, fhe16_gates.hpp).
+//
+#pragma once
+
+#define FHE16_NOISE_LOG2_PFAIL_DEFAULT (-40.0)
+#define FHE16_NOISE_MAX_FANIN          7       // libFHE16 이 제공하는 가장 넓은 XOR (C_FHE16_XOR7)
+
+struct FHE16_NoiseParams {
+    double delta;           // 메시지 간격 (토러스 단위, scaling_lwe / q_lwe)
+    int    n_lwe;           // LWE 차원
+    int    n_bk;            // 링 차수 N
+    int    k_bk;            // RLWE 모듈 차수 k
+    double q_bk;            // 부트스트랩 키 모듈러스 Q (CRT 곱)
+    double sigma_bk;
+    int    base_bk;         // 가젯 밑 (log2)
+    int    rm_bk;           // 버리는 하위 비트 수
+    int    len_bk;          // 가젯 길이
+    double q_ks;
+    double sigma_ks;
+    int    base_ks;
+    int    rm_ks;
+    int    len_ks;
+};
+
+// 입력 f 개를 더한 LWE 를 부트스트랩할 때의 분산 (토러스 단위)
+double FHE16_noise_variance(const FHE16_NoiseParams& p, int fanin);
+
+// log2(실패 확률). 한없이 작으면 점근식으로 (double 언더플로 없음)
+double FHE16_noise_log2_pfail(const FHE16_NoiseParams& p, int fanin);
+
+// log2 실패 확률이 log2_bound 이하인 가장 큰 f (2..FHE16_NOISE_MAX_FANIN). 2 도 넘으면 1
+int FHE16_noise_max_fanin(const FHE16_NoiseParams& p, double log2_bound);
@@ -0,0 +1,131 @@
+// native/fhe16_params.cpp — 파라미터 세트 표 / 선택 (fhe16_params.hpp 참고)
+
+#include "fhe16_params.hpp"
+#include "fhe16_noise.hpp"
+
+#include <cmath>
+#include <cstring>
+
+// include 순서는 fhe16_addon.cc 와 동일하게
+#include "BinOperationCstyle.hpp"
+#include "soAPI.hpp"
+#include "Core.hpp"
+
+// FHE16Param.hpp 에 선언이 없는 내장 세트 (libFHE16.so 에서 export)
+extern FHE16Params GINX16bit_128b_RELEASE;
+extern FHE16Params GINX16bit_128b_TEST;
+
+static const FHE16_ParamSet kSets[] = {
+    { "ginx16_128b", "production set (n_lwe 585, bk 7/7/3 + 9/10/2, ks 5/0/3)", &GINX16bit_128b_RELEASE },
+    { "ginx16_test", "functional tests only, NOT secure (n_lwe 2, sigma 0.01)",  &GINX16bit_128b_TEST },
+};
+
+static std::string g_name = "ginx16_128b";
+
+int FHE16_param_sets(const FHE16_ParamSet** out) {
+    *out = kSets;
+    return (int)(sizeof(kSets) / sizeof(kSets[0]));
+}
+
+const FHE16_ParamSet* FHE16_param_set_find(const char* name) {
+    for (const FHE16_ParamSet& s : kSets)
+        if (std::strcmp(s.name, name) == 0) return &s;
+    return nullptr;
+}
+
+static int ceil_log2(int64_t v) {
+    int b = 0;
+    while (((int64_t)1 << b) < v) ++b;
+    return b;
+}
+
+// 가젯 (밑, 버리는 비트, 길이) 이 bits 비트를 덮는지. len 이 0 이면 채움
+static bool check_gadget(const char* what, int base, int rm, int& len, int bits, std::string& err) {
+    if (base < 1 || base > 16 || rm < 0) {
+        err = std::string(what) + ": base must be 1..16 and rm >= 0";
+        return false;
+    }
+    if (len <= 0) len = (bits - rm + base - 1) / base;
+    if (rm + base * len < bits || rm + base * len > 31) {
+        err = std::string(what) + ": rm + base * len = " + std::to_string(rm + base * len) +
+              ", must cover " + std::to_string(bits) + " bits (and stay <= 31)";
+        return false;
+    }
+    return true;
+}
+
+bool FHE16_params_normalize(FHE16Params& p, std::string& err) {
+    const FHE16Params& build = GINX16bit_128b_RELEASE;
+
+    // 빌드에 고정된 것 (링 / CRT 모듈러스)
+    if (p._n_bk != build._n_bk || p._k_bk != build._k_bk) {
+        err = "ring (n_bk " + std::to_string(p._n_bk) + ", k_bk " + std::to_string(p._k_bk) +
+              ") is fixed by the library build (" + std::to_string(build._n_bk) + ", " + std::to_string(build._k_bk) + ")";
+        return false;
+    }
+    if (p._q_num != build._q_num || std::memcmp(p._q_bk16, build._q_bk16, sizeof(p._q_bk16)) != 0) {
+        err = "bootstrapping moduli are fixed by the library build";
+        return false;
+    }
+
+    if (p._n_lwe < 1 || p._n_lwe > 4096) { err = "n_lwe must be 1..4096"; return false; }
+    if (!(p._sigma_lwe >= 0) || !(p._sigma_ks >= 0) || !(p._sigma_bs >= 0) ||
+        !std::isfinite(p._sigma_lwe) || !std::isfinite(p._sigma_ks) || !std::isfinite(p._sigma_bs)) {
+        err = "sigmas must be finite and >= 0";
+        return false;
+    }
+    // LWE / KS 모듈러스는 16비트에 담기는 2 의 거듭제곱
+    for (int q : { p._q_lwe, p._q_ks }) {
+        if (q < 256 || q > (1 << 15) || (q & (q - 1)) != 0) {
+            err = "q_lwe / q_ks must be powers of two in 2^8..2^15";
+            return false;
+        }
+    }
+    if (p._scaling_lwe <= 0 || p._scaling_lwe >= p._q_lwe) { err = "scaling_lwe must be in (0, q_lwe)"; return false; }
+
+    p._q_lwe_bit   = ceil_log2(p._q_lwe);
+    p._q_ks_bit    = ceil_log2(p._q_ks);
+    if (p._n_ks <= 0) p._n_ks = p._n_lwe;
+    p._n_lwe_cache = ((p._n_lwe + 1 + 31) / 32) * 32;     // EFHE_BIN_Param_List 의 _n_lwe_avx512_16bit 와 같은 규칙
+    if (p._n_lwe_cache < 64) p._n_lwe_cache = 64;           // ginx16_test (n_lwe 2) 도 64
+    int64_t Q = 1;
+    for (int i = 0; i < p._q_num; ++i) Q *= p._q_bk16[i];
+    p._Q_TOT       = Q;
+    p._q_bk_bit16  = ceil_log2(Q);
+
+    return check_gadget("ks",   p._base_ks,   p._base_rm_ks,   p._gadget_len_ks, p._q_ks_bit,   err) &&
+           check_gadget("bk_a", p._base_bk_a, p._base_rm_bk_a, p._base_len_bk_a, p._q_bk_bit16, err) &&
+           check_gadget("bk_b", p._base_bk_b, p._base_rm_bk_b, p._base_len_bk_b, p._q_bk_bit16, err);
+}
+
+bool FHE16_params_select(const FHE16Params& p, const char* name, std::string& err) {
+    if (G_FHE16_PARAM) {
+        err = "evaluation key already initialised; select parameters before GenEval / LoadEval";
+        return false;
+    }
+    FHE16Params q = p;
+    if (!FHE16_params_normalize(q, err)) return false;
+    GINX16bit_128b = q;
+    g_name = (name && *name) ? name : "custom";
+    return true;
+}
+
+const FHE16Params& FHE16_params_current() { return GINX16bit_128b; }
+const char* FHE16_params_current_name() { return g_name.c_str(); }
+
+void FHE16_noise_params_from(const FHE16Params& p, FHE16_NoiseParams& np) {
+    np.delta    = p._q_lwe > 0 ? (double)p._scaling_lwe / p._q_lwe : 0;
+    np.n_lwe    = p._n_lwe;
+    np.n_bk     = p._n_bk;
+    np.k_bk     = p._k_bk;
+    np.q_bk     = (double)p._Q_TOT;
+    np.sigma_bk = p._sigma_bs;
+    np.base_bk  = p._base_bk_a;
+    np.rm_bk    = p._base_rm_bk_a;
+    np.len_bk   = p._base_len_bk_a;
+    np.q_ks     = p._q_ks;
+    np.sigma_ks = p._sigma_ks;
+    np.base_ks  = p._base_ks;
+    np.rm_ks    = p._base_rm_ks;
+    np.len_ks   = p._gadget_len_ks;
+}
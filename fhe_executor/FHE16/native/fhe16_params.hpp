@@ -0,0 +1,35 @@
+// native/fhe16_params.hpp — 파라미터 세트를 데이터로 (FHE16Params 표, 실행 중 선택)
+//
+// libFHE16 은 GenEval / LoadEval 때 전역 GINX16bit_128b (FHE16Params) 로 EFHE_BIN_Param_List 를 만든다.
+// 이 전역은 라이브러리 로드 시 GINX16bit_128b_RELEASE 를 복사한 값이므로, 키를 만들기 전에 바꾸면
+// 라이브러리를 다시 빌드하지 않고 n_lwe / 시그마 / 가젯 밑을 바꿀 수 있다.
+// 링 차수 N, k, CRT 모듈러스는 커널과 NTT 표가 빌드 시 고정(CMAKEPARAM.h)이라 바꿀 수 없다 → 거절.
+// 평가 키(bootparam.bin)는 그 키를 만든 파라미터 세트에서만 쓸 수 있다.
+//
+#pragma once
+
+#include <string>
+
+struct FHE16Params;
+struct FHE16_NoiseParams;
+
+struct FHE16_ParamSet {
+    const char*        name;
+    const char*        note;
+    const FHE16Params* params;
+};
+
+// 내장 세트 (라이브러리가 export 하는 값). 반환 = 개수
+int FHE16_param_sets(const FHE16_ParamSet** out);
+const FHE16_ParamSet* FHE16_param_set_find(const char* name);
+
+// 파생 필드(Q_TOT, *_bit, n_lwe_cache, 0 인 n_ks / 가젯 길이)를 채우고 검사. 실패하면 false + err
+bool FHE16_params_normalize(FHE16Params& p, std::string& err);
+
+// GINX16bit_128b 를 바꾼다. GenEval / LoadEval 전에만 (평가 키가 이미 있으면 false)
+bool FHE16_params_select(const FHE16Params& p, const char* name, std::string& err);
+const FHE16Params& FHE16_params_current();
+const char* FHE16_params_current_name();
+
+// 잡음 모델 입력 (fhe16_noise.hpp). FHE16_noise_params_live 와 같은 필드 대응
+void FHE16_noise_params_from(const FHE16Params& p, FHE16_NoiseParams& out);
@@ -0,0 +1,360 @@
+// native/fhe16_plan.cpp — 실행 계획 디코딩 / 생존 구간 / 스케줄러 (fhe16_plan.hpp 참고)
+
+#include "fhe16_plan.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+struct OpInfo {
+    const char* name;
+    int         arity;
+};
+
+static const OpInfo kOpInfo[FHE16_OP_COUNT_] = {
+    { nullptr,          0 },
+    { "add",            2 },
+    { "sub",            2 },
+    { "add3",           3 },
+    { "ge",             2 },
+    { "gt",             2 },
+    { "le",             2 },
+    { "lt",             2 },
+    { "eq",             2 },
+    { "neq",            2 },
+    { "max",            2 },
+    { "min",            2 },
+    { "and",            2 },
+    { "or",             2 },
+    { "xor",            2 },
+    { "select",         3 },
+    { "smull",          2 },
+    { "smull_constant", 1 },
+    { "add_constant",   1 },
+    { "neg",            1 },
+    { "abs",            1 },
+    { "relu",           1 },
+    { "add_pow2",       1 },
+    { "sub_pow2",       1 },
+    { "shl_constant",   1 },
+    { "xor3",           3 },
+};
+
+int32_t FHE16_plan_op_code(const char* name) {
+    for (int32_t op = 1; op < FHE16_OP_COUNT_; ++op)
+        if (std::strcmp(kOpInfo[op].name, name) == 0) return op;
+    return 0;
+}
+
+const char* FHE16_plan_op_name(int32_t op) {
+    return (op > 0 && op < FHE16_OP_COUNT_) ? kOpInfo[op].name : nullptr;
+}
+
+int FHE16_plan_op_arity(int32_t op) {
+    return (op > 0 && op < FHE16_OP_COUNT_) ? kOpInfo[op].arity : -1;
+}
+
+// ===== 직렬화 =====
+bool FHE16_plan_decode(const int32_t* w, size_t nwords, FHE16_Plan& out, std::string& err) {
+    if (nwords < 4 || w[0] != FHE16_PLAN_MAGIC) { err = "plan: bad magic"; return false; }
+    const int32_t ni = w[1], ns = w[2], no = w[3];
+    if (ni < 0 || ns < 0 || no <= 0 || ni > 4096 || ns > (1 << 20) || no > 4096) {
+        err = "plan: bad header";
+        return false;
+    }
+    if (nwords != 4 + (size_t)ns * FHE16_PLAN_STEP_WORDS + (size_t)no) { err = "plan: size mismatch"; return false; }
+
+    out.n_inputs = ni;
+    out.steps.resize(ns);
+    const int32_t* q = w + 4;
+    for (int32_t i = 0; i < ns; ++i, q += FHE16_PLAN_STEP_WORDS) {
+        FHE16_PlanStep& s = out.steps[i];
+        s.op   = q[0];
+        s.n_in = q[1];
+        s.in[0] = q[2]; s.in[1] = q[3]; s.in[2] = q[4];
+        s.imm  = q[5];
+        if (FHE16_plan_op_arity(s.op) != s.n_in) {
+            err = "plan: step " + std::to_string(i) + " has bad op/arity";
+            return false;
+        }
+        // SSA: 입력은 앞 단계 결과나 계획 입력만 참조
+        for (int k = 0; k < s.n_in; ++k) {
+            if (s.in[k] < 0 || s.in[k] >= ni + i) {
+                err = "plan: step " + std::to_string(i) + " reads undefined value " + std::to_string(s.in[k]);
+                return false;
+            }
+        }
+        for (int k = s.n_in; k < FHE16_PLAN_MAX_IN; ++k) s.in[k] = -1;
+    }
+    out.outputs.assign(q, q + no);
+    for (int32_t v : out.outputs) {
+        if (v < 0 || v >= ni + ns) { err = "plan: bad output id " + std::to_string(v); return false; }
+    }
+    return true;
+}
+
+void FHE16_plan_encode(const FHE16_Plan& p, std::vector<int32_t>& out) {
+    out.clear();
+    out.reserve(4 + p.steps.size() * FHE16_PLAN_STEP_WORDS + p.outputs.size());
+    out.push_back(FHE16_PLAN_MAGIC);
+    out.push_back(p.n_inputs);
+    out.push_back((int32_t)p.steps.size());
+    out.push_back((int32_t)p.outputs.size());
+    for (const FHE16_PlanStep& s : p.steps) {
+        out.push_back(s.op);
+        out.push_back(s.n_in);
+        for (int k = 0; k < FHE16_PLAN_MAX_IN; ++k) out.push_back(k < s.n_in ? s.in[k] : -1);
+        out.push_back(s.imm);
+    }
+    out.insert(out.end(), p.outputs.begin(), p.outputs.end());
+}
+
+void FHE16_plan_use_counts(const FHE16_Plan& p, std::vector<int>& uses) {
+    uses.assign(p.n_inputs + p.steps.size(), 0);
+    for (const FHE16_PlanStep& s : p.steps)
+        for (int k = 0; k < s.n_in; ++k) ++uses[s.in[k]];
+    for (int32_t v : p.outputs) ++uses[v];
+}
+
+// ===== 내장 연산 =====
+// 암호문 = 16 meta + 비트마다 1040 워드 블록 (비트 0 = LSB). 왼쪽 시프트는 블록을 k 칸 올리고
+// 아래 k 블록을 0 (a = 0, b = 0 → 노이즈 없는 0 의 암호문) 으로 채우면 된다. 넘치는 상위 비트는 버림 (mod 2^n)
+bool FHE16_plan_apply_builtin(const FHE16_PlanStep& s, int32_t* const* in, int32_t** out) {
+    if (s.op != FHE16_OP_SHL_CONST) return false;
+    const int32_t* src = in[0];
+    const size_t words = FHE16_ct_words(src);
+    const int nbits = (int)((words - FHE16_CT_META) / FHE16_LWE_WORDS);
+    const int k = s.imm < 0 ? 0 : (s.imm > nbits ? nbits : s.imm);
+
+    int32_t* dst = (int32_t*)std::malloc(words * sizeof(int32_t));
+    if (dst) {
+        std::memcpy(dst, src, FHE16_CT_META * sizeof(int32_t));
+        std::memset(dst + FHE16_CT_META, 0, (size_t)k * FHE16_LWE_WORDS * sizeof(int32_t));
+        std::memcpy(dst + FHE16_CT_META + (size_t)k * FHE16_LWE_WORDS, src + FHE16_CT_META,
+                    (size_t)(nbits - k) * FHE16_LWE_WORDS * sizeof(int32_t));
+    }
+    *out = dst;
+    return true;
+}
+
+// ===== 실행 =====
+namespace {
+
+struct Runner {
+    const FHE16_Plan&  p;
+    int32_t* const*    inputs;
+    FHE16_PlanApply    apply;
+    FHE16_PlanFree     free_fn;
+
+    int NI, NS;
+    std::vector<int32_t*> val;
+    std::vector<int>      uses;       // 남은 사용 횟수
+    std::vector<char>     live;       // 결과가 쓰이는 단계만 실행
+    int live_now = 0, max_live = 0, steps_run = 0;
+
+    Runner(const FHE16_Plan& p_, int32_t* const* in, FHE16_PlanApply a, FHE16_PlanFree f)
+        : p(p_), inputs(in), apply(a), free_fn(f),
+          NI(p_.n_inputs), NS((int)p_.steps.size()) {}
+
+    // 출력에서 거꾸로 도달 가능한 단계만 live, 사용 횟수도 live 단계 기준으로
+    void analyze() {
+        live.assign(NS, 0);
+        std::vector<char> need(NI + NS, 0);
+        for (int32_t v : p.outputs) need[v] = 1;
+        for (int i = NS - 1; i >= 0; --i) {
+            if (!need[NI + i]) continue;
+            live[i] = 1;
+            const FHE16_PlanStep& s = p.steps[i];
+            for (int k = 0; k < s.n_in; ++k) need[s.in[k]] = 1;
+        }
+        uses.assign(NI + NS, 0);
+        for (int i = 0; i < NS; ++i) {
+            if (!live[i]) continue;
+            const FHE16_PlanStep& s = p.steps[i];
+            for (int k = 0; k < s.n_in; ++k) ++uses[s.in[k]];
+        }
+        for (int32_t v : p.outputs) ++uses[v];
+
+        val.assign(NI + NS, nullptr);
+        for (int i = 0; i < NI; ++i) val[i] = inputs[i];
+    }
+
+    int32_t* exec(int i, std::string& err) {
+        const FHE16_PlanStep& s = p.steps[i];
+        int32_t* in[FHE16_PLAN_MAX_IN] = {};
+        for (int k = 0; k < s.n_in; ++k) in[k] = val[s.in[k]];
+        int32_t* r = nullptr;
+        if (!FHE16_plan_apply_builtin(s, in, &r)) r = apply(s, in, err);
+        if (!r && err.empty()) err = std::string("plan: step ") + std::to_string(i) + " (" + FHE16_plan_op_name(s.op) + ") returned null";
+        return r;
+    }
+
+    // 단계 i 완료 처리 : 결과 저장, 마지막 사용이 끝난 입력 해제
+    void retire(int i, int32_t* r) {
+        val[NI + i] = r;
+        ++steps_run;
+        if (++live_now > max_live) max_live = live_now;
+        const FHE16_PlanStep& s = p.steps[i];
+        for (int k = 0; k < s.n_in; ++k) {
+            const int v = s.in[k];
+            if (--uses[v] == 0 && v >= NI) {
+                free_fn(val[v]);
+                val[v] = nullptr;
+                --live_now;
+            }
+        }
+    }
+
+    void cleanup() {
+        for (int v = NI; v < NI + NS; ++v)
+            if (val[v]) { free_fn(val[v]); val[v] = nullptr; }
+    }
+
+    bool run_serial(std::string& err) {
+        for (int i = 0; i < NS; ++i) {
+            if (!live[i]) continue;
+            int32_t* r = exec(i, err);
+            if (!r) return false;
+            retire(i, r);
+        }
+        return true;
+    }
+
+    bool run_parallel(int nthreads, std::string& err) {
+        std::vector<int> deps(NS, 0);
+        std::vector<std::vector<int>> consumers(NI + NS);
+        std::deque<int> ready;
+        int remaining = 0;
+        for (int i = 0; i < NS; ++i) {
+            if (!live[i]) continue;
+            ++remaining;
+            const FHE16_PlanStep& s = p.steps[i];
+            for (int k = 0; k < s.n_in; ++k) {
+                if (s.in[k] >= NI) { ++deps[i]; consumers[s.in[k]].push_back(i); }
+            }
+            if (deps[i] == 0) ready.push_back(i);
+        }
+
+        std::mutex mu;
+        std::condition_variable cv;
+        bool failed = false;
+
+        auto worker = [&]() {
+            std::unique_lock<std::mutex> lk(mu);
+            for (;;) {
+                cv.wait(lk, [&] { return failed || remaining == 0 || !ready.empty(); });
+                if (failed || remaining == 0) return;
+                const int i = ready.front();
+                ready.pop_front();
+
+                lk.unlock();
+                std::string e;
+                int32_t* r = exec(i, e);
+                lk.lock();
+
+                if (!r) {
+                    if (!failed) err = e;
+                    failed = true;
+                    cv.notify_all();
+                    return;
+                }
+                retire(i, r);
+                for (int c : consumers[NI + i])
+                    if (--deps[c] == 0) ready.push_back(c);
+                --remaining;
+                cv.notify_all();
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (int t = 1; t < nthreads; ++t) pool.emplace_back(worker);
+        worker();
+        for (std::thread& th : pool) th.join();
+        return !failed;
+    }
+};
+
+} // namespace
+
+bool FHE16_plan_run(const FHE16_Plan& p, int32_t* const* inputs, int parallel,
+                    FHE16_PlanApply apply, FHE16_PlanFree free_fn,
+                    std::vector<int32_t*>& outputs, FHE16_PlanStats* st, std::string& err) {
+    const auto t0 = std::chrono::steady_clock::now();
+    outputs.clear();
+
+    Runner R(p, inputs, apply, free_fn);
+    R.analyze();
+
+    // 한도보다 많은 스레드는 FHE16_LibSlot 에서 기다리기만 한다
+    parallel = std::min(parallel, FHE16_lib_limit());
+
+    const bool ok = (parallel > 1 && R.NS > 1) ? R.run_parallel(parallel, err) : R.run_serial(err);
+    if (!ok) { R.cleanup(); return false; }
+
+    // 출력: 단계 결과는 소유권 이전, 입력이나 중복 출력은 복사
+    std::vector<char> handed(R.NI + R.NS, 0);
+    for (int32_t v : p.outputs) {
+        int32_t* ct = R.val[v];
+        if (v < R.NI || handed[v]) {
+            const size_t bytes = FHE16_ct_words(ct) * sizeof(int32_t);
+            int32_t* cp = (int32_t*)std::malloc(bytes);
+            if (!cp) {
+                for (int32_t* o : outputs) free_fn(o);
+                outputs.clear();
+                for (int32_t u : p.outputs) if (u >= R.NI && handed[u]) R.val[u] = nullptr;
+                R.cleanup();
+                err = "plan: out of memory";
+                return false;
+            }
+            std::memcpy(cp, ct, bytes);
+            ct = cp;
+        }
+        handed[v] = 1;
+        outputs.push_back(ct);
+    }
+    for (int v = R.NI; v < R.NI + R.NS; ++v)
+        if (handed[v]) R.val[v] = nullptr;
+    R.cleanup();
+
+    if (st) {
+        st->steps_run  = R.steps_run;
+        st->max_live   = R.max_live;
+        st->elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                             std::chrono::steady_clock::now() - t0).count();
+    }
+    return true;
+}
+
+// ===== 라이브러리 호출 한도 =====
+static std::mutex              g_lib_mu;
+static std::condition_variable g_lib_cv;
+static int                     g_lib_limit = 1;
+static int                     g_lib_busy  = 0;
+
+void FHE16_lib_set_limit(int n) {
+    std::lock_guard<std::mutex> lk(g_lib_mu);
+    g_lib_limit = n < 1 ? 1 : n;
+    g_lib_cv.notify_all();
+}
+
+int FHE16_lib_limit() {
+    std::lock_guard<std::mutex> lk(g_lib_mu);
+    return g_lib_limit;
+}
+
+FHE16_LibSlot::FHE16_LibSlot() {
+    std::unique_lock<std::mutex> lk(g_lib_mu);
+    g_lib_cv.wait(lk, [] { return g_lib_busy < g_lib_limit; });
+    ++g_lib_busy;
+}
+
+FHE16_LibSlot::~FHE16_LibSlot() {
+    std::lock_guard<std::mutex> lk(g_lib_mu);
+    --g_lib_busy;
+    g_lib_cv.notify_one();
+}
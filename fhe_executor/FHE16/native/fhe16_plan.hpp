@@ -0,0 +1,153 @@
+// native/fhe16_plan.hpp — 실행 계획(IR plan) 직렬화 포맷과 네이티브 인터프리터
+//
+// server.js 의 execution_plan 을 JS 에서 한 단계씩 FFI 로 넘기는 대신, 계획 전체를 한 번에 넘겨
+// 네이티브에서 실행한다. (작업당 FFI 호출 1회)
+//  - 값(value)은 SSA 번호: 0..n_inputs-1 = 입력, n_inputs + i = i 번째 단계의 결과
+//  - 생존 구간(liveness): 마지막 사용이 끝난 중간 암호문은 즉시 해제 → 메모리 = 최대 동시 생존 수
+//  - 의존성이 없는 단계는 parallel 개의 스레드로 동시에 실행 (라이브러리 호출 한도 FHE16_lib_limit 이내)
+//  - 요청한 출력만 돌려준다
+//
+// 직렬화 (int32 little endian, FHE16/plan.js 의 encodePlan 이 생성)
+//   [0] magic 'FPL1'   [1] n_inputs   [2] n_steps   [3] n_outputs
+//   n_steps  x { op, n_in, in0, in1, in2, imm }
+//   n_outputs x value id
+//
+// 라이브러리 호출은 FHE16_PlanApply 로 주입 → 이 파일은 libFHE16 에 의존하지 않는다.
+// (SHL_CONST 처럼 암호문 배치만 바꾸는 연산은 FHE16_plan_apply_builtin 이 직접 처리)
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define FHE16_PLAN_MAGIC      0x314C5046   // "FPL1"
+#define FHE16_PLAN_STEP_WORDS 6
+#define FHE16_PLAN_MAX_IN     3
+
+#define FHE16_CT_META   16
+#define FHE16_LWE_WORDS 1040
+#define FHE16_CT_WORDS  (FHE16_CT_META + FHE16_LWE_WORDS * 32)
+
+// 메타 [0] = 비트 수, [1] = 비트당 워드 수 (1040, FHE16_ENCInt 가 기록)
+inline bool FHE16_ct_meta_ok(const int32_t* ct) {
+    return ct[0] > 0 && ct[0] <= 64 && ct[1] == FHE16_LWE_WORDS;
+}
+
+// 메타 기준 전체 워드 수. 비정상 값이면 32비트 기본 길이
+inline size_t FHE16_ct_words(const int32_t* ct) {
+    if (FHE16_ct_meta_ok(ct)) return FHE16_CT_META + (size_t)ct[0] * FHE16_LWE_WORDS;
+    return FHE16_CT_WORDS;
+}
+
+// 연산 코드 (값은 직렬화 포맷의 일부 — 순서 변경 금지)
+enum FHE16_PlanOp : int32_t {
+    FHE16_OP_ADD = 1,
+    FHE16_OP_SUB,
+    FHE16_OP_ADD3,
+    FHE16_OP_GE,
+    FHE16_OP_GT,
+    FHE16_OP_LE,
+    FHE16_OP_LT,
+    FHE16_OP_EQ,
+    FHE16_OP_NEQ,
+    FHE16_OP_MAX,
+    FHE16_OP_MIN,
+    FHE16_OP_AND,
+    FHE16_OP_OR,
+    FHE16_OP_XOR,
+    FHE16_OP_SELECT,
+    FHE16_OP_SMULL,
+    FHE16_OP_SMULL_CONST,   // imm = 상수
+    FHE16_OP_ADD_CONST,     // imm = 상수
+    FHE16_OP_NEG,
+    FHE16_OP_ABS,
+    FHE16_OP_RELU,
+    FHE16_OP_ADD_POW2,      // imm = 지수
+    FHE16_OP_SUB_POW2,      // imm = 지수
+    FHE16_OP_SHL_CONST,     // imm = k. 비트 블록 이동만 (부트스트랩 없음), k >= 비트 수면 자명한 0
+    FHE16_OP_XOR3,          // a ^ b ^ c. 비트마다 세 입력을 더한 뒤 부트스트랩 1회 (fhe16_gates.hpp)
+    FHE16_OP_COUNT_
+};
+
+struct FHE16_PlanStep {
+    int32_t op;
+    int32_t n_in;
+    int32_t in[FHE16_PLAN_MAX_IN];
+    int32_t imm;
+};
+
+struct FHE16_Plan {
+    int32_t n_inputs = 0;
+    std::vector<FHE16_PlanStep> steps;
+    std::vector<int32_t> outputs;
+};
+
+struct FHE16_PlanStats {
+    int     steps_run;      // 실행한 단계 수
+    int     max_live;       // 동시에 살아 있던 중간 암호문 최대 수
+    int64_t elapsed_us;
+};
+
+// 연산 이름 ("add", "smull_constant", ...) ↔ 코드. 모르는 이름이면 0 / nullptr
+int32_t     FHE16_plan_op_code(const char* name);
+const char* FHE16_plan_op_name(int32_t op);
+int         FHE16_plan_op_arity(int32_t op);
+
+bool FHE16_plan_decode(const int32_t* w, size_t nwords, FHE16_Plan& out, std::string& err);
+void FHE16_plan_encode(const FHE16_Plan& p, std::vector<int32_t>& out);
+
+// 값별 남은 사용 횟수 (소비 단계 수 + 출력 횟수)
+void FHE16_plan_use_counts(const FHE16_Plan& p, std::vector<int>& uses);
+
+// 단계 하나 실행: in[] 은 입력 암호문, 반환은 새로 할당된 결과 (실패 시 nullptr)
+typedef int32_t* (*FHE16_PlanApply)(const FHE16_PlanStep& s, int32_t* const* in, std::string& err);
+typedef void     (*FHE16_PlanFree)(int32_t* ct);
+
+// 라이브러리 없이 처리하는 연산 (SHL_CONST). 해당 없으면 false
+bool FHE16_plan_apply_builtin(const FHE16_PlanStep& s, int32_t* const* in, int32_t** out);
+
+// ===== 최적화 (fhe16_plan_opt.cpp) =====
+// 순서대로: 대수 단순화/상수 접기, 2^k 상수곱 → SHL_CONST, 비교+선택 → MAX/MIN,
+// XOR 연쇄 → XOR3 (max_xor_fanin >= 3 일 때, 잡음 한도는 호출자가 fhe16_noise.hpp 로 정함), CSE, DCE.
+// 부트스트랩 수는 32비트 게이트 수 모델로 추정 (FHE16_plan_bootstrap_estimate)
+struct FHE16_PlanOptReport {
+    int     steps_before;
+    int     steps_after;
+    int64_t bootstraps_before;
+    int64_t bootstraps_after;
+    int     folded;             // 상수 접기 / 항등식 제거
+    int     strength_reduced;   // 상수곱 → 시프트
+    int     fused;              // 비교 + 선택 → MAX/MIN
+    int     xor_fused;          // xor(xor(a, b), c) → XOR3
+    int     cse;                // 공통 부분식 제거
+    int     dead;               // 죽은 단계 제거
+};
+
+int64_t FHE16_plan_step_bootstraps(const FHE16_PlanStep& s);
+int64_t FHE16_plan_bootstrap_estimate(const FHE16_Plan& p);
+void    FHE16_plan_optimize(FHE16_Plan& p, FHE16_PlanOptReport* rep, int max_xor_fanin = 2);
+
+// 계획 실행. inputs 는 빌려 쓰고 해제하지 않는다.
+// outputs 는 호출자 소유 (입력을 그대로 출력하거나 같은 값을 두 번 출력하면 복사본)
+// parallel 은 FHE16_lib_limit() 로 줄인다. 2 이상이면 apply 가 여러 스레드에서 불리므로
+// apply 는 라이브러리 호출을 FHE16_LibSlot 으로 감싸야 한다
+bool FHE16_plan_run(const FHE16_Plan& p, int32_t* const* inputs, int parallel,
+                    FHE16_PlanApply apply, FHE16_PlanFree free_fn,
+                    std::vector<int32_t*>& outputs, FHE16_PlanStats* st, std::string& err);
+
+// ===== 라이브러리 호출 한도 =====
+// libFHE16 은 CPU 별 scratch 버퍼와 전역 키를 공유해서 최상위 호출이 동시에 돌면 결과가 깨질 수 있다.
+// 라이브러리를 부르는 곳 (애드온의 직접 연산, 계획 단계) 은 모두 FHE16_LibSlot 을 잡고 호출한다.
+// 한도 = 동시에 허용하는 호출 수. 기본 1 (배포 .so), 동시 호출에 안전한 빌드에서만 늘린다.
+// 프로세스 전역 (worker_threads 의 env 들도 같은 한도를 쓴다)
+void FHE16_lib_set_limit(int n);
+int  FHE16_lib_limit();
+
+struct FHE16_LibSlot {
+    FHE16_LibSlot();
+    ~FHE16_LibSlot();
+    FHE16_LibSlot(const FHE16_LibSlot&) = delete;
+    FHE16_LibSlot& operator=(const FHE16_LibSlot&) = delete;
+};
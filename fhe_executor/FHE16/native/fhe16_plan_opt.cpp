@@ -0,0 +1,290 @@
+// native/fhe16_plan_opt.cpp — 실행 계획 최적화 (CSE / 상수 접기 / 시프트 변환 / 비교+선택 융합 / XOR 융합 / DCE)
+//
+// 한 번의 전진 패스로 새 계획을 만든다. 각 단계는 입력을 치환 표(map)로 바꾼 뒤
+//   1) 규칙으로 다시 쓰고 (다른 값의 별칭이 되거나 다른 연산으로 바뀜)
+//   2) 같은 (op, 입력, imm) 이 이미 있으면 그 값을 재사용 (CSE, 교환법칙 연산은 입력 정렬)
+// 마지막에 출력에서 도달하지 않는 단계를 지우고 SSA 번호를 다시 매긴다.
+// 새 계획의 추정 부트스트랩 수가 줄지 않으면 원래 계획을 유지한다.
+//
+#include "fhe16_plan.hpp"
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+// ===== 부트스트랩 추정 모델 =====
+// 32비트 정수 연산을 게이트 회로로 봤을 때의 부트스트랩(= 2입력 게이트) 수 추정치.
+// 실측이 아니라 상대 비교용: 덧셈기 = 2n + n*log2(n) (prefix adder), 비교 = 3n, mux = n
+namespace {
+
+constexpr int64_t kBits   = 32;
+constexpr int64_t kLog    = 5;
+constexpr int64_t kAdd    = 2 * kBits + kBits * kLog;   // 224
+constexpr int64_t kCmp    = 3 * kBits;                  // 96
+constexpr int64_t kMux    = kBits;                      // 32
+constexpr int64_t kInc    = kBits * kLog;               // 160 (증가/2^k 가감, 부호 반전)
+// 자명한 0: 모든 비트 블록을 밀어내는 시프트. 실행기는 k 를 암호문 비트 수로 자르므로 64비트 암호문에도 0
+constexpr int32_t kZeroShift = 64;
+
+int popcount64(uint64_t x) {
+    int c = 0;
+    for (; x; x &= x - 1) ++c;
+    return c;
+}
+
+} // namespace
+
+int64_t FHE16_plan_step_bootstraps(const FHE16_PlanStep& s) {
+    switch (s.op) {
+    case FHE16_OP_ADD: case FHE16_OP_SUB: case FHE16_OP_ADD_CONST: return kAdd;
+    case FHE16_OP_ADD3:        return 2 * kBits + kAdd;                 // carry-save + 덧셈기
+    case FHE16_OP_GE: case FHE16_OP_GT: case FHE16_OP_LE: case FHE16_OP_LT: return kCmp;
+    case FHE16_OP_EQ: case FHE16_OP_NEQ: return 2 * kBits - 1;
+    case FHE16_OP_MAX: case FHE16_OP_MIN: return kCmp + kMux;
+    case FHE16_OP_AND: case FHE16_OP_OR: case FHE16_OP_XOR: case FHE16_OP_XOR3: return kBits;
+    case FHE16_OP_SELECT:      return kMux;
+    case FHE16_OP_SMULL:       return kBits * kBits + (kBits - 1) * kAdd;
+    case FHE16_OP_SMULL_CONST: {
+        // 시프트-덧셈: 상수의 1 비트마다 덧셈 1회, 음수면 부호 반전 추가
+        const int64_t c = s.imm;
+        const uint64_t mag = (uint64_t)(c < 0 ? -c : c) & 0xffffffffu;
+        return popcount64(mag) * kAdd + (c < 0 ? kInc : 0);
+    }
+    case FHE16_OP_NEG:         return kInc;
+    case FHE16_OP_ABS:         return kInc + kMux;
+    case FHE16_OP_RELU:        return kMux;
+    case FHE16_OP_ADD_POW2: case FHE16_OP_SUB_POW2: return kInc;
+    case FHE16_OP_SHL_CONST:   return 0;
+    }
+    return 0;
+}
+
+int64_t FHE16_plan_bootstrap_estimate(const FHE16_Plan& p) {
+    // 출력에 도달하는 단계만 실행되므로 그 단계만 센다 (FHE16_plan_run 과 동일)
+    const int NI = p.n_inputs, NS = (int)p.steps.size();
+    std::vector<char> need(NI + NS, 0);
+    for (int32_t v : p.outputs) need[v] = 1;
+    int64_t total = 0;
+    for (int i = NS - 1; i >= 0; --i) {
+        if (!need[NI + i]) continue;
+        total += FHE16_plan_step_bootstraps(p.steps[i]);
+        for (int k = 0; k < p.steps[i].n_in; ++k) need[p.steps[i].in[k]] = 1;
+    }
+    return total;
+}
+
+// ===== 최적화 =====
+namespace {
+
+bool is_commutative(int32_t op) {
+    switch (op) {
+    case FHE16_OP_ADD: case FHE16_OP_ADD3: case FHE16_OP_EQ: case FHE16_OP_NEQ:
+    case FHE16_OP_MAX: case FHE16_OP_MIN: case FHE16_OP_AND: case FHE16_OP_OR:
+    case FHE16_OP_XOR: case FHE16_OP_XOR3: case FHE16_OP_SMULL:
+        return true;
+    }
+    return false;
+}
+
+bool is_pow2(int64_t c, int* k) {
+    if (c <= 0 || (c & (c - 1)) != 0) return false;
+    int e = 0;
+    while ((c >> e) != 1) ++e;
+    *k = e;
+    return true;
+}
+
+struct Optimizer {
+    const FHE16_Plan&   in;
+    const int           xor_fanin;
+    FHE16_Plan          out;
+    FHE16_PlanOptReport r = {};
+    std::map<std::tuple<int32_t, int32_t, int32_t, int32_t, int32_t>, int32_t> seen;   // CSE
+
+    Optimizer(const FHE16_Plan& p, int fanin) : in(p), xor_fanin(fanin) { out.n_inputs = p.n_inputs; }
+
+    const FHE16_PlanStep* def(int32_t v) const {
+        return v >= out.n_inputs ? &out.steps[v - out.n_inputs] : nullptr;
+    }
+
+    // 다시 쓰기 규칙. 값 v 의 별칭이 되면 *alias = v 후 true, 단계를 바꿨으면 s 수정 후 true
+    bool rewrite(FHE16_PlanStep& s, int32_t* alias) {
+        const int32_t a = s.in[0], b = s.in[1], c = s.in[2];
+        const FHE16_PlanStep* da = s.n_in >= 1 ? def(a) : nullptr;
+
+        switch (s.op) {
+        case FHE16_OP_SMULL_CONST: {
+            int k;
+            if (s.imm == 1) { *alias = a; ++r.folded; return true; }
+            if (s.imm == 0) {   // x * 0 → 자명한 0
+                s.op = FHE16_OP_SHL_CONST; s.imm = kZeroShift; ++r.folded; return true;
+            }
+            if (da && da->op == FHE16_OP_SMULL_CONST) {
+                const int64_t m = (int64_t)da->imm * s.imm;
+                if (m >= INT32_MIN && m <= INT32_MAX) { s.in[0] = da->in[0]; s.imm = (int32_t)m; ++r.folded; return true; }
+            }
+            if (is_pow2(s.imm, &k)) { s.op = FHE16_OP_SHL_CONST; s.imm = k; ++r.strength_reduced; return true; }
+            break;
+        }
+        case FHE16_OP_SHL_CONST:
+            if (s.imm <= 0) { *alias = a; ++r.folded; return true; }
+            if (da && da->op == FHE16_OP_SHL_CONST) {
+                s.in[0] = da->in[0];
+                s.imm = (int32_t)std::min<int64_t>((int64_t)s.imm + da->imm, kZeroShift);
+                ++r.folded;
+                return true;
+            }
+            break;
+        case FHE16_OP_ADD_CONST:
+            if (s.imm == 0) { *alias = a; ++r.folded; return true; }
+            if (da && da->op == FHE16_OP_ADD_CONST) {
+                const int64_t m = (int64_t)da->imm + s.imm;
+                if (m >= INT32_MIN && m <= INT32_MAX) { s.in[0] = da->in[0]; s.imm = (int32_t)m; ++r.folded; return true; }
+            }
+            break;
+        case FHE16_OP_SUB: case FHE16_OP_XOR:
+            if (a == b) { s.op = FHE16_OP_SHL_CONST; s.n_in = 1; s.in[1] = -1; s.imm = kZeroShift; ++r.folded; return true; }
+            // xor(xor(x, y), z) → XOR3(x, y, z): 비트마다 부트스트랩 2 회 → 1 회 (잡음 한도가 허용할 때만)
+            if (s.op == FHE16_OP_XOR && xor_fanin >= 3) {
+                const FHE16_PlanStep* db = def(b);
+                const FHE16_PlanStep* dx = (da && da->op == FHE16_OP_XOR) ? da : (db && db->op == FHE16_OP_XOR) ? db : nullptr;
+                if (dx) {
+                    const int32_t z = dx == da ? b : a;
+                    s.op = FHE16_OP_XOR3; s.n_in = 3; s.in[0] = dx->in[0]; s.in[1] = dx->in[1]; s.in[2] = z;
+                    ++r.xor_fused;
+                    return true;
+                }
+            }
+            break;
+        case FHE16_OP_XOR3:     // x ^ x ^ z = z
+            if (a == b) { *alias = c; ++r.folded; return true; }
+            if (a == c) { *alias = b; ++r.folded; return true; }
+            if (b == c) { *alias = a; ++r.folded; return true; }
+            break;
+        case FHE16_OP_AND: case FHE16_OP_OR: case FHE16_OP_MAX: case FHE16_OP_MIN:
+            if (a == b) { *alias = a; ++r.folded; return true; }
+            break;
+        case FHE16_OP_NEG:
+            if (da && da->op == FHE16_OP_NEG) { *alias = da->in[0]; ++r.folded; return true; }
+            break;
+        case FHE16_OP_SELECT: {
+            if (b == c) { *alias = b; ++r.folded; return true; }
+            // select(cmp(x, y), x, y) → MAX/MIN (비교 결과를 따로 만들지 않음)
+            if (da) {
+                const int32_t x = da->in[0], y = da->in[1];
+                bool pick_x_when_greater;
+                switch (da->op) {
+                case FHE16_OP_GE: case FHE16_OP_GT: pick_x_when_greater = true;  break;
+                case FHE16_OP_LE: case FHE16_OP_LT: pick_x_when_greater = false; break;
+                default: return false;
+                }
+                int32_t fused = 0;
+                if (b == x && c == y)      fused = pick_x_when_greater ? FHE16_OP_MAX : FHE16_OP_MIN;
+                else if (b == y && c == x) fused = pick_x_when_greater ? FHE16_OP_MIN : FHE16_OP_MAX;
+                if (fused) {
+                    s.op = fused; s.n_in = 2; s.in[0] = x; s.in[1] = y; s.in[2] = -1; s.imm = 0;
+                    ++r.fused;
+                    return true;
+                }
+            }
+            break;
+        }
+        }
+        return false;
+    }
+
+    // 교환법칙 연산의 입력 정렬 (n_in <= 3)
+    static void sort_inputs(FHE16_PlanStep& s) {
+        if (s.n_in >= 2 && s.in[0] > s.in[1]) std::swap(s.in[0], s.in[1]);
+        if (s.n_in >= 3) {
+            if (s.in[1] > s.in[2]) std::swap(s.in[1], s.in[2]);
+            if (s.in[0] > s.in[1]) std::swap(s.in[0], s.in[1]);
+        }
+    }
+
+    int32_t emit(FHE16_PlanStep s) {
+        if (is_commutative(s.op)) sort_inputs(s);
+        if (FHE16_plan_op_arity(s.op) == 1 && s.op != FHE16_OP_SMULL_CONST && s.op != FHE16_OP_ADD_CONST &&
+            s.op != FHE16_OP_ADD_POW2 && s.op != FHE16_OP_SUB_POW2 && s.op != FHE16_OP_SHL_CONST)
+            s.imm = 0;
+        for (int k = s.n_in; k < FHE16_PLAN_MAX_IN; ++k) s.in[k] = -1;
+
+        const auto key = std::make_tuple(s.op, s.in[0], s.in[1], s.in[2], s.imm);
+        auto it = seen.find(key);
+        if (it != seen.end()) { ++r.cse; return it->second; }
+
+        const int32_t id = out.n_inputs + (int32_t)out.steps.size();
+        out.steps.push_back(s);
+        seen.emplace(key, id);
+        return id;
+    }
+
+    void forward() {
+        std::vector<int32_t> map(in.n_inputs + in.steps.size());
+        for (int32_t i = 0; i < in.n_inputs; ++i) map[i] = i;
+
+        for (size_t i = 0; i < in.steps.size(); ++i) {
+            FHE16_PlanStep s = in.steps[i];
+            for (int k = 0; k < s.n_in; ++k) s.in[k] = map[s.in[k]];
+
+            int32_t alias = -1;
+            for (int guard = 0; guard < 8 && alias < 0; ++guard)
+                if (!rewrite(s, &alias)) break;
+            map[in.n_inputs + i] = alias >= 0 ? alias : emit(s);
+        }
+        out.outputs.clear();
+        for (int32_t v : in.outputs) out.outputs.push_back(map[v]);
+    }
+
+    void dce() {
+        const int NI = out.n_inputs, NS = (int)out.steps.size();
+        std::vector<char> need(NI + NS, 0);
+        for (int32_t v : out.outputs) need[v] = 1;
+        for (int i = NS - 1; i >= 0; --i) {
+            if (!need[NI + i]) continue;
+            for (int k = 0; k < out.steps[i].n_in; ++k) need[out.steps[i].in[k]] = 1;
+        }
+        std::vector<int32_t> renum(NI + NS, -1);
+        for (int v = 0; v < NI; ++v) renum[v] = v;
+        std::vector<FHE16_PlanStep> kept;
+        for (int i = 0; i < NS; ++i) {
+            if (!need[NI + i]) { ++r.dead; continue; }
+            FHE16_PlanStep s = out.steps[i];
+            for (int k = 0; k < s.n_in; ++k) s.in[k] = renum[s.in[k]];
+            renum[NI + i] = NI + (int32_t)kept.size();
+            kept.push_back(s);
+        }
+        out.steps.swap(kept);
+        for (int32_t& v : out.outputs) v = renum[v];
+    }
+};
+
+} // namespace
+
+void FHE16_plan_optimize(FHE16_Plan& p, FHE16_PlanOptReport* rep, int max_xor_fanin) {
+    FHE16_PlanOptReport total = {};
+    total.steps_before      = (int)p.steps.size();
+    total.bootstraps_before = FHE16_plan_bootstrap_estimate(p);
+
+    // 한 패스가 다음 패스의 기회를 만들 수 있으므로 고정점까지 (최대 4회)
+    FHE16_Plan cur = p;
+    for (int pass = 0; pass < 4; ++pass) {
+        Optimizer o(cur, max_xor_fanin);
+        o.forward();
+        o.dce();
+        const bool changed = o.r.folded || o.r.strength_reduced || o.r.fused || o.r.xor_fused || o.r.cse || o.r.dead;
+        total.folded           += o.r.folded;
+        total.strength_reduced += o.r.strength_reduced;
+        total.fused            += o.r.fused;
+        total.xor_fused        += o.r.xor_fused;
+        total.cse              += o.r.cse;
+        total.dead             += o.r.dead;
+        cur = std::move(o.out);
+        if (!changed) break;
+    }
+
+    if (FHE16_plan_bootstrap_estimate(cur) <= total.bootstraps_before) p = std::move(cur);
+    total.steps_after      = (int)p.steps.size();
+    total.bootstraps_after = FHE16_plan_bootstrap_estimate(p);
+    if (rep) *rep = total;
+}
@@ -0,0 +1,204 @@
+// native/fhe16_stats.cpp — 연산별 카운터 / 추적 (fhe16_stats.hpp 참고)
+
+#include "fhe16_stats.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+enum { F_CALLS, F_ERRORS, F_TOTAL, F_MAX, F_BOOT, F_COUNT };
+
+struct Counters {
+    std::atomic<int64_t> v[FHE16_STATS_MAX_SLOTS][F_COUNT];
+    Counters() {
+        for (auto& s : v)
+            for (auto& f : s) f.store(0, std::memory_order_relaxed);
+    }
+};
+
+struct Span {
+    std::atomic<bool> ready{false};
+    int               slot = 0;
+    uint32_t          tid  = 0;
+    int64_t           t0   = 0;
+    int64_t           dur  = 0;
+};
+
+static std::mutex            g_mu;                                // 등록 / 스레드 목록 / 누적값
+static std::string           g_names[FHE16_STATS_MAX_SLOTS];
+static std::atomic<int>      g_slots{0};
+static std::vector<Counters*> g_threads;                          // 살아 있는 스레드
+static int64_t               g_retired[FHE16_STATS_MAX_SLOTS][F_COUNT];   // 종료한 스레드 합
+static int64_t               g_base[FHE16_STATS_MAX_SLOTS][F_COUNT];      // 마지막 Reset 시점 (max 제외)
+static std::atomic<uint32_t> g_next_tid{1};
+
+static std::vector<Span>     g_trace;
+static std::atomic<bool>     g_trace_on{false};
+static std::atomic<size_t>   g_trace_next{0};
+static std::atomic<int>      g_trace_writers{0};                  // g_trace 에 쓰는 중인 스레드 수
+static int64_t               g_trace_t0 = 0;
+
+// 스레드 종료 시 값을 누적값으로 옮기고 목록에서 뺀다
+struct ThreadSlot {
+    Counters* c   = nullptr;
+    uint32_t  tid = 0;
+    ~ThreadSlot() {
+        if (!c) return;
+        std::lock_guard<std::mutex> lk(g_mu);
+        for (int s = 0; s < FHE16_STATS_MAX_SLOTS; ++s) {
+            for (int f = 0; f < F_COUNT; ++f) {
+                const int64_t x = c->v[s][f].load(std::memory_order_relaxed);
+                if (f == F_MAX) { if (x > g_retired[s][f]) g_retired[s][f] = x; }
+                else            g_retired[s][f] += x;
+            }
+        }
+        for (size_t i = 0; i < g_threads.size(); ++i)
+            if (g_threads[i] == c) { g_threads.erase(g_threads.begin() + i); break; }
+        delete c;
+    }
+};
+
+static thread_local ThreadSlot t_slot;
+
+static ThreadSlot& local() {
+    if (!t_slot.c) {
+        t_slot.c   = new Counters();
+        t_slot.tid = g_next_tid.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lk(g_mu);
+        g_threads.push_back(t_slot.c);
+    }
+    return t_slot;
+}
+
+int FHE16_stats_register(const char* name) {
+    std::lock_guard<std::mutex> lk(g_mu);
+    const int n = g_slots.load(std::memory_order_relaxed);
+    for (int i = 0; i < n; ++i)
+        if (g_names[i] == name) return i;
+    if (n >= FHE16_STATS_MAX_SLOTS) return -1;
+    g_names[n] = name;
+    g_slots.store(n + 1, std::memory_order_release);
+    return n;
+}
+
+int64_t FHE16_stats_now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void FHE16_stats_record(int slot, int64_t start_ns, int64_t dur_ns, int64_t bootstraps, bool ok) {
+    if (slot < 0 || slot >= FHE16_STATS_MAX_SLOTS) return;
+    ThreadSlot& ts = local();
+    std::atomic<int64_t>* v = ts.c->v[slot];
+    // 이 스레드만 쓰므로 load + store 로 충분 (읽는 쪽과는 atomic 으로 안전)
+    v[F_CALLS].store(v[F_CALLS].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (!ok) v[F_ERRORS].store(v[F_ERRORS].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    v[F_TOTAL].store(v[F_TOTAL].load(std::memory_order_relaxed) + dur_ns, std::memory_order_relaxed);
+    if (dur_ns > v[F_MAX].load(std::memory_order_relaxed)) v[F_MAX].store(dur_ns, std::memory_order_relaxed);
+    v[F_BOOT].store(v[F_BOOT].load(std::memory_order_relaxed) + bootstraps, std::memory_order_relaxed);
+
+    // 쓰는 동안 g_trace_writers 로 버퍼를 붙잡는다. Start / Stop 은 on 을 끈 뒤 0 이 될 때까지 기다리고
+    // 나서 버퍼를 바꾸므로, 카운터를 올린 뒤 on 을 다시 확인하면 해제된 버퍼에 쓰지 않는다 (둘 다 seq_cst)
+    if (g_trace_on.load(std::memory_order_relaxed)) {
+        g_trace_writers.fetch_add(1);
+        if (g_trace_on.load()) {
+            const size_t i = g_trace_next.fetch_add(1, std::memory_order_relaxed);
+            if (i < g_trace.size()) {
+                Span& sp = g_trace[i];
+                sp.slot = slot;
+                sp.tid  = ts.tid;
+                sp.t0   = start_ns;
+                sp.dur  = dur_ns;
+                sp.ready.store(true, std::memory_order_release);
+            }
+        }
+        g_trace_writers.fetch_sub(1);
+    }
+}
+
+// 살아 있는 스레드 + 종료한 스레드 합 (g_mu 보유 상태에서 호출)
+static void sum_locked(int64_t out[FHE16_STATS_MAX_SLOTS][F_COUNT]) {
+    std::memcpy(out, g_retired, sizeof(g_retired));
+    for (Counters* c : g_threads) {
+        for (int s = 0; s < FHE16_STATS_MAX_SLOTS; ++s) {
+            for (int f = 0; f < F_COUNT; ++f) {
+                const int64_t x = c->v[s][f].load(std::memory_order_relaxed);
+                if (f == F_MAX) { if (x > out[s][f]) out[s][f] = x; }
+                else            out[s][f] += x;
+            }
+        }
+    }
+}
+
+int FHE16_GetStats(FHE16_OpStats* out, int max) {
+    static int64_t sum[FHE16_STATS_MAX_SLOTS][F_COUNT];
+    std::lock_guard<std::mutex> lk(g_mu);
+    sum_locked(sum);
+    const int n = g_slots.load(std::memory_order_acquire);
+    int k = 0;
+    for (int s = 0; s < n && k < max; ++s) {
+        const int64_t calls = sum[s][F_CALLS] - g_base[s][F_CALLS];
+        if (calls <= 0) continue;
+        FHE16_OpStats& o = out[k++];
+        o.name       = g_names[s].c_str();
+        o.calls      = calls;
+        o.errors     = sum[s][F_ERRORS] - g_base[s][F_ERRORS];
+        o.total_ns   = sum[s][F_TOTAL] - g_base[s][F_TOTAL];
+        o.max_ns     = sum[s][F_MAX];           // 누적 최대 (Reset 으로 지우지 않음)
+        o.bootstraps = sum[s][F_BOOT] - g_base[s][F_BOOT];
+    }
+    return k;
+}
+
+void FHE16_ResetStats() {
+    std::lock_guard<std::mutex> lk(g_mu);
+    sum_locked(g_base);
+}
+
+// 추적을 끄고 기록 중인 스레드가 빠져나갈 때까지 대기 (이후 g_trace 를 바꿔도 안전)
+static void trace_quiesce() {
+    g_trace_on.store(false);
+    while (g_trace_writers.load() != 0) std::this_thread::yield();
+}
+
+void FHE16_TraceStart(size_t capacity) {
+    std::lock_guard<std::mutex> lk(g_mu);
+    trace_quiesce();
+    g_trace = std::vector<Span>(capacity);
+    g_trace_next.store(0);
+    g_trace_t0 = FHE16_stats_now_ns();
+    g_trace_on.store(true);
+}
+
+bool FHE16_TraceActive() {
+    return g_trace_on.load(std::memory_order_relaxed);
+}
+
+size_t FHE16_TraceStop(std::string& json) {
+    std::lock_guard<std::mutex> lk(g_mu);
+    trace_quiesce();
+    const size_t n = std::min(g_trace_next.load(), g_trace.size());
+    size_t written = 0;
+    char buf[256];
+    json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (size_t i = 0; i < n; ++i) {
+        const Span& sp = g_trace[i];
+        if (!sp.ready.load(std::memory_order_acquire)) continue;   // 기록 중이던 span
+        // ts / dur 단위는 마이크로초
+        std::snprintf(buf, sizeof(buf),
+                      "%s{\"name\":\"%s\",\"cat\":\"fhe16\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                      written ? "," : "", g_names[sp.slot].c_str(), sp.tid,
+                      (sp.t0 - g_trace_t0) / 1e3, sp.dur / 1e3);
+        json += buf;
+        ++written;
+    }
+    json += "]}";
+    g_trace.clear();
+    g_trace.shrink_to_fit();
+    return written;
+}
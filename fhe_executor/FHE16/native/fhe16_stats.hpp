@@ -0,0 +1,51 @@
+// native/fhe16_stats.hpp — 연산별 카운터 / 추적 (Chrome trace)
+//
+// libFHE16 내부(블라인드 회전, 키 스위칭, NTT)는 배포된 .so 안에 있어 직접 계측할 수 없으므로
+// 애드온이 호출하는 최상위 FHE16_* 함수 단위로 센다.
+//   - 호출 수 / 실패 수 / 누적·최대 시간 / 추정 부트스트랩 수 (fhe16_plan_step_bootstraps 게이트 수 모델)
+//   - 카운터는 스레드 로컬 (자기 스레드만 쓰는 relaxed atomic) → 기록에 락/경합 없음.
+//     종료하는 스레드의 값은 전역 누적값으로 옮긴다. 읽을 때만 전 스레드를 합산
+//   - 추적: FHE16_TraceStart 이후의 호출을 미리 잡아 둔 버퍼에 span 으로 기록 →
+//     FHE16_TraceStop 이 Chrome trace / Perfetto 가 읽는 JSON 으로 돌려준다
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#define FHE16_STATS_MAX_SLOTS 64
+
+struct FHE16_OpStats {
+    const char* name;           // 예: "FHE16_GE"
+    int64_t     calls;
+    int64_t     errors;
+    int64_t     total_ns;
+    int64_t     max_ns;
+    int64_t     bootstraps;     // 추정치 (32비트 게이트 수 모델)
+};
+
+// 이름별 slot (같은 이름이면 같은 slot). 가득 차면 -1
+int     FHE16_stats_register(const char* name);
+int64_t FHE16_stats_now_ns();
+void    FHE16_stats_record(int slot, int64_t start_ns, int64_t dur_ns, int64_t bootstraps, bool ok);
+
+// 호출이 한 번 이상 있었던 slot 을 out 에 채우고 개수 반환 (max 개까지). 마지막 Reset 이후 값
+int  FHE16_GetStats(FHE16_OpStats* out, int max);
+void FHE16_ResetStats();
+
+// 추적: capacity 개 span 까지 기록 (넘치면 버림)
+void   FHE16_TraceStart(size_t capacity);
+bool   FHE16_TraceActive();
+// 추적을 멈추고 Chrome trace JSON 을 json 에. 반환값 = 기록된 span 수 (버린 것 제외)
+size_t FHE16_TraceStop(std::string& json);
+
+// 범위 기록: 생성~소멸 시간을 slot 에 기록 (ok 는 소멸 전에 설정)
+struct FHE16_StatScope {
+    int     slot;
+    int64_t bootstraps;
+    int64_t t0;
+    bool    ok = false;
+    FHE16_StatScope(int s, int64_t bs) : slot(s), bootstraps(bs), t0(FHE16_stats_now_ns()) {}
+    ~FHE16_StatScope() { FHE16_stats_record(slot, t0, FHE16_stats_now_ns() - t0, bootstraps, ok); }
+};
@@ -0,0 +1,244 @@
+/* eslint-disable no-console */
+// FHE16/param-search.js — 파라미터 세트 탐색 (보안 추정 × 잡음 모델 × 비용 모델)
+//
+//   node FHE16/param-search.js [--base ginx16_128b] [--n-lwe 503,537,560,585,630] [--sigma-scale 1,1.5,2]
+//                              [--min-bits <base 추정치>] [--log2-pfail -40] [--fanin 1] [--top 10]
+//                              [--bench] [--samples 3] [--out params.json] [--json search.json]
+//
+// 기준 세트(--base)에서 n_lwe, 시그마(LWE / KS 같은 배율), KS 가젯(밑, 버리는 비트), BK a-가젯을 바꿔 보며
+//   1) 보안 : LWE(n_lwe, q_lwe, sigma_lwe), KS 키(n_lwe, q_ks, sigma_ks) 의 primal uSVP core-SVP 추정
+//            (0.292 beta, 이진 비밀키) 중 작은 쪽. 기본 한도는 기준 세트의 값 (기준보다 약해지지 않게).
+//            BK 키(RLWE kN, Q, sigma_bs) 는 탐색 대상이 아니라 참고로만 출력
+//   2) 잡음 : FHE16Async.noiseModel({ params }) 의 입력 --fanin 개 실패 확률 (native/fhe16_noise.hpp)
+//   3) 비용 : 블라인드 회전 n_lwe * (k+1) * (k len_a + len_b) 번 NTT 곱 + 키 스위칭 kN * len_ks * n_lwe, 기준 세트 대비
+// 을 계산해 보안 / 실패 확률 한도를 넘는 후보 중 비용이 가장 작은 것을 고른다.
+// --bench 면 상위 후보마다 자식 프로세스에서 selectParams → GenEval → ge 게이트 시간을 잰다.
+// --out 파일은 server.js 의 FHE16_PARAMS 로 그대로 쓸 수 있다 (키 팩은 그 세트로 다시 만들어야 함).
+//
+// 링 차수 N, k, CRT 모듈러스는 라이브러리 빌드에 고정이라 탐색하지 않는다 (native/fhe16_params.hpp).
+// BK b-가젯은 잡음 모델이 a-가젯만 보므로 기준 세트 값을 그대로 둔다.
+
+const fs = require('fs');
+const { spawnSync } = require('child_process');
+const { FHE16, FHE16Async } = require('./index.js');
+
+function parseArgs() {
+  const a = {
+    base: 'ginx16_128b', nLwe: [503, 537, 560, 585, 610, 630], sigmaScale: [1, 1.5, 2],
+    minBits: null, log2Pfail: -40, fanin: 1, top: 10, bench: false, samples: 3, out: null, json: null, benchOne: null
+  };
+  const argv = process.argv.slice(2);
+  for (let i = 0; i < argv.length; i += 2) {
+    const flag = argv[i];
+    if (flag === '--bench') { a.bench = true; i -= 1; continue; }
+    const val = argv[i + 1];
+    if (val === undefined) throw new Error(`${flag}: missing value`);
+    const num = () => {
+      const n = Number(val);
+      if (!Number.isFinite(n)) throw new Error(`${flag}: number expected, got '${val}'`);
+      return n;
+    };
+    const list = () => val.split(',').filter(Boolean).map(Number).filter((n) => n > 0);
+    switch (flag) {
+      case '--base': a.base = val; break;
+      case '--n-lwe': a.nLwe = list().map(Math.floor); break;
+      case '--sigma-scale': a.sigmaScale = list(); break;
+      case '--min-bits': a.minBits = num(); break;
+      case '--log2-pfail':
+        a.log2Pfail = num();
+        if (a.log2Pfail >= 0) throw new Error(`${flag}: negative number expected, got '${val}'`);
+        break;
+      case '--fanin': a.fanin = Math.min(7, Math.max(1, Math.floor(num()))); break;
+      case '--top': a.top = Math.max(1, Math.floor(num())); break;
+      case '--samples': a.samples = Math.max(1, Math.floor(num())); break;
+      case '--out': a.out = val; break;
+      case '--json': a.json = val; break;
+      case '--bench-one': a.benchOne = val; break;   // 내부용 (자식 프로세스)
+      default: throw new Error(`unknown flag '${flag}'`);
+    }
+  }
+  return a;
+}
+
+// ===== 보안 추정: primal uSVP (2016 추정식), core-SVP = 0.292 beta =====
+// 차원 d = m + n + 1 격자에서 sigma sqrt(beta) <= delta^(2 beta - d) * (q^m * (sigma / sigma_s)^n)^(1/d) 인 최소 beta.
+// 비밀키가 이진이면 sigma_s = 1/2 (스케일링으로 오차와 균형).
+function rootHermite(beta) {
+  return Math.pow(Math.pow(Math.PI * beta, 1 / beta) * beta / (2 * Math.PI * Math.E), 1 / (2 * (beta - 1)));
+}
+
+function usvpBeta(n, log2q, sigma) {
+  if (!(sigma > 0)) return 0;                     // 오차가 없으면 보안도 없다 (ginx16_test)
+  const lnSigma = Math.log(sigma);
+  const lnNu = Math.log(sigma / 0.5);
+  const step = Math.max(1, Math.floor(n / 64));
+  for (let beta = 40; beta < 2000; beta++) {
+    const lnDelta = Math.log(rootHermite(beta));
+    const lhs = lnSigma + 0.5 * Math.log(beta);
+    for (let m = Math.max(1, beta - n); m <= 4 * n; m += step) {
+      const d = m + n + 1;
+      if (lhs <= (2 * beta - d) * lnDelta + (m * log2q * Math.LN2 + n * lnNu) / d) return beta;
+    }
+  }
+  return 2000;
+}
+
+const usvpCache = new Map();
+function coreSvpBits(n, log2q, sigma) {
+  const key = `${n}/${log2q}/${sigma}`;
+  if (!usvpCache.has(key)) usvpCache.set(key, +(0.292 * usvpBeta(n, log2q, sigma)).toFixed(1));
+  return usvpCache.get(key);
+}
+
+function security(p) {
+  const lwe = coreSvpBits(p.n_lwe, Math.log2(p.q_lwe), p.sigma_lwe);
+  const ks = coreSvpBits(p.n_lwe, Math.log2(p.q_ks), p.sigma_ks);
+  const bk = coreSvpBits(p.k_bk * p.n_bk, Math.log2(p.q_tot), p.sigma_bs);
+  return { bits: Math.min(lwe, ks), lwe, ks, bk };
+}
+
+// ===== 비용 모델 (상대값) =====
+const gadgetLen = (bits, base, rm) => Math.ceil((bits - rm) / base);
+
+function cost(p) {
+  const lenA = gadgetLen(p.q_bk_bit16, p.base_bk_a, p.base_rm_bk_a);
+  const lenB = gadgetLen(p.q_bk_bit16, p.base_bk_b, p.base_rm_bk_b);
+  const lenKs = gadgetLen(p.q_ks_bit, p.base_ks, p.base_rm_ks);
+  const N = p.n_bk;
+  const br = p.n_lwe * (p.k_bk + 1) * (p.k_bk * lenA + lenB) * N * (Math.log2(N) + 1);
+  const ks = p.k_bk * N * lenKs * p.n_lwe;
+  return br + ks;
+}
+
+// ===== 후보 =====
+function* candidates(base, args) {
+  for (const n of args.nLwe) {
+    for (const s of args.sigmaScale) {
+      for (let bKs = 2; bKs <= 7; bKs++) {
+        for (let rmKs = 0; rmKs <= 3; rmKs++) {
+          for (let bA = 5; bA <= 10; bA++) {
+            for (let rmA = 1; rmA <= 11; rmA += 2) {
+              yield {
+                base: args.base,
+                n_lwe: n,
+                sigma_lwe: +(base.sigma_lwe * s).toFixed(4),
+                sigma_ks: +(base.sigma_ks * s).toFixed(4),
+                base_ks: bKs,
+                base_rm_ks: rmKs,
+                base_bk_a: bA,
+                base_rm_bk_a: rmA
+              };
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+function candidateName(c) {
+  return `n${c.n_lwe}-s${c.sigma_lwe}-ks${c.base_ks}.${c.base_rm_ks}-bka${c.base_bk_a}.${c.base_rm_bk_a}`;
+}
+
+// 자식 프로세스: 후보 하나로 키를 만들고 ge 게이트 시간 (ms 중앙값) 을 stdout 에 JSON 한 줄로
+async function benchOne(params, samples) {
+  FHE16Async.selectParams(params);
+  if (!FHE16.FHE16_GenEval()) throw new Error('GenEval returned null');
+  const [x, y] = await Promise.all([FHE16Async.encInt(7, 16), FHE16Async.encInt(-3, 16)]);
+  await FHE16Async.ge(x, y); // 워밍업
+  const ms = [];
+  for (let s = 0; s < samples; s++) {
+    const t0 = process.hrtime.bigint();
+    await FHE16Async.ge(x, y);
+    ms.push(Number(process.hrtime.bigint() - t0) / 1e6);
+  }
+  ms.sort((a, b) => a - b);
+  process.stdout.write(JSON.stringify({ geMs: +ms[ms.length >> 1].toFixed(3) }) + '\n');
+}
+
+function runBench(params, samples) {
+  const r = spawnSync(process.execPath, [__filename, '--bench-one', JSON.stringify(params), '--samples', String(samples)], {
+    encoding: 'utf8'
+  });
+  const line = (r.stdout || '').trim().split('\n').pop();
+  try {
+    return JSON.parse(line).geMs;
+  } catch (_) {
+    console.warn('[param-search] bench failed:', (r.stderr || '').trim().split('\n').pop());
+    return null;
+  }
+}
+
+(async () => {
+  const args = parseArgs();
+  if (args.benchOne) {
+    await benchOne(JSON.parse(args.benchOne), args.samples);
+    process.exit(0);
+  }
+  if (!FHE16Async.native) throw new Error('N-API addon not loaded (noise model and parameter sets are addon-only)');
+
+  const baseSet = FHE16Async.paramSets().find((s) => s.name === args.base);
+  if (!baseSet) throw new Error(`unknown base set '${args.base}'`);
+  const baseSec = security(baseSet);
+  const baseCost = cost(baseSet);
+  const minBits = args.minBits !== null ? args.minBits : baseSec.bits;
+  console.log(`[param-search] base ${baseSet.name}: core-SVP lwe ${baseSec.lwe}, ks ${baseSec.ks} bits (bk ${baseSec.bk}, fixed)`);
+  console.log(`[param-search] constraints: >= ${minBits} bits, log2 pfail(fanin ${args.fanin}) <= ${args.log2Pfail}`);
+
+  const rows = [];
+  let tried = 0;
+  for (const c of candidates(baseSet, args)) {
+    tried++;
+    const full = { ...baseSet, ...c };
+    const sec = security(full);
+    if (sec.bits < minBits) continue;
+    let nm;
+    try {
+      nm = FHE16Async.noiseModel({ params: c, log2Pfail: args.log2Pfail });
+    } catch (_) {
+      continue; // 가젯이 비트를 못 덮는 등 FHE16_params_normalize 가 거절, 또는 입력 2 개부터 한도 초과 (RangeError)
+    }
+    const pfail = nm.log2Pfail[args.fanin - 1];
+    if (!(pfail <= args.log2Pfail)) continue;
+    rows.push({
+      name: candidateName(c),
+      params: c,
+      bits: sec.bits,
+      security: sec,
+      log2Pfail: +pfail.toFixed(1),
+      maxXorFanin: nm.maxXorFanin,
+      cost: +(cost(full) / baseCost).toFixed(4)
+    });
+  }
+  rows.sort((x, y) => x.cost - y.cost || x.log2Pfail - y.log2Pfail);
+  console.log(`[param-search] ${tried} candidates, ${rows.length} pass`);
+  if (!rows.length) throw new Error('no candidate meets the constraints');
+
+  const top = rows.slice(0, args.top);
+  for (const r of top) {
+    if (args.bench) r.geMs = runBench(r.params, args.samples);
+    console.log(`[param-search] ${r.name.padEnd(36)} bits ${String(r.bits).padStart(6)}  log2 pfail ${String(r.log2Pfail).padStart(7)}` +
+      `  cost ${r.cost.toFixed(3)}` + (r.geMs != null ? `  ge ${r.geMs.toFixed(1)} ms` : ''));
+  }
+  // 측정했다면 측정값, 아니면 모델 비용 기준
+  const measured = top.filter((r) => r.geMs != null);
+  const best = measured.length ? measured.reduce((x, y) => (y.geMs < x.geMs ? y : x)) : top[0];
+  console.log(`[param-search] best: ${best.name} (cost ${best.cost} x ${baseSet.name})`);
+
+  if (args.out) {
+    fs.writeFileSync(args.out, JSON.stringify({
+      version: 1,
+      params: { name: best.name, ...best.params },
+      estimate: { bits: best.bits, security: best.security, log2Pfail: best.log2Pfail, fanin: args.fanin, cost: best.cost, geMs: best.geMs }
+    }, null, 2) + '\n');
+    console.log('[param-search] wrote', args.out, '(use FHE16_PARAMS=<file>; regenerate the key pack for it)');
+  }
+  if (args.json) {
+    fs.writeFileSync(args.json, JSON.stringify({ version: 1, base: baseSet.name, minBits, log2Pfail: args.log2Pfail, fanin: args.fanin, tried, results: rows }, null, 2) + '\n');
+    console.log('[param-search] wrote', args.json);
+  }
+  process.exit(0);
+})().catch((e) => {
+  console.error('[param-search] failed:', e.message || e);
+  process.exit(1);
+});
@@ -0,0 +1,164 @@
+// FHE16/plan.js — execution_plan → 직렬화 계획 (native/fhe16_plan.hpp 포맷)
+//
+// 값은 SSA 번호: 0..nInputs-1 = 입력, nInputs + i = i 번째 단계 결과.
+// server.js 의 이름 기반 계획 ({ op, inputs: [0, 'temp_a'], output: 'temp_b' }) 을 그대로 받는다.
+
+const PLAN_MAGIC = 0x314C5046; // 'FPL1'
+const STEP_WORDS = 6;
+const CT_META = 16;
+const LWE_WORDS = 1040;
+
+// 순서 = FHE16_PlanOp 값 (1부터). 네이티브 enum 과 반드시 같게 유지
+const OPS = [
+  ['add', 2, 'add'],
+  ['sub', 2, 'sub'],
+  ['add3', 3, 'add3'],
+  ['ge', 2, 'ge'],
+  ['gt', 2, 'gt'],
+  ['le', 2, 'le'],
+  ['lt', 2, 'lt'],
+  ['eq', 2, 'eq'],
+  ['neq', 2, 'neq'],
+  ['max', 2, 'max'],
+  ['min', 2, 'min'],
+  ['and', 2, 'andVec'],
+  ['or', 2, 'orVec'],
+  ['xor', 2, 'xorVec'],
+  ['select', 3, 'select'],
+  ['smull', 2, 'smull'],
+  ['smull_constant', 1, 'smullConst_i32'],
+  ['add_constant', 1, 'addConst_i32'],
+  ['neg', 1, 'neg'],
+  ['abs', 1, 'abs'],
+  ['relu', 1, 'relu'],
+  ['add_pow2', 1, 'addPow2'],
+  ['sub_pow2', 1, 'subPow2'],
+  ['shl_constant', 1, null], // 비트 블록 이동만 — shlConst 로 JS 에서 처리
+  ['xor3', 3, 'xor3Vec'],     // a ^ b ^ c (optimizePlan 의 XOR 융합이 만든다)
+];
+const OP_CODE = Object.fromEntries(OPS.map(([name], i) => [name, i + 1]));
+
+// 단계 하나의 즉시값 (상수 / 지수)
+function immOf(step) {
+  const v = step.constant !== undefined ? step.constant : (step.pow !== undefined ? step.pow : 0);
+  if (!Number.isInteger(v) || v < -0x80000000 || v > 0x7fffffff) {
+    throw new Error(`plan: constant for '${step.op}' must be an int32, got ${v}`);
+  }
+  return v;
+}
+
+/**
+ * 이름 기반 execution_plan → { words: Int32Array, steps, nInputs, outputs }
+ * @param {Array<{op:string, inputs:(number|string)[], output:string|number, constant?:number}>} executionPlan
+ * @param {number} nInputs
+ * @param {(string|number)[]} [outputs=['result']]
+ */
+function encodePlan(executionPlan, nInputs, outputs = ['result']) {
+  const env = new Map();
+  for (let i = 0; i < nInputs; i++) env.set(i, i);
+
+  const resolve = (name, where) => {
+    if (!env.has(name)) throw new Error(`plan: ${where} reads undefined value '${name}'`);
+    return env.get(name);
+  };
+
+  const steps = executionPlan.map((step, i) => {
+    const code = OP_CODE[step.op];
+    if (!code) throw new Error(`plan: unsupported op '${step.op}' at step ${i}`);
+    const arity = OPS[code - 1][1];
+    if (!Array.isArray(step.inputs) || step.inputs.length !== arity) {
+      throw new Error(`plan: '${step.op}' at step ${i} needs ${arity} inputs`);
+    }
+    const ins = step.inputs.map((n) => resolve(n, `step ${i}`));
+    env.set(step.output, nInputs + i);
+    return { op: code, ins, imm: immOf(step) };
+  });
+
+  const outIds = outputs.map((n) => resolve(n, 'output'));
+
+  const words = new Int32Array(4 + steps.length * STEP_WORDS + outIds.length);
+  words[0] = PLAN_MAGIC;
+  words[1] = nInputs;
+  words[2] = steps.length;
+  words[3] = outIds.length;
+  let k = 4;
+  for (const s of steps) {
+    words[k++] = s.op;
+    words[k++] = s.ins.length;
+    for (let j = 0; j < 3; j++) words[k++] = j < s.ins.length ? s.ins[j] : -1;
+    words[k++] = s.imm;
+  }
+  words.set(outIds, k);
+
+  return { words, steps, nInputs, outputs: outIds };
+}
+
+/**
+ * 직렬화된 계획 → { words, steps, nInputs, outputs } (optimizePlan 결과를 runPlanJS 에서도 쓰기 위해)
+ * @param {Int32Array} words
+ */
+function decodePlan(words) {
+  if (words[0] !== PLAN_MAGIC) throw new Error('plan: bad magic');
+  const nInputs = words[1], nSteps = words[2], nOut = words[3];
+  const steps = [];
+  let k = 4;
+  for (let i = 0; i < nSteps; i++, k += STEP_WORDS) {
+    steps.push({ op: words[k], ins: Array.from(words.subarray(k + 2, k + 2 + words[k + 1])), imm: words[k + 5] });
+  }
+  return { words, steps, nInputs, outputs: Array.from(words.subarray(k, k + nOut)) };
+}
+
+// SHL_CONST: LSB 쪽 k 개 비트 블록을 자명한 0 으로 채우고 나머지를 위로 민다 (부트스트랩 없음)
+function shlConst(ct, k) {
+  const src = new Int32Array(ct.buffer, ct.byteOffset, ct.length >> 2);
+  const out = Buffer.alloc(ct.length);
+  const dst = new Int32Array(out.buffer, out.byteOffset, src.length);
+  const bits = Math.floor((src.length - CT_META) / LWE_WORDS);
+  const s = Math.max(0, Math.min(k, bits));
+  dst.set(src.subarray(0, CT_META));
+  dst.set(src.subarray(CT_META, CT_META + (bits - s) * LWE_WORDS), CT_META + s * LWE_WORDS);
+  return out;
+}
+
+/**
+ * 애드온이 없을 때의 JS 인터프리터 (FHE16Async 단계 호출).
+ * 출력에 도달하지 않는 단계는 건너뛰고, 마지막 사용이 끝난 중간값은 참조를 놓는다.
+ */
+async function runPlanJS(api, plan, inputs) {
+  const { steps, nInputs, outputs } = plan;
+  const t0 = Date.now();
+
+  const need = new Uint8Array(nInputs + steps.length);
+  for (const v of outputs) need[v] = 1;
+  for (let i = steps.length - 1; i >= 0; i--) {
+    if (need[nInputs + i]) for (const v of steps[i].ins) need[v] = 1;
+  }
+  const uses = new Int32Array(nInputs + steps.length);
+  steps.forEach((s, i) => { if (need[nInputs + i]) for (const v of s.ins) uses[v]++; });
+  for (const v of outputs) uses[v]++;
+
+  const val = new Array(nInputs + steps.length);
+  for (let i = 0; i < nInputs; i++) val[i] = inputs[i];
+
+  let live = 0, maxLive = 0, run = 0;
+  for (let i = 0; i < steps.length; i++) {
+    if (!need[nInputs + i]) continue;
+    const s = steps[i];
+    const [name, arity, method] = OPS[s.op - 1];
+    const args = s.ins.map((v) => val[v]);
+    if (arity === 1 && (name.endsWith('_constant') || name.endsWith('_pow2'))) args.push(s.imm);
+    val[nInputs + i] = method ? await api[method](...args) : shlConst(...args);
+    run++;
+    if (++live > maxLive) maxLive = live;
+    for (const v of s.ins) {
+      if (--uses[v] === 0 && v >= nInputs) { val[v] = undefined; live--; }
+    }
+  }
+
+  return {
+    outputs: outputs.map((v) => val[v]),
+    stats: { steps: run, maxLive, elapsedUs: (Date.now() - t0) * 1000 },
+  };
+}
+
+module.exports = { encodePlan, decodePlan, runPlanJS, OP_CODE, PLAN_MAGIC };
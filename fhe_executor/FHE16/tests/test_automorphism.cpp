@@ -0,0 +1,157 @@
+// tests/test_automorphism.cpp — automorphism.h 의 복사 없는 / NTT 영역 자기동형을 스칼라 정의와 비교
+//
+// 기준: X^i → X^(i*idx mod 2N), 2N 이상이면 부호 반전 (Q - v, 기존 Automorphism_Coeff_*bit 와 같은 규칙).
+// NTT 영역은 음순환 NTT 의 정의 (â_k = a(ψ^(2k+1)), ψ 는 원시 2N 제곱근) 를 직접 계산해
+// NTT(aut(a)) == Automorphism_NTT_16bit(NTT(a)) 인지 본다. 빌드 설정(AVXTYPE)의 SIMD 경로를 탄다.
+// 이 함수들은 헤더 전용으로 libFHE16 / 애드온에서는 아직 부르지 않는다.
+
+#include "automorphism.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static int g_fail = 0;
+#define CHECK(c) do { if (!(c)) { std::fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #c); ++g_fail; } } while (0)
+
+static int64_t pow_mod(int64_t b, int64_t e, int64_t q) {
+    int64_t r = 1;
+    for (b %= q; e; e >>= 1, b = b * b % q) if (e & 1) r = r * b % q;
+    return r;
+}
+
+// 원시 2N 제곱근 ψ (ψ^N = -1)
+static int64_t root_2n(int N, int64_t q) {
+    for (int64_t g = 2; g < q; ++g) {
+        const int64_t psi = pow_mod(g, (q - 1) / (2 * N), q);
+        if (pow_mod(psi, N, q) == q - 1) return psi;
+    }
+    return 0;
+}
+
+// 음순환 NTT 의 정의 그대로 (O(N^2))
+static std::vector<int16_t> ntt_ref(const int16_t* a, int N, int64_t q, int64_t psi) {
+    std::vector<int16_t> out(N);
+    for (int k = 0; k < N; ++k) {
+        const int64_t w = pow_mod(psi, 2 * k + 1, q);
+        int64_t acc = 0, wi = 1;
+        for (int i = 0; i < N; ++i, wi = wi * w % q) acc = (acc + (int64_t)a[i] * wi) % q;
+        out[k] = (int16_t)acc;
+    }
+    return out;
+}
+
+template <typename T>
+static std::vector<T> aut_ref(const std::vector<T>& x, const std::vector<T>& Q, int idx, int N) {
+    std::vector<T> y(x.size());
+    for (size_t jj = 0; jj < Q.size(); ++jj)
+        for (int i = 0; i < N; ++i) {
+            const int64_t to = (int64_t)i * idx % (2 * N);
+            const T v = x[jj * N + i];
+            y[jj * N + (to % N)] = to >= N ? (T)(Q[jj] - v) : v;
+        }
+    return y;
+}
+
+template <typename T, typename Fn, typename FnTo>
+static void check_coeff(const std::vector<T>& Q, int N, std::mt19937_64& rng, Fn old_fn, FnTo to_fn) {
+    const int q_num = (int)Q.size();
+    std::vector<T> x((size_t)N * q_num);
+    for (int jj = 0; jj < q_num; ++jj)
+        for (int i = 0; i < N; ++i) x[(size_t)jj * N + i] = (T)(rng() % (uint64_t)Q[jj]);
+    x[0] = 0;                       // 0 의 부정은 Q (기존 함수와 같게)
+    for (int idx : { 1, 3, 5, 2 * N - 1, N + 1, (int)(rng() % N) * 2 + 1 }) {
+        const std::vector<T> want = aut_ref(x, Q, idx, N);
+        std::vector<T> y(x.size(), (T)-7);
+        to_fn(x.data(), y.data(), Q.data(), idx, N, q_num);
+        CHECK(y == want);
+        std::vector<T> z = x, tmps(x.size());
+        old_fn(z.data(), tmps.data(), const_cast<T*>(Q.data()), idx, N, q_num);
+        CHECK(z == want);
+    }
+}
+
+int main() {
+    std::mt19937_64 rng(45);
+
+    // 계수 영역: 기존 함수 / 정의와 같은지 (16 / 32 비트, 모듈러스 여러 개)
+    for (int N : { 8, 256, 1024 }) {
+        check_coeff<int16_t>({ 12289, 7681, 3329 }, N, rng, Automorphism_Coeff_16bit, Automorphism_Coeff_16bit_To);
+        check_coeff<int32_t>({ 163603457, 12289 }, N, rng, Automorphism_Coeff_32bit, Automorphism_Coeff_32bit_To);
+    }
+
+    // NTT 영역: 순열이 정의에서 구한 NTT(aut(a)) 를 재현하는지
+    struct Ring { int N; std::vector<int16_t> Q; };
+    const Ring rings[] = { { 512, { 12289 } }, { 1024, { 12289 } }, { 256, { 12289, 7681 } } };
+    for (const Ring& r : rings) {
+        const int N = r.N, q_num = (int)r.Q.size();
+        std::vector<int64_t> psi(q_num);
+        for (int jj = 0; jj < q_num; ++jj) { psi[jj] = root_2n(N, r.Q[jj]); CHECK(psi[jj] != 0); }
+
+        std::vector<int16_t> a((size_t)N * q_num), a_hat((size_t)N * q_num);
+        for (int jj = 0; jj < q_num; ++jj) {
+            for (int i = 0; i < N; ++i) a[(size_t)jj * N + i] = (int16_t)(rng() % (uint64_t)r.Q[jj]);
+            const std::vector<int16_t> h = ntt_ref(a.data() + (size_t)jj * N, N, r.Q[jj], psi[jj]);
+            std::copy(h.begin(), h.end(), a_hat.begin() + (size_t)jj * N);
+        }
+
+        for (int idx : { 1, 3, 5, 2 * N - 1, (int)(rng() % N) * 2 + 1 }) {
+            std::vector<int16_t> perm((size_t)N * q_num), want((size_t)N * q_num);
+            const std::vector<int16_t> aut = aut_ref(a, r.Q, idx, N);
+            for (int jj = 0; jj < q_num; ++jj) {
+                const int16_t Q = r.Q[jj];
+                std::vector<int16_t> mono(N), scratch(Q);
+                Automorphism_Monomial_16bit(mono.data(), 1, N, Q);
+                const std::vector<int16_t> x1 = ntt_ref(mono.data(), N, Q, psi[jj]);
+                Automorphism_Monomial_16bit(mono.data(), idx, N, Q);
+                const std::vector<int16_t> xi = ntt_ref(mono.data(), N, Q, psi[jj]);
+                CHECK(Automorphism_NTT_Perm_16bit(x1.data(), xi.data(), perm.data() + (size_t)jj * N,
+                                                  scratch.data(), N, Q) == 0);
+                for (int k = 0; k < N; ++k) perm[(size_t)jj * N + k] += (int16_t)(jj * N);
+
+                // 정의에서: 0 은 aut_ref 가 Q 로 두지만 NTT 값에서는 같은 원소
+                std::vector<int16_t> aut_j(aut.begin() + (size_t)jj * N, aut.begin() + (size_t)(jj + 1) * N);
+                for (int16_t& v : aut_j) if (v == Q) v = 0;
+                const std::vector<int16_t> h = ntt_ref(aut_j.data(), N, Q, psi[jj]);
+                std::copy(h.begin(), h.end(), want.begin() + (size_t)jj * N);
+            }
+            std::vector<int16_t> got((size_t)N * q_num);
+            Automorphism_NTT_16bit(a_hat.data(), got.data(), perm.data(), N * q_num);
+            CHECK(got == want);
+        }
+    }
+
+    // 순열이 아니면 -1 (중복 값, 범위 밖 값, 없는 값)
+    {
+        const int N = 8;
+        const int16_t Q = 17;
+        std::vector<int16_t> perm(N), scratch(Q);
+        std::vector<int16_t> x = { 1, 2, 3, 4, 5, 6, 7, 8 }, y = { 8, 7, 6, 5, 4, 3, 2, 1 };
+        CHECK(Automorphism_NTT_Perm_16bit(x.data(), y.data(), perm.data(), scratch.data(), N, Q) == 0);
+        CHECK(perm[0] == 7 && perm[7] == 0);
+        std::vector<int16_t> dup = x; dup[3] = 1;
+        CHECK(Automorphism_NTT_Perm_16bit(dup.data(), y.data(), perm.data(), scratch.data(), N, Q) == -1);
+        std::vector<int16_t> big = x; big[2] = Q;
+        CHECK(Automorphism_NTT_Perm_16bit(big.data(), y.data(), perm.data(), scratch.data(), N, Q) == -1);
+        std::vector<int16_t> miss = y; miss[0] = 9;
+        CHECK(Automorphism_NTT_Perm_16bit(x.data(), miss.data(), perm.data(), scratch.data(), N, Q) == -1);
+        std::vector<int16_t> twice = y; twice[1] = 8;
+        CHECK(Automorphism_NTT_Perm_16bit(x.data(), twice.data(), perm.data(), scratch.data(), N, Q) == -1);
+    }
+
+    // 임의 순열 / SIMD 묶음 크기의 배수가 아닌 길이 (마지막 원소를 읽는 묶음은 스칼라)
+    for (int len : { 1, 7, 8, 15, 16, 17, 37, 64, 100 }) {
+        std::vector<int16_t> x(len), perm(len), y(len);
+        for (int i = 0; i < len; ++i) { x[i] = (int16_t)(rng() % 30000) - 15000; perm[i] = (int16_t)i; }
+        std::shuffle(perm.begin(), perm.end(), rng);
+        Automorphism_NTT_16bit(x.data(), y.data(), perm.data(), len);
+        bool ok = true;
+        for (int i = 0; i < len; ++i) ok &= y[i] == x[perm[i]];
+        CHECK(ok);
+    }
+
+    if (g_fail) { std::fprintf(stderr, "test_automorphism: %d failure(s)\n", g_fail); return 1; }
+    std::printf("test_automorphism: ok\n");
+    return 0;
+}
@@ -0,0 +1,97 @@
+// tests/test_ct_words.cpp — 암호문 길이 규칙 (FHE16_ct_meta_ok / FHE16_ct_words) 과 그 사용처
+//
+// 메타 [0] = 비트 수 (1..64), [1] = 비트당 워드 수 (1040, FHE16_ENCInt 가 기록). 전체 = 16 + 비트 수 * 1040.
+//  - 정상 / 비정상 메타 (0·음수·65 비트, 옛 규칙의 [1] = 비트 수 * 1040, 1039) 판정과 기본 길이
+//  - FHE16_plan_run 이 입력 / 중복 출력을 복사할 때 전체 길이를 복사하는지 (8 / 32 / 33 / 64 비트)
+//  - SHL_CONST 내장 구현이 메타의 비트 수대로 블록을 옮기는지
+
+#include "fhe16_plan.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static int g_fail = 0;
+#define CHECK(c) do { if (!(c)) { std::fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #c); ++g_fail; } } while (0)
+
+// 비트 i 블록의 모든 워드 = (i + 1) * 1000 + 워드 위치 % 1000 (어느 블록이 어디로 갔는지 알 수 있게)
+static int32_t* ct_make(int bits) {
+    const size_t words = FHE16_CT_META + (size_t)bits * FHE16_LWE_WORDS;
+    int32_t* ct = (int32_t*)std::malloc(words * sizeof(int32_t));
+    std::memset(ct, 0, FHE16_CT_META * sizeof(int32_t));
+    ct[0] = bits;
+    ct[1] = FHE16_LWE_WORDS;
+    for (int i = 0; i < bits; ++i)
+        for (int w = 0; w < FHE16_LWE_WORDS; ++w) ct[FHE16_CT_META + (size_t)i * FHE16_LWE_WORDS + w] = (i + 1) * 1000 + w % 1000;
+    return ct;
+}
+
+static int32_t* no_apply(const FHE16_PlanStep&, int32_t* const*, std::string& err) { err = "unexpected"; return nullptr; }
+static void     plain_free(int32_t* ct) { std::free(ct); }
+
+int main() {
+    // ===== 메타 판정 =====
+    for (int bits : { 1, 8, 32, 33, 64 }) {
+        const int32_t meta[2] = { bits, FHE16_LWE_WORDS };
+        CHECK(FHE16_ct_meta_ok(meta));
+        CHECK(FHE16_ct_words(meta) == FHE16_CT_META + (size_t)bits * FHE16_LWE_WORDS);
+    }
+    const int32_t bad[][2] = { { 0, FHE16_LWE_WORDS }, { -1, FHE16_LWE_WORDS }, { 65, FHE16_LWE_WORDS },
+                               { 32, 32 * FHE16_LWE_WORDS }, { 1, FHE16_LWE_WORDS - 1 }, { 32, 0 }, { 1 << 30, FHE16_LWE_WORDS } };
+    for (const auto& m : bad) {
+        CHECK(!FHE16_ct_meta_ok(m));
+        CHECK(FHE16_ct_words(m) == FHE16_CT_WORDS);
+    }
+    CHECK(FHE16_CT_WORDS == FHE16_CT_META + 32 * FHE16_LWE_WORDS);
+
+    // ===== plan_run 의 복사 (입력을 그대로 / 두 번 내보내기) =====
+    for (int bits : { 8, 32, 33, 64 }) {
+        int32_t* in[2] = { ct_make(bits), ct_make(1) };
+        FHE16_Plan p;
+        p.n_inputs = 2;
+        p.outputs = { 0, 1, 0 };
+        std::vector<int32_t*> out;
+        std::string err;
+        CHECK(FHE16_plan_run(p, in, 1, no_apply, plain_free, out, nullptr, err));
+        CHECK(out.size() == 3);
+        for (size_t k = 0; k < out.size(); ++k) {
+            const int32_t* src = in[p.outputs[k]];
+            CHECK(out[k] != src);
+            CHECK(std::memcmp(out[k], src, FHE16_ct_words(src) * sizeof(int32_t)) == 0);
+            plain_free(out[k]);
+        }
+        plain_free(in[0]);
+        plain_free(in[1]);
+    }
+
+    // ===== SHL_CONST =====
+    for (int bits : { 8, 33, 64 }) {
+        int32_t* src = ct_make(bits);
+        for (int k : { 0, 1, 5, bits - 1, bits, bits + 3, -2 }) {
+            FHE16_PlanStep s = {};
+            s.op = FHE16_OP_SHL_CONST;
+            s.n_in = 1;
+            s.imm = k;
+            int32_t* dst = nullptr;
+            int32_t* const ins[1] = { src };
+            CHECK(FHE16_plan_apply_builtin(s, ins, &dst) && dst);
+            if (!dst) continue;
+            const int kk = k < 0 ? 0 : (k > bits ? bits : k);
+            bool ok = std::memcmp(dst, src, FHE16_CT_META * sizeof(int32_t)) == 0;
+            for (int i = 0; i < bits; ++i) {
+                const int32_t* blk = dst + FHE16_CT_META + (size_t)i * FHE16_LWE_WORDS;
+                for (int w = 0; w < FHE16_LWE_WORDS; ++w) ok &= blk[w] == (i < kk ? 0 : (i - kk + 1) * 1000 + w % 1000);
+            }
+            CHECK(ok);
+            if (!ok) std::fprintf(stderr, "  bits %d k %d\n", bits, k);
+            std::free(dst);
+        }
+        std::free(src);
+    }
+
+    if (g_fail) { std::fprintf(stderr, "test_ct_words: %d failure(s)\n", g_fail); return 1; }
+    std::printf("test_ct_words: ok\n");
+    return 0;
+}
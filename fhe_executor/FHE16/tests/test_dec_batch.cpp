@@ -0,0 +1,132 @@
+// tests/test_dec_batch.cpp — FHE16_DECInt_BATCH_P 를 FHE16_DECInt 의 스칼라 정의와 비교
+//
+// 기준 함수 dec_ref 는 libFHE16 의 FHE16_DECInt 를 그대로 옮긴 것 (int32 넘침, C 나눗셈 포함).
+// 정상 암호문 외에 범위를 벗어난 마스크 / 키, 0·음수 비트 수, null 암호문도 비교한다.
+
+#include "BinOperationCstyle.hpp"
+#include "soAPI.hpp"
+#include "Core.hpp"
+#include "fhe16_dec_batch.hpp"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// 라이브러리 없이 링크 (FHE16_dec_params_live 는 null 이면 false)
+EFHEs::EFHE_BIN_Param_List* G_FHE16_PARAM = nullptr;
+
+static int g_fail = 0;
+#define CHECK(c) do { if (!(c)) { std::fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #c); ++g_fail; } } while (0)
+
+static int64_t dec_ref(const int32_t* ct, const int32_t* sk, int32_t q, int width) {
+    const int bits = ct[0];
+    const int64_t stride = ct[1];
+    uint32_t res = 0;
+    for (int i = 0; i < bits; ++i) {
+        const int32_t* lwe = ct + 16 + i * stride;
+        int32_t acc = lwe[width - 1];
+        for (int j = 0; j < width - 1; ++j) {
+            const int32_t t = (int32_t)((uint32_t)lwe[j] * (uint32_t)sk[j] + (uint32_t)((sk[j] >> 31) & q));
+            acc = (int32_t)((uint32_t)acc - (uint32_t)t);
+            acc = (int32_t)((uint32_t)acc + (uint32_t)((acc >> 31) & q));
+        }
+        const int32_t v = (int32_t)((uint32_t)acc + (uint32_t)(q >> 3));
+        res += (uint32_t)((uint64_t)(uint32_t)((v % q) / (q >> 2)) << (i & 63));
+    }
+    return (int32_t)res;
+}
+
+// 값 m 을 비트별 LWE 로: b = <a, s> + bit * q/4 + e  (|e| < q/8)
+static std::vector<int32_t> encrypt(int32_t m, int bits, const std::vector<int32_t>& sk,
+                                    int32_t q, int width, int stride, std::mt19937_64& rng) {
+    std::vector<int32_t> ct(16 + (size_t)bits * stride, 0);
+    ct[0] = bits;
+    ct[1] = stride;
+    for (int i = 0; i < bits; ++i) {
+        int32_t* lwe = ct.data() + 16 + (size_t)i * stride;
+        int64_t b = (int64_t)(((uint32_t)m >> i) & 1) * (q / 4) + (int64_t)(rng() % (q / 16)) - q / 32;
+        for (int j = 0; j < width - 1; ++j) {
+            lwe[j] = (int32_t)(rng() % (uint64_t)q);
+            b += (int64_t)lwe[j] * sk[j];
+        }
+        lwe[width - 1] = (int32_t)(((b % q) + q) % q);
+    }
+    return ct;
+}
+
+static void check_batch(const FHE16_DecParams& p, const std::vector<int32_t*>& cts,
+                        const std::vector<int32_t>& sk, int threads) {
+    const int n = (int)cts.size();
+    std::vector<int64_t> out(n, -1);
+    std::vector<uint8_t> ok(n, 2);
+    int nulls = 0;
+    for (int32_t* c : cts) nulls += !c;
+    CHECK(FHE16_DECInt_BATCH_P(p, cts.data(), n, sk.data(), out.data(), threads, ok.data()) == n - nulls);
+    for (int i = 0; i < n; ++i) {
+        if (!cts[i]) { CHECK(ok[i] == 0 && out[i] == 0); continue; }
+        CHECK(ok[i] == 1);
+        CHECK(out[i] == dec_ref(cts[i], sk.data(), p.q, p.width));
+    }
+}
+
+int main() {
+    std::mt19937_64 rng(7);
+
+    // 배포 파라미터 (GINX16bit_128b: _Q_TOT = 163603457, _PK_col = 1025, 비트당 1040 워드)
+    {
+        const FHE16_DecParams p = { 163603457, 1025 };
+        std::vector<int32_t> sk(p.width - 1);
+        for (int32_t& s : sk) s = (int32_t)(rng() & 1);
+        const int32_t msgs[] = { 0, 1, -1, 7, -3, 12345, -2147483647 - 1, 2147483647 };
+        std::vector<std::vector<int32_t>> store;
+        for (int32_t m : msgs) store.push_back(encrypt(m, 32, sk, p.q, p.width, 1040, rng));
+        store.push_back(encrypt(5, 8, sk, p.q, p.width, 1040, rng));
+        std::vector<int32_t*> cts;
+        for (auto& c : store) cts.push_back(c.data());
+
+        std::vector<int64_t> out(cts.size());
+        CHECK(FHE16_DECInt_BATCH_P(p, cts.data(), (int)cts.size(), sk.data(), out.data()) == (int)cts.size());
+        for (size_t i = 0; i < sizeof(msgs) / sizeof(msgs[0]); ++i) CHECK(out[i] == msgs[i]);
+        CHECK(out.back() == 5);
+        check_batch(p, cts, sk, 1);
+    }
+
+    // 범위를 벗어난 입력: 임의 마스크 / 키 / 비트 수, 레인 수의 배수가 아닌 행 수, 여러 스레드
+    const FHE16_DecParams shapes[] = { { 163603457, 1025 }, { 16384, 586 }, { 7, 13 }, { 1000003, 9 },
+                                       { 2147483393, 40 }, { 5, 2 }, { 163603457, 1 } };
+    for (const FHE16_DecParams& p : shapes) {
+        const int stride = p.width + (int)(rng() % 24);
+        for (int mode = 0; mode < 3; ++mode) {
+            std::vector<int32_t> sk(p.width);
+            for (int32_t& s : sk) s = mode == 0 ? (int32_t)(rng() % 3) - 1 : (int32_t)rng();
+            std::vector<std::vector<int32_t>> store(41);
+            std::vector<int32_t*> cts;
+            for (auto& c : store) {
+                const int bits = mode == 2 ? (int)(rng() % 70) - 3 : (int)(rng() % 33);
+                c.resize(16 + (size_t)(bits > 0 ? bits : 0) * stride);
+                for (int32_t& w : c) w = mode == 0 ? (int32_t)(rng() % (uint64_t)p.q) : (int32_t)rng();
+                c[0] = bits;
+                c[1] = stride;
+                cts.push_back(c.data());
+            }
+            if (mode == 2) cts[5] = nullptr;
+            check_batch(p, cts, sk, 1);
+            check_batch(p, cts, sk, 3);
+        }
+    }
+
+    // 잘못된 파라미터 / 파라미터 없음
+    {
+        int32_t* none = nullptr;
+        int64_t out = 0;
+        const FHE16_DecParams bad = { 3, 1025 };
+        CHECK(FHE16_DECInt_BATCH_P(bad, &none, 1, nullptr, &out) == -1);
+        FHE16_DecParams live;
+        CHECK(!FHE16_dec_params_live(live));
+        CHECK(FHE16_DECInt_BATCH(&none, 1, nullptr, &out) == -1);
+    }
+
+    if (g_fail) { std::fprintf(stderr, "test_dec_batch: %d failure(s)\n", g_fail); return 1; }
+    std::printf("test_dec_batch: ok\n");
+    return 0;
+}
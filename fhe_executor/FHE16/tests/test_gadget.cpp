@@ -0,0 +1,112 @@
+// tests/test_gadget.cpp — gadget.h 의 CRT2 분해 (SignedDecompTwoPowRemoveCRT2_16bit) 를 스칼라 정의와 비교
+//
+// 입력은 [0, q_j) (원래 함수와 출력이 같은 범위, gadget.h 주석 참고). 배포 모듈러스 12289 / 13313 (Q = 163603457).
+//  - 기준 1: 기존 스칼라 함수 SignedDecompTwoPowRemoveOneCRT_16bit (rm >= 1, rm = 0 은 원래 함수가 32 비트 시프트라 제외)
+//  - 기준 2: int64 로 그대로 쓴 정의 (CRT 복원 → [floor(Q/2), Q) 는 음수로 → 하위 rm 비트 반올림 제거 → 부호 있는 base 비트 자릿수)
+// 무작위 값 외에 0, q_j - 1, Q/2 경계, 반올림 경계 (x mod 2^rm = 2^(rm-1)) 를 넣고 CHUNK 배수가 아닌 dim 도 쓴다.
+// 이 함수들은 헤더 전용으로 libFHE16 / 애드온에서는 아직 부르지 않는다.
+
+#include "gadget.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static int g_fail = 0;
+#define CHECK(c) do { if (!(c)) { std::fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #c); ++g_fail; } } while (0)
+
+static const int16_t kQ[2] = { 12289, 13313 };
+static const int64_t kQtot = (int64_t)kQ[0] * kQ[1];
+
+static int64_t floor_mod(int64_t a, int64_t m) { return ((a % m) + m) % m; }
+
+// 정의: from [poly][q][dim] → to [poly][gl][q][dim]
+static void decomp_ref(const int16_t* from, int16_t* to, int dim, int poly_len, int base, int len, int rm) {
+    for (int p = 0; p < poly_len; ++p)
+        for (int e = 0; e < dim; ++e) {
+            const int64_t a0 = from[p * dim * 2 + e], a1 = from[p * dim * 2 + dim + e];
+            static const int64_t inv = [] { int64_t i = 1; while (kQ[0] * i % kQ[1] != 1) ++i; return i; }();
+            int64_t x = a0 + kQ[0] * (floor_mod(a1 - a0, kQ[1]) * inv % kQ[1]);
+            if (x >= kQtot / 2) x -= kQtot;   // 원래 함수와 같은 경계 (floor(Q/2) 부터 음수)
+            int64_t low = floor_mod(x, (int64_t)1 << rm);
+            if (rm > 0 && low >= ((int64_t)1 << (rm - 1))) low -= (int64_t)1 << rm;
+            int64_t v = (x - low) >> rm;
+            for (int g = 0; g < len; ++g) {
+                int64_t d = floor_mod(v, (int64_t)1 << base);
+                if (d >= ((int64_t)1 << (base - 1))) d -= (int64_t)1 << base;
+                v = (v - d) >> base;
+                to[((p * len + g) * 2 + 0) * dim + e] = (int16_t)(d < 0 ? d + kQ[0] : d);
+                to[((p * len + g) * 2 + 1) * dim + e] = (int16_t)(d < 0 ? d + kQ[1] : d);
+            }
+        }
+}
+
+int main() {
+    std::mt19937_64 rng(47);
+
+    // 원래 함수의 CRT 기저: (Q / q_j) * ((Q / q_j)^-1 mod q_j)
+    int64_t crt_basis[2];
+    for (int j = 0; j < 2; ++j) {
+        const int64_t m = kQtot / kQ[j];
+        int64_t inv = 1;
+        while (m * inv % kQ[j] != 1) ++inv;
+        crt_basis[j] = m * inv;
+    }
+    int16_t Qmut[2] = { kQ[0], kQ[1] };
+
+    struct G { int base, rm, len; };
+    const G gadgets[] = { { 7, 7, 3 }, { 9, 10, 2 }, { 8, 8, 3 }, { 11, 17, 1 }, { 9, 11, 2 },
+                          { 5, 3, 4 }, { 6, 1, 4 }, { 4, 12, 3 }, { 8, 0, 3 }, { 1, 5, 20 }, { 13, 2, 2 } };
+
+    for (int dim : { 1, 63, 64, 65, 512 }) {
+        const int poly_len = dim == 512 ? 3 : 2;
+        std::vector<int16_t> from((size_t)poly_len * 2 * dim);
+        for (int p = 0; p < poly_len; ++p)
+            for (int e = 0; e < dim; ++e) {
+                int64_t x;
+                switch (rng() % 6) {
+                case 0:  x = 0; break;
+                case 1:  x = kQtot - 1; break;
+                case 2:  x = kQtot / 2 + (int64_t)(rng() % 5) - 2; break;   // 중심화 경계
+                case 3:  x = ((int64_t)(rng() % (kQtot >> 12)) << 12) | 0x800; break;   // 반올림 경계
+                default: x = (int64_t)(rng() % (uint64_t)kQtot);
+                }
+                from[(size_t)p * dim * 2 + e]       = (int16_t)(x % kQ[0]);
+                from[(size_t)p * dim * 2 + dim + e] = (int16_t)(x % kQ[1]);
+            }
+        if (dim > 2) {   // 각 모듈러스의 끝값
+            from[1] = kQ[0] - 1; from[dim + 1] = 0;
+            from[2] = 0;         from[dim + 2] = kQ[1] - 1;
+        }
+
+        for (const G& g : gadgets) {
+            const size_t out_n = (size_t)poly_len * g.len * 2 * dim;
+            std::vector<int16_t> got(out_n, -1), ref(out_n, -2), old(out_n, -3);
+            SignedDecompTwoPowRemoveCRT2_16bit(from.data(), got.data(), dim, poly_len, g.base, g.len, g.rm, kQ);
+            decomp_ref(from.data(), ref.data(), dim, poly_len, g.base, g.len, g.rm);
+            CHECK(got == ref);
+            if (g.rm >= 1) {
+                SignedDecompTwoPowRemoveOneCRT_16bit(from.data(), old.data(), dim, poly_len, g.base, g.len, g.rm, Qmut, 2, crt_basis);
+                CHECK(got == old);
+            }
+            if (got != ref) std::fprintf(stderr, "  dim %d gadget %d/%d/%d\n", dim, g.base, g.rm, g.len);
+        }
+
+        // 컴파일 타임 특수화도 같은 출력
+        std::vector<int16_t> a((size_t)poly_len * 3 * 2 * dim), b(a.size());
+        SignedDecompTwoPowRemoveCRT2_16bit(from.data(), a.data(), dim, poly_len, 7, 3, 7, kQ);
+        SignedDecompTwoPowRemoveCRT2_16bit_T<7, 7, 3>(from.data(), b.data(), dim, poly_len, kQ);
+        CHECK(a == b);
+        SignedDecompTwoPowRemoveCRT2_16bit(from.data(), a.data(), dim, poly_len, 8, 3, 0, kQ);
+        SignedDecompTwoPowRemoveCRT2_16bit_T<8, 0, 3>(from.data(), b.data(), dim, poly_len, kQ);
+        CHECK(a == b);
+        std::vector<int16_t> c((size_t)poly_len * 2 * dim), d(c.size());
+        SignedDecompTwoPowRemoveCRT2_16bit(from.data(), c.data(), dim, poly_len, 11, 1, 17, kQ);
+        SignedDecompTwoPowRemoveCRT2_16bit_T<11, 17, 1>(from.data(), d.data(), dim, poly_len, kQ);
+        CHECK(c == d);
+    }
+
+    if (g_fail) { std::fprintf(stderr, "test_gadget: %d failure(s)\n", g_fail); return 1; }
+    std::printf("test_gadget: ok\n");
+    return 0;
+}
@@ -0,0 +1,78 @@
+// tests/test_gates.cpp — FHE16_XOR3VEC 가 키 / 입력이 없을 때 라이브러리를 부르지 않고 오류를 내는지
+//
+// 평가 키 없이 (G_FHE16_PARAM = nullptr) 링크하므로 정상 경로는 여기서 돌리지 않는다.
+// 라이브러리 함수는 불리면 abort 하는 자리표시로 채운다.
+
+#include "fhe16_gates.hpp"
+#include "fhe16_plan.hpp"
+
+#include "BinOperationCstyle.hpp"
+#include "soAPI.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+EFHEs::EFHE_BIN_Param_List* G_FHE16_PARAM = nullptr;
+
+// 라이브러리 함수 자리: 키가 없으면 불리면 안 된다
+static void not_reached(const char* fn) {
+    std::fprintf(stderr, "called %s without an evaluation key\n", fn);
+    std::abort();
+}
+void C_FHE16_XOR3(const int32_t*, const int32_t*, const int32_t*, int32_t*, FHE16BOOTParam*, BIN_EV_METHOD) { not_reached("C_FHE16_XOR3"); }
+int32_t* FHE16_XORVEC(int32_t*, int32_t*) { not_reached("FHE16_XORVEC"); return nullptr; }
+int get_core_id() { not_reached("get_core_id"); return 0; }
+namespace EFHEs {
+int32_t  EFHE_BIN_Param_List::GetQLWE() const       { not_reached("GetQLWE"); return 0; }
+int32_t  EFHE_BIN_Param_List::GetNLWE() const       { not_reached("GetNLWE"); return 0; }
+int32_t  EFHE_BIN_Param_List::GetScalingLWE() const { not_reached("GetScalingLWE"); return 0; }
+int64_t  EFHE_BIN_Param_List::GetQBKTOT() const     { not_reached("GetQBKTOT"); return 0; }
+uint32_t EFHE_BIN_Param_List::GetNBK() const        { not_reached("GetNBK"); return 0; }
+uint32_t EFHE_BIN_Param_List::GetKBK() const        { not_reached("GetKBK"); return 0; }
+double   EFHE_BIN_Param_List::GetSigmaBK() const    { not_reached("GetSigmaBK"); return 0; }
+double   EFHE_BIN_Param_List::GetSigmaKS() const    { not_reached("GetSigmaKS"); return 0; }
+}
+
+static int g_fail = 0;
+#define CHECK(c) do { if (!(c)) { std::fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #c); ++g_fail; } } while (0)
+
+// 예외 메시지에 want 가 들어 있으면 true (결과가 나오면 false)
+static bool throws(int32_t* a, int32_t* b, int32_t* c, const char* want) {
+    try {
+        FHE16_XOR3VEC(a, b, c);
+    } catch (const std::runtime_error& e) {
+        if (std::strstr(e.what(), want)) return true;
+        std::fprintf(stderr, "unexpected error: %s\n", e.what());
+    }
+    return false;
+}
+
+int main() {
+    std::vector<int32_t> ct(FHE16_CT_WORDS, 0);
+    ct[0] = 32;
+    ct[1] = FHE16_LWE_WORDS;
+    std::vector<int32_t> bad = ct;
+    bad[1] = 7;
+
+    CHECK(throws(nullptr, ct.data(), ct.data(), "null ciphertext"));
+    CHECK(throws(ct.data(), ct.data(), nullptr, "null ciphertext"));
+    CHECK(throws(ct.data(), bad.data(), ct.data(), "invalid ciphertext header"));
+    CHECK(throws(ct.data(), ct.data(), ct.data(), "evaluation key not loaded"));
+
+    // 비트 수가 달라 XORVEC 두 번으로 가는 경로도 키부터 확인
+    std::vector<int32_t> small(FHE16_CT_META + 8 * FHE16_LWE_WORDS, 0);
+    small[0] = 8;
+    small[1] = FHE16_LWE_WORDS;
+    CHECK(throws(ct.data(), small.data(), ct.data(), "evaluation key not loaded"));
+
+    FHE16_NoiseParams np;
+    CHECK(!FHE16_noise_params_live(np));
+
+    if (g_fail) { std::fprintf(stderr, "test_gates: %d failure(s)\n", g_fail); return 1; }
+    std::printf("test_gates: ok\n");
+    return 0;
+}
@@ -0,0 +1,139 @@
+// tests/test_keyswitching.cpp — keyswitching.hpp 의 블록 / 배치 키 전환 커널 검사
+//
+//  - 기준 ks_ref: C_KeySwitchingRawCRTBin_16bit 의 계수별 순회 (분해하자마자 그 자리 행을 뺌) 를 스칼라로 옮긴 것.
+//    _Blocked / _Batch 의 출력 n_lwe + 1 개가 비트 단위로 같아야 한다 (빌드 설정의 SIMD 경로).
+//  - 의미 검사: 잡음 없는 키 (행 = d * 2^(base*j) * s_i 를 비밀키 z 로 암호화) 로 돌리면
+//    위상 b - <a, z> 가 b' - sum a'_i s_i (mod q_ks) 와 정확히 같아야 한다 (a', b' = q_ks 로 전환한 입력).
+//  - 모양: 배포 파라미터 모양 (n_lwe 586, 밑 2^5, 자리 3, q_ks 2^14, kN 을 줄인 것) 과 row_len 이 SIMD 폭의
+//    배수가 아니거나 n_lwe + 1 이 이미 16 의 배수인 경우, 배치 수 1 / 5 / 70 (64 묶음 경계).
+// 이 커널들은 헤더 전용으로 libFHE16 / 애드온에서는 아직 부르지 않는다.
+
+#include "BinOperationCstyle.hpp"
+#include "soAPI.hpp"
+#include "Core.hpp"
+#include "keyswitching.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+static int g_fail = 0;
+#define CHECK(c) do { if (!(c)) { std::fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #c); ++g_fail; } } while (0)
+
+struct Shape { int n_lwe, base, len, q_ks, n_bk, k_bk; };
+
+static int16_t mod_switch(int32_t v, const FHE16Params& P, const NTTTable16Struct& st) {
+    const int64_t scale = (((int64_t)1 << 48) / st._Q_TOT) * P._q_ks;
+    return (int16_t)((((int64_t)v * scale + ((int64_t)1 << 47)) >> 48) & (P._q_ks - 1));
+}
+
+// 라이브러리 순서 그대로: 계수마다 분해하고 바로 행을 뺀다
+static std::vector<int16_t> ks_ref(const std::vector<int32_t>& val, const std::vector<int16_t>& KS,
+                                   const FHE16Params& P, const NTTTable16Struct& st) {
+    const int kN = P._n_bk * P._k_bk, row_len = KS16_RowLen(P._n_lwe);
+    std::vector<int16_t> out(P._n_lwe + 1, 0);
+    for (int i = 0; i < kN; ++i) {
+        int a = mod_switch(val[i], P, st);
+        for (int j = 0; j < P._gadget_len_ks; ++j) {
+            const int d = a & ((1 << P._base_ks) - 1);
+            a >>= P._base_ks;
+            const int16_t* row = KS.data() + ((size_t)((i * P._gadget_len_ks + j) << P._base_ks) + d) * row_len;
+            if (d) for (int k = 0; k <= P._n_lwe; ++k) out[k] = (int16_t)(out[k] - row[k]);
+        }
+    }
+    for (int k = 0; k < P._n_lwe; ++k) out[k] &= (int16_t)(P._q_ks - 1);
+    out[P._n_lwe] = (int16_t)((out[P._n_lwe] + mod_switch(val[kN], P, st)) & (P._q_ks - 1));
+    return out;
+}
+
+static bool same_prefix(const int32_t* got, const std::vector<int16_t>& want) {
+    return std::memcmp(got, want.data(), want.size() * sizeof(int16_t)) == 0;
+}
+
+static void run_shape(const Shape& sh, bool real_key, std::mt19937_64& rng) {
+    FHE16Params P = {};
+    P._n_lwe = sh.n_lwe; P._base_ks = sh.base; P._gadget_len_ks = sh.len; P._q_ks = sh.q_ks;
+    P._n_bk = sh.n_bk; P._k_bk = sh.k_bk;
+    NTTTable16Struct st;
+    st._Q_TOT = 163603457;      // 배포 _Q_TOT
+
+    const int kN = sh.n_bk * sh.k_bk, row_len = KS16_RowLen(sh.n_lwe), mask = sh.q_ks - 1;
+    CHECK(row_len % 16 == 0 && row_len > sh.n_lwe);
+
+    // 키: 임의 값 또는 잡음 없는 LWE (s: 입력 쪽 비밀키, z: 출력 쪽 비밀키, 둘 다 0/1)
+    std::vector<int> s(kN), z(sh.n_lwe);
+    for (int& v : s) v = (int)(rng() & 1);
+    for (int& v : z) v = (int)(rng() & 1);
+    std::vector<int16_t> KS((size_t)kN * sh.len * row_len << sh.base);
+    for (int i = 0; i < kN; ++i)
+        for (int j = 0; j < sh.len; ++j)
+            for (int d = 0; d < (1 << sh.base); ++d) {
+                int16_t* row = KS.data() + ((size_t)((i * sh.len + j) << sh.base) + d) * row_len;
+                int64_t b = (int64_t)d * ((int64_t)1 << (sh.base * j)) * s[i];
+                for (int k = 0; k < row_len; ++k) row[k] = (int16_t)rng();
+                if (!real_key) continue;
+                for (int k = 0; k < sh.n_lwe; ++k) { row[k] &= mask; b += (int64_t)row[k] * z[k]; }
+                row[sh.n_lwe] = (int16_t)(b & mask);
+            }
+
+    const int sizes[] = { 1, 5, 70 };
+    for (int cnt : sizes) {
+        // 입력: [0, Q) 무작위 + 끝값 (0, Q - 1: 반올림하면 q_ks 가 되어 0 으로 감긴다)
+        std::vector<std::vector<int32_t>> in(cnt);
+        for (auto& v : in) {
+            v.assign((size_t)row_len / 2 + kN + 1, 0);
+            for (int i = 0; i <= kN; ++i) {
+                const uint64_t r = rng();
+                v[i] = (r & 7) == 0 ? 0 : (r & 7) == 1 ? (int32_t)(st._Q_TOT - 1) : (int32_t)((r >> 3) % st._Q_TOT);
+            }
+        }
+
+        std::vector<int32_t> rows((size_t)cnt * KS16_RowsSize(&P));
+        std::vector<std::vector<int32_t>> blk = in, bat = in;
+        std::vector<int32_t*> ptrs;
+        for (auto& v : bat) ptrs.push_back(v.data());
+        C_KeySwitchingRawCRTBin_16bit_Batch(ptrs.data(), cnt, KS.data(), rows.data(), &P, &st);
+
+        int bad_blk = 0, bad_bat = 0, bad_phase = 0;
+        for (int c = 0; c < cnt; ++c) {
+            const std::vector<int16_t> want = ks_ref(in[c], KS, P, st);
+            C_KeySwitchingRawCRTBin_16bit_Blocked(blk[c].data(), KS.data(), rows.data(), &P, &st);
+            bad_blk += !same_prefix(blk[c].data(), want);
+            bad_bat += !same_prefix(bat[c].data(), want);
+
+            if (real_key) {
+                int64_t phase = want[sh.n_lwe], expect = mod_switch(in[c][kN], P, st);
+                for (int k = 0; k < sh.n_lwe; ++k) phase -= (int64_t)want[k] * z[k];
+                for (int i = 0; i < kN; ++i) expect -= (int64_t)mod_switch(in[c][i], P, st) * s[i];
+                bad_phase += (phase & mask) != (expect & mask);
+            }
+        }
+        CHECK(bad_blk == 0);
+        CHECK(bad_bat == 0);
+        CHECK(bad_phase == 0);
+        if (bad_blk || bad_bat || bad_phase)
+            std::fprintf(stderr, "  n_lwe %d base %d len %d kN %d cnt %d key %s\n",
+                         sh.n_lwe, sh.base, sh.len, kN, cnt, real_key ? "lwe" : "random");
+    }
+}
+
+int main() {
+    std::mt19937_64 rng(50);
+
+    const Shape shapes[] = {
+        { 586, 5, 3, 1 << 14, 64, 2 },     // 배포 모양 (kN 만 줄임)
+        { 13, 4, 4, 1 << 14, 17, 1 },      // row_len 16: AVX-512 루프 없이 AVX2 / 스칼라만
+        { 47, 5, 3, 1 << 14, 9, 3 },       // n_lwe + 1 = 48: 이미 16 의 배수
+        { 100, 3, 4, 1 << 12, 11, 2 },     // 자리 수 * 밑 == log2 q_ks
+        { 31, 7, 2, 1 << 13, 5, 1 },       // 2^base > row_len, 마지막 자리가 일부만 쓰임
+    };
+    for (const Shape& sh : shapes) {
+        run_shape(sh, false, rng);
+        run_shape(sh, true, rng);
+    }
+
+    if (g_fail) { std::fprintf(stderr, "test_keyswitching: %d failure(s)\n", g_fail); return 1; }
+    std::printf("test_keyswitching: ok\n");
+    return 0;
+}
@@ -0,0 +1,203 @@
+// tests/test_plan_opt.cpp — FHE16_plan_optimize 전후 계획이 같은 값을 내는지 (평문 모델)
+//
+// 무작위 계획 (상수곱 → 시프트, x * 0, 시프트 / 상수 사슬, sub(x, x), 비교 + 선택, XOR 융합 등 규칙을
+// 일부러 자주 만들도록) 을 최적화 전후로 FHE16_plan_run 에 돌려 출력을 비교한다.
+// 암호문은 실제 배치 (메타 16 + 비트당 1040 워드) 의 장난감 버전: 비트 블록의 첫 워드 = 평문 비트.
+// SHL_CONST 는 실행기의 내장 구현 (블록 이동) 을 그대로 쓰고, 나머지 연산은 n 비트 2의 보수 (mod 2^n) 로 계산한다.
+// 입력은 부호 / 넘침 경계값 (INT_MIN, INT_MAX, -1, 0 …) 을 섞고, 8 / 32 / 64 비트 암호문에서 확인한다.
+
+#include "fhe16_plan.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+static int g_fail = 0;
+#define CHECK(c) do { if (!(c)) { std::fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #c); ++g_fail; } } while (0)
+
+// ===== 장난감 암호문 =====
+static int32_t* ct_make(int bits, uint64_t v) {
+    const size_t words = FHE16_CT_META + (size_t)bits * FHE16_LWE_WORDS;
+    int32_t* ct = (int32_t*)std::calloc(words, sizeof(int32_t));
+    ct[0] = bits;
+    ct[1] = FHE16_LWE_WORDS;
+    for (int i = 0; i < bits; ++i) ct[FHE16_CT_META + (size_t)i * FHE16_LWE_WORDS] = (int32_t)((v >> i) & 1);
+    return ct;
+}
+
+static uint64_t ct_value(const int32_t* ct) {
+    uint64_t v = 0;
+    for (int i = 0; i < ct[0]; ++i) v |= (uint64_t)(ct[FHE16_CT_META + (size_t)i * FHE16_LWE_WORDS] & 1) << i;
+    return v;
+}
+
+// ===== n 비트 2의 보수 모델 =====
+static uint64_t mask_of(int n) { return n >= 64 ? ~0ull : ((1ull << n) - 1); }
+static int64_t  sx(uint64_t v, int n) { return n >= 64 ? (int64_t)v : (int64_t)(v << (64 - n)) >> (64 - n); }
+
+static uint64_t eval_op(const FHE16_PlanStep& s, const uint64_t* x, int n) {
+    const uint64_t m = mask_of(n);
+    const uint64_t a = x[0], b = x[1], c = x[2];
+    const uint64_t imm = (uint64_t)(int64_t)s.imm;
+    const uint64_t p2 = (s.imm >= 0 && s.imm < n) ? 1ull << s.imm : 0;
+    switch (s.op) {
+    case FHE16_OP_ADD:         return (a + b) & m;
+    case FHE16_OP_SUB:         return (a - b) & m;
+    case FHE16_OP_ADD3:        return (a + b + c) & m;
+    case FHE16_OP_GE:          return sx(a, n) >= sx(b, n);
+    case FHE16_OP_GT:          return sx(a, n) >  sx(b, n);
+    case FHE16_OP_LE:          return sx(a, n) <= sx(b, n);
+    case FHE16_OP_LT:          return sx(a, n) <  sx(b, n);
+    case FHE16_OP_EQ:          return a == b;
+    case FHE16_OP_NEQ:         return a != b;
+    case FHE16_OP_MAX:         return sx(a, n) >= sx(b, n) ? a : b;
+    case FHE16_OP_MIN:         return sx(a, n) <= sx(b, n) ? a : b;
+    case FHE16_OP_AND:         return a & b;
+    case FHE16_OP_OR:          return a | b;
+    case FHE16_OP_XOR:         return a ^ b;
+    case FHE16_OP_XOR3:        return a ^ b ^ c;
+    case FHE16_OP_SELECT:      return a ? b : c;
+    case FHE16_OP_SMULL:       return (a * b) & m;
+    case FHE16_OP_SMULL_CONST: return (a * imm) & m;
+    case FHE16_OP_ADD_CONST:   return (a + imm) & m;
+    case FHE16_OP_NEG:         return (0 - a) & m;
+    case FHE16_OP_ABS:         return sx(a, n) < 0 ? (0 - a) & m : a;
+    case FHE16_OP_RELU:        return sx(a, n) < 0 ? 0 : a;
+    case FHE16_OP_ADD_POW2:    return (a + p2) & m;
+    case FHE16_OP_SUB_POW2:    return (a - p2) & m;
+    }
+    std::abort();
+}
+
+static int32_t* toy_apply(const FHE16_PlanStep& s, int32_t* const* in, std::string&) {
+    uint64_t x[FHE16_PLAN_MAX_IN] = {};
+    for (int k = 0; k < s.n_in; ++k) x[k] = ct_value(in[k]);
+    return ct_make(in[0][0], eval_op(s, x, in[0][0]));
+}
+
+static void toy_free(int32_t* ct) { std::free(ct); }
+
+// ===== 무작위 계획 =====
+static const int32_t kMulImm[] = { 0, 1, -1, 2, 4, 8, 1 << 30, 3, -4, 65536, INT32_MIN, INT32_MAX, -2 };
+static const int32_t kShlImm[] = { 0, 1, 5, 31, 32, 40, 63, 64 };
+static const int32_t kAddImm[] = { 0, 1, -1, INT32_MAX, INT32_MIN, 12345, -7 };
+
+static FHE16_PlanStep step(int32_t op, int32_t a, int32_t b = -1, int32_t c = -1, int32_t imm = 0) {
+    FHE16_PlanStep s;
+    s.op = op;
+    s.n_in = FHE16_plan_op_arity(op);
+    s.in[0] = a; s.in[1] = b; s.in[2] = c;
+    s.imm = imm;
+    return s;
+}
+
+static FHE16_Plan random_plan(std::mt19937_64& rng) {
+    FHE16_Plan p;
+    p.n_inputs = 3 + (int)(rng() % 2);
+    const int ns = 10 + (int)(rng() % 16);
+    auto any = [&](int cur) { return (int32_t)(rng() % cur); };
+    auto pick = [&](const int32_t* v, size_t n) { return v[rng() % n]; };
+    static const int32_t cmp[] = { FHE16_OP_GE, FHE16_OP_GT, FHE16_OP_LE, FHE16_OP_LT };
+
+    while ((int)p.steps.size() < ns) {
+        const int cur = p.n_inputs + (int)p.steps.size();
+        const int32_t x = any(cur), y = any(cur), z = any(cur);
+        switch (rng() % 12) {
+        case 0: p.steps.push_back(step(FHE16_OP_SMULL_CONST, x, -1, -1, pick(kMulImm, sizeof(kMulImm) / 4))); break;
+        case 1: p.steps.push_back(step(FHE16_OP_SHL_CONST, x, -1, -1, pick(kShlImm, sizeof(kShlImm) / 4))); break;
+        case 2: p.steps.push_back(step(FHE16_OP_ADD_CONST, x, -1, -1, pick(kAddImm, sizeof(kAddImm) / 4))); break;
+        case 3: p.steps.push_back(step(rng() & 1 ? FHE16_OP_SUB : FHE16_OP_XOR, x, rng() & 1 ? x : y)); break;
+        case 4: {   // select(cmp(x, y), x, y) 와 그 변형
+            p.steps.push_back(step(pick(cmp, 4), x, y));
+            const int32_t f = cur;
+            p.steps.push_back(rng() & 1 ? step(FHE16_OP_SELECT, f, x, y) : step(FHE16_OP_SELECT, f, y, x));
+            break;
+        }
+        case 5: p.steps.push_back(step(FHE16_OP_NEG, x)); p.steps.push_back(step(FHE16_OP_NEG, cur)); break;
+        case 6: p.steps.push_back(step(FHE16_OP_XOR, x, y)); p.steps.push_back(step(FHE16_OP_XOR, rng() & 1 ? cur : z, rng() & 1 ? z : cur)); break;
+        case 7: p.steps.push_back(step(FHE16_OP_XOR3, x, rng() & 1 ? x : y, z)); break;
+        case 8: {
+            static const int32_t bin[] = { FHE16_OP_ADD, FHE16_OP_SUB, FHE16_OP_AND, FHE16_OP_OR, FHE16_OP_MAX,
+                                           FHE16_OP_MIN, FHE16_OP_EQ, FHE16_OP_NEQ, FHE16_OP_SMULL };
+            p.steps.push_back(step(pick(bin, 9), x, rng() & 3 ? y : x));
+            break;
+        }
+        case 9: {
+            static const int32_t un[] = { FHE16_OP_ABS, FHE16_OP_RELU, FHE16_OP_ADD_POW2, FHE16_OP_SUB_POW2 };
+            p.steps.push_back(step(pick(un, 4), x, -1, -1, (int32_t)(rng() % 66)));
+            break;
+        }
+        case 10: p.steps.push_back(step(FHE16_OP_SELECT, x, y, rng() & 1 ? y : z)); break;
+        default: p.steps.push_back(step(FHE16_OP_ADD3, x, y, z)); break;
+        }
+    }
+    const int total = p.n_inputs + (int)p.steps.size();
+    p.outputs.push_back(total - 1);
+    for (int k = (int)(rng() % 3); k > 0; --k) p.outputs.push_back((int32_t)(rng() % total));
+    return p;
+}
+
+static bool run(const FHE16_Plan& p, const std::vector<int32_t*>& in, std::vector<uint64_t>& vals) {
+    std::vector<int32_t*> out;
+    std::string err;
+    if (!FHE16_plan_run(p, in.data(), 1, toy_apply, toy_free, out, nullptr, err)) {
+        std::fprintf(stderr, "plan_run: %s\n", err.c_str());
+        return false;
+    }
+    vals.clear();
+    for (int32_t* o : out) { vals.push_back(ct_value(o)); std::free(o); }
+    return true;
+}
+
+int main() {
+    std::mt19937_64 rng(33);
+    const uint64_t edge[] = { 0, 1, ~0ull, 0x7fffffffull, 0xffffffff80000000ull, 0x80000000ull,
+                              0x7fffffffffffffffull, 0x8000000000000000ull, 2, 0xfffffffffffffffeull };
+    int rewritten = 0, strength = 0, zeroed = 0;
+
+    for (int iter = 0; iter < 400; ++iter) {
+        const FHE16_Plan p = random_plan(rng);
+        for (int fanin : { 2, 3 }) {
+            FHE16_Plan q = p;
+            FHE16_PlanOptReport rep;
+            FHE16_plan_optimize(q, &rep, fanin);
+            rewritten += rep.folded + rep.fused + rep.xor_fused + rep.cse;
+            strength  += rep.strength_reduced;
+            for (const FHE16_PlanStep& s : q.steps) zeroed += s.op == FHE16_OP_SHL_CONST && s.imm >= 64;
+
+            // 최적화된 계획도 유효한 직렬화여야 한다
+            std::vector<int32_t> words;
+            FHE16_plan_encode(q, words);
+            FHE16_Plan back;
+            std::string err;
+            CHECK(FHE16_plan_decode(words.data(), words.size(), back, err));
+
+            for (int bits : { 8, 32, 64 }) {
+                for (int trial = 0; trial < 3; ++trial) {
+                    std::vector<int32_t*> in;
+                    for (int i = 0; i < p.n_inputs; ++i) {
+                        const uint64_t v = (rng() & 1) ? edge[rng() % 10] : rng();
+                        in.push_back(ct_make(bits, v & mask_of(bits)));
+                    }
+                    std::vector<uint64_t> want, got;
+                    const bool ok1 = run(p, in, want), ok2 = run(q, in, got);
+                    CHECK(ok1 && ok2);
+                    if (ok1 && ok2 && want != got) {
+                        std::fprintf(stderr, "iter %d fanin %d bits %d: optimized plan differs\n", iter, fanin, bits);
+                        ++g_fail;
+                    }
+                    for (int32_t* c : in) std::free(c);
+                }
+            }
+        }
+    }
+    // 무작위 계획이 규칙들을 실제로 건드렸는지
+    CHECK(rewritten > 0 && strength > 0 && zeroed > 0);
+
+    if (g_fail) { std::fprintf(stderr, "test_plan_opt: %d failure(s)\n", g_fail); return 1; }
+    std::printf("test_plan_opt: ok (%d rewrites, %d strength reductions, %d zero shifts)\n", rewritten, strength, zeroed);
+    return 0;
+}
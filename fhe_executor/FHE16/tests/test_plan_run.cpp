@@ -0,0 +1,146 @@
+// tests/test_plan_run.cpp — FHE16_plan_run 의 병렬 경로가 라이브러리 호출 한도를 지키는지
+//
+// apply 는 FHE16_LibSlot 을 잡고 (애드온의 plan_apply 와 같게) 동시에 안에 있는 호출 수를 센다.
+// 한도 1 (배포 기본) 에서는 parallel 을 크게 줘도 한 번에 하나, 한도 3 에서는 3 이하여야 하고,
+// 결과는 직렬 실행과 같아야 한다. 슬롯을 잡지 않은 호출은 FHE16_plan_run 이 parallel 을 줄여서 막는다.
+
+#include "fhe16_plan.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+static int g_fail = 0;
+#define CHECK(c) do { if (!(c)) { std::fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #c); ++g_fail; } } while (0)
+
+static std::atomic<int> g_inside{0};
+static std::atomic<int> g_peak{0};
+static bool             g_use_slot = true;
+
+// 장난감 암호문: 비트 수 32, 첫 비트 블록의 첫 워드에 값
+static int32_t* ct_make(int32_t v) {
+    int32_t* ct = (int32_t*)std::calloc(FHE16_CT_WORDS, sizeof(int32_t));
+    ct[0] = 32;
+    ct[1] = FHE16_LWE_WORDS;
+    ct[FHE16_CT_META] = v;
+    return ct;
+}
+
+static int32_t value(const int32_t* ct) { return ct[FHE16_CT_META]; }
+
+static int32_t* eval(const FHE16_PlanStep& s, int32_t* const* in) {
+    const int32_t a = value(in[0]), b = s.n_in > 1 ? value(in[1]) : 0;
+    switch (s.op) {
+    case FHE16_OP_ADD: return ct_make(a + b);
+    case FHE16_OP_SUB: return ct_make(a - b);
+    case FHE16_OP_XOR: return ct_make(a ^ b);
+    case FHE16_OP_NEG: return ct_make(-a);
+    default:           return nullptr;
+    }
+}
+
+static int32_t* counting_apply(const FHE16_PlanStep& s, int32_t* const* in, std::string&) {
+    auto body = [&]() {
+        const int now = ++g_inside;
+        int peak = g_peak.load();
+        while (now > peak && !g_peak.compare_exchange_weak(peak, now)) {}
+        std::this_thread::sleep_for(std::chrono::microseconds(300));
+        --g_inside;
+        return eval(s, in);
+    };
+    if (!g_use_slot) return body();
+    FHE16_LibSlot lib;
+    return body();
+}
+
+static void toy_free(int32_t* ct) { std::free(ct); }
+
+// 입력 4 개에서 폭 넓은 (서로 독립인 단계가 많은) 계획
+static FHE16_Plan wide_plan() {
+    FHE16_Plan p;
+    p.n_inputs = 4;
+    static const int32_t ops[] = { FHE16_OP_ADD, FHE16_OP_SUB, FHE16_OP_XOR };
+    for (int i = 0; i < 48; ++i) {
+        FHE16_PlanStep s = {};
+        s.op = ops[i % 3];
+        s.n_in = 2;
+        s.in[0] = i < 16 ? i % 4 : 4 + (i - 16);
+        s.in[1] = i < 16 ? (i + 1) % 4 : 4 + (i - 15) % 16;
+        p.steps.push_back(s);
+    }
+    FHE16_PlanStep neg = {};
+    neg.op = FHE16_OP_NEG;
+    neg.n_in = 1;
+    neg.in[0] = 4 + 47;
+    p.steps.push_back(neg);
+    for (int v = 4 + 32; v < 4 + 49; ++v) p.outputs.push_back(v);
+    return p;
+}
+
+static std::vector<int32_t> run(const FHE16_Plan& p, const std::vector<int32_t*>& in, int parallel, int* peak) {
+    g_peak = 0;
+    std::vector<int32_t*> out;
+    std::string err;
+    const bool ok = FHE16_plan_run(p, in.data(), parallel, counting_apply, toy_free, out, nullptr, err);
+    CHECK(ok);
+    std::vector<int32_t> vals;
+    for (int32_t* o : out) { vals.push_back(value(o)); std::free(o); }
+    if (peak) *peak = g_peak.load();
+    return vals;
+}
+
+int main() {
+    const FHE16_Plan p = wide_plan();
+    std::vector<int32_t*> in = { ct_make(7), ct_make(-3), ct_make(2147483647), ct_make(12345) };
+
+    CHECK(FHE16_lib_limit() == 1);
+    int peak = 0;
+    const std::vector<int32_t> want = run(p, in, 1, &peak);
+    CHECK(peak == 1);
+
+    // 한도 1: 스레드를 8 개 달라고 해도 라이브러리 호출은 한 번에 하나
+    CHECK(run(p, in, 8, &peak) == want);
+    CHECK(peak == 1);
+
+    // 한도 1 이면 FHE16_plan_run 이 직렬로 돌려서 슬롯 없는 apply 도 겹치지 않는다
+    g_use_slot = false;
+    CHECK(run(p, in, 8, &peak) == want);
+    CHECK(peak == 1);
+    g_use_slot = true;
+
+    // 한도 3: 계획 스레드 8 개, 외부 스레드 2 개가 같이 돌아도 3 이하
+    FHE16_lib_set_limit(3);
+    CHECK(FHE16_lib_limit() == 3);
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> others;
+    for (int t = 0; t < 2; ++t)
+        others.emplace_back([&] {
+            while (!stop) {
+                FHE16_LibSlot lib;
+                const int now = ++g_inside;
+                int pk = g_peak.load();
+                while (now > pk && !g_peak.compare_exchange_weak(pk, now)) {}
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                --g_inside;
+            }
+        });
+    for (int r = 0; r < 5; ++r) {
+        CHECK(run(p, in, 8, &peak) == want);
+        CHECK(peak <= 3);
+    }
+    stop = true;
+    for (std::thread& t : others) t.join();
+
+    FHE16_lib_set_limit(0);
+    CHECK(FHE16_lib_limit() == 1);
+
+    for (int32_t* c : in) std::free(c);
+    if (g_fail) { std::fprintf(stderr, "test_plan_run: %d failure(s)\n", g_fail); return 1; }
+    std::printf("test_plan_run: ok\n");
+    return 0;
+}
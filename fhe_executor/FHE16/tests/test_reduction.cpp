@@ -0,0 +1,113 @@
+// tests/test_reduction.cpp — reduction.h 의 16비트 지연 축약 (LazyReduce* / LazyAcc*) 검사
+//
+//  - 줄이기: 모든 x in [0, 2^16) 에 대해 x mod Q 와 같은지 (스칼라 + 빌드 설정의 SIMD 경로), 2^8 < Q < 2^15 여러 개
+//  - 누산기: 무작위 더하기 / 빼기 (입력 한도 1 .. max_bound - 1) 를 int64 정확한 값과 비교하고,
+//           한도가 지켜지는지 (모든 레인 < bound * Q) 매 단계 확인. N 은 SIMD 폭의 배수가 아닌 것도 쓴다.
+// 이 함수들은 헤더 전용으로 libFHE16 (블라인드 회전) / 애드온에서는 아직 부르지 않는다.
+
+#include "reduction.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static int g_fail = 0;
+#define CHECK(c) do { if (!(c)) { std::fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #c); ++g_fail; } } while (0)
+
+static const int16_t kQs[] = { 12289, 13313, 18433, 7681, 3329, 257, 769, 16385, 32749, 32767 };
+
+static bool below_bound(const std::vector<int16_t>& x, int bound, int16_t Q) {
+    for (int16_t v : x) if ((uint32_t)(uint16_t)v >= (uint32_t)bound * (uint32_t)Q) return false;
+    return true;
+}
+
+static bool equal_mod(const std::vector<int16_t>& x, const std::vector<int64_t>& want, int16_t Q) {
+    for (size_t i = 0; i < x.size(); ++i)
+        if ((int64_t)(uint16_t)x[i] % Q != ((want[i] % Q) + Q) % Q) return false;
+    return true;
+}
+
+int main() {
+    std::mt19937_64 rng(49);
+
+    // 줄이기: 전수 검사
+    std::vector<int16_t> all(65536);
+    for (int16_t Q : kQs) {
+        const int s = LazyBarrettShift_16bit(Q);
+        const uint16_t M = LazyBarrettConst_16bit(Q, s);
+        CHECK((1 << s) < Q && Q < (2 << s));
+        int bad = 0;
+        for (uint32_t x = 0; x < 65536; ++x) {
+            bad += LazyReduce_16bit((uint16_t)x, M, s, Q) != x % (uint32_t)Q;
+            all[x] = (int16_t)(uint16_t)x;
+        }
+        CHECK(bad == 0);
+        LazyReduceVec_16bit(all.data(), (int)all.size(), Q);
+        bad = 0;
+        for (uint32_t x = 0; x < 65536; ++x) bad += (uint16_t)all[x] != x % (uint32_t)Q;
+        CHECK(bad == 0);
+        if (bad) std::fprintf(stderr, "  Q = %d\n", Q);
+
+        // 넘치지 않는 최대 한도
+        CHECK((uint32_t)LAZY_MAX_BOUND_16bit(Q) * (uint32_t)Q <= 65536u);
+        CHECK((uint32_t)(LAZY_MAX_BOUND_16bit(Q) + 1) * (uint32_t)Q > 65536u);
+    }
+    CHECK(LAZY_MAX_BOUND_16bit(12289) == 5 && LAZY_MAX_BOUND_16bit(13313) == 4 && LAZY_MAX_BOUND_16bit(18433) == 3);
+
+    // 누산기: 무작위 연산열을 정확한 값과 비교
+    for (int16_t Q : kQs) {
+        const int max_bound = LAZY_MAX_BOUND_16bit(Q);
+        if (max_bound < 2) continue;
+        for (int N : { 1, 15, 16, 33, 64, 1024 }) {
+            std::vector<int16_t> x(N), y(N);
+            std::vector<int64_t> want(N);
+            for (int i = 0; i < N; ++i) { x[i] = (int16_t)(rng() % Q); want[i] = x[i]; }
+            LazyAcc_16bit acc;
+            LazyAccInit_16bit(&acc, x.data(), N, Q);
+
+            for (int step = 0; step < 60; ++step) {
+                const int by = 1 + (int)(rng() % (max_bound - 1));
+                for (int i = 0; i < N; ++i) {
+                    // 한도 끝값 (0, by*Q - 1) 을 자주
+                    const uint64_t r = rng();
+                    const uint32_t v = (r & 3) == 0 ? 0 : (r & 3) == 1 ? (uint32_t)by * Q - 1 : (uint32_t)((r >> 2) % ((uint64_t)by * Q));
+                    y[i] = (int16_t)(uint16_t)v;
+                }
+                const bool sub = rng() & 1;
+                if (sub) LazyAccSub_16bit(&acc, y.data(), by);
+                else     LazyAccAdd_16bit(&acc, y.data(), by);
+                for (int i = 0; i < N; ++i) want[i] += sub ? -(int64_t)(uint16_t)y[i] : (int64_t)(uint16_t)y[i];
+
+                CHECK(acc.bound <= max_bound);
+                CHECK(below_bound(x, acc.bound, Q));
+                CHECK(equal_mod(x, want, Q));
+                if (g_fail) break;
+            }
+            LazyAccFlush_16bit(&acc);
+            CHECK(acc.bound == 1 && below_bound(x, 1, Q) && equal_mod(x, want, Q));
+            if (g_fail) { std::fprintf(stderr, "  Q = %d, N = %d\n", Q, N); break; }
+        }
+    }
+
+    // 줄이기 + 더하기 / 빼기 한 패스 (LazyReduceAccVec_16bit) 를 직접: 입력이 uint16 전 범위여도 맞아야 한다
+    for (int16_t Q : { (int16_t)12289, (int16_t)13313 }) {
+        const int N = 77;
+        std::vector<int16_t> x(N), y(N), x0;
+        for (int i = 0; i < N; ++i) { x[i] = (int16_t)rng(); y[i] = (int16_t)(rng() % Q); }
+        x[0] = (int16_t)0xffff; y[0] = Q - 1;
+        x0 = x;
+        LazyReduceAccVec_16bit(x.data(), y.data(), 0, 0, Q, N);
+        bool ok = true;
+        for (int i = 0; i < N; ++i) ok &= (uint16_t)x[i] == (uint16_t)x0[i] % Q + (uint16_t)y[i];
+        CHECK(ok);
+        x = x0;
+        LazyReduceAccVec_16bit(x.data(), y.data(), 1, (uint16_t)Q, Q, N);
+        ok = true;
+        for (int i = 0; i < N; ++i) ok &= (uint16_t)x[i] == (uint16_t)x0[i] % Q + Q - (uint16_t)y[i];
+        CHECK(ok);
+    }
+
+    if (g_fail) { std::fprintf(stderr, "test_reduction: %d failure(s)\n", g_fail); return 1; }
+    std::printf("test_reduction: ok\n");
+    return 0;
+}
@@ -0,0 +1,131 @@
+// tests/test_stats.cpp — 연산별 카운터 / 추적 (fhe16_stats.cpp) 검사
+//
+//  - 같은 이름은 같은 slot, 호출 / 실패 / 시간 / 부트스트랩 합계, Reset 이후 값 (max 는 누적)
+//  - 종료한 스레드의 값이 사라지지 않는다
+//  - 추적: span 이 Chrome trace JSON 으로 나오고, 용량을 넘친 span 은 버린다
+//  - 여러 스레드가 기록하는 동안 TraceStart / TraceStop 을 반복해도 버퍼를 바꾸는 사이에 쓰지 않는다
+//    (버퍼 교체와 기록이 겹치는지는 -fsanitize=thread 빌드에서 드러난다)
+
+#include "fhe16_stats.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+static int g_fail = 0;
+#define CHECK(c) do { if (!(c)) { std::fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #c); ++g_fail; } } while (0)
+
+static const FHE16_OpStats* find(const std::vector<FHE16_OpStats>& v, const char* name) {
+    for (const auto& s : v) if (std::strcmp(s.name, name) == 0) return &s;
+    return nullptr;
+}
+
+static std::vector<FHE16_OpStats> get() {
+    std::vector<FHE16_OpStats> v(FHE16_STATS_MAX_SLOTS);
+    v.resize(FHE16_GetStats(v.data(), (int)v.size()));
+    return v;
+}
+
+static size_t count(const std::string& s, const char* pat) {
+    size_t n = 0;
+    for (size_t p = s.find(pat); p != std::string::npos; p = s.find(pat, p + 1)) ++n;
+    return n;
+}
+
+int main() {
+    const int a = FHE16_stats_register("OP_A");
+    const int b = FHE16_stats_register("OP_B");
+    CHECK(a >= 0 && b >= 0 && a != b);
+    CHECK(FHE16_stats_register("OP_A") == a);
+
+    // ===== 카운터 =====
+    FHE16_stats_record(a, 0, 100, 3, true);
+    FHE16_stats_record(a, 0, 500, 3, false);
+    FHE16_stats_record(-1, 0, 1, 1, true);                    // 등록 실패한 slot 은 무시
+    FHE16_stats_record(FHE16_STATS_MAX_SLOTS, 0, 1, 1, true);
+    std::thread([&] { FHE16_stats_record(a, 0, 50, 1, true); }).join();   // 종료한 스레드
+    {
+        const auto v = get();
+        const FHE16_OpStats* s = find(v, "OP_A");
+        CHECK(s && s->calls == 3 && s->errors == 1 && s->total_ns == 650 && s->max_ns == 500 && s->bootstraps == 7);
+        CHECK(!find(v, "OP_B"));                                // 호출 없는 slot 은 빠짐
+    }
+    FHE16_ResetStats();
+    CHECK(get().empty());
+    {
+        FHE16_StatScope sc(b, 2);
+        sc.ok = true;
+    }
+    {
+        const auto v = get();
+        const FHE16_OpStats* sa = find(v, "OP_A");
+        const FHE16_OpStats* sb = find(v, "OP_B");
+        CHECK(!sa && sb && sb->calls == 1 && sb->errors == 0 && sb->bootstraps == 2 && sb->total_ns >= 0);
+    }
+
+    // ===== 추적 =====
+    CHECK(!FHE16_TraceActive());
+    FHE16_TraceStart(4);
+    CHECK(FHE16_TraceActive());
+    const int64_t t = FHE16_stats_now_ns();
+    for (int i = 0; i < 6; ++i) FHE16_stats_record(i % 2 ? b : a, t + i * 1000, 2000, 0, true);
+    std::string json;
+    CHECK(FHE16_TraceStop(json) == 4);                        // 넘친 2 개는 버림
+    CHECK(!FHE16_TraceActive());
+    CHECK(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[{", 0) == 0);
+    CHECK(json.size() >= 2 && json.compare(json.size() - 2, 2, "]}") == 0);
+    CHECK(count(json, "\"name\":\"OP_A\"") == 2 && count(json, "\"name\":\"OP_B\"") == 2);
+    CHECK(count(json, "\"dur\":2.000") == 4);
+    FHE16_stats_record(a, t, 1, 0, true);                     // 멈춘 뒤에는 기록 안 함
+    CHECK(FHE16_TraceStop(json) == 0 && json == "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[]}");
+
+    // ===== 기록 중 Start / Stop 반복 =====
+    {
+        FHE16_ResetStats();
+        std::atomic<bool> stop{false};
+        std::atomic<int64_t> recorded{0};
+        std::vector<std::thread> th;
+        for (int k = 0; k < 4; ++k)
+            th.emplace_back([&, k] {
+                int64_t n = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    FHE16_stats_record(k % 2 ? b : a, FHE16_stats_now_ns(), 10, 1, true);
+                    ++n;
+                }
+                recorded += n;
+            });
+        bool ok = true;
+        size_t spans = 0;
+        for (int round = 0; round < 500; ++round) {
+            const size_t cap = 1 + round % 97;
+            FHE16_TraceStart(cap);
+            if (round % 3 == 0) std::this_thread::yield();
+            const size_t n = FHE16_TraceStop(json);
+            ok &= n <= cap;
+            ok &= count(json, "\"name\":") == n;
+            ok &= count(json, "\"name\":\"OP_A\"") + count(json, "\"name\":\"OP_B\"") == n;
+            spans += n;
+        }
+        stop = true;
+        for (auto& x : th) x.join();
+        CHECK(ok);
+        CHECK(spans > 0);
+        const auto v = get();
+        const FHE16_OpStats* sa = find(v, "OP_A");
+        const FHE16_OpStats* sb = find(v, "OP_B");
+        CHECK(sa && sb && sa->calls + sb->calls == recorded.load());
+    }
+
+    // ===== slot 이 가득 차면 -1 =====
+    int last = 0;
+    for (int i = 0; i < FHE16_STATS_MAX_SLOTS + 2; ++i) last = FHE16_stats_register(("FILL_" + std::to_string(i)).c_str());
+    CHECK(last == -1);
+    CHECK(FHE16_stats_register("OP_B") == b);
+
+    if (g_fail) { std::fprintf(stderr, "test_stats: %d failure(s)\n", g_fail); return 1; }
+    std::printf("test_stats: ok\n");
+    return 0;
+}
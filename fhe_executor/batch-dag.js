@@ -0,0 +1,124 @@
+// batch-dag.js — CID 핸들 기반 작업 의존성 + 메모리 내 암호문 전달
+//
+// 작업은 결과를 입력 CID 하나(상태 CID, output slot)에 덮어쓴다. 같은 CID 를 건드리는 작업은 slot 순서대로:
+//   RAW  뒤 작업이 앞 작업이 쓴 CID 를 읽음   → 앞 작업의 결과를 기다렸다가 메모리에서 바로 받음
+//   WAW  둘 다 같은 CID 를 씀                 → RAW 와 같음 (출력 CID 는 항상 입력이기도 함)
+//   WAR  입력 값은 schedule 시점에 정해지므로 (받은 암호문 또는 앞 작업의 결과) 기다릴 필요 없음
+// 서로 다른 CID 만 쓰는 작업은 독립이므로 바로 병렬 실행된다 (= 위상 정렬 웨이브를 장벽 없이 실행).
+//
+// 앞 작업의 결과는 게이트하우스 저장소를 거치지 않고 넘긴다. 결과 제출이 끝난 뒤 시작한 폴링 주기부터는
+// 게이트하우스가 최신 값을 주므로 그때 메모리 항목을 버린다 (beginCycle / endCycle).
+//
+// 폴링 주기를 넘는 순서는 게이트하우스가 지킨다 (services/queue/job-dag.ts 와 같은 RAW / WAW / WAR 규칙):
+//   - executor/jobs 는 선행 작업이 끝났거나 같은 응답의 앞쪽에 있는 작업만 준다 (응답의 앞부분은 의존성에 닫혀 있음)
+//   - claim 은 선행 작업이 아직 큐에 있거나 다른 실행기에 할당돼 있으면 409
+// 실행기는 claimInOrder 로 앞 작업의 claim 이 성공한 뒤에만 뒤 작업을 claim 한다.
+// 앞 작업을 못 가져가면 뒤 작업은 claim 하지 않고 큐에 남긴다 (앞 작업이 끝나면 다음 폴링에 나온다).
+
+class CidScheduler {
+  constructor() {
+    this.writer = new Map();    // cid → { value: Promise<data|null> } 마지막으로 쓰는 작업의 결과
+    this.inCycle = false;
+    this.deferred = [];         // 진행 중인 주기가 끝나면 버릴 항목
+  }
+
+  // 폴링 주기: fetch 시작 ~ 받은 작업 schedule 완료
+  beginCycle() {
+    this.inCycle = true;
+  }
+
+  endCycle() {
+    this.inCycle = false;
+    for (const [cid, entry] of this.deferred.splice(0)) this.drop(cid, entry);
+  }
+
+  drop(cid, entry) {
+    if (this.writer.get(cid) !== entry) return;   // 이미 뒤 작업이 덮어씀
+    this.writer.delete(cid);
+  }
+
+  /**
+   * 작업 하나 등록 (slot 순서대로 호출)
+   * @param {string[]} cids     입력 CID 핸들
+   * @param {number} outSlot    결과를 쓰는 입력 슬롯 (-1 = 상태 출력 없음)
+   * @returns {{ ready: Promise<(Array|null)[]>, deps: number, complete(value: Array|null): void, submitted(): void }}
+   *   ready      → 입력별 메모리 암호문 (앞 작업이 없으면 null = 받은 암호문 사용)
+   *   complete   → 계산 결과 (실패 시 null: 뒤 작업은 이전 값을 받음)
+   *   submitted  → 게이트하우스 제출 완료 (메모리 항목 정리)
+   */
+  schedule(cids, outSlot) {
+    const outCid = outSlot >= 0 && outSlot < cids.length ? cids[outSlot] : null;
+
+    const reads = cids.map((cid) => (this.writer.has(cid) ? this.writer.get(cid).value : null));
+    const deps = new Set(reads.filter(Boolean)).size;
+
+    let complete;
+    const computed = new Promise((resolve) => { complete = resolve; });
+
+    let entry = null;
+    if (outCid) {
+      const prev = this.writer.has(outCid) ? this.writer.get(outCid).value : Promise.resolve(null);
+      entry = { value: computed.then((v) => (v != null ? v : prev)) };
+      this.writer.set(outCid, entry);
+    }
+
+    return {
+      ready: Promise.all(reads),
+      deps,
+      complete: (value) => complete(value == null ? null : value),
+      submitted: () => {
+        if (!entry) return;
+        if (this.inCycle) this.deferred.push([outCid, entry]);
+        else this.drop(outCid, entry);
+      },
+    };
+  }
+}
+
+// 같은 배치 안에서 작업 i 보다 앞서야 하는 작업 (게이트하우스 job-dag 와 같은 규칙)
+function predecessors(jobs) {
+  const lastWriter = new Map();   // cid → 마지막으로 쓴 작업
+  const readers = new Map();      // cid → 그 뒤로 읽기만 한 작업
+  return jobs.map(({ cids, outSlot }, i) => {
+    const outCid = outSlot >= 0 && outSlot < cids.length ? cids[outSlot] : null;
+    const preds = new Set();
+    for (const cid of new Set(cids)) {
+      if (lastWriter.has(cid)) preds.add(lastWriter.get(cid));          // RAW / WAW
+      if (cid === outCid) {
+        for (const r of readers.get(cid) || []) preds.add(r);           // WAR
+        lastWriter.set(cid, i);
+        readers.set(cid, []);
+      } else {
+        if (!readers.has(cid)) readers.set(cid, []);
+        readers.get(cid).push(i);
+      }
+    }
+    return [...preds];
+  });
+}
+
+/**
+ * slot 순서의 작업을 claim. 독립인 작업은 동시에, 뒤 작업은 앞 작업의 claim 이 성공한 뒤에
+ * @param {{ cids: string[], outSlot: number }[]} jobs  slot 순서
+ * @param {(i: number) => Promise<any>} claim            게이트하우스 claim (성공이면 { success: true })
+ * @returns {Promise<{ claimed: boolean, result?: any, skipped?: boolean }[]>}
+ *   skipped = 앞 작업을 못 가져가서 claim 하지 않음 (큐에 남는다)
+ */
+async function claimInOrder(jobs, claim) {
+  const preds = predecessors(jobs);
+  const done = [];
+  preds.forEach((ps, i) => {
+    done[i] = Promise.all(ps.map((p) => done[p])).then(async (prev) => {
+      if (!prev.every((r) => r.claimed)) return { claimed: false, skipped: true };
+      try {
+        const result = await claim(i);
+        return { claimed: !!(result && result.success), result };
+      } catch (e) {
+        return { claimed: false, result: { error: e.message } };
+      }
+    });
+  });
+  return Promise.all(done);
+}
+
+module.exports = { CidScheduler, claimInOrder, predecessors };
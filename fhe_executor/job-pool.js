@@ -0,0 +1,90 @@
+// job-pool.js — 동시 작업 풀 + 지연시간 기반 허용 제어 (admission control)
+//
+// 폴링 1회에 여러 작업을 가져와 동시에 실행한다.
+//  - maxWorkers = floor(물리 코어 / 작업당 스레드) — 풀의 상한
+//  - limit      = 현재 허용 동시 작업 수 (1..maxWorkers). 연산당 실행 시간(ms/step) EWMA 로 조정
+//      (실행 시간 = 계획이 실제로 돈 시간. 애드온 / ffi 큐에서 기다린 시간은 빼고 잰다 —
+//       대기 시간을 넣으면 limit 를 올릴수록 대기가 늘어 스스로 줄어드는 되먹임이 생긴다)
+//      EWMA > target          → limit 를 줄임 (곱셈 감소, 과부하 시 빠르게 물러남)
+//      EWMA < target * 0.8    → 풀이 꽉 찬 상태였을 때만 limit + 1 (덧셈 증가)
+//  - capacity() = limit - active  → 다음 폴링에서 가져올 작업 수
+
+class JobPool {
+  /**
+   * @param {{ maxWorkers: number, targetOpMs: number, logger?: any }} opts
+   */
+  constructor({ maxWorkers, targetOpMs, logger = null }) {
+    this.maxWorkers = Math.max(1, maxWorkers | 0);
+    this.targetOpMs = targetOpMs;
+    this.logger = logger;
+    this.limit = this.maxWorkers;   // 처음엔 전부 허용, 지연시간을 보고 줄인다
+    this.active = 0;
+    this.ewmaOpMs = 0;
+    this.samples = 0;
+    this.completed = 0;
+    this.failed = 0;
+    this.slotWaiters = [];
+  }
+
+  capacity() {
+    return Math.max(0, this.limit - this.active);
+  }
+
+  // 실행 결과 관측: steps 개 연산을 실행하는 데 execMs 걸림 (큐 대기 제외, 동시 실행 중의 벽시계 시간)
+  observe(steps, execMs) {
+    if (!(steps > 0) || !(execMs >= 0) || !this.targetOpMs) return;
+    const opMs = execMs / steps;
+    this.ewmaOpMs = this.samples === 0 ? opMs : this.ewmaOpMs * 0.7 + opMs * 0.3;
+    this.samples++;
+
+    const prev = this.limit;
+    if (this.ewmaOpMs > this.targetOpMs && this.limit > 1) {
+      this.limit = Math.max(1, Math.floor(this.limit * 0.75));
+    } else if (this.ewmaOpMs < this.targetOpMs * 0.8 && this.active >= this.limit && this.limit < this.maxWorkers) {
+      this.limit++;
+    }
+    if (prev !== this.limit && this.logger) {
+      this.logger.info('Job:Pool', 'Admission limit changed', {
+        limit: `${prev} -> ${this.limit}`,
+        op_ms: Math.round(this.ewmaOpMs),
+        target_op_ms: this.targetOpMs
+      });
+    }
+  }
+
+  // 빈 슬롯이 생길 때까지 대기 (이미 있으면 즉시)
+  waitForSlot() {
+    if (this.capacity() > 0) return Promise.resolve();
+    return new Promise((resolve) => this.slotWaiters.push(resolve));
+  }
+
+  // fn 을 풀 슬롯 하나로 실행. 호출자는 capacity() 를 먼저 확인한다
+  async run(fn) {
+    this.active++;
+    try {
+      const r = await fn();
+      this.completed++;
+      return r;
+    } catch (e) {
+      this.failed++;
+      throw e;
+    } finally {
+      this.active--;
+      if (this.capacity() > 0) this.slotWaiters.splice(0).forEach((wake) => wake());
+    }
+  }
+
+  stats() {
+    return {
+      max_workers: this.maxWorkers,
+      limit: this.limit,
+      active: this.active,
+      op_ms: Math.round(this.ewmaOpMs),
+      target_op_ms: this.targetOpMs,
+      completed: this.completed,
+      failed: this.failed
+    };
+  }
+}
+
+module.exports = { JobPool };
@@ -0,0 +1,70 @@
+// long-poll.js — 게이트하우스 롱 폴링 (작업 / 복호화 작업 수신)
+//
+// 게이트하우스는 ?wait=ms 가 있으면 대기 중인 작업이 없을 때 요청을 최대 wait 동안 붙잡고 있다가
+// enqueue 즉시 응답한다. 실행기는 응답을 처리한 뒤 바로 다음 요청을 보낸다.
+//  - 게이트하우스가 꺼져 있으면 retryMs 후 재시도 (연결 상태가 바뀔 때만 로그)
+//  - wait 를 모르는 게이트하우스는 즉시 빈 응답 → 1 초 안에 빈 응답이 오면 retryMs 주기 폴링으로 후퇴
+//  - handle 실패는 로그만 남기고 루프를 계속한다
+
+const http = require('http');
+
+// GET 후 JSON 파싱. 롱 폴링 대기 시간 + 15 초 안에 응답이 없으면 실패
+function getJson(url, { agent = undefined, waitMs = 0 } = {}) {
+  return new Promise((resolve, reject) => {
+    const req = http.request(url, {
+      method: 'GET',
+      agent,
+      headers: { 'Content-Type': 'application/json' }
+    }, (res) => {
+      let data = '';
+      res.on('data', chunk => data += chunk);
+      res.on('end', () => {
+        try {
+          resolve(JSON.parse(data));
+        } catch (e) {
+          reject(e);
+        }
+      });
+    });
+    req.on('error', reject);
+    req.setTimeout(waitMs + 15000, () => req.destroy(new Error('Gatehouse request timed out')));
+    req.end();
+  });
+}
+
+/**
+ * fetchBatch(waitMs) 가 { jobs: [...] } 를 돌려줄 때마다 handle(jobs) 호출. stopped() 가 true 면 종료
+ * @param {{ tag: string, fetchBatch: (waitMs: number) => Promise<any>, handle: (jobs: any[]) => Promise<void>,
+ *           waitMs: number, retryMs: number, logger: any, stopped?: () => boolean }} opts
+ */
+async function longPollLoop({ tag, fetchBatch, handle, waitMs, retryMs, logger, stopped = () => false }) {
+  let connected = null;
+  while (!stopped()) {
+    const t0 = Date.now();
+    let jobs;
+    try {
+      const data = await fetchBatch(waitMs);
+      jobs = (data && data.jobs) || [];
+      if (connected !== true) logger.info(tag, 'Connected to gatehouse (long-poll)', { wait_ms: waitMs });
+      connected = true;
+    } catch (error) {
+      if (connected !== false) logger.warn(tag, 'Gatehouse unavailable, retrying', { error: error.message, retry_ms: retryMs });
+      connected = false;
+      await new Promise((r) => setTimeout(r, retryMs));
+      continue;
+    }
+
+    if (jobs.length > 0) {
+      try {
+        await handle(jobs);
+      } catch (error) {
+        logger.error(tag, 'Job handling failed', { error: error.message });
+      }
+    } else if (Date.now() - t0 < 1000) {
+      // 롱 폴링을 지원하지 않는 게이트하우스는 즉시 빈 응답 → 주기 폴링으로 후퇴
+      await new Promise((r) => setTimeout(r, retryMs));
+    }
+  }
+}
+
+module.exports = { getJson, longPollLoop };
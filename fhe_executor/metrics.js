@@ -0,0 +1,76 @@
+// metrics.js — Prometheus 텍스트 포맷 (/metrics)
+//
+// 라이브러리 함수별 카운터 (FHE16Async.opStats) + 애드온 실행 큐 + 작업 풀 + 결과 캐시.
+// 스크레이프마다 현재 값을 그대로 내보낸다 (카운터는 프로세스 시작 이후 누적).
+
+function escapeLabel(v) {
+  return String(v).replace(/\\/g, '\\\\').replace(/"/g, '\\"').replace(/\n/g, '\\n');
+}
+
+class MetricsWriter {
+  constructor() {
+    this.lines = [];
+  }
+
+  // samples: [[labels|null, value]]
+  metric(name, type, help, samples) {
+    this.lines.push(`# HELP ${name} ${help}`, `# TYPE ${name} ${type}`);
+    for (const [labels, value] of samples) {
+      if (value == null || Number.isNaN(value)) continue;
+      const l = labels
+        ? `{${Object.entries(labels).map(([k, v]) => `${k}="${escapeLabel(v)}"`).join(',')}}`
+        : '';
+      this.lines.push(`${name}${l} ${Number(value)}`);
+    }
+  }
+
+  text() {
+    return this.lines.join('\n') + '\n';
+  }
+}
+
+/**
+ * @param {object} src
+ * @param {Array}  src.opStats      FHE16Async.opStats()
+ * @param {object} src.addon        FHE16Async.stats()
+ * @param {object|null} src.jobPool     JobPool.stats()
+ * @param {object|null} src.resultCache ResultCache.stats()
+ * @param {number} src.uptime       초
+ */
+function renderMetrics(src) {
+  const m = new MetricsWriter();
+  const ops = src.opStats || [];
+  const per = (f) => ops.map((s) => [{ op: s.op }, f(s)]);
+
+  m.metric('fhe16_op_calls_total', 'counter', 'libFHE16 calls by function', per((s) => s.calls));
+  m.metric('fhe16_op_errors_total', 'counter', 'libFHE16 calls that threw or returned null', per((s) => s.errors));
+  m.metric('fhe16_op_seconds_total', 'counter', 'Wall time spent in libFHE16 calls', per((s) => s.totalMs / 1e3));
+  m.metric('fhe16_op_max_seconds', 'gauge', 'Longest single libFHE16 call', per((s) => s.maxMs / 1e3));
+  m.metric('fhe16_op_bootstraps_estimated_total', 'counter', 'Bootstraps estimated from the gate-count model', per((s) => s.bootstraps));
+
+  const a = src.addon || {};
+  m.metric('fhe16_native_max_concurrency', 'gauge', 'Concurrent native calls allowed', [[null, a.maxConcurrency]]);
+  m.metric('fhe16_native_running', 'gauge', 'Native calls running', [[null, a.running]]);
+  m.metric('fhe16_native_queued', 'gauge', 'Native calls waiting for a slot', [[null, a.queued]]);
+
+  const p = src.jobPool;
+  if (p) {
+    m.metric('executor_jobs_active', 'gauge', 'Jobs running in the pool', [[null, p.active]]);
+    m.metric('executor_jobs_limit', 'gauge', 'Admitted job limit (admission control)', [[null, p.limit]]);
+    m.metric('executor_jobs_completed_total', 'counter', 'Jobs completed', [[null, p.completed]]);
+    m.metric('executor_jobs_failed_total', 'counter', 'Jobs failed', [[null, p.failed]]);
+    m.metric('executor_plan_step_ms', 'gauge', 'EWMA of ms per plan step', [[null, p.op_ms]]);
+  }
+
+  const c = src.resultCache;
+  if (c) {
+    m.metric('executor_result_cache_hits_total', 'counter', 'Result cache hits', [[null, c.hits]]);
+    m.metric('executor_result_cache_misses_total', 'counter', 'Result cache misses', [[null, c.misses]]);
+    m.metric('executor_result_cache_bytes', 'gauge', 'Result cache size', [[null, c.bytes]]);
+  }
+
+  m.metric('executor_uptime_seconds', 'gauge', 'Process uptime', [[null, src.uptime]]);
+  return m.text();
+}
+
+module.exports = { renderMetrics };
@@ -0,0 +1,174 @@
+// result-cache.js — 결정적 작업의 결과 메모이제이션 (내용 주소 기반, 디스크 + LRU)
+//
+// FHE 작업은 (실행 계획, 파라미터, 입력 암호문) 의 순수 함수이므로 같은 입력이면 같은 결과를 재사용한다.
+// (재제출, claim 타임아웃 후 재시도, challenge 재실행)
+//  - 키   = sha256(키 형식 ‖ ir_digest ‖ 버전 ‖ 입력 개수 ‖ 입력별 길이 ‖ 입력 바이트)
+//    버전 = 호출자가 주는 실행 계획 / 파라미터 식별자. 레지스트리의 계획이나 최적화 여부가 바뀌면 다른 키
+//  - 저장 = <dir>/<키 앞 2자>/<키>.ct : 'FRC1' + 워드 수 + int32 LE 결과 암호문
+//  - 인덱스는 메모리 Map (삽입 순서 = LRU 순서). 시작 시 디렉터리를 mtime 순으로 읽어 복원
+//  - 적중 시 mtime 을 갱신해 재시작 후에도 LRU 순서 유지. 용량 초과 시 가장 오래된 것부터 삭제
+
+const crypto = require('crypto');
+const fs = require('fs');
+const path = require('path');
+
+const MAGIC = 0x31435246; // 'FRC1'
+const HEADER_BYTES = 8;
+const KEY_FORMAT = 'FRC-key-2';
+let tmpSeq = 0;
+
+class ResultCache {
+  /**
+   * @param {{ dir: string, maxBytes: number, logger?: any }} opts
+   */
+  constructor({ dir, maxBytes, logger = null }) {
+    this.dir = dir;
+    this.maxBytes = maxBytes;
+    this.logger = logger;
+    this.index = new Map();   // key → bytes (LRU: 앞쪽이 가장 오래됨)
+    this.writing = new Map(); // key → 진행 중인 put (같은 키는 한 번만 쓴다)
+    this.bytes = 0;
+    this.hits = 0;
+    this.misses = 0;
+  }
+
+  // 디렉터리를 읽어 인덱스 복원 (오래된 것부터)
+  load() {
+    fs.mkdirSync(this.dir, { recursive: true });
+    const entries = [];
+    for (const sub of fs.readdirSync(this.dir)) {
+      const subDir = path.join(this.dir, sub);
+      if (!fs.statSync(subDir).isDirectory()) continue;
+      for (const name of fs.readdirSync(subDir)) {
+        if (!name.endsWith('.ct')) continue;   // 쓰다 만 .tmp 는 무시
+        const st = fs.statSync(path.join(subDir, name));
+        entries.push({ key: name.slice(0, -3), bytes: st.size, mtime: st.mtimeMs });
+      }
+    }
+    entries.sort((a, b) => a.mtime - b.mtime);
+    for (const e of entries) {
+      this.index.set(e.key, e.bytes);
+      this.bytes += e.bytes;
+    }
+    this.evict();
+    return this.index.size;
+  }
+
+  /**
+   * @param {string} irDigest
+   * @param {Buffer[]} inputs  입력 암호문 (int32 LE)
+   * @param {string} [version] 실행 계획 / 파라미터 식별자
+   */
+  static key(irDigest, inputs, version = '') {
+    const h = crypto.createHash('sha256');
+    const len = Buffer.alloc(4);
+    for (const part of [KEY_FORMAT, String(irDigest), String(version)]) {
+      const b = Buffer.from(part);
+      len.writeUInt32LE(b.length);
+      h.update(len);
+      h.update(b);
+    }
+    len.writeUInt32LE(inputs.length);
+    h.update(len);
+    for (const ct of inputs) {
+      len.writeUInt32LE(ct.length);
+      h.update(len);
+      h.update(ct);
+    }
+    return h.digest('hex');
+  }
+
+  fileOf(key) {
+    return path.join(this.dir, key.slice(0, 2), `${key}.ct`);
+  }
+
+  // 적중하면 결과 암호문 Buffer (int32 LE), 아니면 null
+  async get(key) {
+    if (!this.index.has(key)) {
+      this.misses++;
+      return null;
+    }
+    const file = this.fileOf(key);
+    try {
+      const buf = await fs.promises.readFile(file);
+      if (buf.length < HEADER_BYTES || buf.readUInt32LE(0) !== MAGIC ||
+          buf.length !== HEADER_BYTES + buf.readUInt32LE(4) * 4) {
+        throw new Error('corrupt cache entry');
+      }
+      // LRU 갱신 (메모리 + mtime)
+      const bytes = this.index.get(key);
+      this.index.delete(key);
+      this.index.set(key, bytes);
+      const now = new Date();
+      fs.promises.utimes(file, now, now).catch(() => {});
+      this.hits++;
+      return buf.subarray(HEADER_BYTES);
+    } catch (e) {
+      this.drop(key);
+      this.misses++;
+      if (this.logger) this.logger.warn('Cache:Result', 'Dropped unreadable entry', { key: key.slice(0, 12), error: e.message });
+      return null;
+    }
+  }
+
+  // 결과 암호문 저장 (임시 파일 → rename 으로 원자적).
+  // 같은 키의 put 이 겹치면 먼저 시작한 것만 쓰고 나머지는 그것을 기다린다 (결과가 같으므로).
+  // 겹친 쓰기를 모두 rename 하면 rename 순서와 인덱스 갱신 순서가 달라 디스크 크기와 bytes 가 어긋날 수 있다
+  put(key, ct) {
+    if (this.index.has(key)) return Promise.resolve();
+    let p = this.writing.get(key);
+    if (!p) {
+      p = this.write(key, ct).finally(() => this.writing.delete(key));
+      this.writing.set(key, p);
+    }
+    return p;
+  }
+
+  async write(key, ct) {
+    const file = this.fileOf(key);
+    const tmp = `${file}.${process.pid}.${++tmpSeq}.tmp`;
+    const header = Buffer.alloc(HEADER_BYTES);
+    header.writeUInt32LE(MAGIC, 0);
+    header.writeUInt32LE(ct.length >> 2, 4);
+    try {
+      await fs.promises.mkdir(path.dirname(file), { recursive: true });
+      await fs.promises.writeFile(tmp, Buffer.concat([header, ct]));
+      await fs.promises.rename(tmp, file);
+    } catch (e) {
+      fs.promises.unlink(tmp).catch(() => {});
+      if (this.logger) this.logger.warn('Cache:Result', 'Failed to store entry', { error: e.message });
+      return;
+    }
+    const bytes = HEADER_BYTES + ct.length;
+    this.index.set(key, bytes);
+    this.bytes += bytes;
+    this.evict();
+  }
+
+  drop(key) {
+    const bytes = this.index.get(key);
+    if (bytes === undefined) return;
+    this.index.delete(key);
+    this.bytes -= bytes;
+    fs.promises.unlink(this.fileOf(key)).catch(() => {});
+  }
+
+  evict() {
+    for (const key of this.index.keys()) {
+      if (this.bytes <= this.maxBytes) break;
+      this.drop(key);
+    }
+  }
+
+  stats() {
+    return {
+      entries: this.index.size,
+      bytes: this.bytes,
+      max_bytes: this.maxBytes,
+      hits: this.hits,
+      misses: this.misses
+    };
+  }
+}
+
+module.exports = { ResultCache };
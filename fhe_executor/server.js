@@ -1,14 +1,46 @@
 /* eslint-disable no-console */
 const http = require('http');
+const crypto = require('crypto');
 const path = require('path');
-const { FHE16 } = require('./FHE16/index.js');
+const { FHE16, FHE16Async } = require('./FHE16/index.js');
+const { JobPool } = require('./job-pool.js');
+const { ResultCache } = require('./result-cache.js');
+const { CidScheduler, claimInOrder } = require('./batch-dag.js');
+const { renderMetrics } = require('./metrics.js');
+const { getJson, longPollLoop } = require('./long-poll.js');
+const { loadBootProfile } = require('./FHE16/boot-profile.js');
 
 const EXECUTOR_PORT = 3001;
 const GATEHOUSE_URL = 'http://localhost:3000';
 const EXECUTOR_ID = `FHE_Executor_${Date.now()}`;
-const POLL_INTERVAL = 5000; // 5 seconds
-
-let isProcessing = false;
+const POLL_INTERVAL = 5000; // 5 seconds (retry delay when the gatehouse is unreachable)
+// 롱 폴링: 작업이 없으면 게이트하우스가 요청을 최대 LONG_POLL_MS 동안 붙잡고 있다가 enqueue 즉시 응답
+const LONG_POLL_MS = parseInt(process.env.EXECUTOR_LONG_POLL_MS || '30000', 10);
+
+// 게이트하우스 연결 재사용 (롱 폴링 + claim/result 요청이 같은 소켓을 사용)
+const gatehouseAgent = new http.Agent({ keepAlive: true, maxSockets: 16 });
+
+// 복호화 배치: 한 주기에 대기 중인 복호화 작업을 최대 DECRYPT_BATCH 개까지 받아 한 번에 복호화
+// FHE16_DEC_THREADS = 배치 복호화 스레드 수 (기본 1, 작업 풀과 코어를 나눠 씀)
+const DECRYPT_BATCH = parseInt(process.env.FHE_DECRYPT_BATCH || '1024', 10);
+const DEC_THREADS = parseInt(process.env.FHE16_DEC_THREADS || '1', 10);
+
+// 동시 작업 풀: 네이티브 동시 호출 수(FHE16_MAX_CONCURRENCY, 기본 1) 이하에서 작업당 스레드 수
+// (FHE16_THREADS_PER_JOB, 기본 = FHE16_PLAN_PARALLEL)와 물리 코어 수로 크기 결정. FHE16_MAX_JOBS 로 직접 지정 가능. FHE16_TARGET_OP_MS = 연산(계획 단계)당 목표 지연시간, 0 이면 허용 제어 끔
+// FHE16_BOOT_PROFILE=1 이고 환경 변수가 없으면 키 팩 옆의 boot_profile.json (FHE16/boot-tune.js 보정 결과) 을 쓴다
+// (계획 병렬 / 동시 작업을 켜므로 동시 호출에 안전한 libFHE16 빌드 전용, 기본은 읽기만 하고 적용하지 않음)
+const TARGET_OP_MS = parseInt(process.env.FHE16_TARGET_OP_MS || '1500', 10);
+let jobPool = null;
+
+// 결과 메모이제이션: (ir_digest, 실행 계획 / 파라미터, 입력 암호문) → 결과 암호문. FHE_RESULT_CACHE_MB=0 이면 끔
+const RESULT_CACHE_MB = parseInt(process.env.FHE_RESULT_CACHE_MB || '512', 10);
+const RESULT_CACHE_DIR = process.env.FHE_RESULT_CACHE_DIR || path.join(__dirname, 'cache', 'results');
+let resultCache = null;
+
+// /trace?ms=N : N ms 동안 라이브러리 호출을 Chrome trace 로 기록 (최대 TRACE_MAX_MS, span FHE16_TRACE_BUFFER 개)
+const TRACE_BUFFER = parseInt(process.env.FHE16_TRACE_BUFFER || '65536', 10);
+const TRACE_MAX_MS = 60000;
+let traceBusy = false;
 
 // Logger utility with colors
 class Logger {
@@ -72,10 +104,24 @@ class Logger {
 
 const logger = new Logger();
 
+// FHE16_PARAMS: 파라미터 세트 이름 (FHE16Async.paramSets) 또는 FHE16/param-search.js --out 으로 쓴 JSON 파일.
+// GenEval 전에 골라야 하고, 키 팩(bootparam.bin)은 같은 세트로 만든 것이어야 한다
+function selectFHE16Params(spec) {
+  let params = spec;
+  if (spec.endsWith('.json')) {
+    const body = JSON.parse(require('fs').readFileSync(spec, 'utf8'));
+    params = body.params || body;
+  }
+  const cur = FHE16Async.selectParams(params);
+  logger.info('FHE:Init', 'Parameter set', { name: cur.name, n_lwe: cur.n_lwe, q_lwe: cur.q_lwe, n_bk: cur.n_bk });
+}
+
 // Initialize FHE16
 async function initFHE16() {
   try {
     logger.info('FHE:Init', 'Initializing FHE16...');
+
+    if (process.env.FHE16_PARAMS) selectFHE16Params(process.env.FHE16_PARAMS);
     
     const skInitPtr = FHE16.FHE16_GenEval();
     if (!skInitPtr) {
@@ -90,7 +136,62 @@ async function initFHE16() {
     }
 
     await loadSecretKey();
+
+    // 네이티브 동시 호출 수: 기본 1. 배포된 libFHE16 은 부트스트랩 / 키 스위칭 스크래치 버퍼를
+    // 호출 스레드가 올라간 CPU(get_core_id) 로 골라서, 고정되지 않은 스레드 둘이 같은 버퍼를 쓸 수 있다.
+    // 동시 호출에 안전한 빌드에서만 FHE16_MAX_CONCURRENCY 로 늘린다
+    const nativeConcurrency = Math.max(1, parseInt(process.env.FHE16_MAX_CONCURRENCY || '1', 10) || 1);
+    FHE16Async.setMaxConcurrency(nativeConcurrency);
+
+    const cores = FHE16Async.physicalCores();
+    const backend = FHE16Async.native ? 'napi-addon' : 'ffi-async';
+    const { profile, reason, path: profilePath } = loadBootProfile(bootPath, { cores, backend });
+    const useProfile = !!profile && process.env.FHE16_BOOT_PROFILE === '1';
+    if (profile) {
+      // 프로필의 계획 스레드 수도 네이티브 동시 호출 수를 넘지 않는다 (넘는 스레드는 라이브러리 슬롯만 기다린다)
+      if (useProfile && process.env.FHE16_PLAN_PARALLEL === undefined) {
+        planParallel = Math.min(profile.batch.parallel, nativeConcurrency);
+        planParallelAlone = Math.min(profile.gate.parallel, nativeConcurrency);
+      }
+      logger.info('FHE:Init', useProfile ? 'Boot profile' : 'Boot profile not applied (set FHE16_BOOT_PROFILE=1)', {
+        gate_parallel: profile.gate.parallel,
+        batch: `${profile.batch.parallel} x ${profile.batch.concurrency}`,
+        max_concurrency: nativeConcurrency
+      });
+    } else if (reason) {
+      logger.warn('FHE:Init', 'Boot profile ignored (re-run FHE16/boot-tune.js)', { path: profilePath, reason });
+    }
+
+    // 동시 작업 수는 네이티브 동시 호출 수를 넘지 않는다. 넘는 작업은 애드온 큐에서 기다리는 동안
+    // 게이트하우스 claim 만 잡고 있어 다른 실행기가 가져갈 수 없다 (FHE16_MAX_JOBS 로 직접 지정하면 그 값)
+    const threadsPerJob = Math.max(1, parseInt(process.env.FHE16_THREADS_PER_JOB || String(planParallel), 10));
+    const coreJobs = (useProfile && !process.env.FHE16_THREADS_PER_JOB && process.env.FHE16_PLAN_PARALLEL === undefined)
+      ? profile.batch.concurrency
+      : Math.max(1, Math.floor(cores / threadsPerJob));
+    const maxJobs = process.env.FHE16_MAX_JOBS
+      ? parseInt(process.env.FHE16_MAX_JOBS, 10)
+      : Math.min(nativeConcurrency, coreJobs);
+    jobPool = new JobPool({ maxWorkers: maxJobs, targetOpMs: TARGET_OP_MS, logger });
+    logger.info('FHE:Init', 'Async backend', {
+      backend: FHE16Async.native ? 'napi-addon' : 'ffi-async',
+      max_concurrency: FHE16Async.stats().maxConcurrency,
+      physical_cores: cores,
+      threads_per_job: threadsPerJob,
+      max_jobs: jobPool.maxWorkers,
+      target_op_ms: TARGET_OP_MS
+    });
     
+    if (RESULT_CACHE_MB > 0) {
+      try {
+        resultCache = new ResultCache({ dir: RESULT_CACHE_DIR, maxBytes: RESULT_CACHE_MB * 1024 * 1024, logger });
+        const entries = resultCache.load();
+        logger.info('FHE:Init', 'Result cache', { dir: RESULT_CACHE_DIR, entries, max_mb: RESULT_CACHE_MB });
+      } catch (e) {
+        resultCache = null;
+        logger.warn('FHE:Init', 'Result cache disabled', { error: e.message });
+      }
+    }
+
     logger.info('FHE:Init', 'Initialization complete');
     return true;
   } catch (e) {
@@ -100,26 +201,9 @@ async function initFHE16() {
 }
 
 // Fetch jobs from gatehouse
-async function fetchJobs() {
-  return new Promise((resolve, reject) => {
-    const req = http.request(`${GATEHOUSE_URL}/api/executor/jobs?limit=1`, {
-      method: 'GET',
-      headers: { 'Content-Type': 'application/json' }
-    }, (res) => {
-      let data = '';
-      res.on('data', chunk => data += chunk);
-      res.on('end', () => {
-        try {
-          const result = JSON.parse(data);
-          resolve(result);
-        } catch (e) {
-          reject(e);
-        }
-      });
-    });
-    req.on('error', reject);
-    req.end();
-  });
+// waitMs > 0 이면 롱 폴링 (작업이 들어올 때까지 게이트하우스가 응답을 미룸)
+async function fetchJobs(limit = 1, waitMs = 0) {
+  return getJson(`${GATEHOUSE_URL}/api/executor/jobs?limit=${limit}&wait=${waitMs}`, { agent: gatehouseAgent, waitMs });
 }
 
 // Claim a job
@@ -128,6 +212,7 @@ async function claimJob(jobPda) {
     const postData = JSON.stringify({ executor: EXECUTOR_ID });
     const req = http.request(`${GATEHOUSE_URL}/api/executor/jobs/${jobPda}/claim`, {
       method: 'POST',
+      agent: gatehouseAgent,
       headers: {
         'Content-Type': 'application/json',
         'Content-Length': Buffer.byteLength(postData)
@@ -170,6 +255,7 @@ async function submitResult(jobPda, success, resultCiphertext = null, error = nu
     const postData = JSON.stringify(payload);
     const req = http.request(`${GATEHOUSE_URL}/api/executor/jobs/${jobPda}/result`, {
       method: 'POST',
+      agent: gatehouseAgent,
       headers: {
         'Content-Type': 'application/json',
         'Content-Length': Buffer.byteLength(postData)
@@ -214,6 +300,7 @@ const FHE_OPERATION_REGISTRY = {
     name: 'binary_add',
     description: 'Basic addition: output = input[0] + input[1]',
     input_slots: 2,
+    output_slot: 0,   // 결과가 덮어쓰는 입력 CID (게이트하우스 services/queue/output-handle.ts 와 동일)
     operations: ['add'],
     execution_plan: [
       { op: 'add', inputs: [0, 1], output: 'result' }
@@ -225,6 +312,7 @@ const FHE_OPERATION_REGISTRY = {
     name: 'defi_operation',
     description: 'DeFi operation: borrow/withdraw with collateral checks',
     input_slots: 3,
+    output_slot: { 2: 0, 3: 2 },   // 입력 개수별 (withdraw / borrow)
     operations: ['smull_constant', 'ge', 'add', 'sub', 'select'],
     execution_plan: [
       // Dynamic execution based on input count
@@ -236,6 +324,7 @@ const FHE_OPERATION_REGISTRY = {
     name: 'withdraw_with_check',
     description: 'Withdraw: Check balance >= amount, then subtract',
     input_slots: 2,
+    output_slot: 0,
     operations: ['ge', 'sub', 'select'],
     execution_plan: [
       // Inputs: [0]=USDC_balance, [1]=withdraw_amount
@@ -249,6 +338,7 @@ const FHE_OPERATION_REGISTRY = {
     name: 'complex_borrow_check',
     description: 'Multi-step: collateral check with balance update',
     input_slots: 3,
+    output_slot: 2,
     operations: ['smull_constant', 'ge', 'add', 'select'],
     execution_plan: [
       // Inputs: [0]=SOL_balance, [1]=borrow_amount, [2]=USDC_balance
@@ -272,6 +362,16 @@ const FHE_OPERATION_REGISTRY = {
   }
 };
 
+// 작업 결과가 덮어쓰는 입력 슬롯 (-1 = 상태 출력 없음)
+function outputSlotOf(job) {
+  const operation = FHE_OPERATION_REGISTRY[job.ir_digest];
+  const slot = operation ? operation.output_slot : undefined;
+  const inputCount = (job.ciphertexts || []).length;
+  if (typeof slot === 'number') return slot;
+  if (slot && slot[inputCount] !== undefined) return slot[inputCount];
+  return -1;
+}
+
 // Execute FHE computation based on IR digest
 async function executeFHEComputation(job) {
   const startTime = Date.now();
@@ -334,7 +434,7 @@ async function executeFHEComputation(job) {
     logger.debug('FHE:Computation', 'Inputs extracted, starting computation', { count: inputData.length });
 
     // Execute FHE computation
-    const result = await executeUniversalFHEComputation(operation, inputData);
+    const result = await executeUniversalFHEComputation(operation, inputData, irDigest);
 
     // Generate deterministic result CID
     const resultCiphertext = generateDeterministicResult(result, job, operation, inputCiphertexts.length);
@@ -368,135 +468,109 @@ async function executeFHEComputation(job) {
   }
 }
 
-// FHE computation executor
-async function executeUniversalFHEComputation(operation, inputData) {
-  try {
-    // Convert all input data to FHE16 Int32Ptr format
-    const inputPtrs = [];
-    for (let i = 0; i < inputData.length; i++) {
-        const ptr = convertJSONToInt32Ptr(inputData[i]);
-      inputPtrs.push(ptr);
-    }
+// 'dynamic' DeFi 연산을 입력 개수에 맞는 명시적 계획으로 전개
+function resolveExecutionPlan(operation, inputCount) {
+  if (!operation.execution_plan.some(step => step.op === 'dynamic')) return operation.execution_plan;
+  if (inputCount === 2) {
+    // 2 inputs: Simple withdraw check (balance >= amount, then subtract)
+    // WORKAROUND: Use NEG + ADD instead of SUB to avoid FHE16 SUB bug
+    return [
+      { op: 'ge', inputs: [0, 1], output: 'check' },               // balance >= amount
+      { op: 'neg', inputs: [1], output: 'neg_amount' },            // -amount
+      { op: 'add', inputs: [0, 'neg_amount'], output: 'sub' },     // balance + (-amount)
+      { op: 'select', inputs: ['check', 'sub', 0], output: 'result' }
+    ];
+  }
+  if (inputCount === 3) {
+    // 3 inputs: Complex borrow (collateral check + balance update)
+    return [
+      { op: 'smull_constant', inputs: [1], constant: 2, output: 'collateral_check' }, // borrow_amount * 2
+      { op: 'ge', inputs: [0, 'collateral_check'], output: 'sufficient' },             // SOL >= (borrow * 2)
+      { op: 'add', inputs: [2, 1], output: 'new_balance' },                            // USDC + borrow_amount
+      { op: 'select', inputs: ['sufficient', 'new_balance', 2], output: 'result' }
+    ];
+  }
+  throw new Error(`Dynamic operation supports 2-3 inputs, got ${inputCount}`);
+}
 
-    // Storage for intermediate values and results
-    const computeStack = {};
-    
-    // Initialize input variables in compute stack
-    for (let i = 0; i < inputPtrs.length; i++) {
-      computeStack[i] = inputPtrs[i];
+// 직렬화된 계획 캐시 (operation 이름 + 입력 개수)
+// 처음 만들 때 1회 최적화 (CSE / 상수 접기 / 비교+선택 → MAX/MIN / DCE). 기본은 끔, FHE16_PLAN_OPTIMIZE=1 이면 사용
+const PLAN_OPTIMIZE = process.env.FHE16_PLAN_OPTIMIZE === '1';
+const encodedPlanCache = new Map();
+function getEncodedPlan(operation, inputCount) {
+  const key = `${operation.name}/${inputCount}`;
+  let plan = encodedPlanCache.get(key);
+  if (!plan) {
+    plan = FHE16Async.encodePlan(resolveExecutionPlan(operation, inputCount), inputCount, ['result']);
+    if (PLAN_OPTIMIZE) {
+      plan = FHE16Async.optimizePlan(plan);
+      if (plan.report) {
+        logger.info('FHE:Plan', 'Plan optimized', {
+          operation: key,
+          steps: `${plan.report.stepsBefore} -> ${plan.report.stepsAfter}`,
+          est_bootstraps: `${plan.report.bootstrapsBefore} -> ${plan.report.bootstrapsAfter}`,
+          folded: plan.report.folded,
+          strength_reduced: plan.report.strengthReduced,
+          fused: plan.report.fused,
+          xor_fused: plan.report.xorFused,
+          cse: plan.report.cse,
+          dead: plan.report.dead
+        });
+      }
     }
+    // 결과 캐시 버전: 실제로 실행할 계획 워드 + 파라미터 세트 (레지스트리 / 최적화가 바뀌면 다른 키)
+    plan.cacheVersion = crypto.createHash('sha256')
+      .update(Buffer.from(plan.words.buffer, plan.words.byteOffset, plan.words.byteLength))
+      .update(JSON.stringify(FHE16Async.currentParams()))
+      .digest('hex');
+    encodedPlanCache.set(key, plan);
+  }
+  return plan;
+}
 
-    
-    // Execute each step in the execution plan
-    for (let stepIndex = 0; stepIndex < operation.execution_plan.length; stepIndex++) {
-      const step = operation.execution_plan[stepIndex];
+// 계획 스레드 수. 보정 프로필이 있으면 혼자 돌 때(planParallelAlone)와 동시에 돌 때를 나눠 쓴다
+let planParallel = parseInt(process.env.FHE16_PLAN_PARALLEL || '1', 10);
+let planParallelAlone = planParallel;
 
-      let resultPtr;
-      
-      // Execute the FHE operation based on type
-      switch (step.op) {
-        case 'dynamic':
-          // Handle dynamic DeFi operations based on input count
-          if (inputPtrs.length === 2) {
-            // 2 inputs: Simple withdraw check (balance >= amount, then subtract)
-            logger.debug('FHE:Operation', 'Executing dynamic withdraw operation', { inputs: 2 });
-            const checkPtr = FHE16.ge(computeStack[0], computeStack[1]); // balance >= amount
-            
-            // WORKAROUND: Use NEG + ADD instead of SUB to avoid FHE16 SUB bug
-            const negAmountPtr = FHE16.neg(computeStack[1]);              // -amount
-            const subPtr = FHE16.add(computeStack[0], negAmountPtr);      // balance + (-amount) = balance - amount
-            
-            resultPtr = FHE16.select(checkPtr, subPtr, computeStack[0]);  // if sufficient then subtract, else keep original
-          } else if (inputPtrs.length === 3) {
-            // 3 inputs: Complex borrow (collateral check + balance update)
-            logger.debug('FHE:Operation', 'Executing dynamic borrow operation', { inputs: 3 });
-            const collateralCheck = FHE16.smullConst_i32(computeStack[1], 2); // borrow_amount * 2
-            const sufficientCollateral = FHE16.ge(computeStack[0], collateralCheck); // SOL >= (borrow * 2)
-            const newBalance = FHE16.add(computeStack[2], computeStack[1]); // USDC + borrow_amount
-            resultPtr = FHE16.select(sufficientCollateral, newBalance, computeStack[2]); // if sufficient then add, else keep original
-          } else {
-            throw new Error(`Dynamic operation supports 2-3 inputs, got ${inputPtrs.length}`);
-          }
-          break;
-          
-        case 'add':
-          const [addInput1, addInput2] = step.inputs.map(input => 
-            typeof input === 'number' ? computeStack[input] : computeStack[input]
-          );
-          resultPtr = FHE16.add(addInput1, addInput2);
-          break;
-        
-        case 'sub':
-          const [subInput1, subInput2] = step.inputs.map(input => 
-            typeof input === 'number' ? computeStack[input] : computeStack[input]
-          );
-          resultPtr = FHE16.sub(subInput1, subInput2);
-          break;
-          
-        case 'ge':
-          const [geInput1, geInput2] = step.inputs.map(input => 
-            typeof input === 'number' ? computeStack[input] : computeStack[input]
-          );
-          resultPtr = FHE16.ge(geInput1, geInput2);
-          break;
-          
-        case 'smull':
-          const [mulInput1, mulInput2] = step.inputs.map(input => 
-            typeof input === 'number' ? computeStack[input] : computeStack[input]
-          );
-          resultPtr = FHE16.smull(mulInput1, mulInput2);
-          break;
-          
-        case 'smull_constant':
-          const mulConstInput = typeof step.inputs[0] === 'number' ? 
-            computeStack[step.inputs[0]] : computeStack[step.inputs[0]];
-          const constant = step.constant || 1;
-          resultPtr = FHE16.smullConst_i32(mulConstInput, constant);
-          break;
-          
-        case 'gt':
-          const [gtInput1, gtInput2] = step.inputs.map(input => 
-            typeof input === 'number' ? computeStack[input] : computeStack[input]
-          );
-          resultPtr = FHE16.gt(gtInput1, gtInput2);
-          break;
-          
-        case 'select':
-          const [condition, trueVal, falseVal] = step.inputs.map(input => 
-            typeof input === 'number' ? computeStack[input] : computeStack[input]
-          );
-          resultPtr = FHE16.select(condition, trueVal, falseVal);
-          break;
-          
-        default:
-          throw new Error(`Unsupported FHE operation: ${step.op}`);
-      }
+// FHE computation executor
+// 계획 전체를 FHE16Async.runPlan 한 번으로 실행 (네이티브: 작업당 FFI 1회, 중간 암호문은 마지막 사용 후 해제)
+async function executeUniversalFHEComputation(operation, inputData, irDigest = null) {
+  try {
+    // Convert all input data to ciphertext Buffers
+    const inputPtrs = inputData.map(convertJSONToCtBuffer);
 
-      // Store result in compute stack
-      computeStack[step.output] = resultPtr;
-    }
+    // 같은 (ir_digest, 실행 계획, 파라미터, 입력) 이면 저장된 결과 재사용 (부트스트랩 없이 디스크 I/O 만)
+    const plan = getEncodedPlan(operation, inputPtrs.length);
+    const cacheKey = resultCache && irDigest ? ResultCache.key(irDigest, inputPtrs, plan.cacheVersion) : null;
+    let finalResult = cacheKey ? await resultCache.get(cacheKey) : null;
 
-    // Return the final result
-    const finalResult = computeStack['result'];
-    if (!finalResult) {
-      throw new Error('Execution plan did not produce a result');
-    }
+    if (finalResult) {
+      logger.info('Cache:Result', 'Result cache hit', { operation: operation.name, key: cacheKey.slice(0, 12) });
+    } else {
+      const parallel = jobPool && jobPool.active <= 1 ? planParallelAlone : planParallel;
+      const { outputs, stats } = await FHE16Async.runPlan(plan, inputPtrs, { parallel });
+      logger.debug('FHE:Plan', 'Plan executed', {
+        steps: stats.steps,
+        max_live: stats.maxLive,
+        time_ms: Math.round(stats.elapsedUs / 1000)
+      });
+      if (jobPool) jobPool.observe(stats.steps, stats.execUs / 1000);
 
-    // Convert result Int32Ptr back to JSON array format
-    const ref = require('ref-napi');
-    const resultLength = 16 + 1040 * 32;
-    const resultBuffer = ref.reinterpret(finalResult, resultLength * 4, 0);
-    const resultArray = [];
-    
-    for (let i = 0; i < resultLength; i++) {
-      resultArray.push(resultBuffer.readInt32LE(i * 4));
+      finalResult = outputs[0];
+      if (!finalResult) {
+        throw new Error('Execution plan did not produce a result');
+      }
+      if (cacheKey) resultCache.put(cacheKey, finalResult);   // 응답을 기다리게 하지 않음
     }
 
+    // Convert result Buffer back to JSON array format
+    const resultArray = FHE16Async.toArray(finalResult);
+
     // DEMO ONLY: Decrypt result for debugging (visualization purposes only)
     let decryptedResult = null;
     if (secretKey) {
       try {
-        decryptedResult = FHE16.decInt(finalResult, secretKey);
+        decryptedResult = await FHE16Async.decInt(finalResult, secretKey);
         logger.demo('FHE:Demo', `DECRYPTED RESULT >>> \x1b[1m\x1b[33m${decryptedResult}\x1b[0m\x1b[31m <<< (Demo visualization only)`);
       } catch (decError) {
         logger.warn('FHE:Debug', 'Decryption failed', { error: decError.message });
@@ -554,6 +628,15 @@ function extractCiphertextDataFromJob(cid1, cid2) {
   return { ct1Data, ct2Data };
 }
 
+// Convert JSON ciphertext data to a ciphertext Buffer (FHE16Async 입력, 라이브러리 호출 없음)
+function convertJSONToCtBuffer(ciphertextArray) {
+  const expectedLength = FHE16Async.CT_WORDS;
+  if (!ciphertextArray || ciphertextArray.length !== expectedLength) {
+    throw new Error(`Invalid ciphertext length: expected ${expectedLength}, got ${ciphertextArray?.length || 0}`);
+  }
+  return FHE16Async.fromArray(ciphertextArray);
+}
+
 // Convert JSON ciphertext data to FHE16 Int32Ptr
 function convertJSONToInt32Ptr(ciphertextArray) {
   try {
@@ -710,26 +793,8 @@ function generateDeterministicCID(jobPda, operations) {
 }
 
 // Fetch decrypt jobs from gatehouse
-async function fetchDecryptJobs() {
-  return new Promise((resolve, reject) => {
-    const req = http.request(`${GATEHOUSE_URL}/api/executor/decrypt-jobs?limit=1`, {
-      method: 'GET',
-      headers: { 'Content-Type': 'application/json' }
-    }, (res) => {
-      let data = '';
-      res.on('data', chunk => data += chunk);
-      res.on('end', () => {
-        try {
-          const result = JSON.parse(data);
-          resolve(result);
-        } catch (e) {
-          reject(e);
-        }
-      });
-    });
-    req.on('error', reject);
-    req.end();
-  });
+async function fetchDecryptJobs(limit = 1, waitMs = 0) {
+  return getJson(`${GATEHOUSE_URL}/api/executor/decrypt-jobs?limit=${limit}&wait=${waitMs}`, { agent: gatehouseAgent, waitMs });
 }
 
 // Submit decrypt result
@@ -745,6 +810,7 @@ async function submitDecryptResult(decryptId, success, decryptedValue = null, er
     const postData = JSON.stringify(payload);
     const req = http.request(`${GATEHOUSE_URL}/api/executor/decrypt-jobs/${decryptId}/result`, {
       method: 'POST',
+      agent: gatehouseAgent,
       headers: {
         'Content-Type': 'application/json',
         'Content-Length': Buffer.byteLength(postData)
@@ -767,123 +833,243 @@ async function submitDecryptResult(decryptId, success, decryptedValue = null, er
   });
 }
 
-// Poll and process decrypt jobs
-async function pollForDecryptJobs() {
-  try {
-    const jobsData = await fetchDecryptJobs();
-
-    if (!jobsData || !jobsData.jobs || jobsData.jobs.length === 0) {
-      return;
+// 복호화 작업의 암호문 JSON 배열 추출
+function extractDecryptCiphertext(job) {
+  if (job.ciphertext && typeof job.ciphertext === 'object') {
+    if (job.ciphertext.encrypted_data && job.ciphertext.encrypted_data.encrypted_data) {
+      return job.ciphertext.encrypted_data.encrypted_data;
+    } else if (job.ciphertext.encrypted_data) {
+      return job.ciphertext.encrypted_data;
     }
+    throw new Error('Invalid ciphertext format');
+  }
+  throw new Error('Missing ciphertext data');
+}
 
-    const job = jobsData.jobs[0];
-    const decryptId = job.decrypt_id;
-    const cid = job.cid;
-
-    logger.info('Decrypt:Polling', 'Decrypt job found', { 
-      decrypt_id: decryptId.slice(0, 16) + '...',
-      cid: cid.slice(0, 8) + '...'
-    });
+// Process a batch of decrypt jobs: 암호문을 모아 FHE16Async.decIntBatch 한 번으로 복호화하고 결과는 동시에 제출
+async function processDecryptJobs(jobs) {
+  const t0 = Date.now();
+  const cts = [];
+  const errors = new Array(jobs.length).fill(null);
+  const index = [];   // cts[k] → jobs[index[k]]
 
+  jobs.forEach((job, i) => {
     try {
-      // Extract ciphertext data
-      let ctData;
-      if (job.ciphertext && typeof job.ciphertext === 'object') {
-        if (job.ciphertext.encrypted_data && job.ciphertext.encrypted_data.encrypted_data) {
-          ctData = job.ciphertext.encrypted_data.encrypted_data;
-        } else if (job.ciphertext.encrypted_data) {
-          ctData = job.ciphertext.encrypted_data;
-        } else {
-          throw new Error('Invalid ciphertext format');
-        }
-      } else {
-        throw new Error('Missing ciphertext data');
-      }
+      cts.push(convertJSONToCtBuffer(extractDecryptCiphertext(job)));
+      index.push(i);
+    } catch (error) {
+      errors[i] = error.message;
+    }
+  });
 
-      // Convert to Int32Ptr
-      const ctPtr = convertJSONToInt32Ptr(ctData);
-      
-      // Decrypt using secret key
+  const values = new Array(jobs.length).fill(null);
+  if (cts.length > 0) {
+    try {
       if (!secretKey) {
         throw new Error('Secret key not available');
       }
+      const out = await FHE16Async.decIntBatch(cts, secretKey, { threads: DEC_THREADS });
+      out.forEach((v, k) => {
+        if (v === null) errors[index[k]] = 'Decryption failed';
+        else values[index[k]] = v;
+      });
+    } catch (error) {
+      for (const i of index) errors[i] = error.message;
+    }
+  }
 
-      const decryptedValue = FHE16.decInt(ctPtr, secretKey);
-      
-      logger.demo('Decrypt:Demo', 'DECRYPTED VALUE FOR UI', { value: decryptedValue, cid: cid.slice(0, 8) + '...' });
+  const decryptMs = Date.now() - t0;
+  logger.info('Decrypt:Batch', 'Decrypted batch', {
+    count: jobs.length,
+    failed: errors.filter(Boolean).length,
+    time_ms: decryptMs
+  });
 
-      // Submit result
-      await submitDecryptResult(decryptId, true, decryptedValue);
-      
-      logger.info('Decrypt:Result', 'Decrypt job completed', { 
+  await Promise.all(jobs.map(async (job, i) => {
+    const decryptId = job.decrypt_id;
+    try {
+      if (errors[i]) {
+        logger.error('Decrypt:Processing', 'Decryption failed', { decrypt_id: decryptId.slice(0, 16) + '...', error: errors[i] });
+        await submitDecryptResult(decryptId, false, null, errors[i]);
+        return;
+      }
+      logger.demo('Decrypt:Demo', 'DECRYPTED VALUE FOR UI', { value: values[i], cid: job.cid.slice(0, 8) + '...' });
+      await submitDecryptResult(decryptId, true, values[i]);
+      logger.debug('Decrypt:Result', 'Decrypt job completed', {
         decrypt_id: decryptId.slice(0, 16) + '...',
-        value: decryptedValue 
+        value: values[i]
       });
-
     } catch (error) {
-      logger.error('Decrypt:Processing', 'Decryption failed', { error: error.message });
-      await submitDecryptResult(decryptId, false, null, error.message);
+      logger.error('Decrypt:Result', 'Failed to submit decrypt result', { decrypt_id: decryptId.slice(0, 16) + '...', error: error.message });
     }
-
-  } catch (error) {
-    // Silently ignore polling errors (gatehouse might be unavailable)
-  }
+  }));
 }
 
-// Main polling loop
-async function pollForJobs() {
-  if (isProcessing) {
-    return;
-  }
+// 같은 CID 를 쓰고 읽는 작업 사이의 의존성 (batch-dag.js). 앞 작업 결과는 메모리로 전달
+const cidScheduler = new CidScheduler();
 
-  try {
-    const jobsData = await fetchJobs();
-
-    if (!jobsData || !jobsData.jobs || jobsData.jobs.length === 0) {
-      return;
-    }
+// Process one claimed job (runs inside a job pool slot)
+// task = cidScheduler.schedule(...) 핸들: 앞 작업(같은 CID 에 쓰는 작업)이 끝나야 시작
+async function processJob(job, task) {
+  const jobId = job.job_pda.slice(0, 8);
 
-    const job = jobsData.jobs[0];
-    const jobPda = job.job_pda;
-    const jobId = jobPda.slice(0, 8);
+  // 앞 작업이 메모리로 넘긴 암호문으로 입력 교체 (게이트하우스 저장소 왕복 없음)
+  const mem = await task.ready;
+  if (mem.some(Boolean)) {
+    job = {
+      ...job,
+      ciphertexts: job.ciphertexts.map((ct, i) => (mem[i] ? { ...ct, ciphertext: { encrypted_data: mem[i] } } : ct))
+    };
+    logger.debug('Job:DAG', 'Inputs taken from preceding jobs', { job_id: jobId, count: mem.filter(Boolean).length });
+  }
 
-    logger.info('Job:Polling', 'Job found, starting processing', { job_id: jobId });
-    isProcessing = true;
+  let result = null;
+  try {
+    result = await executeFHEComputation(job);
+  } finally {
+    task.complete(result && result.success ? result.resultCiphertext.encrypted_data : null);
+  }
 
-    await claimJob(jobPda);
-    const result = await executeFHEComputation(job);
+  try {
     await submitResult(
-      jobPda,
+      job.job_pda,
       result.success,
       result.resultCiphertext,
       result.error || null,
       result.executionTime
     );
-    
-    if (result.success && result.resultCiphertext?.debug_decrypted_result !== undefined) {
-      logger.info('Job:Result', 'Job completed successfully', { 
-        job_id: jobId, 
-        result: result.resultCiphertext.debug_decrypted_result,
-        time_ms: result.executionTime
+  } finally {
+    task.submitted();
+  }
+
+  if (result.success && result.resultCiphertext?.debug_decrypted_result !== undefined) {
+    logger.info('Job:Result', 'Job completed successfully', {
+      job_id: jobId,
+      result: result.resultCiphertext.debug_decrypted_result,
+      time_ms: result.executionTime
+    });
+  }
+}
+
+// Claim fetched jobs and start them in the pool
+// claim 이 끝난 뒤에 다음 롱 폴링을 보내므로 같은 작업을 두 번 받지 않는다.
+// 여러 실행기가 같은 작업을 가져갈 수 있으므로 claim 실패(409)면 건너뜀. 뒤 작업은 앞 작업의 claim 이
+// 성공한 뒤에만 claim 한다 (claimInOrder) → 앞 작업을 놓치면 뒤 작업은 큐에 남아 앞 작업이 끝난 뒤 다시 나온다
+// 작업은 slot 순서로 등록 → CID 의존성이 없는 작업은 바로 병렬, 있는 작업은 앞 작업 결과를 기다림
+// (게이트하우스는 slot 순서로 주고 앞부분이 의존성에 닫혀 있으므로 정렬한 뒤에 자른다)
+async function dispatchJobs(jobs) {
+  try {
+    jobs = jobs.slice().sort((a, b) => (a.slot || 0) - (b.slot || 0)).slice(0, jobPool.capacity());
+    logger.info('Job:Polling', 'Jobs found, starting processing', {
+      count: jobs.length,
+      active: jobPool.active,
+      limit: jobPool.limit
+    });
+
+    const shapes = jobs.map((job) => ({ cids: (job.ciphertexts || []).map((ct) => ct.cid_pda), outSlot: outputSlotOf(job) }));
+    const claims = await claimInOrder(shapes, (k) => claimJob(jobs[k].job_pda));
+    let dependent = 0;
+    jobs.forEach((job, k) => {
+      const jobId = job.job_pda.slice(0, 8);
+      if (!claims[k].claimed) {
+        if (claims[k].skipped) {
+          logger.info('Job:Claim', 'Preceding job not claimed, leaving job queued', { job_id: jobId });
+        } else {
+          logger.warn('Job:Claim', 'Job not claimed, skipping', { job_id: jobId, error: claims[k].result?.error });
+        }
+        return;
+      }
+      const task = cidScheduler.schedule(shapes[k].cids, shapes[k].outSlot);
+      if (task.deps > 0) dependent++;
+      jobPool.run(() => processJob(job, task)).catch((error) => {
+        logger.error('Job:Processing', 'Job processing failed', { job_id: jobId, error: error.message });
       });
+    });
+    if (dependent > 0) {
+      logger.info('Job:DAG', 'Jobs waiting on preceding jobs (same CID)', { dependent, total: jobs.length });
     }
+  } finally {
+    cidScheduler.endCycle();
+  }
+}
 
-  } catch (error) {
-    logger.error('Job:Processing', 'Job processing failed', { error: error.message });
+// Main job loop: 풀에 빈 슬롯이 생기면 그 수만큼 롱 폴링으로 요청
+async function jobLoop() {
+  const fetchBatch = async (waitMs) => {
+    await jobPool.waitForSlot();
+    cidScheduler.beginCycle();
+    try {
+      const data = await fetchJobs(jobPool.capacity(), waitMs);
+      if (!data || !data.jobs || data.jobs.length === 0) cidScheduler.endCycle();
+      return data;
+    } catch (error) {
+      cidScheduler.endCycle();
+      throw error;
+    }
+  };
+  await longPollLoop({ tag: 'Job:Polling', waitMs: LONG_POLL_MS, retryMs: POLL_INTERVAL, logger, fetchBatch, handle: dispatchJobs });
+}
+
+// Decrypt loop: 대기 중인 복호화 작업을 전부 받아 배치로 처리 (제출이 끝난 뒤 다음 주기)
+async function decryptLoop() {
+  await longPollLoop({
+    tag: 'Decrypt:Polling', waitMs: LONG_POLL_MS, retryMs: POLL_INTERVAL, logger,
+    fetchBatch: (waitMs) => fetchDecryptJobs(DECRYPT_BATCH, waitMs), handle: processDecryptJobs
+  });
+}
+
+async function handleTrace(req, res, url) {
+  if (traceBusy) {
+    res.writeHead(409, { 'Content-Type': 'application/json' });
+    res.end(JSON.stringify({ error: 'Trace already in progress' }));
+    return;
+  }
+  const ms = Math.min(TRACE_MAX_MS, Math.max(1, parseInt(url.searchParams.get('ms') || '5000', 10) || 5000));
+  traceBusy = true;
+  try {
+    FHE16Async.traceStart(TRACE_BUFFER);
+    await new Promise((resolve) => setTimeout(resolve, ms));
+    const json = FHE16Async.traceStop();
+    if (json == null) {
+      res.writeHead(501, { 'Content-Type': 'application/json' });
+      res.end(JSON.stringify({ error: 'Tracing requires the N-API addon' }));
+      return;
+    }
+    logger.info('Trace', 'Trace captured', { ms, bytes: json.length });
+    res.writeHead(200, { 'Content-Type': 'application/json' });
+    res.end(json);
   } finally {
-    isProcessing = false;
+    traceBusy = false;
   }
 }
 
 // Create HTTP server for status endpoint
 const server = http.createServer((req, res) => {
-  if (req.url === '/status' && req.method === 'GET') {
+  const url = new URL(req.url, 'http://localhost');
+  if (url.pathname === '/metrics' && req.method === 'GET') {
+    res.writeHead(200, { 'Content-Type': 'text/plain; version=0.0.4' });
+    res.end(renderMetrics({
+      opStats: FHE16Async.opStats(),
+      addon: FHE16Async.stats(),
+      jobPool: jobPool ? jobPool.stats() : null,
+      resultCache: resultCache ? resultCache.stats() : null,
+      uptime: process.uptime()
+    }));
+  } else if (url.pathname === '/trace' && req.method === 'GET') {
+    handleTrace(req, res, url).catch((error) => {
+      logger.error('Trace', 'Trace failed', { error: error.message });
+      if (!res.headersSent) res.writeHead(500, { 'Content-Type': 'application/json' });
+      res.end(JSON.stringify({ error: error.message }));
+    });
+  } else if (req.url === '/status' && req.method === 'GET') {
     res.writeHead(200, { 'Content-Type': 'application/json' });
     res.end(JSON.stringify({
       executor_id: EXECUTOR_ID,
       port: EXECUTOR_PORT,
       gatehouse_url: GATEHOUSE_URL,
-      is_processing: isProcessing,
+      is_processing: !!jobPool && jobPool.active > 0,
+      job_pool: jobPool ? jobPool.stats() : null,
+      result_cache: resultCache ? resultCache.stats() : null,
       uptime: process.uptime()
     }));
   } else if (req.url === '/health' && req.method === 'GET') {
@@ -914,13 +1100,10 @@ async function start() {
     logger.info('Server', 'Server ready', { port: EXECUTOR_PORT });
   });
 
-  logger.info('Job:Polling', 'Starting job polling', { interval_sec: POLL_INTERVAL/1000 });
-  setInterval(pollForJobs, POLL_INTERVAL);
-  setInterval(pollForDecryptJobs, POLL_INTERVAL);
-
-  // Initial poll
-  setTimeout(pollForJobs, 1000);
-  setTimeout(pollForDecryptJobs, 1500);
+  // 주기 폴링 대신 롱 폴링 루프 (작업이 enqueue 되는 즉시 응답을 받음)
+  logger.info('Job:Polling', 'Starting long-poll loops', { wait_ms: LONG_POLL_MS });
+  jobLoop();
+  decryptLoop();
 }
 
 // Handle graceful shutdown
@@ -0,0 +1,68 @@
+// test/batch-dag.test.js — CID 의존성 스케줄 / 순서 있는 claim (node --test)
+const test = require('node:test');
+const assert = require('node:assert');
+const { CidScheduler, claimInOrder, predecessors } = require('../batch-dag.js');
+
+test('predecessors follow RAW / WAW / WAR like the gatehouse plan', () => {
+  const jobs = [
+    { cids: ['a', 'b'], outSlot: 0 },   // 0: writes a, reads b
+    { cids: ['c', 'a'], outSlot: 0 },   // 1: writes c, reads a  (RAW on 0)
+    { cids: ['b'], outSlot: 0 },        // 2: writes b           (WAR on 0)
+    { cids: ['a'], outSlot: 0 },        // 3: writes a           (WAW on 0, WAR on 1)
+    { cids: ['d'], outSlot: -1 },       // 4: independent
+  ];
+  const preds = predecessors(jobs).map((p) => p.sort());
+  assert.deepStrictEqual(preds, [[], [0], [0], [0, 1], []]);
+});
+
+test('later job receives the preceding result in memory', async () => {
+  const s = new CidScheduler();
+  const first = s.schedule(['a', 'b'], 0);
+  const second = s.schedule(['a'], 0);
+  assert.strictEqual(first.deps, 0);
+  assert.strictEqual(second.deps, 1);
+  assert.deepStrictEqual(await first.ready, [null, null]);
+  first.complete([1, 2, 3]);
+  assert.deepStrictEqual(await second.ready, [[1, 2, 3]]);
+  second.complete(null);                 // 실패: 뒤 작업은 이전 값을 받는다
+  const third = s.schedule(['a'], 0);
+  assert.deepStrictEqual(await third.ready, [[1, 2, 3]]);
+});
+
+test('claims dependents only after their predecessors were claimed', async () => {
+  const jobs = [
+    { cids: ['a'], outSlot: 0 },
+    { cids: ['a'], outSlot: 0 },
+    { cids: ['x'], outSlot: 0 },
+  ];
+  const order = [];
+  const claims = await claimInOrder(jobs, async (i) => {
+    order.push(`start ${i}`);
+    await new Promise((r) => setTimeout(r, 5));
+    order.push(`end ${i}`);
+    return { success: true };
+  });
+  assert.ok(claims.every((c) => c.claimed));
+  assert.ok(order.indexOf('start 1') > order.indexOf('end 0'));
+  assert.ok(order.indexOf('start 2') < order.indexOf('end 0'));   // 독립 작업은 기다리지 않는다
+});
+
+test('a failed claim leaves its dependents unclaimed', async () => {
+  const jobs = [
+    { cids: ['a'], outSlot: 0 },
+    { cids: ['b', 'a'], outSlot: 0 },
+    { cids: ['b'], outSlot: 0 },
+    { cids: ['c'], outSlot: 0 },
+  ];
+  const asked = [];
+  const claims = await claimInOrder(jobs, async (i) => {
+    asked.push(i);
+    if (i === 0) return { error: 'Job not available for claiming' };
+    if (i === 3) throw new Error('socket hang up');
+    return { success: true };
+  });
+  assert.deepStrictEqual(asked.sort(), [0, 3]);
+  assert.deepStrictEqual(claims.map((c) => c.claimed), [false, false, false, false]);
+  assert.deepStrictEqual(claims.map((c) => !!c.skipped), [false, true, true, false]);
+  assert.strictEqual(claims[3].result.error, 'socket hang up');
+});
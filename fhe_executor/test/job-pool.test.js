@@ -0,0 +1,63 @@
+// test/job-pool.test.js — JobPool 허용 제어 (node --test)
+const test = require('node:test');
+const assert = require('node:assert');
+const { JobPool } = require('../job-pool.js');
+
+test('limit starts at maxWorkers and capacity excludes active jobs', async () => {
+  const pool = new JobPool({ maxWorkers: 4, targetOpMs: 100 });
+  assert.strictEqual(pool.limit, 4);
+  let release;
+  const running = pool.run(() => new Promise((r) => { release = r; }));
+  assert.strictEqual(pool.capacity(), 3);
+  release();
+  await running;
+  assert.strictEqual(pool.capacity(), 4);
+  assert.strictEqual(pool.completed, 1);
+});
+
+test('execution time above target shrinks the limit multiplicatively', () => {
+  const pool = new JobPool({ maxWorkers: 8, targetOpMs: 100 });
+  pool.observe(10, 10 * 250);      // 250 ms/step
+  assert.strictEqual(pool.limit, 6);
+  pool.observe(10, 10 * 250);
+  assert.strictEqual(pool.limit, 4);
+});
+
+test('limit grows only while the pool is full and execution is fast', () => {
+  const pool = new JobPool({ maxWorkers: 4, targetOpMs: 100 });
+  pool.limit = 2;
+  pool.observe(5, 5 * 50);         // 빠르지만 풀이 비어 있음 → 그대로
+  assert.strictEqual(pool.limit, 2);
+  pool.active = 2;
+  pool.observe(5, 5 * 50);
+  assert.strictEqual(pool.limit, 3);
+});
+
+test('EWMA follows the observed per-step execution time', () => {
+  const pool = new JobPool({ maxWorkers: 2, targetOpMs: 1000 });
+  pool.observe(4, 400);            // 100 ms/step
+  assert.strictEqual(pool.ewmaOpMs, 100);
+  pool.observe(2, 400);            // 200 ms/step
+  assert.ok(Math.abs(pool.ewmaOpMs - 130) < 1e-9);
+});
+
+test('targetOpMs = 0 disables admission control', () => {
+  const pool = new JobPool({ maxWorkers: 3, targetOpMs: 0 });
+  pool.observe(1, 1e6);
+  assert.strictEqual(pool.limit, 3);
+  assert.strictEqual(pool.samples, 0);
+});
+
+test('waitForSlot resolves when a running job finishes', async () => {
+  const pool = new JobPool({ maxWorkers: 1, targetOpMs: 0 });
+  let release;
+  const running = pool.run(() => new Promise((r) => { release = r; }));
+  let woke = false;
+  const waiting = pool.waitForSlot().then(() => { woke = true; });
+  await Promise.resolve();
+  assert.strictEqual(woke, false);
+  release();
+  await running;
+  await waiting;
+  assert.strictEqual(woke, true);
+});
@@ -0,0 +1,135 @@
+// test/long-poll.test.js — 롱 폴링 루프와 게이트하우스 GET (node --test)
+const test = require('node:test');
+const assert = require('node:assert');
+const http = require('http');
+const { getJson, longPollLoop } = require('../long-poll.js');
+
+function recorder() {
+  const lines = [];
+  const log = (level) => (tag, msg) => lines.push(`${level} ${msg}`);
+  return { lines, info: log('info'), warn: log('warn'), error: log('error') };
+}
+
+// 게이트하우스 흉내: 큐가 비어 있으면 ?wait 동안 요청을 붙잡고 enqueue 즉시 응답
+function mockGatehouse() {
+  const queue = [];
+  const held = [];
+  const seen = [];
+  const reply = (res) => {
+    res.writeHead(200, { 'Content-Type': 'application/json' });
+    res.end(JSON.stringify({ jobs: queue.splice(0) }));
+  };
+  const server = http.createServer((req, res) => {
+    const url = new URL(req.url, 'http://x');
+    seen.push(url.searchParams.get('wait'));
+    const wait = parseInt(url.searchParams.get('wait') || '0', 10);
+    if (queue.length > 0 || wait <= 0) return reply(res);
+    const h = { res, timer: setTimeout(() => { held.splice(held.indexOf(h), 1); reply(res); }, wait) };
+    held.push(h);
+  });
+  return {
+    server, seen,
+    enqueue(job) {
+      queue.push(job);
+      for (const h of held.splice(0)) { clearTimeout(h.timer); reply(h.res); }
+    },
+    listen: () => new Promise((r) => server.listen(0, '127.0.0.1', () => r(`http://127.0.0.1:${server.address().port}`))),
+    close: () => new Promise((r) => server.close(r)),
+  };
+}
+
+test('held request is answered as soon as a job is enqueued', async () => {
+  const gh = mockGatehouse();
+  const base = await gh.listen();
+  const agent = new http.Agent({ keepAlive: true });
+  const log = recorder();
+  let stop = false;
+  let enqueuedAt = 0;
+  const got = [];
+  const loop = longPollLoop({
+    tag: 'T', waitMs: 5000, retryMs: 5000, logger: log, stopped: () => stop,
+    fetchBatch: (waitMs) => getJson(`${base}/jobs?wait=${waitMs}`, { agent, waitMs }),
+    handle: async (jobs) => {
+      got.push({ jobs, latency: Date.now() - enqueuedAt });
+      if (got.length === 2) stop = true;
+    },
+  });
+  for (const job of ['a', 'b']) {
+    await new Promise((r) => setTimeout(r, 150));
+    enqueuedAt = Date.now();
+    gh.enqueue(job);
+    while (got.length < (job === 'a' ? 1 : 2)) await new Promise((r) => setTimeout(r, 5));
+  }
+  await loop;
+  assert.deepStrictEqual(got.map((g) => g.jobs), [['a'], ['b']]);
+  for (const g of got) assert.ok(g.latency < 1000, `latency ${g.latency} ms`);
+  // 대기 중에는 요청 하나가 열려 있을 뿐 (주기 폴링 없음): 작업마다 요청 1 개
+  assert.strictEqual(gh.seen.length, 2);
+  assert.ok(gh.seen.every((w) => w === '5000'));
+  assert.deepStrictEqual(log.lines, ['info Connected to gatehouse (long-poll)']);
+  agent.destroy();
+  await gh.close();
+});
+
+test('immediate empty answers fall back to the retry interval', async () => {
+  const calls = [];
+  let stop = false;
+  const loop = longPollLoop({
+    tag: 'T', waitMs: 5000, retryMs: 100, logger: recorder(), stopped: () => stop,
+    fetchBatch: async () => { calls.push(Date.now()); return { jobs: [] }; },
+    handle: async () => assert.fail('no jobs expected'),
+  });
+  await new Promise((r) => setTimeout(r, 350));
+  stop = true;
+  await loop;
+  assert.ok(calls.length >= 2 && calls.length <= 5, `calls ${calls.length}`);
+  for (let i = 1; i < calls.length; ++i) assert.ok(calls[i] - calls[i - 1] >= 90);
+});
+
+test('unreachable gatehouse is retried and logged only on state changes', async () => {
+  const log = recorder();
+  let n = 0;
+  let stop = false;
+  const got = [];
+  await longPollLoop({
+    tag: 'T', waitMs: 5000, retryMs: 20, logger: log, stopped: () => stop,
+    fetchBatch: async () => {
+      ++n;
+      if (n <= 3 || n === 5) throw new Error('ECONNREFUSED');
+      return { jobs: [n] };
+    },
+    handle: async (jobs) => { got.push(...jobs); if (got.length === 2) stop = true; },
+  });
+  assert.deepStrictEqual(got, [4, 6]);
+  assert.deepStrictEqual(log.lines, [
+    'warn Gatehouse unavailable, retrying',
+    'info Connected to gatehouse (long-poll)',
+    'warn Gatehouse unavailable, retrying',
+    'info Connected to gatehouse (long-poll)',
+  ]);
+});
+
+test('a failing handler does not stop the loop', async () => {
+  const log = recorder();
+  let n = 0;
+  let stop = false;
+  await longPollLoop({
+    tag: 'T', waitMs: 5000, retryMs: 5000, logger: log, stopped: () => stop,
+    fetchBatch: async () => ({ jobs: [++n] }),
+    handle: async ([job]) => {
+      if (job === 1) throw new Error('boom');
+      stop = true;
+    },
+  });
+  assert.strictEqual(n, 2);
+  assert.ok(log.lines.includes('error Job handling failed'));
+});
+
+test('getJson rejects on a non-JSON body and on connection errors', async () => {
+  const server = http.createServer((req, res) => res.end('<html>'));
+  await new Promise((r) => server.listen(0, '127.0.0.1', r));
+  const url = `http://127.0.0.1:${server.address().port}/jobs`;
+  await assert.rejects(getJson(url));
+  await new Promise((r) => server.close(r));
+  await assert.rejects(getJson(url));
+});
@@ -0,0 +1,76 @@
+// test/result-cache.test.js — ResultCache 키 / 용량 계산 (node --test)
+const test = require('node:test');
+const assert = require('node:assert');
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const { ResultCache } = require('../result-cache.js');
+
+function tmpCache(maxBytes = 1 << 20) {
+  const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'result-cache-'));
+  const cache = new ResultCache({ dir, maxBytes });
+  cache.load();
+  return cache;
+}
+
+function diskBytes(dir) {
+  let n = 0;
+  for (const sub of fs.readdirSync(dir)) {
+    for (const name of fs.readdirSync(path.join(dir, sub))) {
+      assert.ok(name.endsWith('.ct'), `leftover ${name}`);
+      n += fs.statSync(path.join(dir, sub, name)).size;
+    }
+  }
+  return n;
+}
+
+test('key depends on digest, version and input bytes', () => {
+  const a = Buffer.from([1, 0, 0, 0]);
+  const b = Buffer.from([2, 0, 0, 0]);
+  const k = ResultCache.key('d', [a, b], 'v1');
+  assert.strictEqual(k, ResultCache.key('d', [Buffer.from(a), Buffer.from(b)], 'v1'));
+  assert.notStrictEqual(k, ResultCache.key('d', [a, b], 'v2'));
+  assert.notStrictEqual(k, ResultCache.key('e', [a, b], 'v1'));
+  assert.notStrictEqual(k, ResultCache.key('d', [b, a], 'v1'));
+  // 경계가 모호한 (digest, version) 쌍도 구분
+  assert.notStrictEqual(ResultCache.key('ab', [a], 'c'), ResultCache.key('a', [a], 'bc'));
+});
+
+test('round trip and a version change misses', async () => {
+  const cache = tmpCache();
+  const ct = Buffer.from(new Int32Array([3, 1040, 7, -1]).buffer);
+  const k1 = ResultCache.key('d', [ct], 'plan-a');
+  await cache.put(k1, ct);
+  assert.deepStrictEqual(await cache.get(k1), ct);
+  assert.strictEqual(await cache.get(ResultCache.key('d', [ct], 'plan-b')), null);
+  assert.strictEqual(cache.hits, 1);
+  assert.strictEqual(cache.misses, 1);
+});
+
+test('concurrent puts of one key count its bytes once', async () => {
+  const cache = tmpCache();
+  const small = Buffer.alloc(16, 1);
+  const large = Buffer.alloc(64, 2);
+  const key = ResultCache.key('d', [small], 'v');
+  await Promise.all([cache.put(key, small), cache.put(key, large), cache.put(key, small)]);
+  assert.strictEqual(cache.index.size, 1);
+  assert.strictEqual(cache.bytes, cache.index.get(key));
+  assert.strictEqual(cache.bytes, diskBytes(cache.dir));
+  assert.deepStrictEqual(await cache.get(key), small);   // 먼저 시작한 put 이 남는다
+});
+
+test('eviction keeps bytes within maxBytes and matches the disk', async () => {
+  const cache = tmpCache(3 * (8 + 32));
+  for (let i = 0; i < 6; i++) {
+    const ct = Buffer.alloc(32, i);
+    await cache.put(ResultCache.key('d', [ct], 'v'), ct);
+  }
+  assert.strictEqual(cache.index.size, 3);
+  assert.ok(cache.bytes <= cache.maxBytes);
+  await new Promise((r) => setTimeout(r, 20));   // drop 의 unlink 는 기다리지 않는다
+  assert.strictEqual(cache.bytes, diskBytes(cache.dir));
+
+  const reloaded = new ResultCache({ dir: cache.dir, maxBytes: cache.maxBytes });
+  assert.strictEqual(reloaded.load(), 3);
+  assert.strictEqual(reloaded.bytes, cache.bytes);
+});
@@ -8,6 +8,7 @@
 #include <iostream>
 #include <BINFHE.hpp>
 #include <ntttable.hpp>
+#include <reduction.h>
 
 
 /*
@@ -155,6 +156,85 @@ namespace EFHEs{
 			void MUL_NTT_MONT(int32_t *res, int32_t *x, int32_t *y, const NTTTable32 *Param_x, const NTTTable32 *Param_y, int N, int q_num); 
 
 
+			// 제자리 연산 (임시 Poly32 / 할당 없음). this 는 같은 NTTTable32 로 만들어져 있어야 하고
+			// 값은 [0, Q) 범위. a, b 가 this 여도 된다.
+			//   AddInto / SubInto : this = a + b / a - b (표현은 a 를 따른다)
+			//   MulNTTInto        : this = a * b (MUL_NTT_MONT, 커널은 표의 NTT 깊이로 고른다).
+			//                       a, b 는 NTT 영역, b 는 몽고메리 (operator*= 와 같은 규칙), 표현은 a 를 따른다
+			//   FMAInto / FMSInto : this += a * b / this -= a * b (곱은 스레드별 버퍼에).
+			//                       this 는 NTT 영역이고 몽고메리 여부가 a 와 같아야 한다
+			// 표현 플래그(_IsNTT / _IsMont)가 규칙과 다르면 결과가 조용히 틀리므로 메시지를 찍고 abort
+			// 예) r = a*b + c*d - e  →  r.MulNTTInto(a, b); r.FMAInto(c, d); r -= e;
+			void AddInto(const Poly32 &a, const Poly32 &b) {
+				ReprCheck(a._IsNTT == b._IsNTT && a._IsMont == b._IsMont, "AddInto");
+				const int N = _Param_NTT->GetN();
+				for (int jj = 0; jj < _Param_NTT->GetQnum(); jj++) {
+					FastAddPolyWithRangeZeroToQ_32bit(_poly + jj*N, a._poly + jj*N, b._poly + jj*N, _Param_NTT->GetQ(jj), N);
+				}
+				_IsNTT = a._IsNTT;
+				_IsMont = a._IsMont;
+			}
+			void SubInto(const Poly32 &a, const Poly32 &b) {
+				ReprCheck(a._IsNTT == b._IsNTT && a._IsMont == b._IsMont, "SubInto");
+				const int N = _Param_NTT->GetN();
+				for (int jj = 0; jj < _Param_NTT->GetQnum(); jj++) {
+					SubPolyQ(_poly + jj*N, a._poly + jj*N, b._poly + jj*N, _Param_NTT->GetQ(jj), N);
+				}
+				_IsNTT = a._IsNTT;
+				_IsMont = a._IsMont;
+			}
+			void MulNTTInto(const Poly32 &a, const Poly32 &b) {
+				ReprCheck(a._IsNTT && b._IsNTT && b._IsMont, "MulNTTInto");
+				MUL_NTT_MONT(_poly, a._poly, b._poly, a._Param_NTT, b._Param_NTT, _Param_NTT->GetN(), _Param_NTT->GetQnum());
+				_IsNTT = true;
+				_IsMont = a._IsMont;
+			}
+			void FMAInto(const Poly32 &a, const Poly32 &b) {
+				ReprCheck(_IsNTT && a._IsNTT && b._IsNTT && b._IsMont && _IsMont == a._IsMont, "FMAInto");
+				const int N = _Param_NTT->GetN();
+				int32_t *prod = ScratchFMA(N * _Param_NTT->GetQnum());
+				MUL_NTT_MONT(prod, a._poly, b._poly, a._Param_NTT, b._Param_NTT, N, _Param_NTT->GetQnum());
+				for (int jj = 0; jj < _Param_NTT->GetQnum(); jj++) {
+					FastAddPolyWithRangeZeroToQ_32bit(_poly + jj*N, _poly + jj*N, prod + jj*N, _Param_NTT->GetQ(jj), N);
+				}
+			}
+			void FMSInto(const Poly32 &a, const Poly32 &b) {
+				ReprCheck(_IsNTT && a._IsNTT && b._IsNTT && b._IsMont && _IsMont == a._IsMont, "FMSInto");
+				const int N = _Param_NTT->GetN();
+				int32_t *prod = ScratchFMA(N * _Param_NTT->GetQnum());
+				MUL_NTT_MONT(prod, a._poly, b._poly, a._Param_NTT, b._Param_NTT, N, _Param_NTT->GetQnum());
+				for (int jj = 0; jj < _Param_NTT->GetQnum(); jj++) {
+					SubPolyQ(_poly + jj*N, _poly + jj*N, prod + jj*N, _Param_NTT->GetQ(jj), N);
+				}
+			}
+
+		private:
+			static void ReprCheck(bool ok, const char *op) {
+				if (ok) return;
+				printf("Poly32::%s: operand representation mismatch (_IsNTT / _IsMont)\n", op);
+				fflush(stdout);
+				abort();
+			}
+			// FMA 곱 버퍼 (스레드별, 늘어나기만 함, 64B 정렬)
+			static int32_t *ScratchFMA(int len) {
+				struct Buf { int32_t *p = nullptr; int len = 0; ~Buf() { free(p); } };
+				thread_local Buf buf;
+				if (buf.len < len) {
+					free(buf.p);
+					buf.len = (len + 15) & ~15;
+					buf.p = (int32_t *)aligned_alloc(64, buf.len * sizeof(int32_t));
+				}
+				return buf.p;
+			}
+			static void SubPolyQ(int32_t *res, const int32_t *a, const int32_t *b, int32_t Q, int N) {
+				for (int ii = 0; ii < N; ii++) {
+					res[ii] = FastSubWithRangeZeroToQ_32bit(a[ii], b[ii], Q);
+				}
+			}
+
+		public:
+
+
             // Auto
             void Aut(int idx);
 		};
@@ -269,6 +349,78 @@ namespace EFHEs{
 			void MUL_NTT_MONT(int16_t *res, int16_t *x, int16_t *y, const NTTTable16 *Param_x, const NTTTable16 *Param_y, int N, int q_num); 
 
 
+			// 제자리 연산 (임시 Poly16 / 할당 없음). this 는 같은 NTTTable16 으로 만들어져 있어야 하고
+			// 값은 [0, Q) 범위. a, b 가 this 여도 된다.
+			//   AddInto / SubInto : this = a + b / a - b (표현은 a 를 따른다)
+			//   MulNTTInto        : this = a * b (MUL_NTT_MONT, 커널은 표의 NTT 깊이로 고른다).
+			//                       a, b 는 NTT 영역, b 는 몽고메리 (operator*= 와 같은 규칙), 표현은 a 를 따른다
+			//   FMAInto / FMSInto : this += a * b / this -= a * b (곱은 스레드별 버퍼에).
+			//                       this 는 NTT 영역이고 몽고메리 여부가 a 와 같아야 한다
+			// 표현 플래그(_IsNTT / _IsMont)가 규칙과 다르면 결과가 조용히 틀리므로 메시지를 찍고 abort
+			// 예) r = a*b + c*d - e  →  r.MulNTTInto(a, b); r.FMAInto(c, d); r -= e;
+			void AddInto(const Poly16 &a, const Poly16 &b) {
+				ReprCheck(a._IsNTT == b._IsNTT && a._IsMont == b._IsMont, "AddInto");
+				const int N = _Param_NTT->GetN();
+				for (int jj = 0; jj < _Param_NTT->GetQnum(); jj++) {
+					FastAddWithRangeZeroToQVec_16bit(a._poly + jj*N, b._poly + jj*N, _poly + jj*N, _Param_NTT->GetQ(jj), 0, N);
+				}
+				_IsNTT = a._IsNTT;
+				_IsMont = a._IsMont;
+			}
+			void SubInto(const Poly16 &a, const Poly16 &b) {
+				ReprCheck(a._IsNTT == b._IsNTT && a._IsMont == b._IsMont, "SubInto");
+				const int N = _Param_NTT->GetN();
+				for (int jj = 0; jj < _Param_NTT->GetQnum(); jj++) {
+					FastSubWithRangeZeroToQVec_16bit(a._poly + jj*N, b._poly + jj*N, _poly + jj*N, _Param_NTT->GetQ(jj), 0, N);
+				}
+				_IsNTT = a._IsNTT;
+				_IsMont = a._IsMont;
+			}
+			void MulNTTInto(const Poly16 &a, const Poly16 &b) {
+				ReprCheck(a._IsNTT && b._IsNTT && b._IsMont, "MulNTTInto");
+				MUL_NTT_MONT(_poly, a._poly, b._poly, a._Param_NTT, b._Param_NTT, _Param_NTT->GetN(), _Param_NTT->GetQnum());
+				_IsNTT = true;
+				_IsMont = a._IsMont;
+			}
+			void FMAInto(const Poly16 &a, const Poly16 &b) {
+				ReprCheck(_IsNTT && a._IsNTT && b._IsNTT && b._IsMont && _IsMont == a._IsMont, "FMAInto");
+				const int N = _Param_NTT->GetN();
+				int16_t *prod = ScratchFMA(N * _Param_NTT->GetQnum());
+				MUL_NTT_MONT(prod, a._poly, b._poly, a._Param_NTT, b._Param_NTT, N, _Param_NTT->GetQnum());
+				for (int jj = 0; jj < _Param_NTT->GetQnum(); jj++) {
+					FastAddWithRangeZeroToQVec_16bit(_poly + jj*N, prod + jj*N, _poly + jj*N, _Param_NTT->GetQ(jj), 0, N);
+				}
+			}
+			void FMSInto(const Poly16 &a, const Poly16 &b) {
+				ReprCheck(_IsNTT && a._IsNTT && b._IsNTT && b._IsMont && _IsMont == a._IsMont, "FMSInto");
+				const int N = _Param_NTT->GetN();
+				int16_t *prod = ScratchFMA(N * _Param_NTT->GetQnum());
+				MUL_NTT_MONT(prod, a._poly, b._poly, a._Param_NTT, b._Param_NTT, N, _Param_NTT->GetQnum());
+				for (int jj = 0; jj < _Param_NTT->GetQnum(); jj++) {
+					FastSubWithRangeZeroToQVec_16bit(_poly + jj*N, prod + jj*N, _poly + jj*N, _Param_NTT->GetQ(jj), 0, N);
+				}
+			}
+
+		private:
+			static void ReprCheck(bool ok, const char *op) {
+				if (ok) return;
+				printf("Poly16::%s: operand representation mismatch (_IsNTT / _IsMont)\n", op);
+				fflush(stdout);
+				abort();
+			}
+			// FMA 곱 버퍼 (스레드별, 늘어나기만 함, 64B 정렬)
+			static int16_t *ScratchFMA(int len) {
+				struct Buf { int16_t *p = nullptr; int len = 0; ~Buf() { free(p); } };
+				thread_local Buf buf;
+				if (buf.len < len) {
+					free(buf.p);
+					buf.len = (len + 31) & ~31;
+					buf.p = (int16_t *)aligned_alloc(64, buf.len * sizeof(int16_t));
+				}
+				return buf.p;
+			}
+
+
 		};
 
     class Poly64 {
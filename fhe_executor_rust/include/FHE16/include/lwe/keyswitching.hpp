@@ -3,7 +3,158 @@
 
 #include<stdint.h>
 #include<FHE16Param.hpp>
+
+#if AVXTYPE == 2
+	#include<immintrin.h>
+#elif AVXTYPE == 3
+	#include<immintrin.h>
+#endif
+
 void C_KeySwitchingRawCRTBin_16bit(int32_t * val, int16_t *KS_raw_16bit, int16_t *MEMORY_HANDLE, FHE16Params *PARAM, NTTTable16Struct *st, int LOC);
 
+
+/******************************** blocked / prefetched key switching ***********************************
+* C_KeySwitchingRawCRTBin_16bit 와 같은 결과 (비트 단위 동일)를 내는 헤더 커널.
+*
+* 키 배치 (라이브러리와 동일, _KS_raw_16bit / FHE16BOOTParam::KS_raw_16bit_start):
+*   KS[((i * len + j) << base) + d][row_len],  i < kN (= n_bk * k_bk), j < gadget_len_ks, d < 2^base_ks
+*   row_len = n_lwe + 1 을 16 의 배수로 올림. 행 = d * 2^(base*j) * s_i 의 LWE 암호문 (a_0..a_{n-1}, b)
+* 계산: a_i = round(val[i] * q_ks / Q) (mod q_ks) 를 밑 2^base_ks 로 (부호 없이, 아래 자리부터) 분해하고
+*       out = (0, .., 0, round(val[kN] * q_ks / Q)) - sum_{i,j} KS[i][j][d_ij]  (mod q_ks)
+*
+* 라이브러리 커널은 계수마다 분해하자마자 그 자리의 행을 읽는다 (116 MB 표에서 자리값에 따른 임의 행).
+* 여기서는
+*   1) 모든 계수를 먼저 분해해 0 이 아닌 자리의 행 위치(int16 오프셋, int32) 목록을 만든다.
+*      (i, j) 순서로 만들므로 목록은 이미 주소 오름차순 — 정렬 없이 표를 한 방향으로만 훑는다.
+*   2) 목록을 따라 빼면서 KS_PREFETCH_DIST 개 앞의 행을 미리 가져온다 (다음 행 주소를 이미 알고 있음).
+*   3) 배치(_Batch)는 KS_BATCH_CHUNK 개의 (i, j) 블록마다 모든 암호문의 행을 처리한다.
+*      블록(2^base * row_len * 2 B, 배포 파라미터 37 KB)이 캐시에 있는 동안 여러 암호문이 읽고,
+*      같은 자리값이면 같은 행을 다시 쓴다.
+* 출력은 라이브러리와 같이 val 자리에 int16 (n_lwe + 1 개, 그 뒤 row_len 까지는 쓰레기).
+* 헤더 전용 — libFHE16 의 부트스트래핑과 애드온은 아직 쓰지 않는다. 검사: fhe_executor/FHE16/tests/test_keyswitching.cpp
+******************************************************************************************************/
+
+#ifndef KS_PREFETCH_DIST
+#define KS_PREFETCH_DIST	4		// 몇 행 앞을 미리 가져올지
+#endif
+#ifndef KS_BATCH_CHUNK
+#define KS_BATCH_CHUNK		4		// 배치에서 한 번에 훑는 (i, j) 블록 수
+#endif
+
+inline int KS16_RowLen(int n_lwe) {
+	return ((n_lwe + 1) & 15) ? ((n_lwe + 1 + 15) & ~15) : (n_lwe + 1);
+}
+
+// rows 에 필요한 int32 개수
+inline int KS16_RowsSize(const FHE16Params *PARAM) {
+	return PARAM->_n_bk * PARAM->_k_bk * PARAM->_gadget_len_ks;
+}
+
+__attribute__((always_inline)) inline void KS16_Prefetch(const int16_t *row, int row_len) {
+	const char *p = (const char *)row;
+	for (int k = 0; k < row_len * 2; k += 64) __builtin_prefetch(p + k, 0, 3);
+}
+
+__attribute__((always_inline)) inline void KS16_RowSub(int16_t *out, const int16_t *row, int row_len) {
+	int k = 0;
+#if AVXTYPE == 3
+	for (; k + 32 <= row_len; k += 32)
+		_mm512_storeu_si512(out + k, _mm512_sub_epi16(_mm512_loadu_si512(out + k), _mm512_loadu_si512(row + k)));
+#endif
+#if AVXTYPE == 2 || AVXTYPE == 3
+	for (; k + 16 <= row_len; k += 16)
+		_mm256_storeu_si256((__m256i *)(out + k), _mm256_sub_epi16(_mm256_loadu_si256((const __m256i *)(out + k)),
+		                                                           _mm256_loadu_si256((const __m256i *)(row + k))));
+#endif
+	for (; k < row_len; k++) out[k] = (int16_t)(out[k] - row[k]);
+}
+
+// 1) 모듈러스 전환 + 분해 → 0 이 아닌 자리의 행 오프셋 목록 (오름차순, *cnt 개). 반환 = b (q_ks 로 전환)
+inline int16_t KS16_CollectRows(const int32_t *val, int32_t *rows, int *cnt, const FHE16Params *PARAM, const NTTTable16Struct *st) {
+	const int kN		= PARAM->_n_bk * PARAM->_k_bk;
+	const int len		= PARAM->_gadget_len_ks;
+	const int base		= PARAM->_base_ks;
+	const int row_len	= KS16_RowLen(PARAM->_n_lwe);
+	const int16_t mask	= (int16_t)(PARAM->_q_ks - 1);
+	const int16_t dmask	= (int16_t)((1 << base) - 1);
+	const int64_t scale	= (((int64_t)1 << 48) / st->_Q_TOT) * PARAM->_q_ks;
+	const int64_t half	= (int64_t)1 << 47;
+
+	int32_t *r = rows;
+	int32_t off = 0;
+	for (int i = 0; i < kN; i++) {
+		int16_t a = (int16_t)((((int64_t)val[i] * scale + half) >> 48) & mask);
+		for (int j = 0; j < len; j++, off += row_len << base) {
+			const int d = a & dmask;
+			if (d) *r++ = off + d * row_len;
+			a = (int16_t)(a >> base);
+		}
+	}
+	*cnt = (int)(r - rows);
+	return (int16_t)((((int64_t)val[kN] * scale + half) >> 48) & mask);
+}
+
+// out[0..n) 를 q_ks 로 줄이고 b 를 더한다
+inline void KS16_Finish(int16_t *out, int16_t b, const FHE16Params *PARAM) {
+	const int n = PARAM->_n_lwe;
+	const int16_t mask = (int16_t)(PARAM->_q_ks - 1);
+	for (int k = 0; k < n; k++) out[k] &= mask;
+	out[n] = (int16_t)((out[n] + b) & mask);
+}
+
+// 단일 암호문. val: kN + 1 개 int32 입력 → n_lwe + 1 개 int16 출력 (같은 자리, row_len 까지 덮어씀). rows: KS16_RowsSize 개
+inline void C_KeySwitchingRawCRTBin_16bit_Blocked(int32_t *val, const int16_t *KS_raw_16bit, int32_t *rows, const FHE16Params *PARAM, const NTTTable16Struct *st) {
+	const int row_len = KS16_RowLen(PARAM->_n_lwe);
+	int cnt;
+	const int16_t b = KS16_CollectRows(val, rows, &cnt, PARAM, st);
+
+	int16_t *out = (int16_t *)val;
+	for (int k = 0; k < row_len; k++) out[k] = 0;
+
+	for (int t = 0; t < KS_PREFETCH_DIST && t < cnt; t++) KS16_Prefetch(KS_raw_16bit + rows[t], row_len);
+	for (int t = 0; t < cnt; t++) {
+		if (t + KS_PREFETCH_DIST < cnt) KS16_Prefetch(KS_raw_16bit + rows[t + KS_PREFETCH_DIST], row_len);
+		KS16_RowSub(out, KS_raw_16bit + rows[t], row_len);
+	}
+	KS16_Finish(out, b, PARAM);
+}
+
+// 배치: vals[c] 마다 위와 같은 입출력. rows: cnt * KS16_RowsSize 개 (암호문별 목록)
+inline void C_KeySwitchingRawCRTBin_16bit_Batch(int32_t **vals, int cnt, const int16_t *KS_raw_16bit, int32_t *rows, const FHE16Params *PARAM, const NTTTable16Struct *st) {
+	const int row_len	= KS16_RowLen(PARAM->_n_lwe);
+	const int stride	= KS16_RowsSize(PARAM);
+	const int32_t blk	= row_len << PARAM->_base_ks;
+
+	int16_t bs[64];
+	const int32_t *pos[64];
+	const int32_t *end[64];
+	for (int c0 = 0; c0 < cnt; c0 += 64) {
+		const int m = (cnt - c0 < 64) ? cnt - c0 : 64;
+		for (int c = 0; c < m; c++) {
+			int32_t *rc = rows + (int64_t)(c0 + c) * stride;
+			int n_rows;
+			bs[c]  = KS16_CollectRows(vals[c0 + c], rc, &n_rows, PARAM, st);
+			pos[c] = rc;
+			end[c] = rc + n_rows;
+			int16_t *out = (int16_t *)vals[c0 + c];
+			for (int k = 0; k < row_len; k++) out[k] = 0;
+		}
+		// (i, j) 블록 KS_BATCH_CHUNK 개씩: 그 구간의 행을 모든 암호문이 처리한 뒤 다음 구간으로
+		for (int s = 0; s < stride; s += KS_BATCH_CHUNK) {
+			const int32_t limit = (s + KS_BATCH_CHUNK < stride) ? (s + KS_BATCH_CHUNK) * blk : INT32_MAX;
+			for (int c = 0; c < m; c++) {
+				int16_t *out = (int16_t *)vals[c0 + c];
+				const int32_t *r = pos[c];
+				for (; r < end[c] && *r < limit; r++) {
+					if (r + KS_PREFETCH_DIST < end[c]) KS16_Prefetch(KS_raw_16bit + r[KS_PREFETCH_DIST], row_len);
+					KS16_RowSub(out, KS_raw_16bit + *r, row_len);
+				}
+				pos[c] = r;
+			}
+		}
+		for (int c = 0; c < m; c++) KS16_Finish((int16_t *)vals[c0 + c], bs[c], PARAM);
+	}
+}
+
 #endif // End header
 
@@ -380,6 +380,92 @@ void DecompFloatTwoPowRemoveCRT2_Base11_Remove17_Len1_16bit(	int16_t * from, int
 
 
 
+/*************************** 16bit, CRT2, any base / rm / len **************************************/
+// SignedDecompTwoPowRemoveOneCRT_16bit 의 q_len == 2 전용판 (같은 배치, 입력이 [0, q_j) 이면 같은 출력).
+//  - CRT 복원: 64비트 곱 + % 대신 Garner (x = a0 + q0 * ((a1 - a0) * q0^-1 mod q1)), mod q1 은 float 몫 + 보정
+//  - 자릿수: 분기 없이 부호 있는 하위 base 비트, 음수는 마스크로 + Q
+//  - 원소 CHUNK 개를 먼저 복원한 뒤 자릿수별로 원소 루프를 돌려 컴파일러가 벡터화할 수 있게 함
+// 입력은 (-q_j, q_j), q0 * q1 < 2^31, 0 <= rm, 1 <= base, rm + base * gl_len <= 31.
+// 음수 입력은 여기서 + q_j 로 정규화하지만 원래 함수는 하지 않으므로 (tmp % Q_tot 가 음수로 남음) 출력이 다르다.
+// 상수 (base, rm, len) 는 C++ 의 SignedDecompTwoPowRemoveCRT2_16bit_T<BASE, RM, LEN> 로 특수화 (자릿수 루프 전개)
+// 헤더 전용 — libFHE16 의 DECOMA / DECOMB 커널과 애드온은 아직 이 함수를 쓰지 않는다.
+// 스칼라 함수 / 정의와의 비교: fhe_executor/FHE16/tests/test_gadget.cpp
+
+#define DECOMP_CRT2_CHUNK	64
+
+__attribute__((always_inline)) inline void SignedDecompTwoPowRemoveCRT2Body_16bit(const int16_t * from, int16_t * to, int dim, int poly_len,  int base, int gl_len, int rm, const int16_t *Q) {
+
+	const int32_t q0 = Q[0];
+	const int32_t q1 = Q[1];
+	const int32_t Q_tot = q0 * q1;
+	const int32_t Q_over_2 = Q_tot >> 1;
+	const float inv_q1 = 1.0f / (float) q1;
+
+	// q0^-1 mod q1 (확장 유클리드)
+	int32_t r0 = q1, r1 = q0 % q1, s0 = 0, s1 = 1;
+	while (r1 != 0) {
+		int32_t qq = r0 / r1, t;
+		t = r0 - qq * r1; r0 = r1; r1 = t;
+		t = s0 - qq * s1; s0 = s1; s1 = t;
+	}
+	const int32_t q0inv = s0 + ((s0 >> 31) & q1);
+
+	const int32_t rm_mask	= (int32_t)(((int64_t)1 << rm) - 1);
+	const int32_t rm_half	= (rm_mask + 1) >> 1;
+	const int32_t base_mask	= (1 << base) - 1;
+	const int32_t base_half	= (base_mask + 1) >> 1;
+
+	int32_t v[DECOMP_CRT2_CHUNK];
+
+	for (int idx_num_poly = 0; idx_num_poly < poly_len; idx_num_poly++) {
+		const int16_t *a0p = from + idx_num_poly * dim * 2;
+		const int16_t *a1p = a0p + dim;
+		int16_t *top = to + idx_num_poly * dim * 2 * gl_len;
+
+		for (int e0 = 0; e0 < dim; e0 += DECOMP_CRT2_CHUNK) {
+			const int n = (dim - e0 < DECOMP_CRT2_CHUNK) ? dim - e0 : DECOMP_CRT2_CHUNK;
+
+			// 복원 → -Q/2 ~ Q/2 → 하위 rm 비트 제거
+			for (int ii = 0; ii < n; ii++) {
+				int32_t a0 = a0p[e0 + ii];
+				int32_t a1 = a1p[e0 + ii];
+				a0 += (a0 >> 31) & q0;
+				a1 += (a1 >> 31) & q1;
+				int32_t d = (a1 - a0) * q0inv;
+				int32_t r = d - q1 * (int32_t)((float) d * inv_q1);
+				r += (r >> 31) & q1;
+				r += (r >> 31) & q1;
+				r -= q1;
+				r += (r >> 31) & q1;
+				int32_t x = a0 + q0 * r;
+				x -= ((~(x - Q_over_2)) >> 31) & Q_tot;
+				int32_t low = x & rm_mask;
+				low -= (low & rm_half) << 1;
+				v[ii] = (x - low) >> rm;
+			}
+
+			for (int idx_gl = 0; idx_gl < gl_len; idx_gl++) {
+				int16_t *o0 = top + idx_gl * dim * 2 + e0;
+				int16_t *o1 = o0 + dim;
+				for (int ii = 0; ii < n; ii++) {
+					int32_t dg = v[ii] & base_mask;
+					dg -= (dg & base_half) << 1;
+					v[ii] = (v[ii] - dg) >> base;
+					o0[ii] = (int16_t)(dg + ((dg >> 31) & q0));
+					o1[ii] = (int16_t)(dg + ((dg >> 31) & q1));
+				}
+			}
+		}
+	}
+}
+
+inline void SignedDecompTwoPowRemoveCRT2_16bit(const int16_t * from, int16_t * to, int dim, int poly_len,  int base, int gl_len, int rm, const int16_t *Q) {
+	SignedDecompTwoPowRemoveCRT2Body_16bit(from, to, dim, poly_len, base, gl_len, rm, Q);
+}
+
+
+
+
 void DecompTwoPowRemoveCRT2_num2q_16bit_asm(	int16_t * from, int16_t * to, const int32_t * INFO, const int16_t *GADGET, int dim, int Ks);
 
 
@@ -452,5 +538,14 @@ void inline DecompTwoPow_base8_rm10_len2_32bit(int32_t * from, int32_t * to, int
 #endif
 
 
+#ifdef __cplusplus
+// 컴파일 타임 (base, rm, len) 특수화. 파라미터 세트마다 한 번씩 인스턴스화하면 자릿수 루프가 전개된다
+template<int BASE, int RM, int LEN>
+inline void SignedDecompTwoPowRemoveCRT2_16bit_T(const int16_t * from, int16_t * to, int dim, int poly_len, const int16_t *Q) {
+	static_assert(BASE >= 1 && RM >= 0 && RM + BASE * LEN <= 31, "gadget does not fit in 31 bits");
+	SignedDecompTwoPowRemoveCRT2Body_16bit(from, to, dim, poly_len, BASE, LEN, RM, Q);
+}
+#endif
+
 
 #endif
@@ -1,5 +1,7 @@
 // cxx/fhe16_capi.cc
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 
 // ✅ include 순서 주의: 이전 빌드 에러를 피하려고 권장 순서
 #include "BinOperationCstyle.hpp"
@@ -7,11 +9,19 @@
 // (필요 시) 내부 타입/선언 선행 노출
 #include "math/ntttable.hpp"
 #include "lwe/FHE16Param.hpp"
+#include "Core.hpp"
+
+// 직렬화 함수는 soAPI.hpp 에 선언이 없고 (C++ 링키지), 배포본에 따라 export 되지 않는다
+// → weak 로 선언해 없으면 null (fhe16_lwe_*_bytes 가 -1 반환)
+int lwe_to_bytes_meta_safe(const int32_t* ct, char** out, size_t* len) __attribute__((weak));
+int lwe_from_bytes_meta_safe(const char* buf, size_t len, int32_t** out) __attribute__((weak));
 
 extern "C" {
 
 // ---------- Eval key ----------
 void fhe16_load_eval() { FHE16_LoadEval(); }
+// FHE16_LoadEval 은 반환값이 없다 → 평가 키가 실제로 생겼는지 (1 / 0)
+int fhe16_eval_ready() { return (G_FHE16_PARAM && G_FHE16_PARAM->GetEV()) ? 1 : 0; }
 int32_t* fhe16_gen_eval() { return FHE16_GenEval(); }
 void fhe16_delete_eval() { FHE16_DeleteEval(); }
 
@@ -138,5 +148,81 @@ int32_t* fhe16_neq(const int32_t* a, const int32_t* b) { return FHE16_NEQ(const_
 // ---------- Plain ----------
 int32_t fhe16_lzc_plain(int x) { return FHE16_LZC_Plain(x); }
 
+// ---------- Memory / serialization ----------
+// 라이브러리 결과 암호문은 aligned_alloc(64) 로 할당 → free 로 해제. Rust 쪽에서 만드는 암호문도 같은 방식
+// (AVX-512 커널이 정렬 로드를 쓸 수 있게). aligned_alloc 은 크기가 정렬의 배수여야 한다
+void fhe16_free_ct(int32_t* ct) { std::free(ct); }
+int32_t* fhe16_ct_alloc(size_t words) {
+    const size_t bytes = (words * sizeof(int32_t) + 63) & ~(size_t)63;
+    return static_cast<int32_t*>(std::aligned_alloc(64, bytes ? bytes : 64));
+}
+void fhe16_free_bytes(char* p) { std::free(p); }
+
+int fhe16_lwe_to_bytes(const int32_t* ct, char** out, size_t* len) {
+    if (!lwe_to_bytes_meta_safe) return -1;
+    return lwe_to_bytes_meta_safe(ct, out, len);
+}
+int fhe16_lwe_from_bytes(const char* buf, size_t len, int32_t** out) {
+    if (!lwe_from_bytes_meta_safe) return -1;
+    return lwe_from_bytes_meta_safe(buf, len, out);
+}
+
+// ---------- Threads ----------
+int fhe16_physical_cores() { return get_physical_core_count(); }
+
+// ---------- NTT tuning ----------
+// NTTTable16Const 는 모듈러스별 NTT 깊이(incomplete NTT)로 커널 함수 포인터를 고른다.
+// 표 하나 = 모듈러스 하나. 커널 정보 포인터는 EFHEs::NTTTable16::GetNTTDATAIdx / GetDATA 와 같은 규칙
+NTTTable16Struct* fhe16_ntt_table_new(int n, int16_t q, int depth) {
+    NTTTable16Struct* st = nullptr;
+    try {
+        NTTTable16Const(st, &q, &depth, n, 1);
+    } catch (...) {
+        if (st) NTTTable16Decon(st);
+        return nullptr;
+    }
+    if (st && (!st->_NTT_TO_MONT || !st->_NTT_TO_MONT[0] || !st->_INTT_TO_MONT || !st->_INTT_TO_MONT[0])) {
+        NTTTable16Decon(st);
+        return nullptr;
+    }
+    return st;
+}
+void fhe16_ntt_table_free(NTTTable16Struct* st) {
+    if (st) NTTTable16Decon(st);
+}
+
+static const int16_t* ntt_info(const NTTTable16Struct* st) { return st->_QNTTINFO + st->_Gadget_END_idx + st->_QINFO_start_arr[0]; }
+
+// x → y (NTT, 몽고메리 표현)
+void fhe16_ntt_forward(const NTTTable16Struct* st, int16_t* x, int16_t* y) {
+    st->_NTT_TO_MONT[0](ntt_info(st), x, y, st->_QINFO);
+}
+void fhe16_ntt_inverse(const NTTTable16Struct* st, int16_t* x, int16_t* y) {
+    st->_INTT_TO_MONT[0](ntt_info(st), x, y, st->_QINFO);
+}
+// NTT 영역 점별 곱 (없으면 -1)
+int fhe16_ntt_mul(const NTTTable16Struct* st, int16_t* res, int16_t* x, int16_t* y) {
+    if (!st->_MUL_MONT_IN_NTT || !st->_MUL_MONT_IN_NTT[0]) return -1;
+    st->_MUL_MONT_IN_NTT[0](res, x, y, ntt_info(st), st->_QINFO);
+    return 0;
+}
+// 표가 실제로 쓰는 깊이 (QDATA_QDEPTH)
+int fhe16_ntt_table_depth(const NTTTable16Struct* st) { return st->_QINFO[QDATA_QDEPTH]; }
+
+// 로드된 평가 키가 쓰는 표: 링 차수 n, 모듈러스별 q / 깊이. 반환 = 모듈러스 수 (키가 없으면 -1)
+int fhe16_ntt_live(int* n, int16_t* q, int* depth, int max) {
+    if (!G_FHE16_PARAM || !G_FHE16_PARAM->GetST()) return -1;
+    const NTTTable16Struct* st = G_FHE16_PARAM->GetST();
+    *n = st->_N;
+    for (int i = 0; i < st->_Q_num && i < max; ++i) {
+        q[i]     = (int16_t)st->_QINFO[QDATA_Q + i * QDATA_LEN];
+        depth[i] = st->_QINFO[QDATA_QDEPTH + i * QDATA_LEN];
+    }
+    return st->_Q_num;
+}
+
+// 라이브러리 빌드의 커널 ISA (CMAKEPARAM.h AVXTYPE: 2 = AVX2)
+int fhe16_kernel_isa() { return AVXTYPE; }
+
 } // extern "C"
 
@@ -0,0 +1,219 @@
+// bench.rs — FHE16 연산별 지연시간 / 처리량 벤치마크 (JSON 출력)
+//
+//   cargo run --release --bin bench -- [--ops add,ge,...] [--bits 8,16,32] [--threads 1,2,4]
+//                                      [--samples 10] [--warmup 1] [--batch-per-thread 4] [--out bench.json]
+//
+// 지연시간 : 단일 스레드에서 연산 1회씩 samples 번 (min / median / mean / p95 / max, ms)
+// 처리량   : threads 개 스레드로 독립 연산 threads * batch-per-thread 개를 실행 (ops/s)
+//            라이브러리 호출은 Context 가 직렬화하므로 스레드를 늘려도 연산은 한 번에 하나씩 돈다
+// 결과 JSON 은 --out 파일(기본: stdout)로. 커널 변경 전/후 비교, 회귀 감지, 장비 산정용
+//
+// criterion / Google Benchmark 가 아닌 직접 만든 측정기다. 오프라인 빌드 환경에서는 새 크레이트를 받을 수 없고
+// (Cargo.lock 은 cc / libc / libloading 뿐), 필요한 통계 (백분위, 스레드 수별 ops/s) 는 여기서 충분하다.
+// criterion 의 이상치 분석 / 기준선 저장은 없으므로 회귀는 두 실행의 JSON 을 직접 비교해서 본다.
+
+use fhe16_wrapper::*;
+use std::os::raw::c_int;
+use std::time::Instant;
+
+// 입력 암호문: a, b, c, d (d 는 SDIV 보조 입력)
+struct Inputs {
+    a: Ciphertext,
+    b: Ciphertext,
+    c: Ciphertext,
+    d: Ciphertext,
+    sel: Ciphertext,
+}
+
+type OpFn = fn(&Inputs) -> Ct;
+
+// 이름, 호출 (입력 암호문은 Inputs 에서)
+const OPS: &[(&str, OpFn)] = &[
+    ("add", |x| unsafe { fhe16_add(x.a.as_ptr(), x.b.as_ptr()) }),
+    ("add3", |x| unsafe { fhe16_add3(x.a.as_ptr(), x.b.as_ptr(), x.c.as_ptr()) }),
+    ("sub", |x| unsafe { fhe16_sub(x.a.as_ptr(), x.b.as_ptr()) }),
+    ("ge", |x| unsafe { fhe16_ge(x.a.as_ptr(), x.b.as_ptr()) }),
+    ("gt", |x| unsafe { fhe16_gt(x.a.as_ptr(), x.b.as_ptr()) }),
+    ("lt", |x| unsafe { fhe16_lt(x.a.as_ptr(), x.b.as_ptr()) }),
+    ("le", |x| unsafe { fhe16_le(x.a.as_ptr(), x.b.as_ptr()) }),
+    ("eq", |x| unsafe { fhe16_eq(x.a.as_ptr(), x.b.as_ptr()) }),
+    ("neq", |x| unsafe { fhe16_neq(x.a.as_ptr(), x.b.as_ptr()) }),
+    ("max", |x| unsafe { fhe16_max(x.a.as_ptr(), x.b.as_ptr()) }),
+    ("min", |x| unsafe { fhe16_min(x.a.as_ptr(), x.b.as_ptr()) }),
+    ("and", |x| unsafe { fhe16_andvec(x.a.as_ptr(), x.b.as_ptr()) }),
+    ("or", |x| unsafe { fhe16_orvec(x.a.as_ptr(), x.b.as_ptr()) }),
+    ("xor", |x| unsafe { fhe16_xorvec(x.a.as_ptr(), x.b.as_ptr()) }),
+    ("select", |x| unsafe { fhe16_select(x.sel.as_ptr(), x.a.as_ptr(), x.b.as_ptr()) }),
+    ("smull", |x| unsafe { fhe16_smull(x.a.as_ptr(), x.b.as_ptr()) }),
+    ("sdiv", |x| unsafe { fhe16_sdiv(x.a.as_ptr(), x.b.as_ptr(), x.c.as_ptr(), x.d.as_ptr()) }),
+    ("relu", |x| unsafe { fhe16_relu(x.a.as_ptr()) }),
+    ("neg", |x| unsafe { fhe16_neg(x.a.as_ptr()) }),
+    ("abs", |x| unsafe { fhe16_abs(x.a.as_ptr()) }),
+    ("add_constant", |x| unsafe { fhe16_add_constant_i32(x.a.as_ptr(), 12345 as c_int) }),
+    ("smull_constant", |x| unsafe { fhe16_smull_constant_i32(x.a.as_ptr(), -312 as c_int) }),
+    ("add_pow2", |x| unsafe { fhe16_add_powtwo(x.a.as_ptr(), 3) }),
+    ("sub_pow2", |x| unsafe { fhe16_sub_powtwo(x.a.as_ptr(), 3) }),
+    ("lshiftl", |x| unsafe { fhe16_lshiftl(x.a.as_ptr(), 3) }),
+    ("lshiftr", |x| unsafe { fhe16_lshiftr(x.a.as_ptr(), 3) }),
+    ("ashiftr", |x| unsafe { fhe16_ashiftr(x.a.as_ptr(), 3) }),
+    ("rotatel", |x| unsafe { fhe16_rotatel(x.a.as_ptr(), 3) }),
+    ("rotater", |x| unsafe { fhe16_rotater(x.a.as_ptr(), 3) }),
+];
+
+struct Args {
+    ops: Vec<String>,
+    bits: Vec<i32>,
+    threads: Vec<usize>,
+    samples: usize,
+    warmup: usize,
+    batch_per_thread: usize,
+    out: Option<String>,
+}
+
+fn parse_list<T: std::str::FromStr>(flag: &str, v: &str) -> Vec<T> {
+    v.split(',')
+        .filter(|s| !s.is_empty())
+        .map(|s| s.parse().unwrap_or_else(|_| panic!("{flag}: invalid value `{s}`")))
+        .collect()
+}
+
+fn parse_args(cores: usize) -> Args {
+    let mut a = Args {
+        ops: OPS.iter().map(|(n, _)| n.to_string()).collect(),
+        bits: vec![8, 16, 32],
+        threads: vec![1, cores],
+        samples: 10,
+        warmup: 1,
+        batch_per_thread: 4,
+        out: None,
+    };
+    let argv: Vec<String> = std::env::args().skip(1).collect();
+    let mut i = 0;
+    while i < argv.len() {
+        let flag = argv[i].as_str();
+        let val = argv.get(i + 1).cloned().unwrap_or_else(|| panic!("{flag}: missing value"));
+        match flag {
+            "--ops" => a.ops = parse_list(flag, &val),
+            "--bits" => a.bits = parse_list(flag, &val),
+            "--threads" => a.threads = parse_list(flag, &val),
+            "--samples" => a.samples = val.parse().expect("--samples: number"),
+            "--warmup" => a.warmup = val.parse().expect("--warmup: number"),
+            "--batch-per-thread" => a.batch_per_thread = val.parse().expect("--batch-per-thread: number"),
+            "--out" => a.out = Some(val),
+            _ => panic!("unknown flag `{flag}`"),
+        }
+        i += 2;
+    }
+    for op in &a.ops {
+        assert!(OPS.iter().any(|(n, _)| n == op), "unknown op `{op}`");
+    }
+    a.threads.dedup();
+    a.samples = a.samples.max(1);
+    a.batch_per_thread = a.batch_per_thread.max(1);
+    a
+}
+
+fn run_op(f: OpFn, x: &Inputs, name: &str) -> Ciphertext {
+    let ct = f(x);
+    assert!(!ct.is_null(), "{name} returned null");
+    unsafe { Ciphertext::from_raw(ct) }
+}
+
+struct Summary {
+    min: f64,
+    median: f64,
+    mean: f64,
+    p95: f64,
+    max: f64,
+}
+
+fn summarize(mut ms: Vec<f64>) -> Summary {
+    ms.sort_by(|a, b| a.partial_cmp(b).unwrap());
+    let n = ms.len();
+    let pct = |p: f64| ms[(((n - 1) as f64) * p).round() as usize];
+    Summary {
+        min: ms[0],
+        median: pct(0.5),
+        mean: ms.iter().sum::<f64>() / n as f64,
+        p95: pct(0.95),
+        max: ms[n - 1],
+    }
+}
+
+// 독립 연산 n 개를 threads 개 스레드로 실행하고 걸린 시간(ms)
+fn run_batch(ctx: &Context, threads: usize, n: usize, f: OpFn, x: &Inputs, name: &str) -> f64 {
+    let t0 = Instant::now();
+    ctx.set_threads(threads);
+    ctx.map_many(n, |_| ctx.exclusive(|| run_op(f, x, name)));
+    t0.elapsed().as_secs_f64() * 1e3
+}
+
+fn main() {
+    check_system_env();
+
+    let ctx = Context::generate().expect("FHE16 context");
+    let cores = ctx.threads();
+    let args = parse_args(cores);
+
+    let mut rows = Vec::new();
+    for &bits in &args.bits {
+        let x = Inputs {
+            a: ctx.encrypt(126, bits).expect("encrypt"),
+            b: ctx.encrypt(-73, bits).expect("encrypt"),
+            c: ctx.encrypt(5, bits).expect("encrypt"),
+            d: ctx.encrypt(0, bits).expect("encrypt"),
+            sel: ctx.encrypt(1, bits).expect("encrypt"),
+        };
+
+        for name in &args.ops {
+            let f = OPS.iter().find(|(n, _)| n == name).unwrap().1;
+
+            for _ in 0..args.warmup {
+                run_op(f, &x, name);
+            }
+            let lat: Vec<f64> = (0..args.samples)
+                .map(|_| {
+                    let t0 = Instant::now();
+                    let _r = run_op(f, &x, name);
+                    t0.elapsed().as_secs_f64() * 1e3
+                })
+                .collect();
+            let s = summarize(lat);
+            eprintln!("[bench] {name:<15} {bits:>2}bit  median {:>9.3} ms  p95 {:>9.3} ms", s.median, s.p95);
+
+            let mut tput = Vec::new();
+            for &t in &args.threads {
+                let n = t.max(1) * args.batch_per_thread;
+                let ms = run_batch(&ctx, t.max(1), n, f, &x, name);
+                let ops_s = n as f64 / (ms / 1e3);
+                eprintln!("[bench] {name:<15} {bits:>2}bit  {t:>3} threads  {ops_s:>10.2} ops/s");
+                tput.push(format!(
+                    "{{\"threads\":{t},\"ops\":{n},\"elapsed_ms\":{ms:.3},\"ops_per_s\":{ops_s:.3}}}"
+                ));
+            }
+
+            rows.push(format!(
+                "{{\"op\":\"{name}\",\"bits\":{bits},\"samples\":{},\"latency_ms\":{{\"min\":{:.3},\"median\":{:.3},\"mean\":{:.3},\"p95\":{:.3},\"max\":{:.3}}},\"throughput\":[{}]}}",
+                args.samples, s.min, s.median, s.mean, s.p95, s.max, tput.join(",")
+            ));
+        }
+    }
+
+    let ts = std::time::SystemTime::now()
+        .duration_since(std::time::UNIX_EPOCH)
+        .map(|d| d.as_secs())
+        .unwrap_or(0);
+    let json = format!(
+        "{{\"version\":1,\"timestamp\":{ts},\"physical_cores\":{cores},\"warmup\":{},\"batch_per_thread\":{},\"results\":[\n  {}\n]}}\n",
+        args.warmup,
+        args.batch_per_thread,
+        rows.join(",\n  ")
+    );
+    match &args.out {
+        Some(path) => {
+            std::fs::write(path, json).expect("write --out");
+            eprintln!("[bench] wrote {path}");
+        }
+        None => print!("{json}"),
+    }
+}
@@ -0,0 +1,232 @@
+// ntt_tune.rs — NTT 깊이(incomplete NTT) 별 커널 벤치마크 + 장비별 튜닝 프로필
+//
+//   cargo run --release --bin ntt_tune -- [--n 512,1024,2048,4096] [--q 12289,18433] [--depths 0,1,2,3]
+//                                         [--iters 200] [--samples 15] [--out ntt_profile.txt] [--json ntt_tune.json]
+//
+// (n, q, 깊이) 마다 NTTTable16Const 로 표를 만들어
+//   1) INTT(NTT(x)) = c·x (mod q) 로 커널을 검증하고 (틀린 조합은 제외)
+//   2) NTT + INTT + 점별 곱 1회를 iters 번 돌린 평균을 samples 번 재서 중앙값(ns)을 구한 뒤
+//   3) (n, q) 마다 가장 빠른 깊이를 프로필(--out)에 쓴다. 전체 결과는 --json 으로.
+// 커널 ISA 는 라이브러리 빌드가 정한다 (AVXTYPE). 다른 ISA 빌드의 프로필은 NttProfile::load 가 거절한다.
+// 깊이는 부트스트랩 키 형식도 정하므로, 프로필은 키를 새로 만들 때 적용된다 (FHE16_NTT_PROFILE 로 현재 키와 비교).
+
+use fhe16_wrapper::*;
+use std::time::Instant;
+
+struct Args {
+    n: Vec<usize>,
+    q: Vec<i16>,
+    depths: Vec<i32>,
+    iters: usize,
+    samples: usize,
+    out: String,
+    json: Option<String>,
+}
+
+fn parse_list<T: std::str::FromStr>(flag: &str, v: &str) -> Vec<T> {
+    v.split(',')
+        .filter(|s| !s.is_empty())
+        .map(|s| s.parse().unwrap_or_else(|_| panic!("{flag}: invalid value `{s}`")))
+        .collect()
+}
+
+fn parse_args() -> Args {
+    let mut a = Args {
+        n: vec![512, 1024, 2048, 4096],
+        q: vec![12289, 18433],
+        depths: vec![0, 1, 2, 3],
+        iters: 200,
+        samples: 15,
+        out: "ntt_profile.txt".to_string(),
+        json: None,
+    };
+    let argv: Vec<String> = std::env::args().skip(1).collect();
+    let mut i = 0;
+    while i < argv.len() {
+        let flag = argv[i].as_str();
+        let val = argv.get(i + 1).cloned().unwrap_or_else(|| panic!("{flag}: missing value"));
+        match flag {
+            "--n" => a.n = parse_list(flag, &val),
+            "--q" => a.q = parse_list(flag, &val),
+            "--depths" => a.depths = parse_list(flag, &val),
+            "--iters" => a.iters = val.parse().expect("--iters: number"),
+            "--samples" => a.samples = val.parse().expect("--samples: number"),
+            "--out" => a.out = val,
+            "--json" => a.json = Some(val),
+            _ => panic!("unknown flag `{flag}`"),
+        }
+        i += 2;
+    }
+    a.iters = a.iters.max(1);
+    a.samples = a.samples.max(1);
+    a
+}
+
+// xorshift (재현 가능한 입력)
+fn random_poly(n: usize, q: i16, seed: u64) -> Vec<i16> {
+    let mut s = seed | 1;
+    (0..n)
+        .map(|_| {
+            s ^= s << 13;
+            s ^= s >> 7;
+            s ^= s << 17;
+            (s % q as u64) as i16
+        })
+        .collect()
+}
+
+fn pow_mod(mut b: i64, mut e: i64, m: i64) -> i64 {
+    let mut r = 1;
+    b = b.rem_euclid(m);
+    while e > 0 {
+        if e & 1 == 1 {
+            r = r * b % m;
+        }
+        b = b * b % m;
+        e >>= 1;
+    }
+    r
+}
+
+// INTT(NTT(x)) 가 x 의 상수배인지 (몽고메리 / 1/n 스케일과 무관하게 검증)
+fn verify(t: &NttTable, q: i16) -> bool {
+    let n = t.len();
+    let x = random_poly(n, q, 0x9e3779b97f4a7c15);
+    let (mut xs, mut y, mut ys, mut z) = (x.clone(), vec![0i16; n], vec![0i16; n], vec![0i16; n]);
+    t.forward(&mut xs, &mut y);
+    ys.copy_from_slice(&y);
+    t.inverse(&mut ys, &mut z);
+
+    let m = q as i64;
+    let Some(i0) = x.iter().position(|&v| v != 0) else { return false };
+    let c = (z[i0] as i64).rem_euclid(m) * pow_mod(x[i0] as i64, m - 2, m) % m;
+    c != 0 && x.iter().zip(&z).all(|(&a, &b)| (a as i64 * c - b as i64).rem_euclid(m) == 0)
+}
+
+// NTT + INTT + 점별 곱 1회 (ns)
+fn measure(t: &NttTable, q: i16, iters: usize, samples: usize) -> (f64, f64, f64, f64) {
+    let n = t.len();
+    let x = random_poly(n, q, 7);
+    let (mut a, mut b, mut c, mut r) = (x.clone(), vec![0i16; n], x.clone(), vec![0i16; n]);
+    let mut fwd = Vec::with_capacity(samples);
+    let mut inv = Vec::with_capacity(samples);
+    let mut mul = Vec::with_capacity(samples);
+    for _ in 0..samples {
+        let t0 = Instant::now();
+        for _ in 0..iters {
+            a.copy_from_slice(&x);
+            t.forward(&mut a, &mut b);
+        }
+        let t1 = Instant::now();
+        for _ in 0..iters {
+            c.copy_from_slice(&b);
+            t.inverse(&mut c, &mut a);
+        }
+        let t2 = Instant::now();
+        let mut has_mul = true;
+        for _ in 0..iters {
+            has_mul = t.mul(&mut r, &mut b, &mut c);
+        }
+        let t3 = Instant::now();
+        let per = |d: std::time::Duration| d.as_secs_f64() * 1e9 / iters as f64;
+        fwd.push(per(t1 - t0));
+        inv.push(per(t2 - t1));
+        mul.push(if has_mul { per(t3 - t2) } else { 0.0 });
+    }
+    let median = |mut v: Vec<f64>| {
+        v.sort_by(|a, b| a.partial_cmp(b).unwrap());
+        v[v.len() / 2]
+    };
+    let (f, i, m) = (median(fwd), median(inv), median(mul));
+    (f, i, m, f + i + m)
+}
+
+fn cpu_features() -> Vec<&'static str> {
+    let mut v = Vec::new();
+    #[cfg(any(target_arch = "x86", target_arch = "x86_64"))]
+    {
+        if is_x86_feature_detected!("sse4.1") {
+            v.push("sse4.1");
+        }
+        if is_x86_feature_detected!("avx") {
+            v.push("avx");
+        }
+        if is_x86_feature_detected!("avx2") {
+            v.push("avx2");
+        }
+        if is_x86_feature_detected!("avx512f") {
+            v.push("avx512f");
+        }
+        if is_x86_feature_detected!("avx512bw") {
+            v.push("avx512bw");
+        }
+    }
+    v
+}
+
+fn main() {
+    let args = parse_args();
+    let isa = kernel_isa();
+    let features = cpu_features();
+    eprintln!("[ntt_tune] kernels: {isa}, cpu: {}", features.join(" "));
+
+    let mut profile = NttProfile { isa: isa.to_string(), entries: Vec::new() };
+    let mut rows = Vec::new();
+
+    for &n in &args.n {
+        for &q in &args.q {
+            let mut best: Option<NttChoice> = None;
+            for &d in &args.depths {
+                let Some(t) = NttTable::new(n, q, d) else {
+                    eprintln!("[ntt_tune] n={n:<5} q={q:<6} depth {d}: no kernel");
+                    continue;
+                };
+                let used = t.depth();
+                if used != d {
+                    eprintln!("[ntt_tune] n={n:<5} q={q:<6} depth {d}: library uses depth {used}, skipped");
+                    continue;
+                }
+                let ok = verify(&t, q);
+                if !ok {
+                    eprintln!("[ntt_tune] n={n:<5} q={q:<6} depth {d}: round trip FAILED, skipped");
+                    rows.push(format!("{{\"n\":{n},\"q\":{q},\"depth\":{d},\"ok\":false}}"));
+                    continue;
+                }
+                let (f, i, m, total) = measure(&t, q, args.iters, args.samples);
+                eprintln!(
+                    "[ntt_tune] n={n:<5} q={q:<6} depth {d}: ntt {f:>9.1} ns  intt {i:>9.1} ns  mul {m:>8.1} ns  total {total:>9.1} ns"
+                );
+                rows.push(format!(
+                    "{{\"n\":{n},\"q\":{q},\"depth\":{d},\"ok\":true,\"ntt_ns\":{f:.1},\"intt_ns\":{i:.1},\"mul_ns\":{m:.1},\"total_ns\":{total:.1}}}"
+                ));
+                if best.as_ref().map_or(true, |b| total < b.ns) {
+                    best = Some(NttChoice { n: n as i32, q, depth: d, ns: total });
+                }
+            }
+            if let Some(b) = best {
+                eprintln!("[ntt_tune] n={n:<5} q={q:<6} → depth {} ({:.1} ns)", b.depth, b.ns);
+                profile.entries.push(b);
+            }
+        }
+    }
+
+    std::fs::write(&args.out, profile.to_text()).expect("write --out");
+    eprintln!("[ntt_tune] wrote {} ({} entries)", args.out, profile.entries.len());
+
+    if let Some(path) = &args.json {
+        let ts = std::time::SystemTime::now()
+            .duration_since(std::time::UNIX_EPOCH)
+            .map(|d| d.as_secs())
+            .unwrap_or(0);
+        let feats: Vec<String> = features.iter().map(|f| format!("\"{f}\"")).collect();
+        let json = format!(
+            "{{\"version\":1,\"timestamp\":{ts},\"kernel_isa\":\"{isa}\",\"cpu_features\":[{}],\"iters\":{},\"samples\":{},\"results\":[\n  {}\n]}}\n",
+            feats.join(","),
+            args.iters,
+            args.samples,
+            rows.join(",\n  ")
+        );
+        std::fs::write(path, json).expect("write --json");
+        eprintln!("[ntt_tune] wrote {path}");
+    }
+}
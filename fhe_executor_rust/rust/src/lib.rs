@@ -1,5 +1,7 @@
-use std::os::raw::c_int;
+use std::os::raw::{c_char, c_int, c_void};
 use std::process::exit;
+use std::sync::atomic::{AtomicBool, AtomicUsize, Ordering};
+use std::sync::Mutex;
 //use std::ffi::c_int;
 
 
@@ -119,6 +121,7 @@ pub fn check_system_env() {
 extern "C" {
     // Eval key
     pub fn fhe16_load_eval();
+    pub fn fhe16_eval_ready() -> c_int;
     pub fn fhe16_gen_eval() -> Sk;
     pub fn fhe16_delete_eval();
 
@@ -194,17 +197,126 @@ extern "C" {
     // Plain
     pub fn fhe16_lzc_plain(x: c_int) -> c_int;
 
-    // 해제 API가 있으면 아래에 extern "C" 선언 추가 (그리고 Drop 구현)
-    // fn fhe16_free_ct(ct: *mut i32);
-    // fn fhe16_free_sk(sk: *mut i32);
+    // Memory / serialization
+    pub fn fhe16_free_ct(ct: Ct);
+    pub fn fhe16_ct_alloc(words: usize) -> Ct;
+    pub fn fhe16_free_bytes(p: *mut c_char);
+    pub fn fhe16_lwe_to_bytes(ct: *const i32, out: *mut *mut c_char, len: *mut usize) -> c_int;
+    pub fn fhe16_lwe_from_bytes(buf: *const c_char, len: usize, out: *mut Ct) -> c_int;
+
+    // Threads
+    pub fn fhe16_physical_cores() -> c_int;
+
+    // NTT tuning
+    pub fn fhe16_ntt_table_new(n: c_int, q: i16, depth: c_int) -> *mut c_void;
+    pub fn fhe16_ntt_table_free(st: *mut c_void);
+    pub fn fhe16_ntt_forward(st: *const c_void, x: *mut i16, y: *mut i16);
+    pub fn fhe16_ntt_inverse(st: *const c_void, x: *mut i16, y: *mut i16);
+    pub fn fhe16_ntt_mul(st: *const c_void, res: *mut i16, x: *mut i16, y: *mut i16) -> c_int;
+    pub fn fhe16_ntt_table_depth(st: *const c_void) -> c_int;
+    pub fn fhe16_ntt_live(n: *mut c_int, q: *mut i16, depth: *mut c_int, max: c_int) -> c_int;
+    pub fn fhe16_kernel_isa() -> c_int;
 }
 
+// 암호문 배치: 메타 16 워드 + 비트당 1040 워드. 메타[0] = 비트 수, 메타[1] = 비트당 워드 수 (1040)
+pub const CT_META: usize = 16;
+pub const LWE_WORDS: usize = 1040;
+pub const CT_WORDS: usize = CT_META + LWE_WORDS * 32;
+
+// 메타[0..2] 로 전체 워드 수 계산. 비정상 값이면 None
+fn ct_words_from_meta(bits: i32, words_per_bit: i32) -> Option<usize> {
+    if (1..=64).contains(&bits) && words_per_bit as usize == LWE_WORDS {
+        Some(CT_META + bits as usize * LWE_WORDS)
+    } else {
+        None
+    }
+}
+
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub enum Error {
+    /// 라이브러리 연산이 null 을 반환
+    Null(&'static str),
+    /// 입력이 암호문 배치와 맞지 않음
+    Format(String),
+    /// 링크된 libFHE16 에 해당 기능이 없음
+    Unsupported(&'static str),
+    /// 배치 연산의 입력 개수가 서로 다름
+    LengthMismatch { left: usize, right: usize },
+    /// Context 는 프로세스에 하나만 (libFHE16 전역 키 상태)
+    ContextExists,
+    /// 비밀키 없이 만든 Context 로 복호화
+    NoSecretKey,
+    /// FHE16_LoadEval 후에도 평가 키가 없음 (키 파일 없음 / 형식 불일치)
+    NoEvalKey,
+}
+
+impl std::fmt::Display for Error {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        match self {
+            Error::Null(op) => write!(f, "{op} returned null"),
+            Error::Format(msg) => write!(f, "invalid ciphertext: {msg}"),
+            Error::Unsupported(what) => write!(f, "{what} is not exported by the linked libFHE16"),
+            Error::LengthMismatch { left, right } => write!(f, "batch length mismatch: {left} vs {right}"),
+            Error::ContextExists => write!(f, "an FHE16 context is already alive in this process"),
+            Error::NoSecretKey => write!(f, "context has no secret key"),
+            Error::NoEvalKey => write!(f, "FHE16_LoadEval did not load an evaluation key"),
+        }
+    }
+}
+
+impl std::error::Error for Error {}
+
+pub type Result<T> = std::result::Result<T, Error>;
+
+// ===== 라이브러리 호출 직렬화 =====
+//
+// 배포된 libFHE16 은 부트스트랩 / 키 스위칭 스크래치 버퍼를 호출 스레드가 올라간 CPU(get_core_id, sched_getcpu)로
+// 고르므로, 고정되지 않은 두 스레드가 동시에 부르면 같은 버퍼를 써서 암호문이 조용히 깨진다.
+// 그래서 이 크레이트의 안전한 API 는 라이브러리 호출을 모두 프로세스 전역 잠금 하나(NATIVE) 안에서 한다
+// (재진입 가능한 C 컨텍스트가 생기기 전까지). 예외는 fhe16_free_ct / fhe16_ct_alloc / fhe16_free_bytes 로,
+// 할당기만 부르므로 잠그지 않는다 (Drop 이 잠금 안에서 불려도 교착되지 않게).
+static NATIVE: Mutex<()> = Mutex::new(());
+
+/// 라이브러리 호출을 전역 잠금 안에서 실행 (한 번에 하나). 원시 FFI 를 직접 부를 때 쓴다.
+/// f 안에서 이 크레이트의 다른 연산을 부르면 교착된다.
+pub fn exclusive<T>(f: impl FnOnce() -> T) -> T {
+    // 잠금은 () 만 지키므로 다른 스레드의 panic 으로 오염돼도 그대로 쓴다
+    let _g = NATIVE.lock().unwrap_or_else(|e| e.into_inner());
+    f()
+}
+
+// 비밀키 메모리는 라이브러리 소유 (FHE16_DeleteEval 이 정리) → Drop 없음
 pub struct SecretKey(pub Sk);
-pub struct Ciphertext(pub Ct);
+
+// 읽기 전용 포인터로만 라이브러리에 넘기고, 넘기는 호출은 모두 NATIVE 안에서 하므로 스레드 간 공유 가능
+unsafe impl Send for SecretKey {}
+unsafe impl Sync for SecretKey {}
+
+/// 라이브러리가 할당한 암호문을 소유. Drop 시 fhe16_free_ct 로 해제
+pub struct Ciphertext(Ct);
+
+// 포인터를 스레드 간에 넘기고 같은 암호문을 여러 스레드가 읽는 것은 안전 (연산은 입력을 읽기만 한다).
+// 라이브러리 연산은 모두 NATIVE 로 직렬화된다
+unsafe impl Send for Ciphertext {}
+unsafe impl Sync for Ciphertext {}
+
+impl Drop for Ciphertext {
+    fn drop(&mut self) {
+        if !self.0.is_null() {
+            unsafe { fhe16_free_ct(self.0) }
+        }
+    }
+}
+
+impl Clone for Ciphertext {
+    fn clone(&self) -> Self {
+        Ciphertext::from_words(self.as_words()).expect("clone of a valid ciphertext")
+    }
+}
 
 impl SecretKey {
     pub fn gen() -> Self {
-        let sk = unsafe { fhe16_gen_eval() };
+        let sk = exclusive(|| unsafe { fhe16_gen_eval() });
         assert!(!sk.is_null(), "fhe16_gen_eval returned null");
         SecretKey(sk)
     }
@@ -267,71 +379,170 @@ impl LiqResult {
 }
 
 impl Ciphertext {
-    pub fn encrypt_i32(m: i32, msg_bit: i32) -> Self {
-        let ct = unsafe { fhe16_enc_int(m as c_int, msg_bit as c_int) };
-        assert!(!ct.is_null(), "fhe16_enc_int returned null");
+    /// 라이브러리가 malloc 으로 할당한 암호문의 소유권을 가져온다
+    ///
+    /// # Safety
+    /// `ct` 는 null 이 아니고, 메타가 올바른 암호문이며, 다른 곳에서 해제하지 않아야 한다.
+    pub unsafe fn from_raw(ct: Ct) -> Self {
+        Ciphertext(ct)
+    }
+
+    /// 소유권을 넘긴다 (호출자가 fhe16_free_ct 로 해제)
+    pub fn into_raw(self) -> Ct {
+        let ct = self.0;
+        std::mem::forget(self);
+        ct
+    }
+
+    pub fn as_ptr(&self) -> *const i32 {
+        self.0
+    }
+
+    // 연산 결과 포인터 → 소유 암호문
+    fn wrap(ct: Ct, op: &'static str) -> Result<Self> {
+        if ct.is_null() { Err(Error::Null(op)) } else { Ok(Ciphertext(ct)) }
+    }
+
+    // 결과를 바로 돌려주는 기존 API 용: 잠금 안에서 부르고 null 이면 panic
+    fn call(op: &'static str, f: impl FnOnce() -> Ct) -> Self {
+        let ct = exclusive(f);
+        assert!(!ct.is_null(), "{op} returned null");
         Ciphertext(ct)
     }
 
+    /// 전체 워드 수 (메타 포함)
+    pub fn words(&self) -> usize {
+        ct_words_from_meta(unsafe { *self.0 }, unsafe { *self.0.add(1) }).unwrap_or(CT_WORDS)
+    }
+
+    /// 암호문 메모리를 그대로 본다 (복사 없음)
+    pub fn as_words(&self) -> &[i32] {
+        unsafe { std::slice::from_raw_parts(self.0, self.words()) }
+    }
+
+    /// int32 LE 바이트로 본다 (복사 없음). 실행기 JSON / 게이트하우스 저장 포맷과 같은 배치
+    pub fn as_bytes(&self) -> &[u8] {
+        let w = self.as_words();
+        unsafe { std::slice::from_raw_parts(w.as_ptr() as *const u8, w.len() * 4) }
+    }
+
+    /// 워드 배열에서 암호문 생성 (C 할당기로 1회 복사)
+    pub fn from_words(words: &[i32]) -> Result<Self> {
+        if words.len() < CT_META {
+            return Err(Error::Format(format!("{} words is shorter than the meta block", words.len())));
+        }
+        match ct_words_from_meta(words[0], words[1]) {
+            Some(n) if n == words.len() => {}
+            _ => {
+                return Err(Error::Format(format!(
+                    "meta says {} bits x {} words, got {} words",
+                    words[0], words[1], words.len()
+                )))
+            }
+        }
+        let ct = Ciphertext::wrap(unsafe { fhe16_ct_alloc(words.len()) }, "fhe16_ct_alloc")?;
+        unsafe { std::ptr::copy_nonoverlapping(words.as_ptr(), ct.0, words.len()) };
+        Ok(ct)
+    }
+
+    /// as_bytes 의 역. 정렬과 무관하게 동작 (C 할당기로 1회 복사)
+    pub fn from_bytes(bytes: &[u8]) -> Result<Self> {
+        if bytes.len() % 4 != 0 {
+            return Err(Error::Format(format!("{} bytes is not a whole number of words", bytes.len())));
+        }
+        let words: Vec<i32> = bytes.chunks_exact(4).map(|c| i32::from_le_bytes([c[0], c[1], c[2], c[3]])).collect();
+        Ciphertext::from_words(&words)
+    }
+
+    /// 라이브러리 직렬화 포맷 (lwe_to_bytes_meta_safe). 파일 저장 / 다른 빌드와 교환용
+    pub fn to_bytes_meta(&self) -> Result<Vec<u8>> {
+        let mut out: *mut c_char = std::ptr::null_mut();
+        let mut len: usize = 0;
+        let rc = exclusive(|| unsafe { fhe16_lwe_to_bytes(self.0, &mut out, &mut len) });
+        if rc == -1 && out.is_null() {
+            return Err(Error::Unsupported("lwe_to_bytes_meta_safe"));
+        }
+        if rc != 0 || out.is_null() {
+            return Err(Error::Format(format!("lwe_to_bytes_meta_safe failed: rc={rc}")));
+        }
+        let v = unsafe { std::slice::from_raw_parts(out as *const u8, len) }.to_vec();
+        unsafe { fhe16_free_bytes(out) };
+        Ok(v)
+    }
+
+    /// to_bytes_meta 의 역 (lwe_from_bytes_meta_safe 가 메타를 검증)
+    pub fn from_bytes_meta(bytes: &[u8]) -> Result<Self> {
+        let mut ct: Ct = std::ptr::null_mut();
+        let rc = exclusive(|| unsafe { fhe16_lwe_from_bytes(bytes.as_ptr() as *const c_char, bytes.len(), &mut ct) });
+        if rc == -1 && ct.is_null() {
+            return Err(Error::Unsupported("lwe_from_bytes_meta_safe"));
+        }
+        if rc != 0 {
+            if !ct.is_null() {
+                unsafe { fhe16_free_ct(ct) }
+            }
+            return Err(Error::Format(format!("lwe_from_bytes_meta_safe failed: rc={rc}")));
+        }
+        Ciphertext::wrap(ct, "lwe_from_bytes_meta_safe")
+    }
+
+    pub fn encrypt_i32(m: i32, msg_bit: i32) -> Self {
+        Ciphertext::call("fhe16_enc_int", || unsafe { fhe16_enc_int(m as c_int, msg_bit as c_int) })
+    }
+
     pub fn decrypt_i64(&self, sk: &SecretKey) -> i64 {
-        unsafe { fhe16_dec_int(self.0 as *const i32, sk.0 as *const i32) }
+        exclusive(|| unsafe { fhe16_dec_int(self.0 as *const i32, sk.0 as *const i32) })
     }
 
     // ---------- 기본 산술 ----------
     pub fn add(a: &Ciphertext, b: &Ciphertext) -> Self {
-        let ct = unsafe { fhe16_add(a.0 as *const i32, b.0 as *const i32) };
-        assert!(!ct.is_null());
-        Ciphertext(ct)
+        Ciphertext::call("fhe16_add", || unsafe { fhe16_add(a.0 as *const i32, b.0 as *const i32) })
     }
 
     pub fn sub(a: &Ciphertext, b: &Ciphertext) -> Self {
-        let ct = unsafe { fhe16_sub(a.0 as *const i32, b.0 as *const i32) };
-        assert!(!ct.is_null());
-        Ciphertext(ct)
+        Ciphertext::call("fhe16_sub", || unsafe { fhe16_sub(a.0 as *const i32, b.0 as *const i32) })
     }
 
     pub fn add3(a: &Ciphertext, b: &Ciphertext, c: &Ciphertext) -> Self {
-        let ct = unsafe { fhe16_add3(a.0 as *const i32, b.0 as *const i32, c.0 as *const i32) };
-        assert!(!ct.is_null());
-        Ciphertext(ct)
+        Ciphertext::call("fhe16_add3", || unsafe { fhe16_add3(a.0 as *const i32, b.0 as *const i32, c.0 as *const i32) })
     }
 
     // ---------- 비교 ----------
     pub fn lt(a: &Ciphertext, b: &Ciphertext) -> Self {
-        Ciphertext(unsafe { fhe16_lt(a.0, b.0) })
+        Ciphertext::call("fhe16_lt", || unsafe { fhe16_lt(a.0, b.0) })
     }
     pub fn le(a: &Ciphertext, b: &Ciphertext) -> Self {
-        Ciphertext(unsafe { fhe16_le(a.0, b.0) })
+        Ciphertext::call("fhe16_le", || unsafe { fhe16_le(a.0, b.0) })
     }
     pub fn gt(a: &Ciphertext, b: &Ciphertext) -> Self {
-        Ciphertext(unsafe { fhe16_gt(a.0, b.0) })
+        Ciphertext::call("fhe16_gt", || unsafe { fhe16_gt(a.0, b.0) })
     }
     pub fn ge(a: &Ciphertext, b: &Ciphertext) -> Self {
-        Ciphertext(unsafe { fhe16_ge(a.0, b.0) })
+        Ciphertext::call("fhe16_ge", || unsafe { fhe16_ge(a.0, b.0) })
     }
     pub fn eq(a: &Ciphertext, b: &Ciphertext) -> Self {
-        Ciphertext(unsafe { fhe16_eq(a.0, b.0) })
+        Ciphertext::call("fhe16_eq", || unsafe { fhe16_eq(a.0, b.0) })
     }
 
     // ---------- 최대/최소 ----------
     pub fn max(a: &Ciphertext, b: &Ciphertext) -> Self {
-        Ciphertext(unsafe { fhe16_max(a.0, b.0) })
+        Ciphertext::call("fhe16_max", || unsafe { fhe16_max(a.0, b.0) })
     }
     pub fn min(a: &Ciphertext, b: &Ciphertext) -> Self {
-        Ciphertext(unsafe { fhe16_min(a.0, b.0) })
+        Ciphertext::call("fhe16_min", || unsafe { fhe16_min(a.0, b.0) })
     }
 
     // ---------- 상수 연산 ----------
     pub fn smull_constant(a: &Ciphertext, k: i32) -> Self {
-        Ciphertext(unsafe { fhe16_smull_constant_i32(a.0, k as c_int) })
+        Ciphertext::call("fhe16_smull_constant_i32", || unsafe { fhe16_smull_constant_i32(a.0, k as c_int) })
     }
 
     pub fn add_constant(a: &Ciphertext, k: i32) -> Self {
-        Ciphertext(unsafe { fhe16_add_constant_i32(a.0, k as c_int) })
+        Ciphertext::call("fhe16_add_constant_i32", || unsafe { fhe16_add_constant_i32(a.0, k as c_int) })
     }
 
     pub fn add_powtwo(a: &Ciphertext, pow: i32) -> Self {
-        Ciphertext(unsafe { fhe16_add_powtwo(a.0, pow as c_int) })
+        Ciphertext::call("fhe16_add_powtwo", || unsafe { fhe16_add_powtwo(a.0, pow as c_int) })
     }
 
     pub fn borrow(asset_1: Ciphertext, asset_2: Ciphertext, loan: &Ciphertext, sk: &SecretKey) -> (Ciphertext, Ciphertext) { // asset_1 : user, asset_2 : bank
@@ -392,7 +603,429 @@ impl Ciphertext {
 
 
 
-// ⚠️ 라이브러리에 해제 함수가 있으면 아래처럼 Drop 구현:
-// impl Drop for Ciphertext { fn drop(&mut self) { unsafe { fhe16_free_ct(self.0) } } }
-// impl Drop for SecretKey { fn drop(&mut self) { unsafe { fhe16_free_sk(self.0) } } }
+// ===== NTT 튜닝 =====
+//
+// 라이브러리의 NTT 커널은 모듈러스별 깊이(incomplete NTT, Q_DEPTH_INFO)로 고른다 (NTTTable16Const).
+// 깊이는 NTT 영역 표현(= 부트스트랩 키 형식)도 정하므로 키를 만든 뒤에는 바꿀 수 없다.
+// → ntt_tune 이 장비별 최적 깊이를 프로필로 남기고, 키 생성 / Context 초기화 때 그 프로필로 표를 고르거나 비교한다.
+
+/// NTT 표 하나 (모듈러스 하나). Drop 시 NTTTable16Decon
+pub struct NttTable {
+    st: *mut c_void,
+    n: usize,
+}
+
+unsafe impl Send for NttTable {}
+
+impl NttTable {
+    /// 없는 조합(커널 없음, 생성 실패)이면 None
+    pub fn new(n: usize, q: i16, depth: i32) -> Option<Self> {
+        let st = exclusive(|| unsafe { fhe16_ntt_table_new(n as c_int, q, depth as c_int) });
+        if st.is_null() { None } else { Some(NttTable { st, n }) }
+    }
+
+    pub fn len(&self) -> usize {
+        self.n
+    }
+
+    /// 표가 실제로 쓰는 깊이 (요청한 깊이를 라이브러리가 조정할 수 있음)
+    pub fn depth(&self) -> i32 {
+        exclusive(|| unsafe { fhe16_ntt_table_depth(self.st) as i32 })
+    }
+
+    /// x → y. 커널이 입력을 작업 공간으로 쓰므로 x 도 바뀔 수 있다
+    pub fn forward(&self, x: &mut [i16], y: &mut [i16]) {
+        assert!(x.len() >= self.n && y.len() >= self.n);
+        exclusive(|| unsafe { fhe16_ntt_forward(self.st, x.as_mut_ptr(), y.as_mut_ptr()) })
+    }
+
+    pub fn inverse(&self, x: &mut [i16], y: &mut [i16]) {
+        assert!(x.len() >= self.n && y.len() >= self.n);
+        exclusive(|| unsafe { fhe16_ntt_inverse(self.st, x.as_mut_ptr(), y.as_mut_ptr()) })
+    }
+
+    /// NTT 영역 점별 곱. 커널이 없으면 false
+    pub fn mul(&self, res: &mut [i16], x: &mut [i16], y: &mut [i16]) -> bool {
+        assert!(res.len() >= self.n && x.len() >= self.n && y.len() >= self.n);
+        exclusive(|| unsafe { fhe16_ntt_mul(self.st, res.as_mut_ptr(), x.as_mut_ptr(), y.as_mut_ptr()) == 0 })
+    }
+}
+
+impl Drop for NttTable {
+    fn drop(&mut self) {
+        exclusive(|| unsafe { fhe16_ntt_table_free(self.st) })
+    }
+}
+
+/// 라이브러리 커널 ISA (CMAKEPARAM.h AVXTYPE)
+pub fn kernel_isa() -> &'static str {
+    match exclusive(|| unsafe { fhe16_kernel_isa() }) {
+        0 => "scalar",
+        1 => "avx1",
+        2 => "avx2",
+        3 => "avx512",
+        _ => "unknown",
+    }
+}
+
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct NttKey {
+    pub n: i32,
+    pub q: i16,
+    pub depth: i32,
+}
+
+#[derive(Debug, Clone, PartialEq)]
+pub struct NttChoice {
+    pub n: i32,
+    pub q: i16,
+    pub depth: i32,
+    /// NTT + INTT + 점별 곱 1회 (ns, 중앙값)
+    pub ns: f64,
+}
 
+/// 장비별 NTT 튜닝 프로필 (ntt_tune 출력). 한 줄에 한 항목:
+///   isa <avx2|...>
+///   ntt <n> <q> <depth> <ns>
+/// '#' 뒤는 주석. 같은 (n, q) 가 여러 번 나오면 마지막 줄
+#[derive(Debug, Clone, Default, PartialEq)]
+pub struct NttProfile {
+    pub isa: String,
+    pub entries: Vec<NttChoice>,
+}
+
+impl NttProfile {
+    pub fn parse(text: &str) -> std::result::Result<Self, String> {
+        let mut p = NttProfile::default();
+        for (no, raw) in text.lines().enumerate() {
+            let line = raw.split('#').next().unwrap_or("").trim();
+            let f: Vec<&str> = line.split_whitespace().collect();
+            let bad = || format!("line {}: `{}`", no + 1, raw.trim());
+            match f.as_slice() {
+                [] => {}
+                ["isa", v] => p.isa = v.to_string(),
+                ["ntt", n, q, d, ns] => {
+                    let c = NttChoice {
+                        n: n.parse().map_err(|_| bad())?,
+                        q: q.parse().map_err(|_| bad())?,
+                        depth: d.parse().map_err(|_| bad())?,
+                        ns: ns.parse().map_err(|_| bad())?,
+                    };
+                    p.entries.retain(|e| (e.n, e.q) != (c.n, c.q));
+                    p.entries.push(c);
+                }
+                _ => return Err(bad()),
+            }
+        }
+        Ok(p)
+    }
+
+    pub fn load(path: &str) -> std::result::Result<Self, String> {
+        let text = std::fs::read_to_string(path).map_err(|e| e.to_string())?;
+        let p = NttProfile::parse(&text)?;
+        if !p.isa.is_empty() && p.isa != kernel_isa() {
+            return Err(format!("profile is for {} kernels, library has {}", p.isa, kernel_isa()));
+        }
+        Ok(p)
+    }
+
+    pub fn best(&self, n: i32, q: i16) -> Option<&NttChoice> {
+        self.entries.iter().find(|e| e.n == n && e.q == q)
+    }
+
+    /// 프로필의 깊이로 표 생성 (프로필에 없으면 깊이 0). 키 생성 전에 표를 고를 때
+    pub fn table(&self, n: i32, q: i16) -> Option<NttTable> {
+        NttTable::new(n as usize, q, self.best(n, q).map_or(0, |c| c.depth))
+    }
+
+    pub fn to_text(&self) -> String {
+        let mut s = String::from("# FHE16 NTT tuning profile (ntt_tune)\n");
+        if !self.isa.is_empty() {
+            s += &format!("isa {}\n", self.isa);
+        }
+        for e in &self.entries {
+            s += &format!("ntt {} {} {} {:.1}\n", e.n, e.q, e.depth, e.ns);
+        }
+        s
+    }
+}
+
+// ===== Context: 평가 키 수명 + 배치 연산 =====
+//
+// libFHE16 은 평가 키/파라미터를 전역(G_FHE16_PARAM, 부트스트랩 키)에 두므로 Context 는 프로세스에 하나만 만든다.
+// 라이브러리 호출은 모두 전역 잠금(NATIVE)으로 직렬화된다. &Context 를 여러 스레드에서 써도 안전하지만
+// 라이브러리 연산은 한 번에 하나씩 돈다.
+//
+// 배치 연산(*_many)은 std::thread::scope 로 threads() 개 스레드에 나누지만, 연산이 직렬화되므로
+// 지금은 순차 실행보다 빠르지 않다 (빨라지는 것은 map_many 의 f 안에서 하는 라이브러리 밖 작업뿐).
+// 재진입 가능한 라이브러리 빌드가 생기면 잠금만 풀면 되도록 API 는 그대로 둔다.
+
+static CONTEXT_ALIVE: AtomicBool = AtomicBool::new(false);
+
+pub struct Context {
+    sk: Option<SecretKey>,
+    threads: AtomicUsize,
+}
+
+impl Context {
+    /// 키 생성 (FHE16_GenEval) — 비밀키 포함
+    pub fn generate() -> Result<Self> {
+        Context::acquire()?;
+        let sk = exclusive(|| unsafe { fhe16_gen_eval() });
+        if sk.is_null() {
+            CONTEXT_ALIVE.store(false, Ordering::Release);
+            return Err(Error::Null("fhe16_gen_eval"));
+        }
+        Ok(Context::with_key(Some(SecretKey(sk))))
+    }
+
+    /// 저장된 평가 키 로드 (FHE16_LoadEval) — 실행기용, 비밀키 없음
+    pub fn load() -> Result<Self> {
+        Context::acquire()?;
+        // FHE16_LoadEval 은 반환값이 없으므로 평가 키가 생겼는지 따로 확인
+        if exclusive(|| unsafe {
+            fhe16_load_eval();
+            fhe16_eval_ready()
+        }) == 0
+        {
+            CONTEXT_ALIVE.store(false, Ordering::Release);
+            return Err(Error::NoEvalKey);
+        }
+        Ok(Context::with_key(None))
+    }
+
+    /// 평가 키가 쓰는 NTT 표 (모듈러스별 링 차수 / q / 깊이)
+    pub fn ntt_live(&self) -> Vec<NttKey> {
+        let (mut n, mut q, mut depth) = (0 as c_int, [0i16; 8], [0 as c_int; 8]);
+        let k = exclusive(|| unsafe { fhe16_ntt_live(&mut n, q.as_mut_ptr(), depth.as_mut_ptr(), 8) });
+        (0..k.clamp(0, 8) as usize).map(|i| NttKey { n: n as i32, q: q[i], depth: depth[i] as i32 }).collect()
+    }
+
+    /// 튜닝 프로필과 비교: 프로필의 최적 깊이가 키의 깊이와 다른 모듈러스 (키, 프로필 항목)
+    pub fn ntt_profile_mismatches(&self, profile: &NttProfile) -> Vec<(NttKey, NttChoice)> {
+        self.ntt_live()
+            .into_iter()
+            .filter_map(|k| profile.best(k.n, k.q).filter(|c| c.depth != k.depth).map(|c| (k, c.clone())))
+            .collect()
+    }
+
+    fn acquire() -> Result<()> {
+        CONTEXT_ALIVE
+            .compare_exchange(false, true, Ordering::AcqRel, Ordering::Acquire)
+            .map(|_| ())
+            .map_err(|_| Error::ContextExists)
+    }
+
+    fn with_key(sk: Option<SecretKey>) -> Self {
+        let cores = exclusive(|| unsafe { fhe16_physical_cores() });
+        let threads = if cores > 0 {
+            cores as usize
+        } else {
+            std::thread::available_parallelism().map(|n| n.get()).unwrap_or(1)
+        };
+        let ctx = Context { sk, threads: AtomicUsize::new(threads) };
+        ctx.check_ntt_profile_env();
+        ctx
+    }
+
+    // FHE16_NTT_PROFILE 가 있으면 키의 NTT 깊이가 이 장비의 최적값인지 확인
+    fn check_ntt_profile_env(&self) {
+        let Ok(path) = std::env::var("FHE16_NTT_PROFILE") else { return };
+        match NttProfile::load(&path) {
+            Ok(p) => {
+                for (k, c) in self.ntt_profile_mismatches(&p) {
+                    eprintln!(
+                        "[WARN] NTT n={} q={}: keys use depth {}, {path} prefers depth {} ({:.0} ns/NTT). Regenerate keys with that depth to use it.",
+                        k.n, k.q, k.depth, c.depth, c.ns
+                    );
+                }
+            }
+            Err(e) => eprintln!("[WARN] FHE16_NTT_PROFILE={path}: {e}"),
+        }
+    }
+
+    pub fn secret_key(&self) -> Option<&SecretKey> {
+        self.sk.as_ref()
+    }
+
+    /// 배치 연산 스레드 수 (기본: 물리 코어 수). 라이브러리 호출은 직렬화되므로 늘려도 연산은 빨라지지 않는다
+    pub fn threads(&self) -> usize {
+        self.threads.load(Ordering::Relaxed)
+    }
+
+    pub fn set_threads(&self, n: usize) {
+        self.threads.store(n.max(1), Ordering::Relaxed);
+    }
+
+    /// 라이브러리 호출을 전역 잠금 안에서 실행 (crate::exclusive 와 같음)
+    pub fn exclusive<T>(&self, f: impl FnOnce() -> T) -> T {
+        exclusive(f)
+    }
+
+    // ---------- 단일 연산 ----------
+    pub fn encrypt(&self, m: i32, msg_bit: i32) -> Result<Ciphertext> {
+        Ciphertext::wrap(exclusive(|| unsafe { fhe16_enc_int(m as c_int, msg_bit as c_int) }), "fhe16_enc_int")
+    }
+
+    pub fn decrypt(&self, ct: &Ciphertext) -> Result<i64> {
+        let sk = self.sk.as_ref().ok_or(Error::NoSecretKey)?;
+        Ok(exclusive(|| unsafe { fhe16_dec_int(ct.0, sk.0) }))
+    }
+
+    pub fn add(&self, a: &Ciphertext, b: &Ciphertext) -> Result<Ciphertext> {
+        Ciphertext::wrap(exclusive(|| unsafe { fhe16_add(a.0, b.0) }), "fhe16_add")
+    }
+
+    pub fn sub(&self, a: &Ciphertext, b: &Ciphertext) -> Result<Ciphertext> {
+        Ciphertext::wrap(exclusive(|| unsafe { fhe16_sub(a.0, b.0) }), "fhe16_sub")
+    }
+
+    pub fn ge(&self, a: &Ciphertext, b: &Ciphertext) -> Result<Ciphertext> {
+        Ciphertext::wrap(exclusive(|| unsafe { fhe16_ge(a.0, b.0) }), "fhe16_ge")
+    }
+
+    pub fn lt(&self, a: &Ciphertext, b: &Ciphertext) -> Result<Ciphertext> {
+        Ciphertext::wrap(exclusive(|| unsafe { fhe16_lt(a.0, b.0) }), "fhe16_lt")
+    }
+
+    pub fn select(&self, sel: &Ciphertext, a: &Ciphertext, b: &Ciphertext) -> Result<Ciphertext> {
+        Ciphertext::wrap(exclusive(|| unsafe { fhe16_select(sel.0, a.0, b.0) }), "fhe16_select")
+    }
+
+    // ---------- 배치 연산 ----------
+    pub fn add_many(&self, a: &[Ciphertext], b: &[Ciphertext]) -> Result<Vec<Ciphertext>> {
+        self.zip_many(a, b, |x, y| self.add(x, y))
+    }
+
+    pub fn sub_many(&self, a: &[Ciphertext], b: &[Ciphertext]) -> Result<Vec<Ciphertext>> {
+        self.zip_many(a, b, |x, y| self.sub(x, y))
+    }
+
+    pub fn ge_many(&self, a: &[Ciphertext], b: &[Ciphertext]) -> Result<Vec<Ciphertext>> {
+        self.zip_many(a, b, |x, y| self.ge(x, y))
+    }
+
+    pub fn lt_many(&self, a: &[Ciphertext], b: &[Ciphertext]) -> Result<Vec<Ciphertext>> {
+        self.zip_many(a, b, |x, y| self.lt(x, y))
+    }
+
+    pub fn decrypt_many(&self, cts: &[Ciphertext]) -> Result<Vec<i64>> {
+        self.par_map(cts.len(), |i| self.decrypt(&cts[i])).into_iter().collect()
+    }
+
+    /// 독립 작업 n 개를 threads() 개 스레드로: f(i) 결과를 입력 순서대로 (f 안의 라이브러리 호출은 직렬화됨)
+    pub fn map_many<T, F>(&self, n: usize, f: F) -> Vec<T>
+    where
+        T: Send,
+        F: Fn(usize) -> T + Sync,
+    {
+        self.par_map(n, f)
+    }
+
+    fn zip_many<F>(&self, a: &[Ciphertext], b: &[Ciphertext], f: F) -> Result<Vec<Ciphertext>>
+    where
+        F: Fn(&Ciphertext, &Ciphertext) -> Result<Ciphertext> + Sync,
+    {
+        if a.len() != b.len() {
+            return Err(Error::LengthMismatch { left: a.len(), right: b.len() });
+        }
+        self.par_map(a.len(), |i| f(&a[i], &b[i])).into_iter().collect()
+    }
+
+    // 스레드마다 다음 인덱스를 가져가며 처리 (연산마다 시간이 달라도 고르게 끝남)
+    fn par_map<T, F>(&self, n: usize, f: F) -> Vec<T>
+    where
+        T: Send,
+        F: Fn(usize) -> T + Sync,
+    {
+        let threads = self.threads().min(n);
+        if threads <= 1 {
+            return (0..n).map(f).collect();
+        }
+        let next = AtomicUsize::new(0);
+        let mut parts: Vec<Vec<(usize, T)>> = std::thread::scope(|s| {
+            let workers: Vec<_> = (0..threads)
+                .map(|_| {
+                    s.spawn(|| {
+                        let mut out = Vec::new();
+                        loop {
+                            let i = next.fetch_add(1, Ordering::Relaxed);
+                            if i >= n {
+                                break;
+                            }
+                            out.push((i, f(i)));
+                        }
+                        out
+                    })
+                })
+                .collect();
+            workers.into_iter().map(|w| w.join().expect("fhe16 batch worker panicked")).collect()
+        });
+        let mut slots: Vec<Option<T>> = (0..n).map(|_| None).collect();
+        for (i, v) in parts.iter_mut().flat_map(|p| p.drain(..)) {
+            slots[i] = Some(v);
+        }
+        slots.into_iter().map(|v| v.expect("every index is processed")).collect()
+    }
+}
+
+impl Drop for Context {
+    fn drop(&mut self) {
+        exclusive(|| unsafe { fhe16_delete_eval() });
+        CONTEXT_ALIVE.store(false, Ordering::Release);
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn ct_words_follow_bits_times_stride() {
+        assert_eq!(ct_words_from_meta(32, 1040), Some(CT_WORDS));
+        assert_eq!(ct_words_from_meta(1, 1040), Some(CT_META + LWE_WORDS));
+        assert_eq!(ct_words_from_meta(64, 1040), Some(CT_META + 64 * LWE_WORDS));
+        // 예전 해석 (메타[1] = 전체 데이터 워드) 이나 범위 밖은 거부
+        assert_eq!(ct_words_from_meta(32, 1040 * 32), None);
+        assert_eq!(ct_words_from_meta(0, 1040), None);
+        assert_eq!(ct_words_from_meta(65, 1040), None);
+        assert_eq!(ct_words_from_meta(-1, 1040), None);
+    }
+
+    #[test]
+    fn ntt_profile_round_trips_through_text() {
+        let p = NttProfile {
+            isa: "avx2".to_string(),
+            entries: vec![
+                NttChoice { n: 1024, q: 12289, depth: 2, ns: 1834.5 },
+                NttChoice { n: 2048, q: -32767, depth: 0, ns: 4000.0 },
+            ],
+        };
+        assert_eq!(NttProfile::parse(&p.to_text()), Ok(p.clone()));
+        assert_eq!(p.best(1024, 12289).map(|c| c.depth), Some(2));
+        assert_eq!(p.best(1024, 7681), None);
+        assert_eq!(p.best(2048, 12289), None);
+    }
+
+    #[test]
+    fn ntt_profile_parse_skips_comments_and_keeps_the_last_entry() {
+        let text = "# 주석\n\n  isa avx2  # 뒤 주석\nntt 1024 12289 1 900\nntt 512 12289 3 400.25\nntt 1024 12289 3 800\n";
+        let p = NttProfile::parse(text).unwrap();
+        assert_eq!(p.isa, "avx2");
+        assert_eq!(p.entries.len(), 2);
+        assert_eq!(p.best(1024, 12289), Some(&NttChoice { n: 1024, q: 12289, depth: 3, ns: 800.0 }));
+        assert_eq!(p.best(512, 12289).map(|c| c.ns), Some(400.25));
+        assert_eq!(NttProfile::parse(""), Ok(NttProfile::default()));
+    }
+
+    #[test]
+    fn ntt_profile_parse_rejects_malformed_lines() {
+        // 오류에는 줄 번호가 들어간다
+        assert_eq!(NttProfile::parse("isa avx2\nntt 1024 12289 2\n"), Err("line 2: `ntt 1024 12289 2`".to_string()));
+        assert!(NttProfile::parse("ntt 1024 70000 2 10").is_err()); // q 는 i16
+        assert!(NttProfile::parse("ntt 1024 12289 two 10").is_err());
+        assert!(NttProfile::parse("ntt 1024 12289 2 fast").is_err());
+        assert!(NttProfile::parse("isa").is_err());
+        assert!(NttProfile::parse("depth 1024 12289 2 10").is_err());
+    }
+}
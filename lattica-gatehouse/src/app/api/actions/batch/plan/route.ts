@@ -6,6 +6,8 @@
 import { NextRequest, NextResponse } from 'next/server'
 import { createLogger } from '@/lib/logger'
 import { jobQueue } from '@/services/queue/job-queue'
+import { resolve_output_handle } from '@/services/queue/output-handle'
+import { job_dag_edges } from '@/services/queue/job-dag'
 import type { QueuedJob } from '@/types/queue'
 
 const log = createLogger('API:BatchPlan')
@@ -41,39 +43,48 @@ interface DAGEdge {
 
 /**
  * Build DAG from actual JobQueue jobs
- *
- * Current implementation: Simple sequential execution (no dependencies)
- * Future: Parse IR to detect actual data dependencies
+ * Edges follow CID handles in slot order (RAW / WAR / WAW, see services/queue/job-dag)
  */
 function buildDAGFromJobs(jobs: QueuedJob[]): { nodes: DAGNode[], edges: DAGEdge[] } {
-  const nodes: DAGNode[] = []
-  const edges: DAGEdge[] = []
-
   // Sort jobs by slot (submission order)
   const sortedJobs = [...jobs].sort((a, b) => a.slot - b.slot)
 
-  // Convert jobs to DAG nodes
-  sortedJobs.forEach((job, index) => {
-    nodes.push({
-      id: index,
-      job_pda: job.job_pda,
-      job_id: job.job_pda,  // Use job_pda as identifier
-      cid_handles: job.cid_handles,
-      ir_digest: job.ir_digest,
-      commitment: job.commitment,
-      output_handle: `output_${job.job_pda.slice(0, 16)}`,  // Mock output handle
-      depends_on: [],  // No dependencies in simple mode
-      slot: job.slot,
-      status: job.status,
-    })
-  })
-
-  // TODO: Analyze IR to build actual dependency graph
-  // For now, all jobs are independent (can execute in parallel)
+  const nodes: DAGNode[] = sortedJobs.map((job, index) => ({
+    id: index,
+    job_pda: job.job_pda,
+    job_id: job.job_pda,  // Use job_pda as identifier
+    cid_handles: job.cid_handles,
+    ir_digest: job.ir_digest,
+    commitment: job.commitment,
+    output_handle: resolve_output_handle(job.ir_digest, job.cid_handles),
+    depends_on: [],
+    slot: job.slot,
+    status: job.status,
+  }))
+
+  const edges: DAGEdge[] = job_dag_edges(sortedJobs)
+  for (const { from, to } of edges) nodes[to].depends_on.push(from)
 
   return { nodes, edges }
 }
 
+/**
+ * Group nodes into topological waves (wave k = longest dependency chain of length k)
+ * All nodes of a wave can run in parallel; the wave count is the critical path length
+ */
+function computeWaves(nodes: DAGNode[], order: number[]): number[][] {
+  const level = new Map<number, number>()
+  const waves: number[][] = []
+  for (const id of order) {
+    const deps = nodes[id].depends_on
+    const lv = deps.length === 0 ? 0 : Math.max(...deps.map(d => level.get(d)!)) + 1
+    level.set(id, lv)
+    if (!waves[lv]) waves[lv] = []
+    waves[lv].push(id)
+  }
+  return waves
+}
+
 /**
  * Compute topological order (Kahn's algorithm)
  * Prioritizes decrypt-needed nodes (nodes with no dependencies)
@@ -193,6 +204,7 @@ export async function GET(request: NextRequest) {
           edges: [],
         },
         topo_order: [],
+        waves: [],
         decrypt_needed_bitmap: '0x00',
         queue_stats: jobQueue.get_stats(),
         message: 'No jobs in queue. Submit jobs first via /api/actions/job/submit',
@@ -206,6 +218,9 @@ export async function GET(request: NextRequest) {
     // Compute topological order
     const topo_order = topologicalSort(nodes, edges)
 
+    // Parallel waves (critical path = waves.length)
+    const waves = computeWaves(nodes, topo_order)
+
     // Generate decrypt-needed bitmap
     const decrypt_needed_bitmap = generateDecryptNeededBitmap(nodes)
 
@@ -224,12 +239,14 @@ export async function GET(request: NextRequest) {
           ir_digest: n.ir_digest.slice(0, 16) + '...',  // Truncate for display
           commitment: n.commitment.slice(0, 16) + '...',
           output_handle: n.output_handle,
+          depends_on: n.depends_on,
           slot: n.slot,
           status: n.status,
         })),
         edges,
       },
       topo_order,
+      waves,
       decrypt_needed_bitmap,
       queue_stats: {
         total_jobs: queueStats.total_jobs,
@@ -238,10 +255,10 @@ export async function GET(request: NextRequest) {
         completed: queueStats.completed_count,
       },
       execution_hints: {
-        description: 'Execute nodes in topological order',
-        decrypt_priority: 'All nodes currently need decryption (no dependencies)',
-        parallelism: 'All jobs can execute in parallel (no inter-job dependencies)',
-        note: 'Dependency analysis requires IR parsing (future work)',
+        description: 'Execute nodes in topological order; nodes in the same wave are independent',
+        decrypt_priority: 'Nodes without dependencies read only stored ciphertexts',
+        parallelism: `${nodes.length} jobs in ${waves.length} waves (critical path)`,
+        note: 'Dependencies derived from CID handles (output handle = state CID written by the job)',
       },
       data_source: 'real_job_queue',
     }))
@@ -1,18 +1,28 @@
 /**
  * Executor Decrypt Jobs API
  * Executor polls for pending decrypt jobs
+ * Query: limit (default 1), wait (long-poll timeout in ms, max 60000)
  */
 import { NextRequest, NextResponse } from 'next/server'
 import { createLogger } from '@/lib/logger'
 import { decryptQueue } from '@/services/queue/decrypt-queue'
 import { ciphertextStore } from '@/services/storage/ciphertext-store'
+import { parse_wait_ms } from '@/services/queue/queue-signal'
 
 const log = createLogger('API:ExecutorDecrypt')
 
+export const dynamic = 'force-dynamic'
+
 export async function GET(request: NextRequest) {
   try {
     const { searchParams } = new URL(request.url)
     const limit = parseInt(searchParams.get('limit') || '1')
+    const wait = parse_wait_ms(searchParams.get('wait'))
+
+    // Long-poll: hold the request until a decrypt job is pending
+    if (wait > 0) {
+      await decryptQueue.wait_for_pending(wait, request.signal)
+    }
 
     const pendingJobs = decryptQueue.get_pending().slice(0, limit)
 
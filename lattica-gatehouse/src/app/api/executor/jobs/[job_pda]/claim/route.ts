@@ -4,6 +4,8 @@
  *
  * External executor claims a job for execution.
  * Marks job as 'assigned' to prevent duplicate processing.
+ * A job whose CID predecessors are still queued, or assigned to another executor,
+ * cannot be claimed yet (409 with `blocked_by`): it would read a stale ciphertext.
  */
 
 import { NextRequest, NextResponse } from 'next/server'
@@ -70,6 +72,22 @@ export async function POST(
       )
     }
 
+    // Predecessors must be finished or held by the same executor (which chains the result)
+    const blocking = jobQueue.get_blocking_jobs(job_pda, body.executor)
+    if (blocking.length > 0) {
+      log.warn('Job blocked by unfinished predecessors', {
+        job_pda: job_pda.slice(0, 8) + '...',
+        blocked_by: blocking.length,
+      })
+      return NextResponse.json(
+        {
+          error: 'Job depends on unfinished jobs',
+          blocked_by: blocking.map(j => j.job_pda),
+        },
+        { status: 409 }
+      )
+    }
+
     // Assign job to executor
     const success = jobQueue.assign_job(job_pda, body.executor)
     if (!success) {
@@ -9,6 +9,7 @@
 import { NextRequest, NextResponse } from 'next/server'
 import { jobQueue } from '@/services/queue/job-queue'
 import { ciphertextStore } from '@/services/storage/ciphertext-store'
+import { resolve_output_handle } from '@/services/queue/output-handle'
 import { createLogger } from '@/lib/logger'
 import bs58 from 'bs58'
 import { createHash } from 'crypto'
@@ -115,33 +116,9 @@ export async function POST(
       }
       
       // Determine which state CID to update based on operation
-      // deposit: update input[0] (SOL balance)
-      // withdraw: update input[0] (USDC balance)  
-      // borrow: update input[2] (USDC balance)
-      // defi_operation: dynamic (2 inputs=withdraw, 3 inputs=borrow)
+      // (deposit/withdraw: input[0], borrow: input[2], defi_operation: by input count)
       const irDigest = job.ir_digest || ''
-      const inputCount = job.cid_handles?.length || 0
-      let stateCidToUpdate: string | undefined
-      
-      if (irDigest === '0xadd0000000000000000000000000000000000000000000000000000000000000') {
-        // deposit operation: update SOL balance (input[0])
-        stateCidToUpdate = job.cid_handles?.[0]
-      } else if (irDigest === '0xwithdrw000000000000000000000000000000000000000000000000000000000') {
-        // withdraw operation: update USDC balance (input[0])
-        stateCidToUpdate = job.cid_handles?.[0]
-      } else if (irDigest === '0xmul0000000000000000000000000000000000000000000000000000000000000') {
-        // borrow operation: update USDC balance (input[2])
-        stateCidToUpdate = job.cid_handles?.[2]
-      } else if (irDigest === '0x8fae5df19cb6bc3db4ea7dfc14a9696be683910c9fee64d839a6eef9981129a1') {
-        // defi_operation: dynamic based on input count
-        if (inputCount === 2) {
-          // withdraw: update USDC balance (input[0])
-          stateCidToUpdate = job.cid_handles?.[0]
-        } else if (inputCount === 3) {
-          // borrow: update USDC balance (input[2])
-          stateCidToUpdate = job.cid_handles?.[2]
-        }
-      }
+      const stateCidToUpdate = resolve_output_handle(irDigest, job.cid_handles)
       
       if (!stateCidToUpdate) {
         log.error('Cannot determine state CID to update', {
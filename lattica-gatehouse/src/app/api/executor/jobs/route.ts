@@ -3,12 +3,17 @@
  * GET /api/executor/jobs
  *
  * External FHE executors use this endpoint to discover available jobs.
- * Returns jobs in 'queued' status that are ready for execution.
+ * Returns jobs in 'queued' status that are ready for execution: a job whose CID
+ * predecessors (see services/queue/job-dag) are still assigned / executing is held
+ * back until they finish. Ready jobs come in slot order, so a prefix is closed
+ * under dependencies.
+ * With `wait`, the request is held open until a job is ready (long-polling).
  */
 
 import { NextRequest, NextResponse } from 'next/server'
 import { jobQueue } from '@/services/queue/job-queue'
 import { ciphertextStore } from '@/services/storage/ciphertext-store'
+import { parse_wait_ms } from '@/services/queue/queue-signal'
 import { createLogger } from '@/lib/logger'
 
 const log = createLogger('API:ExecutorJobs')
@@ -21,6 +26,8 @@ export const dynamic = 'force-dynamic'
  * Query parameters:
  * - status: Filter by status (default: 'queued')
  * - limit: Max jobs to return (default: 10, max: 100)
+ * - wait: Long-poll timeout in ms (default: 0 = return immediately, max: 60000).
+ *         If no job is ready, respond as soon as one is enqueued / unblocked or the timeout expires.
  *
  * Returns:
  * - jobs: Array of available jobs with ciphertext data
@@ -30,12 +37,18 @@ export async function GET(request: NextRequest) {
     const { searchParams } = new URL(request.url)
     const status = searchParams.get('status') || 'queued'
     const limit = Math.min(parseInt(searchParams.get('limit') || '10'), 100)
+    const wait = status === 'queued' ? parse_wait_ms(searchParams.get('wait')) : 0
 
-    log.debug('Fetching jobs', { status, limit })
+    log.debug('Fetching jobs', { status, limit, wait })
 
-    // Get queued jobs
+    // Long-poll: hold the request until a job is ready (or timeout / client disconnect)
+    if (wait > 0) {
+      await jobQueue.wait_for_ready(wait, request.signal)
+    }
+
+    // Get ready jobs (queued, predecessors finished)
     const queuedJobs = status === 'queued'
-      ? jobQueue.get_queued_jobs()
+      ? jobQueue.get_ready_jobs()
       : jobQueue.get_executing_jobs()
 
     log.debug('Found jobs', { count: queuedJobs.length })
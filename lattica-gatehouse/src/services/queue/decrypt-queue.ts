@@ -4,6 +4,7 @@
  */
 
 import { createLogger } from '@/lib/logger'
+import { QueueSignal } from './queue-signal'
 import type { DecryptJob } from '@/types/queue'
 
 const log = createLogger('DecryptQueue')
@@ -15,9 +16,11 @@ declare global {
 
 class DecryptQueue {
   private jobs: Map<string, DecryptJob>
+  private signal: QueueSignal
 
   private constructor() {
     this.jobs = new Map()
+    this.signal = new QueueSignal()
     log.debug('DecryptQueue instance created')
   }
 
@@ -44,9 +47,18 @@ class DecryptQueue {
 
     this.jobs.set(decrypt_id, job)
     log.info('Decrypt job created', { decrypt_id, cid: cid.slice(0, 8) + '...' })
+    this.signal.notify()
     return job
   }
 
+  /**
+   * Wait until at least one job is pending (for executor long-polling)
+   */
+  async wait_for_pending(timeout_ms: number, abort?: AbortSignal): Promise<boolean> {
+    if (this.get_pending().length > 0) return true
+    return this.signal.wait(timeout_ms, abort)
+  }
+
   /**
    * Get pending jobs for executor
    */
@@ -0,0 +1,63 @@
+/**
+ * Job DAG
+ * Data dependencies between jobs, derived from CID handles in submission (slot) order.
+ * Shared by the batch planner (DAG / waves) and the job queue (which queued jobs are ready).
+ *
+ * Jobs write their result into one of their input CIDs (output handle), so:
+ * - read-after-write:  a later job reads a CID an earlier job writes
+ * - write-after-read:  a later job overwrites a CID an earlier job still reads
+ * - write-after-write: two jobs write the same CID
+ * Jobs touching disjoint CIDs stay independent and can execute in parallel.
+ */
+
+import { resolve_output_handle } from './output-handle'
+import type { QueuedJob } from '@/types/queue'
+
+export interface JobDagEdge {
+  from: number
+  to: number
+}
+
+/**
+ * Dependency edges between jobs (indices into `jobs`, which must be sorted by slot)
+ */
+export function job_dag_edges(jobs: QueuedJob[]): JobDagEdge[] {
+  const edges: JobDagEdge[] = []
+  const lastWriter = new Map<string, number>()       // cid -> job that last wrote it
+  const readers = new Map<string, number[]>()         // cid -> jobs reading it since that write
+  const seen = new Set<string>()
+
+  const addEdge = (from: number, to: number) => {
+    const key = `${from}->${to}`
+    if (from === to || seen.has(key)) return
+    seen.add(key)
+    edges.push({ from, to })
+  }
+
+  jobs.forEach((job, index) => {
+    const output_handle = resolve_output_handle(job.ir_digest, job.cid_handles)
+    for (const cid of new Set(job.cid_handles)) {
+      const writer = lastWriter.get(cid)
+      if (writer !== undefined) addEdge(writer, index)            // RAW / WAW
+      if (cid === output_handle) {
+        for (const reader of readers.get(cid) || []) addEdge(reader, index)   // WAR
+        lastWriter.set(cid, index)
+        readers.set(cid, [])
+      } else {
+        if (!readers.has(cid)) readers.set(cid, [])
+        readers.get(cid)!.push(index)
+      }
+    }
+  })
+
+  return edges
+}
+
+/**
+ * Predecessor lists per job (same indexing as job_dag_edges)
+ */
+export function job_predecessors(jobs: QueuedJob[]): number[][] {
+  const preds: number[][] = jobs.map(() => [])
+  for (const { from, to } of job_dag_edges(jobs)) preds[to].push(from)
+  return preds
+}
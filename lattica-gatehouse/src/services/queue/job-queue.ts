@@ -7,6 +7,8 @@
  */
 
 import { createLogger } from '@/lib/logger'
+import { QueueSignal } from './queue-signal'
+import { job_predecessors } from './job-dag'
 import type { QueuedJob, JobStatus, JobQueueStats, BatchWindowJobs } from '@/types/queue'
 import type { JobSubmittedEvent } from '@/types/events'
 
@@ -21,11 +23,13 @@ class JobQueue {
   private jobs: Map<string, QueuedJob>              // job_pda -> QueuedJob
   private batchIndex: Map<string, Set<string>>      // batch_pda -> Set<job_pda>
   private slotIndex: Map<number, Set<string>>       // slot -> Set<job_pda>
+  private signal: QueueSignal                       // wakes long-polling executors
 
   private constructor() {
     this.jobs = new Map()
     this.batchIndex = new Map()
     this.slotIndex = new Map()
+    this.signal = new QueueSignal()
     log.debug('JobQueue instance created')
   }
 
@@ -84,9 +88,20 @@ class JobQueue {
       ir_digest: event.ir_digest?.slice(0, 10) + '...',
       commitment: event.commitment?.slice(0, 10) + '...'
     })
+    this.signal.notify()
     return job
   }
 
+  /**
+   * Wait until at least one job is ready (for executor long-polling)
+   * Resolves immediately if jobs are already ready; false on timeout or abort.
+   * Woken on enqueue and whenever a job finishes (which may unblock its dependents)
+   */
+  async wait_for_ready(timeout_ms: number, abort?: AbortSignal): Promise<boolean> {
+    if (this.get_ready_jobs().length > 0) return true
+    return this.signal.wait(timeout_ms, abort)
+  }
+
   /**
    * Get job by PDA
    */
@@ -135,6 +150,44 @@ class JobQueue {
       .sort((a, b) => a.slot - b.slot)
   }
 
+  /**
+   * Unfinished jobs (queued / assigned / executing) in slot order, with their CID predecessors
+   */
+  private pending_dag(): { pending: QueuedJob[], preds: number[][] } {
+    const pending = Array.from(this.jobs.values())
+      .filter(job => job.status === 'queued' || job.status === 'assigned' || job.status === 'executing')
+      .sort((a, b) => a.slot - b.slot)
+    return { pending, preds: job_predecessors(pending) }
+  }
+
+  /**
+   * Queued jobs that can start now: every CID predecessor (RAW / WAR / WAW, see job-dag)
+   * has finished, or is itself queued and ready (listed earlier, so an executor that takes
+   * a prefix of this list in order can chain the results in memory).
+   * Jobs behind an assigned / executing job stay back until that job finishes.
+   */
+  get_ready_jobs(): QueuedJob[] {
+    const { pending, preds } = this.pending_dag()
+    const ready: boolean[] = []
+    pending.forEach((job, i) => {
+      ready[i] = job.status === 'queued' && preds[i].every(p => ready[p])
+    })
+    return pending.filter((_, i) => ready[i])
+  }
+
+  /**
+   * Unfinished predecessors that keep `executor` from claiming a job.
+   * A predecessor already assigned to the same executor does not block (it chains the result in memory)
+   */
+  get_blocking_jobs(job_pda: string, executor: string): QueuedJob[] {
+    const { pending, preds } = this.pending_dag()
+    const index = pending.findIndex(job => job.job_pda === job_pda)
+    if (index < 0) return []
+    return preds[index]
+      .map(p => pending[p])
+      .filter(job => job.status === 'queued' || job.executor !== executor)
+  }
+
   /**
    * Get executing jobs (currently being processed)
    * Includes both 'assigned' and 'executing' states
@@ -188,6 +241,8 @@ class JobQueue {
     }
 
     log.info('Updated job status', { job: job_pda.slice(0, 8) + '...', status })
+    // A finished job may unblock jobs that depend on it
+    if (status === 'completed' || status === 'failed' || status === 'cancelled') this.signal.notify()
     return true
   }
 
@@ -239,6 +294,7 @@ class JobQueue {
       executing_count: executing.length,
       completed_count: completed.length,
       failed_count: failed.length,
+      waiting_executors: this.signal.waiting,
       oldest_queued_timestamp: queuedTimestamps.length > 0 ? Math.min(...queuedTimestamps) : 0,
       newest_queued_timestamp: queuedTimestamps.length > 0 ? Math.max(...queuedTimestamps) : 0,
     }
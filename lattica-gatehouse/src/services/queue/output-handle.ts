@@ -0,0 +1,35 @@
+/**
+ * Output Handle Resolution
+ * FHE jobs write their result back into one of their input CIDs (the state CID).
+ * Shared by the executor result route (which CID to update) and the batch planner
+ * (which later jobs read a CID this job writes).
+ */
+
+// ir_digest -> input slot that receives the result (per input count for dynamic ops)
+const OUTPUT_SLOTS: Record<string, number | Record<number, number>> = {
+  // deposit: update input[0] (SOL balance)
+  '0xadd0000000000000000000000000000000000000000000000000000000000000': 0,
+  // withdraw: update input[0] (USDC balance)
+  '0xwithdrw000000000000000000000000000000000000000000000000000000000': 0,
+  // borrow: update input[2] (USDC balance)
+  '0xmul0000000000000000000000000000000000000000000000000000000000000': 2,
+  // defi_operation: dynamic (2 inputs=withdraw, 3 inputs=borrow)
+  '0x8fae5df19cb6bc3db4ea7dfc14a9696be683910c9fee64d839a6eef9981129a1': { 2: 0, 3: 2 },
+}
+
+/**
+ * Input slot the job's result is written to, or undefined if the operation has no state output
+ */
+export function resolve_output_slot(ir_digest: string, input_count: number): number | undefined {
+  const slot = OUTPUT_SLOTS[ir_digest]
+  if (typeof slot === 'number') return slot
+  return slot?.[input_count]
+}
+
+/**
+ * CID the job's result is written to
+ */
+export function resolve_output_handle(ir_digest: string, cid_handles: string[] | undefined): string | undefined {
+  const slot = resolve_output_slot(ir_digest, cid_handles?.length || 0)
+  return slot === undefined ? undefined : cid_handles?.[slot]
+}
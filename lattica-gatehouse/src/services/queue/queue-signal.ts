@@ -0,0 +1,55 @@
+/**
+ * Queue Signal
+ * Wakes up long-polling executor requests when new work is queued
+ */
+
+type Waiter = () => void
+
+export class QueueSignal {
+  private waiters: Set<Waiter> = new Set()
+
+  /**
+   * Wake every waiting request (called on enqueue)
+   */
+  notify(): void {
+    const waiters = Array.from(this.waiters)
+    this.waiters.clear()
+    for (const wake of waiters) wake()
+  }
+
+  /**
+   * Resolve true when notified, false on timeout or when the request is aborted
+   */
+  wait(timeout_ms: number, signal?: AbortSignal): Promise<boolean> {
+    if (signal?.aborted) return Promise.resolve(false)
+
+    return new Promise(resolve => {
+      let timer: ReturnType<typeof setTimeout>
+      const done = (notified: boolean) => {
+        clearTimeout(timer)
+        this.waiters.delete(onNotify)
+        signal?.removeEventListener('abort', onAbort)
+        resolve(notified)
+      }
+      const onNotify = () => done(true)
+      const onAbort = () => done(false)
+
+      timer = setTimeout(() => done(false), timeout_ms)
+      this.waiters.add(onNotify)
+      signal?.addEventListener('abort', onAbort, { once: true })
+    })
+  }
+
+  get waiting(): number {
+    return this.waiters.size
+  }
+}
+
+/**
+ * Parse the `wait` query parameter (ms) for long-polling, capped at 60 s
+ */
+export function parse_wait_ms(value: string | null): number {
+  const wait = parseInt(value || '0')
+  if (!Number.isFinite(wait) || wait <= 0) return 0
+  return Math.min(wait, 60_000)
+}
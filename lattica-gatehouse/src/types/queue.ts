@@ -43,6 +43,7 @@ export interface JobQueueStats {
   failed_count: number
   oldest_queued_timestamp: number
   newest_queued_timestamp: number
+  waiting_executors: number       // executors long-polling for new jobs
 }
 
 export interface BatchWindowJobs {